@@ -39,6 +39,8 @@
 #include "nrf_fuel_gauge.h"
 #include "ui/move_ui.h"
 #include "hw_module.h"
+#include "log_module.h"
+#include "hpi_measurement_settings.h"
 
 LOG_MODULE_REGISTER(battery_module, LOG_LEVEL_DBG);
 
@@ -57,6 +59,7 @@ static bool low_battery_screen_active = false;
 static bool critical_battery_notified = false;
 static uint8_t last_battery_level = 100;  // Store last known battery level
 static float last_battery_voltage = 4.2f; // Store last known battery voltage
+static bool last_battery_charging = false; // Store last known charging status
 
 /**
  * @brief Read sensors from the NPM13xx charger
@@ -254,6 +257,7 @@ int battery_fuel_gauge_update(const struct device *charger, bool vbus_connected,
     // Update internal state for external access
     last_battery_level = *batt_level;
     last_battery_voltage = *batt_voltage;
+    last_battery_charging = *batt_charging;
 
     return 0;
 }
@@ -284,11 +288,17 @@ float battery_get_voltage(void)
     return last_battery_voltage;
 }
 
+bool battery_get_charging(void)
+{
+    return last_battery_charging;
+}
+
 void battery_monitor_conditions(uint8_t sys_batt_level, bool sys_batt_charging, float sys_batt_voltage)
 {
     // Update internal state
     last_battery_level = sys_batt_level;
     last_battery_voltage = sys_batt_voltage;
+    last_battery_charging = sys_batt_charging;
 
     // Check for low battery conditions (voltage-based)
     if (!sys_batt_charging)
@@ -297,6 +307,8 @@ void battery_monitor_conditions(uint8_t sys_batt_level, bool sys_batt_charging,
         {
             // Critical battery voltage - immediately shutdown
             LOG_ERR("Critical battery voltage (%.2f V) - shutting down", (double)sys_batt_voltage);
+            log_trend_flush_all();
+            hpi_meas_flush();
             k_msleep(1000); // Give time for log message
             hpi_hw_pmic_off();
         }
@@ -304,6 +316,7 @@ void battery_monitor_conditions(uint8_t sys_batt_level, bool sys_batt_charging,
         {
             // Show low battery warning screen
             LOG_WRN("Low battery voltage (%.2f V) - showing warning screen", (double)sys_batt_voltage);
+            hpi_meas_flush();
             low_battery_screen_active = true;
             critical_battery_notified = true;
 
@@ -101,6 +101,13 @@ uint8_t battery_get_level(void);
  */
 float battery_get_voltage(void);
 
+/**
+ * @brief Get the last known charging status
+ * 
+ * @return true if the battery is charging
+ */
+bool battery_get_charging(void);
+
 /**
  * @brief Check for battery conditions and handle low battery scenarios
  * 
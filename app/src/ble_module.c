@@ -39,6 +39,8 @@
 #include <zephyr/bluetooth/services/bas.h>
 #include <zephyr/bluetooth/services/hrs.h>
 #include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/zbus/zbus.h>
 
 #include <zephyr/settings/settings.h>
@@ -52,7 +54,22 @@
 #define LOG_LEVEL CONFIG_LOG_DEFAULT_LEVEL
 LOG_MODULE_REGISTER(ble_module, LOG_LEVEL_DBG);
 
-struct bt_conn *current_conn;
+static struct bt_conn *current_conn;
+static struct k_spinlock current_conn_lock;
+
+/* Connection callbacks swap current_conn from the BT RX thread; senders take their own reference. */
+static struct bt_conn *ble_conn_get(void)
+{
+	struct bt_conn *conn = NULL;
+	k_spinlock_key_t key = k_spin_lock(&current_conn_lock);
+
+	if (current_conn != NULL)
+	{
+		conn = bt_conn_ref(current_conn);
+	}
+	k_spin_unlock(&current_conn_lock, key);
+	return conn;
+}
 
 // BLE GATT Identifiers
 
@@ -307,6 +324,92 @@ BT_GATT_SERVICE_DEFINE(hpi_cmd_service,
 					   BT_GATT_CCC(cmd_on_cccd_changed,
 								   BT_GATT_PERM_READ | BT_GATT_PERM_WRITE), );
 
+/*
+ * Bulk (file transfer) notifications on the command characteristic. The
+ * semaphore counts free slots in the TX window and is given back from the
+ * sent callback, so a transfer runs as fast as the link drains rather than
+ * at a fixed packet rate.
+ */
+#define BLE_FILE_TX_TIMEOUT_MS 2000
+#define BLE_FILE_TX_RETRY_MS 5
+
+K_SEM_DEFINE(sem_ble_file_tx_window, CONFIG_HPI_FILE_TRANSFER_TX_WINDOW, CONFIG_HPI_FILE_TRANSFER_TX_WINDOW);
+
+static void ble_file_tx_sent_cb(struct bt_conn *conn, void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(user_data);
+
+	k_sem_give(&sem_ble_file_tx_window);
+}
+
+static void ble_file_tx_reset(void)
+{
+	k_sem_reset(&sem_ble_file_tx_window);
+	for (int i = 0; i < CONFIG_HPI_FILE_TRANSFER_TX_WINDOW; i++)
+	{
+		k_sem_give(&sem_ble_file_tx_window);
+	}
+}
+
+int hpi_ble_send_data_windowed(const uint8_t *data, uint16_t len, uint32_t *tx_busy)
+{
+	struct bt_conn *conn = ble_conn_get();
+
+	if (conn == NULL)
+	{
+		return -ENOTCONN;
+	}
+	bt_conn_unref(conn);
+
+	if (k_sem_take(&sem_ble_file_tx_window, K_MSEC(BLE_FILE_TX_TIMEOUT_MS)) != 0)
+	{
+		return -ETIMEDOUT;
+	}
+
+	struct bt_gatt_notify_params params = {
+		.attr = &hpi_cmd_service.attrs[4],
+		.data = data,
+		.len = len,
+		.func = ble_file_tx_sent_cb,
+	};
+	int64_t deadline = k_uptime_get() + BLE_FILE_TX_TIMEOUT_MS;
+
+	for (;;)
+	{
+		conn = ble_conn_get();
+		if (conn == NULL)
+		{
+			k_sem_give(&sem_ble_file_tx_window);
+			return -ENOTCONN;
+		}
+
+		int ret = bt_gatt_notify_cb(conn, &params);
+		bt_conn_unref(conn);
+		if (ret == -ENOMEM || ret == -ENOBUFS)
+		{
+			// Shared TX buffers are held by other traffic - wait for one to free up
+			if (tx_busy != NULL)
+			{
+				(*tx_busy)++;
+			}
+			if (k_uptime_get() >= deadline)
+			{
+				k_sem_give(&sem_ble_file_tx_window);
+				return -ETIMEDOUT;
+			}
+			k_sleep(K_MSEC(BLE_FILE_TX_RETRY_MS));
+			continue;
+		}
+
+		if (ret != 0)
+		{
+			k_sem_give(&sem_ble_file_tx_window);
+		}
+		return ret;
+	}
+}
+
 void hpi_ble_send_data(const uint8_t *data, uint16_t len)
 {
 
@@ -317,73 +420,512 @@ void hpi_ble_send_data(const uint8_t *data, uint16_t len)
 	bt_gatt_notify(NULL, attr, data, len);
 }
 
-void ble_ppg_notify_wr(uint32_t *ppg_data, uint8_t len)
+/*
+ * Live sensor streaming
+ *
+ * Samples from successive sensor batches are packed into MTU-sized
+ * notifications with a small header (see HPI_BLE_STREAM_HDR_LEN). A packet is
+ * closed when the next sample no longer fits or when the oldest sample has
+ * waited CONFIG_HPI_BLE_STREAM_MAX_LATENCY_MS. Closed packets wait in a short
+ * per-stream queue and are released to the stack only while fewer than
+ * CONFIG_HPI_BLE_STREAM_TX_WINDOW notifications are in flight, so the data
+ * thread never blocks on TX buffers. If a queue overflows the oldest packet is
+ * dropped; its sequence number is lost and the host sees the gap.
+ *
+ * Samples are staged raw and encoded only when the packet is closed, using the
+ * stream's negotiated encoding; the fill check tracks the encoded size so
+ * compact encodings carry proportionally more samples per notification.
+ */
+
+#define BLE_STREAM_MAX_PAYLOAD (CONFIG_BT_L2CAP_TX_MTU - 3)
+#define BLE_STREAM_MAX_SAMPLES MIN(BLE_STREAM_MAX_PAYLOAD - HPI_BLE_STREAM_HDR_LEN, UINT8_MAX)
+#define BLE_STREAM_TX_RETRY_MS 5
+
+struct ble_stream_pkt
+{
+	uint16_t len;
+	uint8_t data[BLE_STREAM_MAX_PAYLOAD];
+};
+
+struct ble_stream
+{
+	const struct bt_gatt_attr *attr;
+	uint16_t seq;
+	uint16_t limit;		  // Payload limit for the packet being filled
+	uint16_t enc_len;	  // Encoded size of the packet being filled, header included
+	uint8_t encoding;	  // enum hpi_ble_stream_encoding, applied when the packet is closed
+	uint8_t delta_width;  // Byte width of the widest delta so far (DELTA_BLOCK only)
+	uint8_t sample_count; // Samples in the packet being filled
+	uint32_t first_ts;
+	int32_t staging[BLE_STREAM_MAX_SAMPLES];
+	struct ble_stream_pkt pending[CONFIG_HPI_BLE_STREAM_QUEUE_DEPTH];
+	uint8_t pend_head;
+	uint8_t pend_count;
+	struct k_work_delayable flush_work;
+	struct hpi_ble_stream_stats_t stats;
+};
+
+static struct ble_stream ble_streams[HPI_BLE_STREAM_COUNT];
+static uint8_t ble_stream_rr_next;
+static atomic_t ble_stream_in_flight = ATOMIC_INIT(0);
+K_MUTEX_DEFINE(mutex_ble_stream);
+
+static void ble_stream_tx_work_handler(struct k_work *work);
+K_WORK_DELAYABLE_DEFINE(ble_stream_tx_work, ble_stream_tx_work_handler);
+
+static uint16_t ble_stream_payload_limit(void)
 {
-	uint8_t out_data[128];
+	uint16_t limit = BLE_STREAM_MAX_PAYLOAD;
+	struct bt_conn *conn = ble_conn_get();
 
-	for (int i = 0; i < len; i++)
+	if (conn != NULL)
 	{
-		out_data[i * 4] = (uint8_t)ppg_data[i];
-		out_data[i * 4 + 1] = (uint8_t)(ppg_data[i] >> 8);
-		out_data[i * 4 + 2] = (uint8_t)(ppg_data[i] >> 16);
-		out_data[i * 4 + 3] = (uint8_t)(ppg_data[i] >> 24);
+		uint16_t mtu_payload = bt_gatt_get_mtu(conn) - 3;
+		if (mtu_payload < limit)
+		{
+			limit = mtu_payload;
+		}
+		bt_conn_unref(conn);
 	}
+	return limit;
+}
 
-	// LOG_DBG("PPG Not len %d", len);
+/* Sample encoding helpers. MAX30001 ECG/BioZ and MAX32664 PPG counts all fit in 24 bits. */
 
-	bt_gatt_notify(NULL, &hpi_ppg_service.attrs[2], &out_data, len * 4);
+static inline int32_t ble_stream_sat24(int32_t v)
+{
+	return CLAMP(v, -0x800000, 0x7FFFFF);
 }
 
-void ble_ppg_notify_fi(uint32_t *ppg_data, uint8_t len)
+static inline uint32_t ble_stream_zigzag(int32_t v)
 {
-	uint8_t out_data[128];
+	return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline uint8_t ble_stream_varint_len(uint32_t v)
+{
+	uint8_t n = 1;
 
-	for (int i = 0; i < len; i++)
+	while (v >= 0x80)
 	{
-		out_data[i * 4] = (uint8_t)ppg_data[i];
-		out_data[i * 4 + 1] = (uint8_t)(ppg_data[i] >> 8);
-		out_data[i * 4 + 2] = (uint8_t)(ppg_data[i] >> 16);
-		out_data[i * 4 + 3] = (uint8_t)(ppg_data[i] >> 24);
+		v >>= 7;
+		n++;
 	}
+	return n;
+}
 
-	// LOG_DBG("PPG Not len %d", len);
+static inline uint8_t ble_stream_delta_width(int32_t d)
+{
+	if (d >= INT8_MIN && d <= INT8_MAX)
+	{
+		return 1;
+	}
+	if (d >= INT16_MIN && d <= INT16_MAX)
+	{
+		return 2;
+	}
+	if (d >= -0x800000 && d <= 0x7FFFFF)
+	{
+		return 3;
+	}
+	return 4;
+}
 
-	bt_gatt_notify(NULL, &hpi_ppg_service.attrs[4], &out_data, len * 4);
+/* Delta between consecutive samples with int32 wrap-around, so the host can undo it the same way */
+static inline int32_t ble_stream_delta(int32_t cur, int32_t prev)
+{
+	return (int32_t)((uint32_t)cur - (uint32_t)prev);
 }
 
-void ble_ecg_notify(int32_t *ecg_data, uint8_t len)
-{ 
-	uint8_t out_data[128];
-	
-	for (int i = 0; i < len; i++)
+/* Encoded packet size if v were appended to the packet being filled */
+static uint16_t ble_stream_cost(const struct ble_stream *s, int32_t v, uint8_t *width)
+{
+	*width = s->delta_width;
+
+	switch (s->encoding)
+	{
+	case HPI_BLE_STREAM_ENC_PACKED24:
+		return s->enc_len + 3;
+
+	case HPI_BLE_STREAM_ENC_DELTA_VARINT:
+		if (s->sample_count == 0)
+		{
+			return s->enc_len + ble_stream_varint_len(ble_stream_zigzag(v));
+		}
+		return s->enc_len + ble_stream_varint_len(
+								ble_stream_zigzag(ble_stream_delta(v, s->staging[s->sample_count - 1])));
+
+	case HPI_BLE_STREAM_ENC_DELTA_BLOCK:
+		if (s->sample_count == 0)
+		{
+			// 24-bit base sample + delta width byte
+			return HPI_BLE_STREAM_HDR_LEN + 4;
+		}
+		*width = MAX(s->delta_width,
+					 ble_stream_delta_width(ble_stream_sat24(v) - ble_stream_sat24(s->staging[s->sample_count - 1])));
+		return HPI_BLE_STREAM_HDR_LEN + 4 + s->sample_count * (*width);
+
+	case HPI_BLE_STREAM_ENC_INT32:
+	default:
+		return s->enc_len + 4;
+	}
+}
+
+static uint16_t ble_stream_encode(const struct ble_stream *s, uint8_t *out)
+{
+	uint8_t *p = out;
+
+	switch (s->encoding)
 	{
-		out_data[i * 4] = (uint8_t)ecg_data[i];
-		out_data[i * 4 + 1] = (uint8_t)(ecg_data[i] >> 8);
-		out_data[i * 4 + 2] = (uint8_t)(ecg_data[i] >> 16);
-		out_data[i * 4 + 3] = (uint8_t)(ecg_data[i] >> 24);
+	case HPI_BLE_STREAM_ENC_PACKED24:
+		for (int i = 0; i < s->sample_count; i++)
+		{
+			sys_put_le24((uint32_t)ble_stream_sat24(s->staging[i]), p);
+			p += 3;
+		}
+		break;
+
+	case HPI_BLE_STREAM_ENC_DELTA_VARINT:
+		for (int i = 0; i < s->sample_count; i++)
+		{
+			int32_t v = (i == 0) ? s->staging[0] : ble_stream_delta(s->staging[i], s->staging[i - 1]);
+			uint32_t zz = ble_stream_zigzag(v);
+
+			while (zz >= 0x80)
+			{
+				*p++ = (uint8_t)(zz | 0x80);
+				zz >>= 7;
+			}
+			*p++ = (uint8_t)zz;
+		}
+		break;
+
+	case HPI_BLE_STREAM_ENC_DELTA_BLOCK:
+		sys_put_le24((uint32_t)ble_stream_sat24(s->staging[0]), p);
+		p[3] = s->delta_width;
+		p += 4;
+		for (int i = 1; i < s->sample_count; i++)
+		{
+			uint32_t d = (uint32_t)(ble_stream_sat24(s->staging[i]) - ble_stream_sat24(s->staging[i - 1]));
+			for (int b = 0; b < s->delta_width; b++)
+			{
+				*p++ = (uint8_t)(d >> (8 * b));
+			}
+		}
+		break;
+
+	case HPI_BLE_STREAM_ENC_INT32:
+	default:
+		for (int i = 0; i < s->sample_count; i++)
+		{
+			sys_put_le32((uint32_t)s->staging[i], p);
+			p += 4;
+		}
+		break;
 	}
 
-	// LOG_DBG("ECG Not len %d", len);
+	return (uint16_t)(p - out);
+}
 
-	bt_gatt_notify(NULL, &hpi_ecg_gsr_service.attrs[2], &out_data, len * 4);
+static void ble_stream_begin(struct ble_stream *s)
+{
+	s->limit = ble_stream_payload_limit();
+	s->sample_count = 0;
+	s->delta_width = 1;
+	s->enc_len = HPI_BLE_STREAM_HDR_LEN;
+	s->first_ts = k_uptime_get_32();
 }
 
-void ble_gsr_notify(int32_t *gsr_data, uint8_t len)
+/* Encode the packet being filled into the pending queue. Caller holds mutex_ble_stream. */
+static void ble_stream_finalize(struct ble_stream *s)
 {
-	uint8_t out_data[128];
-	
-	for (int i = 0; i < len; i++)
-    {
-        out_data[i * 4]     = (uint8_t)gsr_data[i];
-        out_data[i * 4 + 1] = (uint8_t)(gsr_data[i] >> 8);
-        out_data[i * 4 + 2] = (uint8_t)(gsr_data[i] >> 16);
-        out_data[i * 4 + 3] = (uint8_t)(gsr_data[i] >> 24);
-    }
+	if (s->sample_count == 0)
+	{
+		s->enc_len = 0;
+		return;
+	}
 
-	//LOG_DBG("GSR Not len %d", len);
+	if (s->pend_count == CONFIG_HPI_BLE_STREAM_QUEUE_DEPTH)
+	{
+		// Link can't keep up - drop the oldest packet, the host sees the sequence gap
+		s->pend_head = (s->pend_head + 1) % CONFIG_HPI_BLE_STREAM_QUEUE_DEPTH;
+		s->pend_count--;
+		s->stats.packets_dropped++;
+	}
+
+	uint8_t tail = (s->pend_head + s->pend_count) % CONFIG_HPI_BLE_STREAM_QUEUE_DEPTH;
+	struct ble_stream_pkt *pkt = &s->pending[tail];
+
+	pkt->data[0] = (uint8_t)(s - ble_streams);
+	pkt->data[1] = s->encoding;
+	sys_put_le16(s->seq++, &pkt->data[2]);
+	sys_put_le32(s->first_ts, &pkt->data[4]);
+	pkt->data[8] = s->sample_count;
+	pkt->len = HPI_BLE_STREAM_HDR_LEN + ble_stream_encode(s, &pkt->data[HPI_BLE_STREAM_HDR_LEN]);
+	s->pend_count++;
+
+	s->enc_len = 0;
+	s->sample_count = 0;
+}
+
+static void ble_stream_sent_cb(struct bt_conn *conn, void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(user_data);
 
-	bt_gatt_notify(NULL, &hpi_ecg_gsr_service.attrs[4], &out_data, len * 4);
-	
+	// Completions for packets sent before a reconnect may still arrive after ble_stream_reset()
+	if (atomic_dec(&ble_stream_in_flight) <= 0)
+	{
+		atomic_set(&ble_stream_in_flight, 0);
+	}
+	k_work_reschedule(&ble_stream_tx_work, K_NO_WAIT);
+}
+
+/* Hand pending packets to the stack while TX window is open. Caller holds mutex_ble_stream. */
+static void ble_stream_pump(void)
+{
+	struct bt_conn *conn = ble_conn_get();
+
+	if (conn == NULL)
+	{
+		return;
+	}
+
+	for (int scanned = 0; scanned < HPI_BLE_STREAM_COUNT;)
+	{
+		if (atomic_get(&ble_stream_in_flight) >= CONFIG_HPI_BLE_STREAM_TX_WINDOW)
+		{
+			break;
+		}
+
+		struct ble_stream *s = &ble_streams[ble_stream_rr_next];
+		if (s->pend_count == 0)
+		{
+			ble_stream_rr_next = (ble_stream_rr_next + 1) % HPI_BLE_STREAM_COUNT;
+			scanned++;
+			continue;
+		}
+
+		struct ble_stream_pkt *pkt = &s->pending[s->pend_head];
+		struct bt_gatt_notify_params params = {
+			.attr = s->attr,
+			.data = pkt->data,
+			.len = pkt->len,
+			.func = ble_stream_sent_cb,
+		};
+
+		atomic_inc(&ble_stream_in_flight);
+		int ret = bt_gatt_notify_cb(conn, &params);
+		if (ret == -ENOMEM || ret == -ENOBUFS)
+		{
+			// Out of TX buffers - keep the packet and retry shortly
+			atomic_dec(&ble_stream_in_flight);
+			s->stats.tx_busy++;
+			k_work_reschedule(&ble_stream_tx_work, K_MSEC(BLE_STREAM_TX_RETRY_MS));
+			break;
+		}
+
+		if (ret == 0)
+		{
+			s->stats.packets_sent++;
+			s->stats.samples_sent += pkt->data[8];
+			s->stats.bytes_sent += pkt->len;
+		}
+		else
+		{
+			// Not subscribed or link going down - nothing to retry
+			atomic_dec(&ble_stream_in_flight);
+			s->stats.packets_dropped++;
+		}
+
+		s->pend_head = (s->pend_head + 1) % CONFIG_HPI_BLE_STREAM_QUEUE_DEPTH;
+		s->pend_count--;
+
+		// Round-robin so one busy stream cannot starve the others
+		ble_stream_rr_next = (ble_stream_rr_next + 1) % HPI_BLE_STREAM_COUNT;
+		scanned = 0;
+	}
+
+	bt_conn_unref(conn);
+}
+
+static void ble_stream_tx_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&mutex_ble_stream, K_FOREVER);
+	ble_stream_pump();
+	k_mutex_unlock(&mutex_ble_stream);
+}
+
+static void ble_stream_flush_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct ble_stream *s = CONTAINER_OF(dwork, struct ble_stream, flush_work);
+
+	k_mutex_lock(&mutex_ble_stream, K_FOREVER);
+	ble_stream_finalize(s);
+	ble_stream_pump();
+	k_mutex_unlock(&mutex_ble_stream);
+}
+
+static void ble_stream_put(enum hpi_ble_stream_id id, const uint32_t *samples, uint8_t count)
+{
+	struct ble_stream *s = &ble_streams[id];
+	struct bt_conn *conn = ble_conn_get();
+
+	if (conn == NULL)
+	{
+		return;
+	}
+
+	bool subscribed = s->attr != NULL &&
+					  bt_gatt_is_subscribed(conn, s->attr, BT_GATT_CCC_NOTIFY);
+	bt_conn_unref(conn);
+	if (!subscribed)
+	{
+		return;
+	}
+
+	k_mutex_lock(&mutex_ble_stream, K_FOREVER);
+
+	for (int i = 0; i < count; i++)
+	{
+		int32_t v = (int32_t)samples[i];
+		uint8_t width;
+
+		if (s->enc_len == 0)
+		{
+			ble_stream_begin(s);
+		}
+
+		uint16_t cost = ble_stream_cost(s, v, &width);
+		if (cost > s->limit || s->sample_count == BLE_STREAM_MAX_SAMPLES)
+		{
+			ble_stream_finalize(s);
+			ble_stream_begin(s);
+			cost = ble_stream_cost(s, v, &width);
+		}
+
+		s->staging[s->sample_count++] = v;
+		s->enc_len = cost;
+		s->delta_width = width;
+	}
+
+	// Bound latency for slow streams (GSR, wrist PPG) that take seconds to fill a packet
+	if (s->sample_count > 0)
+	{
+		k_work_schedule(&s->flush_work, K_MSEC(CONFIG_HPI_BLE_STREAM_MAX_LATENCY_MS));
+	}
+
+	ble_stream_pump();
+
+	k_mutex_unlock(&mutex_ble_stream);
+}
+
+static void ble_stream_reset(void)
+{
+	k_mutex_lock(&mutex_ble_stream, K_FOREVER);
+	for (int i = 0; i < HPI_BLE_STREAM_COUNT; i++)
+	{
+		struct ble_stream *s = &ble_streams[i];
+		k_work_cancel_delayable(&s->flush_work);
+		s->enc_len = 0;
+		s->sample_count = 0;
+		// Encodings are negotiated per connection; old clients expect int32
+		s->encoding = HPI_BLE_STREAM_ENC_INT32;
+		s->pend_head = 0;
+		s->pend_count = 0;
+		s->seq = 0;
+	}
+	atomic_set(&ble_stream_in_flight, 0);
+	k_mutex_unlock(&mutex_ble_stream);
+}
+
+static void ble_stream_init(void)
+{
+	ble_streams[HPI_BLE_STREAM_ECG].attr = &hpi_ecg_gsr_service.attrs[2];
+	ble_streams[HPI_BLE_STREAM_GSR].attr = &hpi_ecg_gsr_service.attrs[4];
+	ble_streams[HPI_BLE_STREAM_PPG_WR].attr = &hpi_ppg_service.attrs[2];
+	ble_streams[HPI_BLE_STREAM_PPG_FI].attr = &hpi_ppg_service.attrs[4];
+
+	for (int i = 0; i < HPI_BLE_STREAM_COUNT; i++)
+	{
+		k_work_init_delayable(&ble_streams[i].flush_work, ble_stream_flush_work_handler);
+	}
+}
+
+uint16_t hpi_ble_get_max_payload(void)
+{
+	return ble_stream_payload_limit();
+}
+
+void hpi_ble_stream_get_stats(uint8_t stream_id, struct hpi_ble_stream_stats_t *out)
+{
+	if (stream_id >= HPI_BLE_STREAM_COUNT || out == NULL)
+	{
+		return;
+	}
+
+	k_mutex_lock(&mutex_ble_stream, K_FOREVER);
+	*out = ble_streams[stream_id].stats;
+	k_mutex_unlock(&mutex_ble_stream);
+}
+
+int hpi_ble_stream_set_encoding(uint8_t stream_id, uint8_t encoding)
+{
+	if (stream_id >= HPI_BLE_STREAM_COUNT)
+	{
+		return -EINVAL;
+	}
+	if (encoding >= HPI_BLE_STREAM_ENC_COUNT)
+	{
+		return -ENOTSUP;
+	}
+
+	struct ble_stream *s = &ble_streams[stream_id];
+
+	k_mutex_lock(&mutex_ble_stream, K_FOREVER);
+	if (s->encoding != encoding)
+	{
+		// Samples already staged go out with the encoding they were sized for
+		ble_stream_finalize(s);
+		s->encoding = encoding;
+		ble_stream_pump();
+	}
+	k_mutex_unlock(&mutex_ble_stream);
+
+	LOG_INF("Stream %d encoding: %d", stream_id, encoding);
+	return 0;
+}
+
+uint8_t hpi_ble_stream_get_encoding(uint8_t stream_id)
+{
+	if (stream_id >= HPI_BLE_STREAM_COUNT)
+	{
+		return HPI_BLE_STREAM_ENC_INT32;
+	}
+	return ble_streams[stream_id].encoding;
+}
+
+void ble_ppg_notify_wr(uint32_t *ppg_data, uint8_t len)
+{
+	ble_stream_put(HPI_BLE_STREAM_PPG_WR, ppg_data, len);
+}
+
+void ble_ppg_notify_fi(uint32_t *ppg_data, uint8_t len)
+{
+	ble_stream_put(HPI_BLE_STREAM_PPG_FI, ppg_data, len);
+}
+
+void ble_ecg_notify(int32_t *ecg_data, uint8_t len)
+{
+	ble_stream_put(HPI_BLE_STREAM_ECG, (const uint32_t *)ecg_data, len);
+}
+
+void ble_gsr_notify(int32_t *gsr_data, uint8_t len)
+{
+	ble_stream_put(HPI_BLE_STREAM_GSR, (const uint32_t *)gsr_data, len);
 }
 
 void ble_bpt_cal_progress_notify(uint8_t bpt_status, uint8_t bpt_progress)
@@ -422,6 +964,13 @@ static void connected(struct bt_conn *conn, uint8_t err)
 
 	LOG_INF("Connected to %s\n", addr);
 
+	k_spinlock_key_t key = k_spin_lock(&current_conn_lock);
+	if (current_conn == NULL)
+	{
+		current_conn = bt_conn_ref(conn);
+	}
+	k_spin_unlock(&current_conn_lock, key);
+
 	if (bt_conn_set_security(conn, BT_SECURITY_L2))
 	{
 		LOG_ERR("Failed to set security\n");
@@ -436,6 +985,22 @@ static void disconnected(struct bt_conn *conn, uint8_t reason)
 
 	LOG_INF("Disconnected from %s, reason 0x%02x %s\n", addr,
 			reason, bt_hci_err_to_str(reason));
+
+	struct bt_conn *old = NULL;
+	k_spinlock_key_t key = k_spin_lock(&current_conn_lock);
+	if (current_conn == conn)
+	{
+		old = current_conn;
+		current_conn = NULL;
+	}
+	k_spin_unlock(&current_conn_lock, key);
+
+	if (old != NULL)
+	{
+		bt_conn_unref(old);
+		ble_stream_reset();
+		ble_file_tx_reset();
+	}
 }
 
 static void security_changed(struct bt_conn *conn, bt_security_t level,
@@ -526,6 +1091,8 @@ void ble_module_init()
 
 	settings_load();
 
+	ble_stream_init();
+
 	err = bt_le_adv_start(BT_LE_ADV_CONN, ad, ARRAY_SIZE(ad), sd, ARRAY_SIZE(sd));
 	if (err)
 	{
@@ -30,12 +30,69 @@
 
 #pragma once
 
+#include <stdint.h>
+
+/* Live sensor stream identifiers (first byte of every stream notification) */
+enum hpi_ble_stream_id
+{
+    HPI_BLE_STREAM_ECG = 0,
+    HPI_BLE_STREAM_GSR,
+    HPI_BLE_STREAM_PPG_WR,
+    HPI_BLE_STREAM_PPG_FI,
+    HPI_BLE_STREAM_COUNT,
+};
+
+/*
+ * Stream notification header (little-endian), followed by the samples:
+ *   [0]    stream id (enum hpi_ble_stream_id)
+ *   [1]    sample encoding (enum hpi_ble_stream_encoding)
+ *   [2..3] sequence number, incremented per notification (gaps = lost packets)
+ *   [4..7] uptime in ms when the first sample in the packet was received
+ *   [8]    number of samples in the packet
+ */
+#define HPI_BLE_STREAM_HDR_LEN 9
+
+/*
+ * Sample encodings, selected per stream with HPI_CMD_STREAM_SET_ENCODING and
+ * reset to INT32 on every new connection:
+ *   INT32         4 bytes per sample, little-endian two's complement
+ *   PACKED24      3 bytes per sample, little-endian two's complement (saturated)
+ *   DELTA_VARINT  first sample, then differences to the previous sample, each
+ *                 zig-zag mapped and written as an LEB128 varint (1-5 bytes)
+ *   DELTA_BLOCK   first sample as PACKED24, one byte holding the delta width W
+ *                 (1-4), then (count - 1) differences of the 24-bit saturated
+ *                 samples as W-byte little-endian two's complement
+ */
+enum hpi_ble_stream_encoding
+{
+    HPI_BLE_STREAM_ENC_INT32 = 0,
+    HPI_BLE_STREAM_ENC_PACKED24,
+    HPI_BLE_STREAM_ENC_DELTA_VARINT,
+    HPI_BLE_STREAM_ENC_DELTA_BLOCK,
+    HPI_BLE_STREAM_ENC_COUNT,
+};
+
+struct hpi_ble_stream_stats_t
+{
+    uint32_t packets_sent;    // Notifications accepted by the stack
+    uint32_t samples_sent;    // Samples carried by those notifications
+    uint32_t packets_dropped; // Packets discarded because the TX queue stayed full
+    uint32_t tx_busy;         // Times the stack had no TX buffer and sending was deferred
+    uint32_t bytes_sent;      // Notification payload bytes, header included
+};
+
 void ble_module_init();
 void ble_bas_notify(uint8_t batt_level);
 void ble_bpt_cal_progress_notify(uint8_t bpt_status, uint8_t bpt_progress);
 void hpi_ble_send_data(const uint8_t *data, uint16_t len);
+int hpi_ble_send_data_windowed(const uint8_t *data, uint16_t len, uint32_t *tx_busy);
+uint16_t hpi_ble_get_max_payload(void);
 
 void ble_ppg_notify_wr(uint32_t *ppg_data, uint8_t len);
 void ble_ppg_notify_fi(uint32_t *ppg_data, uint8_t len);
 void ble_ecg_notify(int32_t *ecg_data, uint8_t len);
-void ble_gsr_notify(int32_t *gsr_data, uint8_t len);
\ No newline at end of file
+void ble_gsr_notify(int32_t *gsr_data, uint8_t len);
+
+void hpi_ble_stream_get_stats(uint8_t stream_id, struct hpi_ble_stream_stats_t *out);
+int hpi_ble_stream_set_encoding(uint8_t stream_id, uint8_t encoding);
+uint8_t hpi_ble_stream_get_encoding(uint8_t stream_id);
\ No newline at end of file
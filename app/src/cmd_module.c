@@ -33,13 +33,19 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/uart.h>
 #include <zephyr/sys/reboot.h>
+#include <zephyr/sys/byteorder.h>
 
 #include "cmd_module.h"
 #include "hw_module.h"
 #include "ble_module.h"
 #include "fs_module.h"
 #include "log_module.h"
+#include "hpi_measurement_settings.h"
+#include "hpi_sensor_workq.h"
+#include "ecg_filter.h"
 #include "recording_module.h"
+#include "hpi_common_types.h"
+#include "hpi_sys.h"
 
 LOG_MODULE_REGISTER(hpi_cmd_module, LOG_LEVEL_DBG);
 
@@ -83,6 +89,8 @@ void hpi_decode_data_packet(uint8_t *in_pkt_buf, uint8_t pkt_len)
     case HPI_CMD_DEVICE_RESET:
         LOG_DBG("RX CMD Reboot");
         LOG_DBG("Rebooting...");
+        log_trend_flush_all();
+        hpi_meas_flush();
         k_sleep(K_MSEC(1000));
         sys_reboot(SYS_REBOOT_COLD);
         break;
@@ -124,6 +132,16 @@ void hpi_decode_data_packet(uint8_t *in_pkt_buf, uint8_t pkt_len)
         }
         log_get(log_type, log_id_int64);
         break;
+    case HPI_CMD_LOG_GET_FILE_RANGE:
+        LOG_DBG("RX CMD Get Log Range");
+        if (pkt_len < 18)
+        {
+            LOG_ERR("Log range request too short: %d", pkt_len);
+            break;
+        }
+        log_get_range(in_pkt_buf[1], (int64_t)sys_get_le64(&in_pkt_buf[2]),
+                      sys_get_le32(&in_pkt_buf[10]), sys_get_le32(&in_pkt_buf[14]));
+        break;
     case HPI_CMD_LOG_DELETE:
         LOG_DBG("RX CMD Log delete");
         log_delete((in_pkt_buf[1] | (in_pkt_buf[2] << 8)));
@@ -218,7 +236,7 @@ void hpi_decode_data_packet(uint8_t *in_pkt_buf, uint8_t pkt_len)
         {
             struct hpi_recording_status_t status;
             hpi_recording_get_status(&status);
-            uint8_t rsp[8] = {
+            uint8_t rsp[28] = {
                 CES_CMDIF_TYPE_CMD_RSP,
                 HPI_CMD_REC_GET_STATUS,
                 status.state,
@@ -228,6 +246,34 @@ void hpi_decode_data_packet(uint8_t *in_pkt_buf, uint8_t pkt_len)
                 (uint8_t)((status.remaining_s >> 8) & 0xFF),
                 status.signal_mask
             };
+            sys_put_le32(status.bytes_written, &rsp[8]);
+            sys_put_le32(status.write_bps, &rsp[12]);
+            sys_put_le32(status.max_flush_us, &rsp[16]);
+            sys_put_le32(status.max_sync_us, &rsp[20]);
+            sys_put_le32(status.overruns, &rsp[24]);
+            hpi_ble_send_data(rsp, sizeof(rsp));
+        }
+        break;
+
+    case HPI_CMD_REC_GET_SIGNAL_STATS:
+        LOG_DBG("RX CMD Recording Get Signal Stats");
+        {
+            struct hpi_recording_signal_stats_t stats = {0};
+            uint8_t signal_type = (pkt_len > 1) ? in_pkt_buf[1] : 0;
+            int ret = hpi_recording_get_signal_stats(signal_type, &stats);
+
+            uint8_t rsp[4 + 28];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_REC_GET_SIGNAL_STATS;
+            rsp[2] = signal_type;
+            rsp[3] = (ret == 0) ? 0 : 1;
+            sys_put_le32(stats.ring_size, &rsp[4]);
+            sys_put_le32(stats.fill, &rsp[8]);
+            sys_put_le32(stats.high_water, &rsp[12]);
+            sys_put_le32(stats.overruns, &rsp[16]);
+            sys_put_le32(stats.dropped_bytes, &rsp[20]);
+            sys_put_le32(stats.bytes_written, &rsp[24]);
+            sys_put_le32(stats.samples_written, &rsp[28]);
             hpi_ble_send_data(rsp, sizeof(rsp));
         }
         break;
@@ -261,6 +307,306 @@ void hpi_decode_data_packet(uint8_t *in_pkt_buf, uint8_t pkt_len)
         }
         break;
 
+    // Diagnostics Commands
+    case HPI_CMD_DIAG_GET_DATA_STATS:
+        LOG_DBG("RX CMD Diag Get Data Stats");
+        {
+            struct hpi_data_thread_stats_t stats;
+            hpi_data_get_thread_stats(&stats);
+
+            // [type][cmd][wakeups u32][per source: batches u32, drains u32, max_burst u16]
+            uint8_t rsp[2 + 4 + HPI_DATA_SRC_COUNT * 10];
+            uint8_t idx = 0;
+            rsp[idx++] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[idx++] = HPI_CMD_DIAG_GET_DATA_STATS;
+            sys_put_le32(stats.wakeups, &rsp[idx]);
+            idx += 4;
+            for (int i = 0; i < HPI_DATA_SRC_COUNT; i++)
+            {
+                sys_put_le32(stats.batches[i], &rsp[idx]);
+                idx += 4;
+                sys_put_le32(stats.drains[i], &rsp[idx]);
+                idx += 4;
+                sys_put_le16(stats.max_burst[i], &rsp[idx]);
+                idx += 2;
+            }
+            hpi_ble_send_data(rsp, idx);
+
+            if (pkt_len > 1 && in_pkt_buf[1] != 0)
+            {
+                hpi_data_reset_thread_stats();
+            }
+        }
+        break;
+
+    case HPI_CMD_DIAG_GET_TREND_STATS:
+        LOG_DBG("RX CMD Diag Get Trend Stats");
+        {
+            struct hpi_trend_wb_stats_t stats;
+            log_trend_get_stats(&stats);
+
+            uint8_t rsp[2 + 44];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_DIAG_GET_TREND_STATS;
+            sys_put_le32(stats.points, &rsp[2]);
+            sys_put_le32(stats.commits, &rsp[6]);
+            sys_put_le32(stats.commits_full, &rsp[10]);
+            sys_put_le32(stats.commits_timer, &rsp[14]);
+            sys_put_le32(stats.commits_forced, &rsp[18]);
+            sys_put_le32(stats.bytes_written, &rsp[22]);
+            sys_put_le32(stats.write_errors, &rsp[26]);
+            sys_put_le32(stats.dropped_bytes, &rsp[30]);
+            sys_put_le32(stats.replayed_bytes, &rsp[34]);
+            sys_put_le32(stats.max_commit_us, &rsp[38]);
+            sys_put_le32(stats.pending_bytes, &rsp[42]);
+            hpi_ble_send_data(rsp, sizeof(rsp));
+
+            if (pkt_len > 1 && in_pkt_buf[1] != 0)
+            {
+                log_trend_reset_stats();
+            }
+        }
+        break;
+
+    case HPI_CMD_DIAG_GET_SENSOR_WQ_STATS:
+        LOG_DBG("RX CMD Diag Get Sensor WQ Stats");
+        {
+            uint8_t work_id = (pkt_len > 1) ? in_pkt_buf[1] : HPI_SENSOR_WORK_ECG_BIOZ;
+            struct hpi_sensor_work_stats_t stats = {0};
+            hpi_sensor_work_get_stats(work_id, &stats);
+
+            uint8_t rsp[3 + 28];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_DIAG_GET_SENSOR_WQ_STATS;
+            rsp[2] = work_id;
+            sys_put_le32(stats.runs, &rsp[3]);
+            sys_put_le32(stats.coalesced, &rsp[7]);
+            sys_put_le32(stats.deadline_misses, &rsp[11]);
+            sys_put_le32(stats.exec_avg_us, &rsp[15]);
+            sys_put_le32(stats.exec_max_us, &rsp[19]);
+            sys_put_le32(stats.wait_avg_us, &rsp[23]);
+            sys_put_le32(stats.wait_max_us, &rsp[27]);
+            hpi_ble_send_data(rsp, sizeof(rsp));
+
+            if (pkt_len > 2 && in_pkt_buf[2] != 0)
+            {
+                hpi_sensor_work_reset_stats(work_id);
+            }
+        }
+        break;
+
+    case HPI_CMD_DIAG_GET_ECG_FILTER_STATS:
+        LOG_DBG("RX CMD Diag Get ECG Filter Stats");
+        {
+            struct hpi_ecg_filter_stats_t stats;
+            hpi_ecg_filter_get_stats(&stats);
+
+            uint8_t rsp[3 + 20];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_DIAG_GET_ECG_FILTER_STATS;
+            rsp[2] = stats.profile;
+            sys_put_le32(stats.batches, &rsp[3]);
+            sys_put_le32(stats.samples, &rsp[7]);
+            sys_put_le32(stats.cycles_per_sample_avg, &rsp[11]);
+            sys_put_le32(stats.cycles_per_sample_max, &rsp[15]);
+            sys_put_le32(stats.budget_cycles, &rsp[19]);
+            hpi_ble_send_data(rsp, sizeof(rsp));
+
+            if (pkt_len > 1 && in_pkt_buf[1] != 0)
+            {
+                hpi_ecg_filter_reset_stats();
+            }
+        }
+        break;
+
+    case HPI_CMD_DIAG_GET_MEAS_CACHE_STATS:
+        LOG_DBG("RX CMD Diag Get Measurement Cache Stats");
+        {
+            struct hpi_meas_cache_stats_t stats;
+            hpi_meas_get_cache_stats(&stats);
+
+            uint8_t rsp[2 + 28];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_DIAG_GET_MEAS_CACHE_STATS;
+            sys_put_le32(stats.updates, &rsp[2]);
+            sys_put_le32(stats.writes, &rsp[6]);
+            sys_put_le32(stats.flushes, &rsp[10]);
+            sys_put_le32(stats.write_errors, &rsp[14]);
+            sys_put_le32(stats.writes_last_hour, &rsp[18]);
+            sys_put_le32(stats.writes_this_hour, &rsp[22]);
+            sys_put_le32(stats.dirty_mask, &rsp[26]);
+            hpi_ble_send_data(rsp, sizeof(rsp));
+
+            if (pkt_len > 1 && in_pkt_buf[1] != 0)
+            {
+                hpi_meas_reset_cache_stats();
+            }
+        }
+        break;
+
+    case HPI_CMD_DIAG_GET_DISPLAY_STATS:
+        LOG_DBG("RX CMD Diag Get Display Stats");
+        {
+            struct hpi_disp_frame_stats_t stats;
+            hpi_disp_get_frame_stats(&stats);
+
+            uint8_t rsp[2 + 3 + 32];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_DIAG_GET_DISPLAY_STATS;
+            rsp[2] = stats.screen;
+            sys_put_le16(stats.fps_x10, &rsp[3]);
+            sys_put_le32(stats.frames, &rsp[5]);
+            sys_put_le32(stats.areas, &rsp[9]);
+            sys_put_le32(stats.bytes, &rsp[13]);
+            sys_put_le32(stats.render_us, &rsp[17]);
+            sys_put_le32(stats.render_max_us, &rsp[21]);
+            sys_put_le32(stats.transfer_us, &rsp[25]);
+            sys_put_le32(stats.transfer_max_us, &rsp[29]);
+            sys_put_le32(stats.wait_us, &rsp[33]);
+            hpi_ble_send_data(rsp, sizeof(rsp));
+
+            if (pkt_len > 1 && in_pkt_buf[1] != 0)
+            {
+                hpi_disp_reset_frame_stats();
+            }
+        }
+        break;
+
+    case HPI_CMD_DIAG_GET_DISPLAY_SCHED_STATS:
+        LOG_DBG("RX CMD Diag Get Display Sched Stats");
+        {
+            uint8_t screen = (pkt_len > 1) ? in_pkt_buf[1] : HPI_DISP_SCHED_CURR_SCREEN;
+            struct hpi_disp_sched_stats_t stats = {0};
+            if (hpi_disp_get_sched_stats(screen, &stats) == 0)
+            {
+                screen = stats.screen;
+            }
+
+            uint8_t rsp[3 + 22];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_DIAG_GET_DISPLAY_SCHED_STATS;
+            rsp[2] = screen;
+            sys_put_le16(stats.duty_permille, &rsp[3]);
+            sys_put_le32(stats.elapsed_ms, &rsp[5]);
+            sys_put_le32(stats.busy_us, &rsp[9]);
+            sys_put_le32(stats.wakeups, &rsp[13]);
+            sys_put_le32(stats.data_wakeups, &rsp[17]);
+            sys_put_le32(stats.event_wakeups, &rsp[21]);
+            hpi_ble_send_data(rsp, sizeof(rsp));
+
+            if (pkt_len > 2 && in_pkt_buf[2] != 0)
+            {
+                hpi_disp_reset_sched_stats();
+            }
+        }
+        break;
+
+    case HPI_CMD_DIAG_GET_SCR_CACHE_STATS:
+        LOG_DBG("RX CMD Diag Get Screen Cache Stats");
+        {
+            struct hpi_scr_cache_stats_t stats;
+            hpi_scr_cache_get_stats(&stats);
+
+            uint8_t rsp[3 + 32];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_DIAG_GET_SCR_CACHE_STATS;
+            rsp[2] = stats.screens;
+            sys_put_le32(stats.bytes, &rsp[3]);
+            sys_put_le32(stats.hits, &rsp[7]);
+            sys_put_le32(stats.misses, &rsp[11]);
+            sys_put_le32(stats.evictions, &rsp[15]);
+            sys_put_le32(stats.hit_latency_avg_us, &rsp[19]);
+            sys_put_le32(stats.hit_latency_max_us, &rsp[23]);
+            sys_put_le32(stats.miss_latency_avg_us, &rsp[27]);
+            sys_put_le32(stats.miss_latency_max_us, &rsp[31]);
+            hpi_ble_send_data(rsp, sizeof(rsp));
+
+            if (pkt_len > 1 && in_pkt_buf[1] != 0)
+            {
+                hpi_scr_cache_reset_stats();
+            }
+        }
+        break;
+
+    case HPI_CMD_DIAG_GET_BLE_STREAM_STATS:
+        LOG_DBG("RX CMD Diag Get BLE Stream Stats");
+        {
+            uint8_t stream_id = (pkt_len > 1) ? in_pkt_buf[1] : HPI_BLE_STREAM_ECG;
+            struct hpi_ble_stream_stats_t stats = {0};
+            hpi_ble_stream_get_stats(stream_id, &stats);
+
+            uint8_t rsp[3 + 20];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_DIAG_GET_BLE_STREAM_STATS;
+            rsp[2] = stream_id;
+            sys_put_le32(stats.packets_sent, &rsp[3]);
+            sys_put_le32(stats.samples_sent, &rsp[7]);
+            sys_put_le32(stats.packets_dropped, &rsp[11]);
+            sys_put_le32(stats.tx_busy, &rsp[15]);
+            sys_put_le32(stats.bytes_sent, &rsp[19]);
+            hpi_ble_send_data(rsp, sizeof(rsp));
+        }
+        break;
+
+    case HPI_CMD_STREAM_SET_ENCODING:
+        LOG_DBG("RX CMD Stream Set Encoding");
+        {
+            uint8_t stream_id = (pkt_len > 1) ? in_pkt_buf[1] : 0xFF;
+            uint8_t encoding = (pkt_len > 2) ? in_pkt_buf[2] : HPI_BLE_STREAM_ENC_INT32;
+            int ret = 0;
+
+            if (stream_id == 0xFF)
+            {
+                for (uint8_t i = 0; i < HPI_BLE_STREAM_COUNT && ret == 0; i++)
+                {
+                    ret = hpi_ble_stream_set_encoding(i, encoding);
+                }
+            }
+            else
+            {
+                ret = hpi_ble_stream_set_encoding(stream_id, encoding);
+            }
+
+            // Reply with the encoding now in effect so the host can fall back if refused
+            uint8_t rsp[5];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_STREAM_SET_ENCODING;
+            rsp[2] = stream_id;
+            rsp[3] = hpi_ble_stream_get_encoding((stream_id == 0xFF) ? 0 : stream_id);
+            rsp[4] = (ret == 0) ? 0x00 : 0x01;
+            hpi_ble_send_data(rsp, sizeof(rsp));
+        }
+        break;
+
+    case HPI_CMD_STREAM_GET_ENCODING:
+        LOG_DBG("RX CMD Stream Get Encoding");
+        {
+            uint8_t rsp[2 + HPI_BLE_STREAM_COUNT];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_STREAM_GET_ENCODING;
+            for (uint8_t i = 0; i < HPI_BLE_STREAM_COUNT; i++)
+            {
+                rsp[2 + i] = hpi_ble_stream_get_encoding(i);
+            }
+            hpi_ble_send_data(rsp, sizeof(rsp));
+        }
+        break;
+
+    case HPI_CMD_STREAM_SET_ECG_FILTER:
+        LOG_DBG("RX CMD Stream Set ECG Filter");
+        {
+            uint8_t profile = (pkt_len > 1) ? in_pkt_buf[1] : HPI_ECG_FILTER_DIAGNOSTIC;
+            int ret = hpi_ecg_filter_set_profile(profile);
+
+            uint8_t rsp[4];
+            rsp[0] = CES_CMDIF_TYPE_CMD_RSP;
+            rsp[1] = HPI_CMD_STREAM_SET_ECG_FILTER;
+            rsp[2] = hpi_ecg_filter_get_profile();
+            rsp[3] = (ret == 0) ? 0x00 : 0x01;
+            hpi_ble_send_data(rsp, sizeof(rsp));
+        }
+        break;
+
     default:
         LOG_DBG("RX CMD Unknown");
         break;
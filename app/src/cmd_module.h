@@ -65,6 +65,7 @@ enum hpi_cmds
     HPI_CMD_LOG_DELETE = 0x52,    // Needs session ID (uint16) as argument
     HPI_CMD_LOG_WIPE_ALL = 0x53,  // No arguments
     HPI_CMD_LOG_GET_COUNT = 0x54, // No arguments
+    HPI_CMD_LOG_GET_FILE_RANGE = 0x55, // [log_type (uint8)][file_id (int64)][offset (uint32)][length (uint32, 0 = to end)]
 
     HPI_CMD_BPT_SEL_CAL_MODE = 0x60,
     HPI_CMD_START_BPT_CAL_START = 0x61, // Needs Sys/Diastolic (as uint8/uint8) as argument
@@ -84,6 +85,23 @@ enum hpi_cmds
     HPI_CMD_REC_GET_SESSION_LIST = 0x74, // List all recording sessions
     HPI_CMD_REC_DELETE_SESSION = 0x75,   // Delete session: [timestamp (8 bytes)]
     HPI_CMD_REC_WIPE_ALL = 0x76,         // Delete all recordings
+    HPI_CMD_REC_GET_SIGNAL_STATS = 0x77, // Ring buffer stats: [signal_type (uint8)]
+
+    // Diagnostics Commands (0x80-0x8F)
+    HPI_CMD_DIAG_GET_DATA_STATS = 0x80,  // Data thread wake-up/drain counters: [reset (uint8)]
+    HPI_CMD_DIAG_GET_BLE_STREAM_STATS = 0x81, // Live stream counters: [stream_id (uint8)]
+    HPI_CMD_DIAG_GET_TREND_STATS = 0x82, // Trend write-behind counters: [reset (uint8)]
+    HPI_CMD_DIAG_GET_SENSOR_WQ_STATS = 0x83, // Sensor work timing counters: [work_id (uint8), reset that work_id (uint8)]
+    HPI_CMD_DIAG_GET_ECG_FILTER_STATS = 0x84, // ECG filter cycles per sample: [reset (uint8)]
+    HPI_CMD_DIAG_GET_MEAS_CACHE_STATS = 0x85, // Measurement cache flash writes: [reset (uint8)]
+    HPI_CMD_DIAG_GET_DISPLAY_STATS = 0x86, // Display render vs transfer time: [reset (uint8)]
+    HPI_CMD_DIAG_GET_DISPLAY_SCHED_STATS = 0x87, // Display thread duty cycle: [screen (uint8, 0xFF = current), reset (uint8)]
+    HPI_CMD_DIAG_GET_SCR_CACHE_STATS = 0x88, // Screen cache hits and swipe latency: [reset (uint8)]
+
+    // Live Stream Commands (0x90-0x9F)
+    HPI_CMD_STREAM_SET_ENCODING = 0x90, // [stream_id (uint8, 0xFF = all)][encoding (uint8)]
+    HPI_CMD_STREAM_GET_ENCODING = 0x91, // No arguments
+    HPI_CMD_STREAM_SET_ECG_FILTER = 0x92, // [profile (uint8): 0 raw, 1 display, 2 diagnostic]
 };
 
 enum cmdif_pkt_type
@@ -95,6 +113,7 @@ enum cmdif_pkt_type
 
     CES_CMDIF_TYPE_LOG_IDX = 0x05,
     CES_CMDIF_TYPE_CMD_RSP = 0x06,
+    CES_CMDIF_TYPE_FILE_END = 0x07,
 };
 
 enum ble_status
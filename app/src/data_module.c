@@ -31,6 +31,7 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/sensor.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include <arm_math.h>
 
@@ -53,6 +54,8 @@ LOG_MODULE_REGISTER(data_module, LOG_LEVEL_DBG);
 #include "log_module.h"
 #include "recording_module.h"
 #include "gsr_algos.h"
+#include "hpi_sample_pool.h"
+#include "ecg_qrs.h"
 
 #if defined(CONFIG_HPI_GSR_STRESS_INDEX)
 ZBUS_CHAN_DECLARE(gsr_stress_chan);
@@ -106,6 +109,18 @@ static bool is_gsr_record_active = false;
 static int32_t gsr_record_buffer[GSR_RECORD_BUFFER_SAMPLES]; // e.g., 32Hz * 30s = 960 samples
 static volatile uint16_t gsr_record_counter = 0;
 K_MUTEX_DEFINE(mutex_is_gsr_record_active);
+#if defined(CONFIG_HPI_GSR_STRESS_INDEX)
+// Stress index filters run as samples arrive; guarded by mutex_is_gsr_record_active
+static struct gsr_stress_stream gsr_stress;
+#endif
+#if defined(CONFIG_HPI_GSR_CONTINUOUS_STRESS)
+// Background stress index, only touched from the data thread
+#define GSR_MONITOR_GAP_MS 2000
+BUILD_ASSERT(CONFIG_HPI_GSR_MONITOR_WINDOW_S / CONFIG_HPI_GSR_MONITOR_INTERVAL_S <= GSR_MONITOR_MAX_EPOCHS,
+             "GSR monitor window spans too many publish intervals");
+static struct gsr_stress_monitor gsr_monitor;
+static int64_t gsr_monitor_last_ts;
+#endif
 
 static int g_last_scr_count = 0;
 K_MUTEX_DEFINE(mutex_is_hrv_record_active);
@@ -118,10 +133,15 @@ static bool is_hrv_eval_active = false;
 static struct hpi_hrv_eval_result_t hrv_eval_result = {0};
 struct hpi_hrv_interval_t hrv_intervals[HRV_MAX_INTERVALS];  // R-to-R interval buffer (shared with state machine)
 volatile uint16_t hrv_interval_count = 0;                     // Number of intervals collected (shared with state machine)
+static bool hrv_run_broken;             // Beats dropped since the last accepted interval
+static int64_t hrv_last_beat_ts;        // End of the last accepted interval, 0 before the first
 K_MUTEX_DEFINE(mutex_is_hrv_eval_active);
 
-// Track last R-to-R interval to detect new beats
-static uint16_t last_rtor_value = 0;
+#if !defined(CONFIG_HPI_HRV_RR_SOURCE_RTOR)
+// Software beat detection for HRV, guarded by mutex_is_hrv_eval_active
+static struct hpi_qrs_detector hrv_qrs;
+static uint16_t hrv_last_rtor;
+#endif
 K_MUTEX_DEFINE(mutex_is_gsr_measurement_active);
 
 static uint32_t last_hr_update_time = 0;
@@ -146,6 +166,23 @@ extern struct k_msgq q_plot_ppg_fi;
 extern struct k_msgq q_plot_hrv;
 extern struct k_msgq q_plot_gsr;
 extern struct k_sem sem_ecg_complete;
+extern struct k_sem sem_gsr_complete;
+
+/* Source queues in enum hpi_data_src order; all carry struct hpi_sample_block pointers */
+static struct k_msgq *const data_src_queues[HPI_DATA_SRC_COUNT] = {
+    [HPI_DATA_SRC_ECG] = &q_ecg_sample,
+    [HPI_DATA_SRC_BIOZ] = &q_bioz_sample,
+    [HPI_DATA_SRC_PPG_FI] = &q_ppg_fi_sample,
+    [HPI_DATA_SRC_PPG_WR] = &q_ppg_wrist_sample,
+};
+
+// Max batches drained from one source queue per dispatcher pass
+#define DATA_THREAD_MAX_BURST 16
+
+static uint32_t hr_zbus_last_pub_time = 0;
+
+static struct hpi_data_thread_stats_t data_stats;
+static struct k_spinlock data_stats_lock;
 
 void sendData(int32_t ecg_sample, int32_t bioz_sample, uint32_t raw_red, uint32_t raw_ir, int32_t temp, uint8_t hr,
               uint8_t bpt_status, uint8_t spo2, bool _bioZSkipSample)
@@ -269,8 +306,8 @@ void hpi_data_hrv_record_to_file(bool active)
                     rr_buffer[i] = hrv_intervals[i].rtor_ms;
             }
             
-            // Calling calculation function
-             hpi_hrv_frequency_compact_update_spectrum(rr_buffer, hrv_interval_count);
+            // Metrics were accumulated as intervals arrived; publish and store them
+             hpi_hrv_stream_finalize();
 
              LOG_INF("HRV recording stopped - writing %d samples to file ",hrv_interval_count);
 
@@ -341,6 +378,9 @@ void hpi_data_set_gsr_record_active(bool active)
         // Starting new recording
         gsr_record_counter = 0;
         memset(gsr_record_buffer, 0, sizeof(gsr_record_buffer));
+#if defined(CONFIG_HPI_GSR_STRESS_INDEX)
+        gsr_stress_stream_reset(&gsr_stress);
+#endif
         LOG_INF("GSR recording started - buffer reset");
     }
     else
@@ -371,10 +411,9 @@ void hpi_data_set_gsr_record_active(bool active)
                 }
 
 #if defined(CONFIG_HPI_GSR_STRESS_INDEX)
-                // Calculate comprehensive stress index from buffered samples
+                // Filtering already ran per batch; only detection and scoring remain
                 static struct hpi_gsr_stress_index_t stress_data = {0};
-                calculate_gsr_stress_index(gsr_record_buffer, gsr_record_counter,
-                                           duration_sec, &stress_data);
+                gsr_stress_stream_finish(&gsr_stress, duration_sec, &stress_data);
 
                 if (stress_data.stress_data_ready) {
                     // Publish stress data via ZBus
@@ -429,6 +468,9 @@ void hpi_data_reset_gsr_record_buffer(void)
     // Reset buffer and counter without saving (for contact lost / restart)
     gsr_record_counter = 0;
     memset(gsr_record_buffer, 0, sizeof(gsr_record_buffer));
+#if defined(CONFIG_HPI_GSR_STRESS_INDEX)
+    gsr_stress_stream_reset(&gsr_stress);
+#endif
     LOG_DBG("GSR recording buffer reset");
     k_mutex_unlock(&mutex_is_gsr_record_active);
 
@@ -481,7 +523,13 @@ void hpi_data_set_hrv_eval_active(bool active)
     if (active) {
         // Reset result when starting new evaluation
         memset(&hrv_eval_result, 0, sizeof(hrv_eval_result));
-        last_rtor_value = 0;
+#if !defined(CONFIG_HPI_HRV_RR_SOURCE_RTOR)
+        hpi_qrs_init(&hrv_qrs);
+        hrv_last_rtor = 0;
+#endif
+        hrv_run_broken = false;
+        hrv_last_beat_ts = 0;
+        hpi_hrv_stream_reset();
         LOG_INF("HRV evaluation started - buffer reset");
     }
     
@@ -501,33 +549,101 @@ bool hpi_data_is_hrv_eval_active(void)
     return active;
 }
 
+// Caller holds mutex_is_hrv_eval_active. timestamp is the beat ending the interval
+static void hrv_add_interval_locked(uint16_t rtor_ms, int64_t timestamp)
+{
+    if (!is_hrv_eval_active || hrv_interval_count >= HRV_MAX_INTERVALS) {
+        return;
+    }
+
+    if (rtor_ms < 300 || rtor_ms > 1500) {
+        hrv_run_broken = true;
+        return;
+    }
+
+    // Tell the stream how long the dropped stretch was, so it neither differences
+    // across it nor squeezes it out of the spectral time axis
+    uint32_t gap_ms = 0;
+    if (hrv_run_broken && hrv_last_beat_ts > 0) {
+        int64_t gap = timestamp - rtor_ms - hrv_last_beat_ts;
+        gap_ms = (gap > 0) ? (uint32_t)gap : 1;
+    }
+    hrv_run_broken = false;
+    hrv_last_beat_ts = timestamp;
+
+    LOG_INF("New RR interval detected : %d", rtor_ms);
+    hrv_intervals[hrv_interval_count].rtor_ms = rtor_ms;
+    hrv_intervals[hrv_interval_count].timestamp = timestamp;
+    hrv_interval_count++;
+    hpi_hrv_stream_add(rtor_ms, gap_ms);
+
+    if (hrv_interval_count % 10 == 0) {
+        LOG_DBG("HRV: collected %d intervals", hrv_interval_count);
+    }
+}
+
 /**
  * @brief Add R-to-R interval to HRV evaluation buffer
- * @param rtor_ms R-to-R interval in milliseconds
+ * @param rtor_ms R-to-R interval in milliseconds, one call per new beat
+ *
+ * Equal consecutive intervals are separate beats and are all kept.
  */
 void hpi_data_add_hrv_interval(uint16_t rtor_ms)
 {
     k_mutex_lock(&mutex_is_hrv_eval_active, K_FOREVER);
-    
-    // if (is_hrv_eval_active && hrv_interval_count < HRV_MAX_INTERVALS && rtor_ms > 0 && rtor_ms < 2000) {
-    if (is_hrv_eval_active && hrv_interval_count < HRV_MAX_INTERVALS && rtor_ms >= 300 && rtor_ms <= 1500) {
-        // Detect new beat: RtoR value should change between samples
-        // Only add if different from last (to avoid duplicate intervals)
-        if (rtor_ms != last_rtor_value) {
-            LOG_INF("New RR interval detected : %d", rtor_ms);
-            hrv_intervals[hrv_interval_count].rtor_ms = rtor_ms;
-            hrv_intervals[hrv_interval_count].timestamp = k_uptime_get();
-            hrv_interval_count++;
-            last_rtor_value = rtor_ms;
-            
-            if (hrv_interval_count % 10 == 0) {
-                LOG_DBG("HRV: collected %d intervals", hrv_interval_count);
-            }
+    hrv_add_interval_locked(rtor_ms, k_uptime_get());
+    k_mutex_unlock(&mutex_is_hrv_eval_active);
+}
+
+#if !defined(CONFIG_HPI_HRV_RR_SOURCE_RTOR)
+static void hrv_detect_beats(const struct hpi_ecg_bioz_sensor_data_t *ecg)
+{
+    struct hpi_qrs_beat beats[QRS_MAX_BEATS_PER_CALL];
+    int64_t now = k_uptime_get();
+
+    k_mutex_lock(&mutex_is_hrv_eval_active, K_FOREVER);
+
+    if (ecg->ecg_lead_off)
+    {
+        hpi_qrs_init(&hrv_qrs);
+        hrv_run_broken = true;
+        k_mutex_unlock(&mutex_is_hrv_eval_active);
+        return;
+    }
+
+    if (ecg->rrint && ecg->rtor > 0)
+    {
+        hrv_last_rtor = ecg->rtor;
+    }
+
+    int num_beats = hpi_qrs_process(&hrv_qrs, ecg->ecg_samples, ecg->ecg_num_samples,
+                                    beats, ARRAY_SIZE(beats));
+
+    for (int i = 0; i < num_beats; i++)
+    {
+        bool accept = beats[i].confident;
+
+#if defined(CONFIG_HPI_HRV_RR_SOURCE_FUSED)
+        // A search-back beat counts when the MAX30001 RTOR agrees within 12.5%
+        if (beats[i].flags == QRS_FLAG_SEARCHBACK && hrv_last_rtor > 0)
+        {
+            accept = abs((int)beats[i].rr_ms - (int)hrv_last_rtor) * 8 <= hrv_last_rtor;
         }
+#endif
+        if (!accept || beats[i].rr_ms == 0)
+        {
+            hrv_run_broken = true;
+            continue;
+        }
+
+        // The batch just processed ends at sample hrv_qrs.n
+        int64_t beat_ts = now - (int64_t)(hrv_qrs.n - beats[i].sample) * 1000 / QRS_FS_HZ;
+        hrv_add_interval_locked(beats[i].rr_ms, beat_ts);
     }
-    
+
     k_mutex_unlock(&mutex_is_hrv_eval_active);
 }
+#endif
 
 /**
  * @brief Get HRV evaluation results
@@ -543,308 +659,432 @@ void hpi_data_reset_hrv_record_buffer(void)
     // Reset buffer and counter without saving (for lead-off restart)
     hrv_interval_count = 0;
     memset(hrv_intervals, 0, sizeof(hrv_intervals));
+    hrv_run_broken = false;
+    hrv_last_beat_ts = 0;
+    hpi_hrv_stream_reset();
     LOG_INF("HRV recording buffer reset (discard incomplete data)");
     is_hrv_eval_active = false;
     k_mutex_unlock(&mutex_is_hrv_eval_active);
 }
 
-void data_thread(void)
+static void data_process_ecg(struct hpi_sample_block *blk)
 {
-    struct hpi_ecg_bioz_sensor_data_t ecg_sensor_sample;
-    struct hpi_ppg_wr_data_t ppg_wr_sensor_sample;
-    struct hpi_ppg_fi_data_t ppg_fi_sensor_sample;
-    struct hpi_bioz_sample_t bsample;
+    struct hpi_ecg_bioz_sensor_data_t *ecg_sensor_sample = &blk->ecg;
 
-    static uint32_t hr_zbus_last_pub_time = 0;
+    if (settings_send_ble_enabled)
+    {
 
-    LOG_INF("Data Thread starting");
+        ble_ecg_notify(ecg_sensor_sample->ecg_samples, ecg_sensor_sample->ecg_num_samples);
+        if (ecg_sensor_sample->bioz_num_samples > 0)
+        {
+            ble_gsr_notify(ecg_sensor_sample->bioz_sample, ecg_sensor_sample->bioz_num_samples);
+        }
+    }
+    if (settings_plot_enabled)
+    {
+        int ret = hpi_sample_block_publish(&q_plot_ecg, blk);
+        if (ret != 0)
+        {
+            static uint32_t plot_drops = 0;
+            plot_drops++;
+            if ((plot_drops % 10) == 0)
+            {
+                LOG_WRN("Plot queue full - dropped %u ECG sample batches", plot_drops);
+            }
+        }
+    }
 
-    for (;;)
+    // ECG recording buffer management with mutex protection
+    // Fixed: No circular buffer - linear recording only, stop when full
+    // IMPORTANT: Only record samples when leads are connected (not lead-off)
+    // This prevents buffer from filling with garbage data when leads are removed
+
+    k_mutex_lock(&mutex_is_ecg_record_active, K_FOREVER);
+    /* DEBUG: Removed !ecg_sensor_sample.ecg_lead_off check to record regardless of lead state */
+    if (is_ecg_record_active == true && !is_hrv_eval_active)
     {
-        bool processed_data = false;
+        int samples_to_copy = ecg_sensor_sample->ecg_num_samples;
+        int space_left = ECG_RECORD_BUFFER_SAMPLES - ecg_record_counter;
+
+        // Defensive check: prevent counter from exceeding buffer size
+        if (ecg_record_counter >= ECG_RECORD_BUFFER_SAMPLES) {
+            LOG_ERR("ECG buffer counter overflow detected: %d >= %d - stopping recording",
+                    ecg_record_counter, ECG_RECORD_BUFFER_SAMPLES);
+            k_sem_give(&sem_ecg_complete);
+            k_mutex_unlock(&mutex_is_ecg_record_active);
+            return;  // Skip this sample batch
+        }
 
-        // Process all available ECG samples (unchanged)
-        if (k_msgq_get(&q_ecg_sample, &ecg_sensor_sample, K_NO_WAIT) == 0)
+        if (samples_to_copy <= space_left)
         {
-            processed_data = true;
-            if (settings_send_ble_enabled)
+            // Copy samples to buffer
+            memcpy(&ecg_record_buffer[ecg_record_counter],
+                ecg_sensor_sample->ecg_samples,
+                samples_to_copy * sizeof(int32_t));
+            ecg_record_counter += samples_to_copy;
+
+            // Check if buffer is exactly full
+            if (ecg_record_counter >= ECG_RECORD_BUFFER_SAMPLES)
             {
-
-                ble_ecg_notify(ecg_sensor_sample.ecg_samples, ecg_sensor_sample.ecg_num_samples);
-                ble_gsr_notify(ecg_sensor_sample.ecg_samples, ecg_sensor_sample.ecg_num_samples);
+                LOG_INF("ECG buffer full - collected %d samples (30.0 seconds @ 128Hz)",
+                        ecg_record_counter);
+                LOG_INF("Signaling state machine to stop recording");
+
+                // Signal state machine that buffer is full
+                // State machine will call hpi_data_set_ecg_record_active(false)
+                // which will write the file synchronously
+                k_sem_give(&sem_ecg_complete);
             }
-            if (settings_plot_enabled)
+        }
+        else
+        {
+            // Not enough space - copy what fits and stop
+            if (space_left > 0)
             {
-                int ret = k_msgq_put(&q_plot_ecg, &ecg_sensor_sample, K_NO_WAIT);
-                if (ret != 0)
-                {
-                    static uint32_t plot_drops = 0;
-                    plot_drops++;
-                    if ((plot_drops % 10) == 0)
-                    {
-                        LOG_WRN("Plot queue full - dropped %u ECG sample batches", plot_drops);
-                    }
-                }
+                memcpy(&ecg_record_buffer[ecg_record_counter],
+                    ecg_sensor_sample->ecg_samples,
+                    space_left * sizeof(int32_t));
+                ecg_record_counter += space_left;
             }
 
-            
+            LOG_WRN("ECG buffer full mid-batch - collected %d samples, discarded %d",
+                    ecg_record_counter, samples_to_copy - space_left);
 
-            // ECG recording buffer management with mutex protection
-            // Fixed: No circular buffer - linear recording only, stop when full
-            // IMPORTANT: Only record samples when leads are connected (not lead-off)
-            // This prevents buffer from filling with garbage data when leads are removed
+            LOG_INF("Signaling state machine to stop recording");
 
-            k_mutex_lock(&mutex_is_ecg_record_active, K_FOREVER);
-            /* DEBUG: Removed !ecg_sensor_sample.ecg_lead_off check to record regardless of lead state */
-            if (is_ecg_record_active == true && !is_hrv_eval_active)
-            {
-                int samples_to_copy = ecg_sensor_sample.ecg_num_samples;
-                int space_left = ECG_RECORD_BUFFER_SAMPLES - ecg_record_counter;
-
-                // Defensive check: prevent counter from exceeding buffer size
-                if (ecg_record_counter >= ECG_RECORD_BUFFER_SAMPLES) {
-                    LOG_ERR("ECG buffer counter overflow detected: %d >= %d - stopping recording",
-                            ecg_record_counter, ECG_RECORD_BUFFER_SAMPLES);
-                    extern struct k_sem sem_ecg_complete;
-                    k_sem_give(&sem_ecg_complete);
-                    k_mutex_unlock(&mutex_is_ecg_record_active);
-                    continue;  // Skip this sample batch
-                }
+            // Signal state machine that buffer is full
+            k_sem_give(&sem_ecg_complete);
+        }
+    }
 
-                if (samples_to_copy <= space_left)
-                {
-                    // Copy samples to buffer
-                    memcpy(&ecg_record_buffer[ecg_record_counter], 
-                        ecg_sensor_sample.ecg_samples, 
-                        samples_to_copy * sizeof(int32_t));
-                    ecg_record_counter += samples_to_copy;
-                    
-                    // Check if buffer is exactly full
-                    if (ecg_record_counter >= ECG_RECORD_BUFFER_SAMPLES)
-                    {
-                        LOG_INF("ECG buffer full - collected %d samples (30.0 seconds @ 128Hz)", 
-                                ecg_record_counter);
-                        
-                       
-                        
-                            LOG_INF("Signaling state machine to stop recording");
-                            
-                            // Signal state machine that buffer is full
-                            // State machine will call hpi_data_set_ecg_record_active(false)
-                            // which will write the file synchronously
-                            extern struct k_sem sem_ecg_complete;
-                            k_sem_give(&sem_ecg_complete);
-                        }
-                       
-                }
-                else
-                {
-                    // Not enough space - copy what fits and stop
-                    if (space_left > 0)
-                    {
-                        memcpy(&ecg_record_buffer[ecg_record_counter], 
-                            ecg_sensor_sample.ecg_samples, 
-                            space_left * sizeof(int32_t));
-                        ecg_record_counter += space_left;
-                    }
-                    
-                    LOG_WRN("ECG buffer full mid-batch - collected %d samples, discarded %d", 
-                            ecg_record_counter, samples_to_copy - space_left);
-                  
-                    LOG_INF("Signaling state machine to stop recording");
-                        
-                     // Signal state machine that buffer is full
-                    extern struct k_sem sem_ecg_complete;
-                    k_sem_give(&sem_ecg_complete);
-                    
-                          
-                }
-            
-            }
-        
-            k_mutex_unlock(&mutex_is_ecg_record_active);
-            
-            // HRV interval capture - only when leads are connected
-            // Skip when lead-off to prevent garbage values from corrupting HRV data
-           // LOG_INF("HRV Eval Active : %s", is_hrv_eval_active ? "True" : "False");
-            /* DEBUG: Removed !ecg_sensor_sample.ecg_lead_off check to capture HRV regardless of lead state */
-            if (is_hrv_eval_active && ecg_sensor_sample.rtor > 0)
+    k_mutex_unlock(&mutex_is_ecg_record_active);
+
+    // HRV interval capture - only when leads are connected
+    // Skip when lead-off to prevent garbage values from corrupting HRV data
+    /* DEBUG: Removed !ecg_sensor_sample.ecg_lead_off check to capture HRV regardless of lead state */
+#if defined(CONFIG_HPI_HRV_RR_SOURCE_RTOR)
+    if (is_hrv_eval_active && ecg_sensor_sample->rrint && ecg_sensor_sample->rtor > 0)
+    {
+        // Capture R-to-R intervals for HRV analysis
+        // RtoR value is in milliseconds from the MAX30001 sensor, rrint marks a new one
+        hpi_data_add_hrv_interval(ecg_sensor_sample->rtor);
+    }
+#else
+    if (is_hrv_eval_active)
+    {
+        hrv_detect_beats(ecg_sensor_sample);
+    }
+#endif
+}
+
+#if defined(CONFIG_HPI_GSR_CONTINUOUS_STRESS)
+static void gsr_monitor_process(const struct hpi_bioz_sample_t *bsample)
+{
+    static struct hpi_gsr_stress_index_t stress_data;
+
+    if (bsample->bioz_lead_off)
+    {
+        gsr_monitor_last_ts = 0;
+        return;
+    }
+
+    // Start over after lead-off or a gap in acquisition
+    if (gsr_monitor_last_ts == 0 || (bsample->timestamp - gsr_monitor_last_ts) > GSR_MONITOR_GAP_MS)
+    {
+        gsr_stress_monitor_init(&gsr_monitor, CONFIG_HPI_GSR_MONITOR_INTERVAL_S,
+                                CONFIG_HPI_GSR_MONITOR_WINDOW_S);
+    }
+    gsr_monitor_last_ts = bsample->timestamp;
+
+    if (gsr_stress_monitor_add(&gsr_monitor, bsample->bioz_samples, bsample->bioz_num_samples, &stress_data))
+    {
+        stress_data.continuous = true;
+        zbus_chan_pub(&gsr_stress_chan, &stress_data, K_NO_WAIT);
+    }
+}
+#endif
+
+static void data_process_bioz(struct hpi_sample_block *blk)
+{
+    struct hpi_bioz_sample_t *bsample = &blk->bioz;
+
+    if (settings_send_ble_enabled)
+    {
+        ble_gsr_notify(bsample->bioz_samples, bsample->bioz_num_samples);
+    }
+    if (settings_plot_enabled)
+    {
+        int ret = hpi_sample_block_publish(&q_plot_gsr, blk);
+        if (ret != 0)
+        {
+            static uint32_t plot_drops = 0;
+            plot_drops++;
+            if ((plot_drops % 10) == 0)
             {
-                // Capture R-to-R intervals for HRV analysis
-                // RtoR value is in milliseconds from the MAX30001 sensor
-                hpi_data_add_hrv_interval(ecg_sensor_sample.rtor);
+                LOG_WRN("Plot queue full - dropped %u GSR sample batches", plot_drops);
             }
-        
         }
-        if (k_msgq_get(&q_bioz_sample, &bsample, K_NO_WAIT) == 0)
+    }
+
+    // Background recording: GSR samples
+    if (hpi_recording_is_signal_enabled(REC_SIGNAL_GSR))
+    {
+        hpi_rec_add_gsr_samples(bsample->bioz_samples, bsample->bioz_num_samples);
+#if defined(CONFIG_HPI_GSR_CONTINUOUS_STRESS)
+        gsr_monitor_process(bsample);
+#endif
+        if (!is_gsr_record_active)
         {
-            processed_data = true;
-            if (settings_send_ble_enabled)
-            {
-                ble_gsr_notify(bsample.bioz_samples, bsample.bioz_num_samples);
-            }
-            if (settings_plot_enabled)
-            {
-                int ret = k_msgq_put(&q_plot_gsr, &bsample, K_NO_WAIT);
-                if (ret != 0)
-                {
-                    static uint32_t plot_drops = 0;
-                    plot_drops++;
-                    if ((plot_drops % 10) == 0)
-                    {
-                        LOG_WRN("Plot queue full - dropped %u GSR sample batches", plot_drops);
-                    }
-                }
-            }
+            hpi_data_set_gsr_measurement_active(false);
+        }
+    }
 
-            // Background recording: GSR samples
-            if (hpi_recording_is_signal_enabled(REC_SIGNAL_GSR))
-            {
-                hpi_rec_add_gsr_samples(bsample.bioz_samples, bsample.bioz_num_samples);
-            //    LOG_WRN("Added %d GSR samples to background recording",bsample.bioz_num_samples);
-                if(!is_gsr_record_active)
-                {
-                    hpi_data_set_gsr_measurement_active(false);
-                }
-            }
-        k_mutex_lock(&mutex_is_gsr_record_active, K_FOREVER);
+    k_mutex_lock(&mutex_is_gsr_record_active, K_FOREVER);
+
+    if (is_gsr_record_active == true)
+    {
+        int samples_to_copy = bsample->bioz_num_samples;
+        int space_left = GSR_RECORD_BUFFER_SAMPLES - gsr_record_counter;
 
-       // LOG_DBG("is_gsr_record_active=%d, is_measurement_active=%d, gsr_record_counter=%d",is_gsr_record_active, hpi_data_is_gsr_measurement_active(), gsr_record_counter);
-        if (is_gsr_record_active == true)
+        // Defensive check: prevent overflow
+        if (gsr_record_counter >= GSR_RECORD_BUFFER_SAMPLES)
         {
-            int samples_to_copy = bsample.bioz_num_samples;
-            int space_left = GSR_RECORD_BUFFER_SAMPLES - gsr_record_counter;
+            LOG_ERR("GSR buffer overflow detected");
+            k_sem_give(&sem_gsr_complete);
+            k_mutex_unlock(&mutex_is_gsr_record_active);
+            return;
+        }
+
+        if (samples_to_copy <= space_left)
+        {
+            memcpy(&gsr_record_buffer[gsr_record_counter],
+                bsample->bioz_samples,
+                samples_to_copy * sizeof(int32_t));
+#if defined(CONFIG_HPI_GSR_STRESS_INDEX)
+            gsr_stress_stream_add(&gsr_stress, bsample->bioz_samples, samples_to_copy);
+#endif
+
+            gsr_record_counter += samples_to_copy;
 
-            // Defensive check: prevent overflow
+            // Completed exactly full buffer
             if (gsr_record_counter >= GSR_RECORD_BUFFER_SAMPLES)
             {
-                LOG_ERR("GSR buffer overflow detected");
-                extern struct k_sem sem_gsr_complete;
+                LOG_WRN("GSR buffer full - collected %d samples(30.0 seconds @ 32Hz)", gsr_record_counter);
+                LOG_INF("Signaling GSR state machine to stop recording");
+
+                is_gsr_record_active = false;   // 🔴 CRITICAL
                 k_sem_give(&sem_gsr_complete);
-                k_mutex_unlock(&mutex_is_gsr_record_active);
-                continue;
             }
-
-            if (samples_to_copy <= space_left)
+        }
+        else
+        {
+            // Copy what fits
+            if (space_left > 0)
             {
                 memcpy(&gsr_record_buffer[gsr_record_counter],
-                    bsample.bioz_samples,
-                    samples_to_copy * sizeof(int32_t));
-
-                gsr_record_counter += samples_to_copy;
-
-                // Completed exactly full buffer
-                if (gsr_record_counter >= GSR_RECORD_BUFFER_SAMPLES)
-                {
-                    LOG_WRN("GSR buffer full - collected %d samples(30.0 seconds @ 32Hz)", gsr_record_counter);
-                    LOG_INF("Signaling GSR state machine to stop recording");
-                    
-                    is_gsr_record_active = false;   // 🔴 CRITICAL
-                    extern struct k_sem sem_gsr_complete;
-                    k_sem_give(&sem_gsr_complete);
-                }
+                    bsample->bioz_samples,
+                    space_left * sizeof(int32_t));
+#if defined(CONFIG_HPI_GSR_STRESS_INDEX)
+                gsr_stress_stream_add(&gsr_stress, bsample->bioz_samples, space_left);
+#endif
+
+                gsr_record_counter += space_left;
             }
-            else
-            {
-                // Copy what fits
-                if (space_left > 0)
-                {
-                    memcpy(&gsr_record_buffer[gsr_record_counter],
-                        bsample.bioz_samples,
-                        space_left * sizeof(int32_t));
-
-                    gsr_record_counter += space_left;
-                }
 
-             //   LOG_WRN("GSR buffer full mid-batch - dropped samples");
-                LOG_WRN("GSR buffer full mid-batch - collected %d samples, discarded %d",gsr_record_counter, samples_to_copy - space_left);
-                LOG_INF("Signaling GSR state machine to stop recording");
+            LOG_WRN("GSR buffer full mid-batch - collected %d samples, discarded %d",gsr_record_counter, samples_to_copy - space_left);
+            LOG_INF("Signaling GSR state machine to stop recording");
 
-                extern struct k_sem sem_gsr_complete;
-                k_sem_give(&sem_gsr_complete);
-            }
+            k_sem_give(&sem_gsr_complete);
         }
+    }
 
-        k_mutex_unlock(&mutex_is_gsr_record_active);
-        }
+    k_mutex_unlock(&mutex_is_gsr_record_active);
+}
+
+static void data_process_ppg_fi(struct hpi_sample_block *blk)
+{
+    struct hpi_ppg_fi_data_t *ppg_fi_sensor_sample = &blk->ppg_fi;
+
+    if (settings_send_ble_enabled)
+    {
+        ble_ppg_notify_fi(ppg_fi_sensor_sample->raw_ir, ppg_fi_sensor_sample->ppg_num_samples);
+    }
+    if (settings_plot_enabled)
+    {
+        hpi_sample_block_publish(&q_plot_ppg_fi, blk);
+    }
+
+    // Background recording: PPG Finger samples
+    if (hpi_recording_is_signal_enabled(REC_SIGNAL_PPG_FINGER))
+    {
+        hpi_rec_add_ppg_finger_samples(ppg_fi_sensor_sample->raw_ir,
+                                        ppg_fi_sensor_sample->raw_red,
+                                        ppg_fi_sensor_sample->ppg_num_samples);
+    }
+}
+
+static void data_process_ppg_wr(struct hpi_sample_block *blk)
+{
+    struct hpi_ppg_wr_data_t *ppg_wr_sensor_sample = &blk->ppg_wr;
 
-        if (k_msgq_get(&q_ppg_fi_sample, &ppg_fi_sensor_sample, K_NO_WAIT) == 0)
+    if (settings_send_ble_enabled)
+    {
+        ble_ppg_notify_wr(ppg_wr_sensor_sample->raw_green, ppg_wr_sensor_sample->ppg_num_samples);
+    }
+    if (settings_plot_enabled)
+    {
+        hpi_sample_block_publish(&q_plot_ppg_wrist, blk);
+    }
+
+    // Background recording: PPG Wrist samples
+    if (hpi_recording_is_signal_enabled(REC_SIGNAL_PPG_WRIST))
+    {
+        hpi_rec_add_ppg_wrist_samples(ppg_wr_sensor_sample->raw_ir,
+                                       ppg_wr_sensor_sample->raw_red,
+                                       ppg_wr_sensor_sample->raw_green,
+                                       ppg_wr_sensor_sample->ppg_num_samples);
+    }
+
+    if (ppg_wr_sensor_sample->scd_state == HPI_PPG_SCD_ON_SKIN)
+    {
+        if (ppg_wr_sensor_sample->hr_confidence > 75)
         {
-            processed_data = true;
-            if (settings_send_ble_enabled)
+            if (hr_zbus_last_pub_time == 0)
             {
-                ble_ppg_notify_fi(ppg_fi_sensor_sample.raw_ir, ppg_fi_sensor_sample.ppg_num_samples);
+                hr_zbus_last_pub_time = k_uptime_seconds();
             }
-            if (settings_plot_enabled)
+            if ((k_uptime_seconds() - hr_zbus_last_pub_time) > 2)
             {
-                k_msgq_put(&q_plot_ppg_fi, &ppg_fi_sensor_sample, K_NO_WAIT);
+                struct hpi_hr_t hr_chan_value = {
+                    .timestamp = hw_get_sys_time_ts(),
+                    .hr = ppg_wr_sensor_sample->hr,
+                    .hr_ready_flag = true,
+                };
+                zbus_chan_pub(&hr_chan, &hr_chan_value, K_SECONDS(1));
+                hr_zbus_last_pub_time = k_uptime_seconds();
             }
+        }
+    }
+}
 
-            // Background recording: PPG Finger samples
-            if (hpi_recording_is_signal_enabled(REC_SIGNAL_PPG_FINGER))
-            {
-                hpi_rec_add_ppg_finger_samples(ppg_fi_sensor_sample.raw_ir,
-                                                ppg_fi_sensor_sample.raw_red,
-                                                ppg_fi_sensor_sample.ppg_num_samples);
-            }
+/**
+ * @brief Snapshot the data thread dispatcher counters
+ * @param out Destination for the counters
+ */
+void hpi_data_get_thread_stats(struct hpi_data_thread_stats_t *out)
+{
+    if (out == NULL)
+    {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data_stats_lock);
+    *out = data_stats;
+    k_spin_unlock(&data_stats_lock, key);
+}
+
+void hpi_data_reset_thread_stats(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&data_stats_lock);
+    memset(&data_stats, 0, sizeof(data_stats));
+    k_spin_unlock(&data_stats_lock, key);
+}
+
+static void data_stats_account_drain(enum hpi_data_src src, uint16_t burst)
+{
+    k_spinlock_key_t key = k_spin_lock(&data_stats_lock);
+    data_stats.batches[src] += burst;
+    data_stats.drains[src]++;
+    if (burst > data_stats.max_burst[src])
+    {
+        data_stats.max_burst[src] = burst;
+    }
+    k_spin_unlock(&data_stats_lock, key);
+}
+
+/*
+ * Drain one ready source queue. At most DATA_THREAD_MAX_BURST batches are
+ * consumed per wake-up so a busy ECG stream cannot starve the other sources;
+ * anything left keeps the poll event ready and is picked up on the next pass
+ * without blocking.
+ */
+static uint16_t data_drain_source(enum hpi_data_src src)
+{
+    struct hpi_sample_block *blk;
+    uint16_t burst = 0;
+
+    while (burst < DATA_THREAD_MAX_BURST)
+    {
+        if (k_msgq_get(data_src_queues[src], &blk, K_NO_WAIT) != 0)
+        {
+            break;
         }
 
-        // Check if PPG data is available
-        if (k_msgq_get(&q_ppg_wrist_sample, &ppg_wr_sensor_sample, K_NO_WAIT) == 0)
+        switch (src)
         {
-            processed_data = true;
-            if (settings_send_ble_enabled)
-            {
-                ble_ppg_notify_wr(ppg_wr_sensor_sample.raw_green, ppg_wr_sensor_sample.ppg_num_samples);
-            }
-            if (settings_plot_enabled)
-            {
-                k_msgq_put(&q_plot_ppg_wrist, &ppg_wr_sensor_sample, K_NO_WAIT);
-            }
+        case HPI_DATA_SRC_ECG:
+            data_process_ecg(blk);
+            break;
+        case HPI_DATA_SRC_BIOZ:
+            data_process_bioz(blk);
+            break;
+        case HPI_DATA_SRC_PPG_FI:
+            data_process_ppg_fi(blk);
+            break;
+        case HPI_DATA_SRC_PPG_WR:
+            data_process_ppg_wr(blk);
+            break;
+        default:
+            break;
+        }
 
-            // Background recording: PPG Wrist samples
-            if (hpi_recording_is_signal_enabled(REC_SIGNAL_PPG_WRIST))
-            {
-                hpi_rec_add_ppg_wrist_samples(ppg_wr_sensor_sample.raw_ir,
-                                               ppg_wr_sensor_sample.raw_red,
-                                               ppg_wr_sensor_sample.raw_green,
-                                               ppg_wr_sensor_sample.ppg_num_samples);
-            }
+        // Consumers that keep the block (plot) hold their own reference
+        hpi_sample_block_unref(blk);
+        burst++;
+    }
 
-            if (settings_send_usb_enabled)
-            {
-            }
+    return burst;
+}
 
-            if (ppg_wr_sensor_sample.scd_state == HPI_PPG_SCD_ON_SKIN)
-            {
-                if (ppg_wr_sensor_sample.hr_confidence > 75)
-                {
-                    if (hr_zbus_last_pub_time == 0)
-                    {
-                        hr_zbus_last_pub_time = k_uptime_seconds();
-                    }
-                    if ((k_uptime_seconds() - hr_zbus_last_pub_time) > 2)
-                    {
-                        struct hpi_hr_t hr_chan_value = {
-                            .timestamp = hw_get_sys_time_ts(),
-                            .hr = ppg_wr_sensor_sample.hr,
-                            .hr_ready_flag = true,
-                        };
-                        zbus_chan_pub(&hr_chan, &hr_chan_value, K_SECONDS(1));
-                        hr_zbus_last_pub_time = k_uptime_seconds();
-                    }
-                }
-            }
-        }
+void data_thread(void)
+{
+    struct k_poll_event data_events[HPI_DATA_SRC_COUNT];
 
-        // Sleep longer if no data was processed to reduce CPU usage
-        if (processed_data)
+    for (int src = 0; src < HPI_DATA_SRC_COUNT; src++)
+    {
+        k_poll_event_init(&data_events[src], K_POLL_TYPE_MSGQ_DATA_AVAILABLE,
+                          K_POLL_MODE_NOTIFY_ONLY, data_src_queues[src]);
+    }
+
+    LOG_INF("Data Thread starting");
+
+    for (;;)
+    {
+        // Block until at least one producer has queued a batch - no periodic wake-ups while sensors are idle
+        int ret = k_poll(data_events, HPI_DATA_SRC_COUNT, K_FOREVER);
+        if (ret != 0)
         {
-            k_yield(); // Give other threads a chance to run
+            LOG_WRN("Data thread poll failed: %d", ret);
+            continue;
         }
-        else
+
+        k_spinlock_key_t key = k_spin_lock(&data_stats_lock);
+        data_stats.wakeups++;
+        k_spin_unlock(&data_stats_lock, key);
+
+        for (int src = 0; src < HPI_DATA_SRC_COUNT; src++)
         {
-            k_sleep(K_MSEC(1)); // Reduced sleep time to process samples faster
+            if (data_events[src].state != K_POLL_STATE_MSGQ_DATA_AVAILABLE)
+            {
+                continue;
+            }
+            data_events[src].state = K_POLL_STATE_NOT_READY;
+
+            uint16_t burst = data_drain_source((enum hpi_data_src)src);
+            if (burst > 0)
+            {
+                data_stats_account_drain((enum hpi_data_src)src, burst);
+            }
         }
     }
 }
@@ -0,0 +1,205 @@
+/*
+ * HealthyPi Move - ECG Filter Chain
+ *
+ * Per-batch CMSIS-DSP biquad cascade for the MAX30001 ECG stream.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#if defined(CONFIG_HPI_ECG_FILTER_STATS)
+#include <zephyr/timing/timing.h>
+#endif
+
+#include <errno.h>
+#include <string.h>
+#include <arm_math.h>
+
+#include "ecg_filter.h"
+
+LOG_MODULE_REGISTER(ecg_filter, LOG_LEVEL_INF);
+
+#define ECG_FILTER_HEADROOM_SHIFT   8
+#define ECG_FILTER_POST_SHIFT       1   // Coefficients are Q30 so |a1| up to 2 fits
+
+/*
+ * {b0, b1, b2, -a1, -a2} per section, Q30, fs = 128 Hz. Butterworth sections
+ * match tools/iir_coeffs_cmsis.m ("butter", 2, 128, fc, 'high'/'low'); the
+ * notch is a second-order notch at the mains frequency, 2 Hz wide at fs = 128 Hz.
+ * Scaled by 2^30 and rounded.
+ */
+#define ECG_BQ_HP_0P5HZ     1055267783, -2110535565, 1055267783, 2110217691, -1037111616
+#define ECG_BQ_HP_0P05HZ    1071879960, -2143759920, 1071879960, 2143756691, -1070021324
+#define ECG_BQ_LP_40HZ      448999474, 897998947, 448999474, -497075920, -225180151
+#define ECG_BQ_NOTCH_50HZ   1023576018, 1582469923, 1023576018, -1582469923, -973410211
+#define ECG_BQ_NOTCH_60HZ   1023576018, 2007816583, 1023576018, -2007816583, -973410211
+
+#if defined(CONFIG_HPI_ECG_MAINS_60HZ)
+#define ECG_BQ_NOTCH        ECG_BQ_NOTCH_60HZ
+#else
+#define ECG_BQ_NOTCH        ECG_BQ_NOTCH_50HZ
+#endif
+
+static const q31_t ecg_coeffs_display[] = {ECG_BQ_HP_0P5HZ, ECG_BQ_NOTCH, ECG_BQ_LP_40HZ};
+static const q31_t ecg_coeffs_diagnostic[] = {ECG_BQ_HP_0P05HZ, ECG_BQ_NOTCH};
+
+/* Every filtering profile starts with its high-pass section */
+static const struct {
+    const q31_t *coeffs;
+    uint8_t stages;
+} ecg_profiles[HPI_ECG_FILTER_PROFILE_COUNT] = {
+    [HPI_ECG_FILTER_RAW] = {NULL, 0},
+    [HPI_ECG_FILTER_DISPLAY] = {ecg_coeffs_display, ARRAY_SIZE(ecg_coeffs_display) / 5},
+    [HPI_ECG_FILTER_DIAGNOSTIC] = {ecg_coeffs_diagnostic, ARRAY_SIZE(ecg_coeffs_diagnostic) / 5},
+};
+
+#if defined(CONFIG_HPI_ECG_FILTER_PROFILE_DISPLAY)
+#define ECG_FILTER_DEFAULT_PROFILE  HPI_ECG_FILTER_DISPLAY
+#elif defined(CONFIG_HPI_ECG_FILTER_PROFILE_RAW)
+#define ECG_FILTER_DEFAULT_PROFILE  HPI_ECG_FILTER_RAW
+#else
+#define ECG_FILTER_DEFAULT_PROFILE  HPI_ECG_FILTER_DIAGNOSTIC
+#endif
+
+struct ecg_filter_chain {
+    arm_biquad_casd_df1_inst_q31 biquad;
+    q31_t state[4 * ECG_FILTER_MAX_STAGES];
+    uint8_t profile;        // Active profile, HPI_ECG_FILTER_PROFILE_COUNT before the first batch
+};
+
+#define ECG_RESET_STREAM    BIT(0)
+#define ECG_RESET_PLOT      BIT(1)
+
+// Requests from any thread, applied by the acquisition thread at the next batch
+static atomic_t ecg_profile_req = ATOMIC_INIT(ECG_FILTER_DEFAULT_PROFILE);
+static atomic_t ecg_reset_req = ATOMIC_INIT(ECG_RESET_STREAM | ECG_RESET_PLOT);
+
+// Owned by the acquisition thread
+static struct ecg_filter_chain ecg_stream = {.profile = HPI_ECG_FILTER_PROFILE_COUNT};
+static struct ecg_filter_chain ecg_plot = {.profile = HPI_ECG_FILTER_PROFILE_COUNT};
+
+static struct hpi_ecg_filter_stats_t ecg_stats;
+static uint64_t ecg_stats_cycles;
+static struct k_spinlock ecg_stats_lock;
+
+int hpi_ecg_filter_set_profile(uint8_t profile)
+{
+    if (profile >= HPI_ECG_FILTER_PROFILE_COUNT) {
+        return -EINVAL;
+    }
+
+    atomic_set(&ecg_profile_req, profile);
+    LOG_INF("ECG filter profile %u", profile);
+    return 0;
+}
+
+uint8_t hpi_ecg_filter_get_profile(void)
+{
+    return (uint8_t)atomic_get(&ecg_profile_req);
+}
+
+void hpi_ecg_filter_reset(void)
+{
+    atomic_or(&ecg_reset_req, ECG_RESET_STREAM | ECG_RESET_PLOT);
+}
+
+static void ecg_filter_start(struct ecg_filter_chain *f, uint8_t profile, int32_t first_sample)
+{
+    f->profile = profile;
+    if (ecg_profiles[profile].stages == 0) {
+        return;
+    }
+
+    arm_biquad_cascade_df1_init_q31(&f->biquad, ecg_profiles[profile].stages,
+                                    ecg_profiles[profile].coeffs, f->state,
+                                    ECG_FILTER_POST_SHIFT);
+
+    // Start the high-pass settled on the electrode offset: no baseline step at session start
+    f->state[0] = first_sample * (1 << ECG_FILTER_HEADROOM_SHIFT);
+    f->state[1] = f->state[0];
+}
+
+static void ecg_filter_run(struct ecg_filter_chain *f, atomic_val_t reset_bit, uint8_t profile,
+                           const int32_t *in, int32_t *out, uint32_t num_samples)
+{
+    if ((atomic_and(&ecg_reset_req, ~reset_bit) & reset_bit) || profile != f->profile) {
+        ecg_filter_start(f, profile, in[0]);
+    }
+
+    // Copy first so the headroom shift and the cascade run in place on out
+    arm_copy_q31(in, out, num_samples);
+    if (ecg_profiles[profile].stages == 0) {
+        return;
+    }
+
+    arm_shift_q31(out, ECG_FILTER_HEADROOM_SHIFT, out, num_samples);
+    arm_biquad_cascade_df1_q31(&f->biquad, out, out, num_samples);
+    arm_shift_q31(out, -ECG_FILTER_HEADROOM_SHIFT, out, num_samples);
+}
+
+void hpi_ecg_filter_process(const int32_t *in, int32_t *out, int32_t *plot_out, uint32_t num_samples)
+{
+    if (num_samples == 0) {
+        return;
+    }
+
+#if defined(CONFIG_HPI_ECG_FILTER_STATS)
+    timing_t start = timing_counter_get();
+#endif
+
+    ecg_filter_run(&ecg_stream, ECG_RESET_STREAM, (uint8_t)atomic_get(&ecg_profile_req),
+                   in, out, num_samples);
+    ecg_filter_run(&ecg_plot, ECG_RESET_PLOT, HPI_ECG_FILTER_DISPLAY, in, plot_out, num_samples);
+
+#if defined(CONFIG_HPI_ECG_FILTER_STATS)
+    timing_t end = timing_counter_get();
+    uint32_t cycles = (uint32_t)timing_cycles_get(&start, &end);
+    uint32_t per_sample = cycles / num_samples;
+
+    k_spinlock_key_t key = k_spin_lock(&ecg_stats_lock);
+    ecg_stats.batches++;
+    ecg_stats.samples += num_samples;
+    ecg_stats_cycles += cycles;
+    if (per_sample > ecg_stats.cycles_per_sample_max) {
+        ecg_stats.cycles_per_sample_max = per_sample;
+    }
+    k_spin_unlock(&ecg_stats_lock, key);
+#endif
+}
+
+void hpi_ecg_filter_get_stats(struct hpi_ecg_filter_stats_t *stats)
+{
+    k_spinlock_key_t key = k_spin_lock(&ecg_stats_lock);
+    *stats = ecg_stats;
+    stats->cycles_per_sample_avg = ecg_stats.samples ? (uint32_t)(ecg_stats_cycles / ecg_stats.samples) : 0;
+    k_spin_unlock(&ecg_stats_lock, key);
+
+    stats->profile = hpi_ecg_filter_get_profile();
+}
+
+void hpi_ecg_filter_reset_stats(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&ecg_stats_lock);
+    uint32_t budget = ecg_stats.budget_cycles;
+    memset(&ecg_stats, 0, sizeof(ecg_stats));
+    ecg_stats.budget_cycles = budget;
+    ecg_stats_cycles = 0;
+    k_spin_unlock(&ecg_stats_lock, key);
+}
+
+#if defined(CONFIG_HPI_ECG_FILTER_STATS)
+static int hpi_ecg_filter_init(void)
+{
+    timing_init();
+    timing_start();
+    ecg_stats.budget_cycles = (uint32_t)(timing_freq_get() / ECG_FILTER_FS_HZ);
+    return 0;
+}
+
+SYS_INIT(hpi_ecg_filter_init, APPLICATION, 0);
+#endif
@@ -0,0 +1,68 @@
+/*
+ * HealthyPi Move - ECG Filter Chain
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define ECG_FILTER_FS_HZ            128
+#define ECG_FILTER_MAX_STAGES       3
+
+/*
+ * Each MAX30001 FIFO batch goes through two arm_biquad_cascade_df1_q31()
+ * cascades on the raw codes: the selected profile for the ECG stream
+ * (recording, BLE, QRS/HRV) and DISPLAY for the live plot only. Samples are
+ * shifted up by ECG_FILTER_HEADROOM_SHIFT bits first so the 18-bit ADC codes
+ * use more of the Q31 range, and shifted back afterwards.
+ *
+ *   DISPLAY     0.5 Hz high-pass, mains notch, 40 Hz low-pass (3 stages)
+ *   DIAGNOSTIC  0.05 Hz high-pass, mains notch (2 stages, AHA low corner)
+ *   RAW         pass-through
+ *
+ * High-pass and low-pass sections are 2nd-order Butterworth. The notch is
+ * 2 Hz wide at the mains frequency (CONFIG_HPI_ECG_MAINS_50HZ / _60HZ).
+ */
+enum hpi_ecg_filter_profile {
+    HPI_ECG_FILTER_RAW = 0,
+    HPI_ECG_FILTER_DISPLAY,
+    HPI_ECG_FILTER_DIAGNOSTIC,
+    HPI_ECG_FILTER_PROFILE_COUNT,
+};
+
+struct hpi_ecg_filter_stats_t {
+    uint32_t batches;
+    uint32_t samples;
+    uint32_t cycles_per_sample_avg; /* CPU cycles, stream and plot filters together */
+    uint32_t cycles_per_sample_max; /* Worst batch */
+    uint32_t budget_cycles;         /* CPU cycles per 128 Hz sample period */
+    uint8_t profile;
+};
+
+/**
+ * @brief Select the filter profile of the ECG stream (any thread)
+ *
+ * Takes effect on the next batch, which restarts the filter state.
+ * @return 0 on success, -EINVAL for an unknown profile
+ */
+int hpi_ecg_filter_set_profile(uint8_t profile);
+uint8_t hpi_ecg_filter_get_profile(void);
+
+/* Restart the filter state on the next batch, e.g. for a new session (any thread) */
+void hpi_ecg_filter_reset(void);
+
+/**
+ * @brief Filter one FIFO batch (acquisition thread only)
+ * @param in Raw ECG samples
+ * @param out Samples filtered with the stream profile, must not overlap in
+ * @param plot_out Samples filtered with the DISPLAY profile, must not overlap in
+ * @param num_samples Batch length
+ */
+void hpi_ecg_filter_process(const int32_t *in, int32_t *out, int32_t *plot_out, uint32_t num_samples);
+
+void hpi_ecg_filter_get_stats(struct hpi_ecg_filter_stats_t *stats);
+void hpi_ecg_filter_reset_stats(void);
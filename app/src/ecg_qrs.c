@@ -0,0 +1,268 @@
+/*
+ * HealthyPi Move - ECG QRS Detector
+ *
+ * Pan-Tompkins R-peak detection on the 128 Hz MAX30001 ECG stream, with
+ * sample-accurate beat positions and interval classification for HRV.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ecg_qrs.h"
+
+#define QRS_BP_DELAY        13                          // Low-pass 3 + high-pass 10 samples
+#define QRS_DETECT_DELAY    (QRS_BP_DELAY + 2 + QRS_MWI_LEN / 2)
+#define QRS_PEAK_HOLD       26                          // Close an integrator peak after 200 ms
+#define QRS_SETTLE          64                          // Filter start-up, ignored
+#define QRS_LEARN           (2 * QRS_FS_HZ)
+#define QRS_REFRACTORY      26                          // 200 ms
+#define QRS_TWAVE_WINDOW    46                          // 360 ms
+#define QRS_RR_MIN_MS       300
+#define QRS_RR_MAX_MS       2000
+#define QRS_ABNORMAL_RESET  4                           // Consecutive abnormal intervals = new rhythm
+#define QRS_RR_PRIMED       (QRS_RR_AVG_LEN / 2)        // Similar intervals before any is trusted
+#define QRS_NOISY_PEAK      4                           // Integrator peak over 4x the signal level
+
+void hpi_qrs_init(struct hpi_qrs_detector *d)
+{
+    memset(d, 0, sizeof(*d));
+}
+
+static int32_t qrs_rr_avg_ms(const struct hpi_qrs_detector *d)
+{
+    return d->rr_count ? (int32_t)(d->rr_sum / d->rr_count) : 0;
+}
+
+static void qrs_rr_push(struct hpi_qrs_detector *d, uint16_t rr_ms)
+{
+    if (d->rr_count == QRS_RR_AVG_LEN) {
+        d->rr_sum -= d->rr_ring[d->rr_head];
+    } else {
+        d->rr_count++;
+    }
+    d->rr_ring[d->rr_head] = rr_ms;
+    d->rr_sum += rr_ms;
+    d->rr_head = (d->rr_head + 1) % QRS_RR_AVG_LEN;
+}
+
+static uint8_t qrs_classify(struct hpi_qrs_detector *d, uint16_t rr_ms)
+{
+    uint8_t flags = 0;
+    int32_t avg = qrs_rr_avg_ms(d);
+    bool off_avg = d->rr_count > 0 && abs((int32_t)rr_ms - avg) * 5 > avg;
+
+    if (rr_ms < QRS_RR_MIN_MS || rr_ms > QRS_RR_MAX_MS) {
+        flags = QRS_FLAG_ARTIFACT;
+    } else if (d->rr_count < QRS_RR_PRIMED) {
+        // No reference to judge against yet: learn from a run of similar intervals, trust none
+        if (off_avg) {
+            d->rr_count = 0;
+            d->rr_sum = 0;
+        }
+        qrs_rr_push(d, rr_ms);
+        d->abnormal_run = 0;
+        d->last_abnormal = false;
+        return QRS_FLAG_LEARNING;
+    } else if (off_avg) {
+        flags = QRS_FLAG_ECTOPIC;
+    }
+
+    bool follows_abnormal = d->last_abnormal;
+
+    if (flags == 0) {
+        d->abnormal_run = 0;
+        if (!follows_abnormal) {
+            qrs_rr_push(d, rr_ms);
+        }
+    } else if (flags == QRS_FLAG_ECTOPIC && ++d->abnormal_run >= QRS_ABNORMAL_RESET) {
+        // Sustained change of rate rather than isolated ectopy: re-learn the reference
+        d->rr_count = 0;
+        d->rr_sum = 0;
+        d->abnormal_run = 0;
+        qrs_rr_push(d, rr_ms);
+    }
+
+    // The interval after an ectopic beat (compensatory pause) is not normal either
+    d->last_abnormal = (flags != 0) && !follows_abnormal;
+    if (follows_abnormal) {
+        flags |= QRS_FLAG_ECTOPIC;
+    }
+
+    return flags;
+}
+
+static void qrs_emit(struct hpi_qrs_detector *d, uint32_t r, int32_t slope, uint8_t flags,
+                     struct hpi_qrs_beat *beats, int max_beats, int *count)
+{
+    struct hpi_qrs_beat beat = {.sample = r};
+    // A misplaced R peak spoils the intervals on both sides, keep them out of the average
+    bool noisy = (flags & QRS_FLAG_NOISY) || d->last_noisy;
+
+    d->last_noisy = (flags & QRS_FLAG_NOISY) != 0;
+
+    if (d->have_beat) {
+        uint32_t rr = r - d->last_r;
+        uint32_t rr_ms = (rr * 1000 + QRS_FS_HZ / 2) / QRS_FS_HZ;
+
+        beat.rr_ms = (uint16_t)((rr_ms > UINT16_MAX) ? UINT16_MAX : rr_ms);
+        flags |= noisy ? QRS_FLAG_NOISY : qrs_classify(d, beat.rr_ms);
+    }
+    beat.flags = flags;
+    beat.confident = (flags == 0);
+
+    d->have_beat = true;
+    d->last_r = r;
+    d->last_slope = slope;
+    d->cand_pk = 0;
+
+    if (*count < max_beats) {
+        beats[(*count)++] = beat;
+    }
+}
+
+/* An integrator peak has closed: locate its R wave and decide whether it is a beat */
+static void qrs_peak(struct hpi_qrs_detector *d, struct hpi_qrs_beat *beats, int max_beats,
+                     int *count)
+{
+    uint32_t r_t = d->pk_n;
+    int32_t r_amp = 0;
+    int32_t slope = 0;
+
+    for (uint32_t t = d->pk_n - (QRS_MWI_LEN + 3); t != d->pk_n + 1; t++) {
+        int32_t a = abs(d->bp[t % QRS_HIST_LEN]);
+        if (a > r_amp) {
+            r_amp = a;
+            r_t = t;
+        }
+        if (d->slope[t % QRS_HIST_LEN] > slope) {
+            slope = d->slope[t % QRS_HIST_LEN];
+        }
+    }
+
+    uint32_t r = r_t - QRS_BP_DELAY;
+    int64_t thr1 = d->npk + (d->spk - d->npk) / 4;
+
+    if (d->have_beat && (int32_t)(r - d->last_r) < QRS_REFRACTORY) {
+        return;
+    }
+
+    if (d->pk > thr1) {
+        // Shortly after a beat, a peak with less than half its slope is a T wave
+        if (d->have_beat && (int32_t)(r - d->last_r) < QRS_TWAVE_WINDOW && slope < d->last_slope / 2) {
+            d->npk = (d->pk + 7 * d->npk) / 8;
+            return;
+        }
+        // Far above the signal level: motion on top of the QRS, the R position is unreliable
+        uint8_t flags = (d->pk > QRS_NOISY_PEAK * d->spk) ? QRS_FLAG_NOISY : 0;
+
+        d->spk = (d->pk + 7 * d->spk) / 8;
+        qrs_emit(d, r, slope, flags, beats, max_beats, count);
+    } else {
+        d->npk = (d->pk + 7 * d->npk) / 8;
+        if (d->pk > thr1 / 2 && d->pk > d->cand_pk) {
+            d->cand_pk = d->pk;
+            d->cand_r = r;
+            d->cand_slope = slope;
+        }
+    }
+}
+
+static void qrs_step(struct hpi_qrs_detector *d, int32_t x, struct hpi_qrs_beat *beats,
+                     int max_beats, int *count)
+{
+    uint32_t n = d->n;
+
+    // Low-pass: y[n] = 2y[n-1] - y[n-2] + x[n] - 2x[n-4] + x[n-8], gain 16
+    int32_t lp = 2 * d->lp1 - d->lp2 + x - 2 * d->x[(n + 4) % QRS_LP_LEN] + d->x[n % QRS_LP_LEN];
+    d->x[n % QRS_LP_LEN] = x;
+    d->lp2 = d->lp1;
+    d->lp1 = lp;
+
+    // High-pass: delayed input minus the moving average, gain QRS_HP_LEN
+    d->lp_sum += lp - d->lp[n % QRS_HP_LEN];
+    d->lp[n % QRS_HP_LEN] = lp;
+    int32_t bp = QRS_HP_LEN * d->lp[(n + QRS_HP_LEN - QRS_HP_LEN / 2) % QRS_HP_LEN] - d->lp_sum;
+    d->bp[n % QRS_HIST_LEN] = bp;
+
+    // Five-point derivative, squaring and integration
+    int32_t der = (2 * bp + d->bp[(n - 1) % QRS_HIST_LEN] - d->bp[(n - 3) % QRS_HIST_LEN] -
+                   2 * d->bp[(n - 4) % QRS_HIST_LEN]) / 8;
+    d->slope[n % QRS_HIST_LEN] = abs(der);
+
+    int64_t sq = (int64_t)der * der;
+    d->mwi_sum += sq - d->sq[n % QRS_MWI_LEN];
+    d->sq[n % QRS_MWI_LEN] = sq;
+    int64_t mwi = d->mwi_sum;
+
+    d->n++;
+
+    if (n < QRS_SETTLE) {
+        d->mwi_prev = mwi;
+        return;
+    }
+
+    bool learning = n < QRS_SETTLE + QRS_LEARN;
+    if (learning) {
+        if (mwi > d->learn_max) {
+            d->learn_max = mwi;
+        }
+        d->learn_sum += mwi;
+        if (n == QRS_SETTLE + QRS_LEARN - 1) {
+            d->spk = d->learn_max / 3;
+            d->npk = d->learn_sum / QRS_LEARN / 2;
+        }
+    }
+
+    // Integrator peaks: start on a rise, close when the level halves or after QRS_PEAK_HOLD
+    if (!d->tracking) {
+        if (mwi > d->mwi_prev) {
+            d->tracking = true;
+            d->pk = mwi;
+            d->pk_n = n;
+        }
+    } else if (mwi > d->pk) {
+        d->pk = mwi;
+        d->pk_n = n;
+    } else if (2 * mwi < d->pk || n - d->pk_n >= QRS_PEAK_HOLD) {
+        d->tracking = false;
+        if (!learning) {
+            qrs_peak(d, beats, max_beats, count);
+        }
+    }
+    d->mwi_prev = mwi;
+
+    if (learning || !d->have_beat) {
+        return;
+    }
+
+    int32_t since = (int32_t)(n - QRS_DETECT_DELAY - d->last_r);
+    int32_t rr_avg = qrs_rr_avg_ms(d) * QRS_FS_HZ / 1000;
+
+    // Search-back: no beat for 166% of the average interval, take the best sub-threshold peak
+    if (d->cand_pk > 0 && rr_avg > 0 && since * 100 > rr_avg * 166) {
+        d->spk = (d->cand_pk + 3 * d->spk) / 4;
+        qrs_emit(d, d->cand_r, d->cand_slope, QRS_FLAG_SEARCHBACK, beats, max_beats, count);
+        return;
+    }
+
+    // Amplitude dropped (electrode shift): let the signal level decay once a second after 2 s
+    if (since > 2 * QRS_FS_HZ && since % QRS_FS_HZ == 0) {
+        d->spk -= (d->spk - d->npk) / 2;
+    }
+}
+
+int hpi_qrs_process(struct hpi_qrs_detector *d, const int32_t *ecg, uint32_t num_samples,
+                    struct hpi_qrs_beat *beats, int max_beats)
+{
+    int count = 0;
+
+    for (uint32_t i = 0; i < num_samples; i++) {
+        qrs_step(d, ecg[i], beats, max_beats, &count);
+    }
+
+    return count;
+}
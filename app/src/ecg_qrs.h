@@ -0,0 +1,112 @@
+/*
+ * HealthyPi Move - ECG QRS Detector
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define QRS_FS_HZ               128
+
+#define QRS_LP_LEN              8       // Triangular low-pass, zero at 32 Hz
+#define QRS_HP_LEN              21      // All-pass minus moving average, zero at 6 Hz
+#define QRS_MWI_LEN             19      // 150 ms integration window
+#define QRS_HIST_LEN            64      // Band-passed / slope history for peak localisation
+#define QRS_RR_AVG_LEN          8       // Normal intervals in the reference average
+
+#define QRS_MAX_BEATS_PER_CALL  4       // Enough for a 32-sample FIFO batch plus a search-back
+
+// Beat flags, any of them clears hpi_qrs_beat.confident
+#define QRS_FLAG_SEARCHBACK     0x01    // Recovered below the main threshold after a long gap
+#define QRS_FLAG_ECTOPIC        0x02    // Interval >20% off the running normal average, or the one after it
+#define QRS_FLAG_ARTIFACT       0x04    // Interval outside 300-2000 ms
+#define QRS_FLAG_LEARNING       0x08    // Reference interval average not primed yet (start, new rhythm)
+#define QRS_FLAG_NOISY          0x10    // This or the previous beat rode on motion artefact
+
+struct hpi_qrs_beat {
+    uint32_t sample;            // R peak, samples since hpi_qrs_init()
+    uint16_t rr_ms;             // Interval from the previous beat, 0 for the first one
+    uint8_t flags;              // QRS_FLAG_*
+    bool confident;             // No flags: safe to use for HRV
+};
+
+/*
+ * Pan-Tompkins detector adapted to 128 Hz: integer band-pass (about 6-11 Hz),
+ * five-point derivative, squaring and a 150 ms moving window integrator,
+ * followed by adaptive signal/noise thresholds with refractory period, T-wave
+ * slope check and search-back. Each beat is then located on the band-passed
+ * signal, so its index is sample-accurate rather than batch-accurate.
+ *
+ * The first two seconds after init only train the thresholds. Intervals are
+ * not confident until four similar ones in a row have primed the reference
+ * average, again after a rhythm change re-learns it.
+ */
+struct hpi_qrs_detector {
+    uint32_t n;                 // Samples processed
+
+    // Band-pass and derivative
+    int32_t x[QRS_LP_LEN];
+    int32_t lp1, lp2;
+    int32_t lp[QRS_HP_LEN];
+    int32_t lp_sum;
+    int32_t bp[QRS_HIST_LEN];
+    int32_t slope[QRS_HIST_LEN];
+
+    // Moving window integrator
+    int64_t sq[QRS_MWI_LEN];
+    int64_t mwi_sum;
+    int64_t mwi_prev;
+
+    // Current integrator peak
+    bool tracking;
+    int64_t pk;
+    uint32_t pk_n;
+
+    // Adaptive thresholds
+    int64_t spk;
+    int64_t npk;
+    int64_t learn_max;
+    int64_t learn_sum;
+
+    // Best sub-threshold peak since the last beat, for search-back
+    int64_t cand_pk;
+    uint32_t cand_r;
+    int32_t cand_slope;
+
+    // Last beat and interval classification
+    bool have_beat;
+    uint32_t last_r;
+    int32_t last_slope;
+    bool last_abnormal;
+    bool last_noisy;
+    uint8_t abnormal_run;
+    uint16_t rr_ring[QRS_RR_AVG_LEN];
+    uint32_t rr_sum;
+    uint8_t rr_head;
+    uint8_t rr_count;
+};
+
+/**
+ * @brief Reset the detector, e.g. at the start of a measurement or after lead-off
+ */
+void hpi_qrs_init(struct hpi_qrs_detector *d);
+
+/**
+ * @brief Run the detector over one batch of ECG samples at QRS_FS_HZ
+ * @param d Detector state
+ * @param ecg ECG samples (raw or filtered MAX30001 codes, either polarity)
+ * @param num_samples Batch length
+ * @param beats Output beats, in time order
+ * @param max_beats Capacity of beats, QRS_MAX_BEATS_PER_CALL is enough for one FIFO batch
+ * @return Number of beats written
+ *
+ * Beats are reported about 200 ms after the R peak, longer after a
+ * search-back, so a beat may belong to an earlier batch.
+ */
+int hpi_qrs_process(struct hpi_qrs_detector *d, const int32_t *ecg, uint32_t num_samples,
+                    struct hpi_qrs_beat *beats, int max_beats);
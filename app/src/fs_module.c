@@ -37,12 +37,15 @@
 #include <zephyr/fs/littlefs.h>
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/settings/settings.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 
 #include "hpi_common_types.h"
 #include "fs_module.h"
 #include "ui/move_ui.h"
 #include "trends.h"
 #include "cmd_module.h"
+#include "ble_module.h"
 
 #ifdef CONFIG_MCUMGR_GRP_FS
 #include <zephyr/device.h>
@@ -63,7 +66,13 @@ static struct fs_mount_t lfs_storage_mnt = {
 
 struct fs_mount_t *mp = &lfs_storage_mnt;
 
-#define FILE_TRANSFER_BLE_PACKET_SIZE 64 // (16*7)
+// File end status codes (CES_CMDIF_TYPE_FILE_END)
+#define FILE_TRANSFER_STATUS_OK 0x00
+#define FILE_TRANSFER_STATUS_OPEN_ERR 0x01
+#define FILE_TRANSFER_STATUS_RANGE_ERR 0x02
+#define FILE_TRANSFER_STATUS_ABORTED 0x03
+
+static uint8_t file_tx_pkt[CONFIG_BT_L2CAP_TX_MTU];
 
 static int littlefs_mount(struct fs_mount_t *mp)
 {
@@ -186,56 +195,137 @@ uint32_t transfer_get_file_length(char *m_file_name)
     return file_len;
 }
 
-void transfer_send_file(char *in_file_name)
+/*
+ * Trailer sent after the last data packet so the app can verify the transfer
+ * and resume from the next offset if the link dropped:
+ *   [type][status][offset u32][bytes u32][file_len u32][crc32 u32][duration_ms u32][tx_busy u32]
+ */
+static void transfer_send_end(uint8_t status, uint32_t offset, uint32_t bytes, uint32_t file_len,
+                              uint32_t crc, uint32_t duration_ms, uint32_t tx_busy)
 {
-    LOG_DBG("Start file transfer %s", in_file_name);
-    uint8_t m_buffer[FILE_TRANSFER_BLE_PACKET_SIZE + 1];
+    uint8_t end_pkt[26];
 
-    uint32_t file_len = transfer_get_file_length(in_file_name);
-    uint32_t number_writes = file_len / FILE_TRANSFER_BLE_PACKET_SIZE;
+    end_pkt[0] = CES_CMDIF_TYPE_FILE_END;
+    end_pkt[1] = status;
+    sys_put_le32(offset, &end_pkt[2]);
+    sys_put_le32(bytes, &end_pkt[6]);
+    sys_put_le32(file_len, &end_pkt[10]);
+    sys_put_le32(crc, &end_pkt[14]);
+    sys_put_le32(duration_ms, &end_pkt[18]);
+    sys_put_le32(tx_busy, &end_pkt[22]);
 
-    uint32_t i = 0;
+    if (hpi_ble_send_data_windowed(end_pkt, sizeof(end_pkt), NULL) != 0)
+    {
+        LOG_ERR("Failed to send file end marker");
+    }
+}
+
+/**
+ * @brief Send part of a file over the command characteristic
+ * @param in_file_name Path of the file to send
+ * @param offset First byte to send, for resuming an interrupted transfer
+ * @param length Number of bytes to send, 0 sends up to the end of the file
+ * @return 0 on success, negative error code otherwise
+ *
+ * Data goes out as CES_CMDIF_TYPE_DATA packets sized to the negotiated MTU,
+ * paced by TX completions. A CES_CMDIF_TYPE_FILE_END trailer with the CRC32
+ * of the bytes sent follows the last packet.
+ */
+int transfer_send_file_range(char *in_file_name, uint32_t offset, uint32_t length)
+{
     struct fs_file_t m_file;
+    uint32_t crc = 0;
+    uint32_t sent = 0;
+    uint32_t packets = 0;
+    uint32_t tx_busy = 0;
     int rc = 0;
 
-    if (file_len % FILE_TRANSFER_BLE_PACKET_SIZE != 0)
+    uint32_t file_len = transfer_get_file_length(in_file_name);
+    if (offset > file_len)
     {
-        number_writes++; // Last write will be smaller than 64 bytes
+        LOG_ERR("Offset %u beyond end of %s (%u)", offset, in_file_name, file_len);
+        transfer_send_end(FILE_TRANSFER_STATUS_RANGE_ERR, offset, 0, file_len, 0, 0, 0);
+        return -EINVAL;
     }
 
-    LOG_DBG("Send file: %s Size:%d No Writes: %d", in_file_name, file_len, number_writes);
+    if (length == 0 || length > file_len - offset)
+    {
+        length = file_len - offset;
+    }
 
     fs_file_t_init(&m_file);
 
     rc = fs_open(&m_file, in_file_name, FS_O_READ);
-
     if (rc != 0)
     {
         LOG_ERR("Error opening file %d", rc);
-        return;
+        transfer_send_end(FILE_TRANSFER_STATUS_OPEN_ERR, offset, 0, file_len, 0, 0, 0);
+        return rc;
     }
 
-    for (i = 0; i < number_writes; i++)
+    if (offset > 0)
     {
-        rc = fs_read(&m_file, m_buffer, FILE_TRANSFER_BLE_PACKET_SIZE);
-        if (rc < 0)
+        rc = fs_seek(&m_file, offset, FS_SEEK_SET);
+        if (rc != 0)
         {
-            LOG_ERR("Error reading file %d", rc);
-            return;
+            LOG_ERR("Error seeking file %d", rc);
+            fs_close(&m_file);
+            transfer_send_end(FILE_TRANSFER_STATUS_RANGE_ERR, offset, 0, file_len, 0, 0, 0);
+            return rc;
         }
-
-        cmdif_send_ble_data(m_buffer, rc); // FILE_TRANSFER_BLE_PACKET_SIZE);
-        k_sleep(K_MSEC(50));
     }
 
-    rc = fs_close(&m_file);
-    if (rc != 0)
+    // One type byte, the rest of the notification carries file data
+    uint16_t chunk = MIN(hpi_ble_get_max_payload(), sizeof(file_tx_pkt)) - 1;
+
+    LOG_DBG("Send file: %s Size:%d Range: %u+%u Chunk: %d", in_file_name, file_len, offset, length, chunk);
+
+    int64_t start_ms = k_uptime_get();
+    uint8_t status = FILE_TRANSFER_STATUS_OK;
+
+    file_tx_pkt[0] = CES_CMDIF_TYPE_DATA;
+    while (sent < length)
     {
-        LOG_ERR("Error closing file %d", rc);
-        return;
+        rc = fs_read(&m_file, &file_tx_pkt[1], MIN(chunk, length - sent));
+        if (rc <= 0)
+        {
+            LOG_ERR("Error reading file %d", rc);
+            status = FILE_TRANSFER_STATUS_ABORTED;
+            break;
+        }
+
+        uint16_t n = (uint16_t)rc;
+        rc = hpi_ble_send_data_windowed(file_tx_pkt, n + 1, &tx_busy);
+        if (rc != 0)
+        {
+            LOG_ERR("File transfer aborted at %u: %d", offset + sent, rc);
+            status = FILE_TRANSFER_STATUS_ABORTED;
+            break;
+        }
+
+        crc = crc32_ieee_update(crc, &file_tx_pkt[1], n);
+        sent += n;
+        packets++;
     }
 
-    LOG_INF("File sent!!");
+    fs_close(&m_file);
+
+    uint32_t duration_ms = (uint32_t)(k_uptime_get() - start_ms);
+    uint32_t rate = (duration_ms > 0) ? (uint32_t)(((uint64_t)sent * 1000U) / duration_ms) : sent;
+
+    LOG_INF("File sent: %u/%u bytes, %u pkts in %u ms (%u B/s), busy %u, crc %08x",
+            sent, length, packets, duration_ms, rate, tx_busy, crc);
+
+    // Lets the app resume from offset + sent if the transfer was cut short
+    transfer_send_end(status, offset, sent, file_len, crc, duration_ms, tx_busy);
+
+    return (status == FILE_TRANSFER_STATUS_OK) ? 0 : -EIO;
+}
+
+void transfer_send_file(char *in_file_name)
+{
+    LOG_DBG("Start file transfer %s", in_file_name);
+    transfer_send_file_range(in_file_name, 0, 0);
 }
 
 void hpi_init_fs_struct(void)
@@ -294,6 +384,16 @@ void hpi_init_fs_struct(void)
         LOG_DBG("Created dir");
     }
 
+    ret = fs_mkdir("/lfs/trgsr");
+    if (ret)
+    {
+        LOG_ERR("Unable to create dir (err %d)", ret);
+    }
+    else
+    {
+        LOG_DBG("Created dir");
+    }
+
     ret = fs_mkdir("/lfs/ecg");
     if (ret)
     {
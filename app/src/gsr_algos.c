@@ -1,11 +1,15 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/device.h>
+#include <zephyr/devicetree.h>
 #include <zephyr/drivers/sensor.h>
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
+#include <arm_math.h>
 #include "gsr_algos.h"
 #include "hpi_common_types.h"
+#include "max30001_bioz.h"
 
 LOG_MODULE_REGISTER(gsr_algos, LOG_LEVEL_DBG);
 
@@ -13,71 +17,198 @@ LOG_MODULE_REGISTER(gsr_algos, LOG_LEVEL_DBG);
 #define GSR_MAX_SAMPLES  2048    // Maximum expected GSR samples
 
 // Static buffers
-static float gsr_uS[GSR_MAX_SAMPLES];
-static float temp_buf[GSR_MAX_SAMPLES];
-
-#define BIOZ_VREF           1.0f        /* MAX30001 internal reference voltage (V) */
-#define BIOZ_ADC_FULLSCALE  524288.0f   /* 2^19 for 20-bit signed ADC */
-#define BIOZ_MIN_IMPEDANCE  0.1f        /* Minimum valid impedance (Ω) to avoid div-by-zero */
-#define BIOZ_GAIN       20.0f       // bioz-gain=1 → 20 V/V
-#define BIOZ_I_MAG      16e-6f      // bioz_cgmag=2 → 16 µA excitation current
+static q31_t gsr_q[GSR_MAX_SAMPLES];
+static struct gsr_window_filter batch_filter;   // Batch filters are not reentrant
+
+#if DT_NODE_EXISTS(DT_ALIAS(max30001))
+#define GSR_BIOZ_GAIN_REG   DT_PROP(DT_ALIAS(max30001), bioz_gain)
+#define GSR_BIOZ_CGMAG_REG  DT_PROP(DT_ALIAS(max30001), bioz_cgmag)
+#else
+#define GSR_BIOZ_GAIN_REG   1   // 20 V/V
+#define GSR_BIOZ_CGMAG_REG  2   // 16 µA
+#endif
+
+#define GSR_CONVERT_CHUNK   32  // Samples converted per call by the streaming paths
+
 /*
- * Convert driver-provided BioZ data to µS (microsiemens)
- *
- * The MAX30001 driver now performs the ADC-to-conductance conversion internally
- * using the datasheet formula and outputs values as fixed-point (µS × 100).
- * This function simply converts from fixed-point to float.
- *
- * Driver conversion formula (in max30001.h):
- *   Z (Ω) = ADC × VREF / (2^19 × CGMAG × GAIN)
- *   Conductance (µS) = 1/Z × 10^6
+ * G = K / |ADC| (see max30001_bioz.h) in the units of k. VDIV.F32 is 14
+ * cycles on the M33 FPU, less than a 32-bit Newton-Raphson reciprocal with
+ * its 64-bit multiplies, so the conversion stays in float.
  */
+static inline float gsr_conductance(int32_t raw, float k, float min_mag)
+{
+    float mag = fabsf((float)raw);
+
+    /* Impedance below BIOZ_MIN_IMPEDANCE (or no current) reads as no contact */
+    return (k <= 0.0f || mag < min_mag) ? 0.0f : k / mag;
+}
+
+void gsr_raw_to_q(const int32_t *raw_data, int32_t *gsr_q_data, int length)
+{
+    const float k = max30001_bioz_uS_numerator(GSR_BIOZ_GAIN_REG, GSR_BIOZ_CGMAG_REG);
+    const float k_q = k * GSR_Q_ONE_US;
+    const float min_mag = BIOZ_MIN_IMPEDANCE * 1e-6f * k;
+
+    for (int i = 0; i < length; i++) {
+        float g = gsr_conductance(raw_data[i], k_q, min_mag);
+
+        gsr_q_data[i] = (g >= 2147483648.0f) ? INT32_MAX : (int32_t)(g + 0.5f);
+    }
+}
+
 void convert_raw_to_uS(const int32_t *raw_data, float *gsr_data, int length)
 {
-    for (int i = 0; i < length; i++)
-    {
-        // /* Driver outputs conductance as fixed-point: µS × 1000000 (to preserve precision)
-        //  * Divide by 1000000 to get actual µS value */
-        // gsr_data[i] = (float)raw_data[i] / 100.0f;
-         // Step 1: Calculate electrode voltage from ADC counts
-        float v_electrode = ((float)raw_data[i] / BIOZ_ADC_FULLSCALE) * (BIOZ_VREF / BIOZ_GAIN);
-
-        // Step 2: Calculate impedance (Z = V / I), use absolute value
-        float impedance = fabsf(v_electrode / BIOZ_I_MAG);
-
-            /* Take absolute value (impedance is magnitude) */
-        if (impedance < 0.0f) {
-            impedance = -impedance;
-        }
+    const float k = max30001_bioz_uS_numerator(GSR_BIOZ_GAIN_REG, GSR_BIOZ_CGMAG_REG);
+    const float min_mag = BIOZ_MIN_IMPEDANCE * 1e-6f * k;
+
+    for (int i = 0; i < length; i++) {
+        gsr_data[i] = gsr_conductance(raw_data[i], k, min_mag);
+    }
+}
 
-        /* Guard against divide-by-zero for very low impedance */
-        if (impedance < BIOZ_MIN_IMPEDANCE) {
-            gsr_data[i] = 0.0f;
+float gsr_raw_sample_to_uS(int32_t raw)
+{
+    float uS;
+
+    convert_raw_to_uS(&raw, &uS, 1);
+    return uS;
+}
+
+void gsr_window_filter_init(struct gsr_window_filter *f, int window)
+{
+    if (window > GSR_FILTER_MAX_WINDOW) {
+        window = GSR_FILTER_MAX_WINDOW;
+    }
+    if (window < 1) {
+        window = 1;
+    }
+
+    f->sum = 0;
+    f->n_in = 0;
+    f->n_out = 0;
+    f->half = window / 2;
+    f->len = 2 * f->half + 1;
+    f->recip = 0x80000000u / f->len;
+    f->in_pos = 0;
+    f->out_pos = 0;
+    f->drop_pos = 0;
+}
+
+static inline uint16_t gsr_ring_next(const struct gsr_window_filter *f, uint16_t pos)
+{
+    return (pos + 1 == f->len) ? 0 : pos + 1;
+}
+
+/*
+ * round(sum * recip / 2^31) without a 64x64 multiply: |sum| < 2^39, so it is
+ * split at bit 31. recip is floor(2^31 / count), the mean never exceeds the
+ * largest input.
+ */
+static inline int32_t gsr_window_mean(int64_t sum, uint32_t recip)
+{
+    int64_t hi = sum >> 31;
+    uint64_t lo = (uint64_t)(sum & 0x7FFFFFFF);
+
+    return (int32_t)(hi * recip + (int64_t)((lo * recip + (1u << 30)) >> 31));
+}
+
+static void gsr_window_filter_emit(struct gsr_window_filter *f, int32_t *center, int32_t *mean)
+{
+    uint32_t i = f->n_out;
+    uint32_t lo = (i > f->half) ? i - f->half : 0;
+    uint32_t hi = MIN(i + f->half, f->n_in - 1);
+    uint32_t count = hi - lo + 1;
+
+    // Only the first and last half-windows are truncated
+    *mean = gsr_window_mean(f->sum, (count == f->len) ? f->recip : 0x80000000u / count);
+    *center = f->ring[f->out_pos];
+    f->out_pos = gsr_ring_next(f, f->out_pos);
+
+    // Drop the sample that leaves the window of the next output
+    if (i >= f->half) {
+        f->sum -= f->ring[f->drop_pos];
+        f->drop_pos = gsr_ring_next(f, f->drop_pos);
+    }
+    f->n_out++;
+}
+
+bool gsr_window_filter_push(struct gsr_window_filter *f, int32_t x, int32_t *center, int32_t *mean)
+{
+    f->ring[f->in_pos] = x;
+    f->in_pos = gsr_ring_next(f, f->in_pos);
+    f->sum += x;
+    f->n_in++;
+
+    if (f->n_in - f->n_out > f->half) {
+        gsr_window_filter_emit(f, center, mean);
+        return true;
+    }
+    return false;
+}
+
+bool gsr_window_filter_flush(struct gsr_window_filter *f, int32_t *center, int32_t *mean)
+{
+    if (f->n_out >= f->n_in) {
+        return false;
+    }
+    gsr_window_filter_emit(f, center, mean);
+    return true;
+}
+
+/*
+ * GSR_SMOOTH_WINDOW taps, summed directly. With the tap count fixed at
+ * compile time this is about 3x cheaper than the ring filter below (~6k vs
+ * ~18k host cycles for 960 samples; the float 5-tap loop it replaced took
+ * ~9k). In place: the window of originals is kept in a shift register.
+ */
+static void smooth_gsr_direct(int32_t *data, int length)
+{
+    enum { half = GSR_SMOOTH_WINDOW / 2, len = 2 * half + 1 };
+    int32_t w[len];     // Originals of data[i - half .. i + half], 0 outside the signal
+    const uint32_t recip = 0x80000000u / len;
+
+    for (int k = 0; k < len; k++) {
+        int j = k - half;
+        w[k] = (j >= 0 && j < length) ? data[j] : 0;
+    }
+
+    for (int i = 0; i < length; i++) {
+        int64_t sum = 0;
+        for (int k = 0; k < len; k++) {
+            sum += w[k];
         }
-        else {
-        /* Convert to conductance in microsiemens: G (µS) = 1/Z × 10^6 */
-          gsr_data[i] = (1.0f / impedance) * 1e6f;
+
+        int count = MIN(i + half, length - 1) - MAX(i - half, 0) + 1;
+        data[i] = gsr_window_mean(sum, (count == len) ? recip : 0x80000000u / count);
+
+        // data[i + half + 1] is still the original
+        for (int k = 0; k < len - 1; k++) {
+            w[k] = w[k + 1];
         }
+        w[len - 1] = (i + half + 1 < length) ? data[i + half + 1] : 0;
     }
 }
 
-// Simple moving average for smoothing
-void smooth_gsr(float *data, int length, int window)
+// Centered moving average for smoothing
+void smooth_gsr(int32_t *data, int length, int window)
 {
+    int32_t center, mean;
+
+    if (window / 2 == GSR_SMOOTH_WINDOW / 2) {
+        smooth_gsr_direct(data, length);
+        return;
+    }
+
+    // Outputs trail the inputs by window/2 and the ring holds the originals, so in place is safe
+    gsr_window_filter_init(&batch_filter, window);
     for (int i = 0; i < length; i++) {
-        float sum = 0;
-        int count = 0;
-        for (int j = i - window/2; j <= i + window/2; j++) {
-            if (j >= 0 && j < length) {
-                sum += data[j];
-                count++;
-            }
+        if (gsr_window_filter_push(&batch_filter, data[i], &center, &mean)) {
+            data[batch_filter.n_out - 1] = mean;
         }
-        temp_buf[i] = sum / count;
     }
-    // Copy back
-    for (int i = 0; i < length; i++)
-        data[i] = temp_buf[i];
+    while (gsr_window_filter_flush(&batch_filter, &center, &mean)) {
+        data[batch_filter.n_out - 1] = mean;
+    }
 }
 
 // static float calculate_adaptive_threshold(float *data, int length)
@@ -106,47 +237,61 @@ void smooth_gsr(float *data, int length, int window)
 //     return thr;
 // }
 
-static float calculate_adaptive_threshold(float *data, int length)
+static float scr_threshold_from_noise(float noise)
+{
+    /* 3×noise = 99.7th percentile threshold */
+    float threshold = 3.0f * noise;
+
+    /* Physiological bounds for phasic SCR detection */
+    if (threshold < 0.02f) threshold = 0.02f;  // BIOPAC minimum
+
+    return threshold;
+}
+
+static float calculate_adaptive_threshold(const int32_t *data, int length)
 {
     if (data == NULL || length < 10) {
         return 0.03f;   // Safe physiological default
     }
 
     /* Calculate NOISE FLOOR using first derivative */
-    float noise = 0.0f;
+    int64_t noise = 0;
     for (int i = 1; i < length; i++) {
-        noise += fabsf(data[i] - data[i - 1]);
+        noise += llabs((int64_t)data[i] - data[i - 1]);
     }
-    noise /= (float)(length - 1);
-
-    /* 3×noise = 99.7th percentile threshold */
-    float threshold = 3.0f * noise;
-
-    /* Physiological bounds for phasic SCR detection */
-    if (threshold < 0.02f) threshold = 0.02f;  // BIOPAC minimum
 
-   // if (threshold > 0.05f) threshold = 0.05f;  // Conservative max
+    return scr_threshold_from_noise(GSR_Q_TO_US(noise) / (float)(length - 1));
+}
 
-    return threshold;
+// Flush centers - means of a completed chunk of outputs ending at index end
+static void remove_baseline_chunk(int32_t *data, uint32_t end, const q31_t *center,
+                                  const q31_t *mean, int n)
+{
+    arm_sub_q31(center, mean, &data[end - n], n);
 }
 
-// Simple baseline removal
-void remove_baseline(float *data, int length, int window)
+// Baseline removal: subtract the centered moving average
+void remove_baseline(int32_t *data, int length, int window)
 {
+    q31_t center[GSR_CONVERT_CHUNK], mean[GSR_CONVERT_CHUNK];
+    int n = 0;
+
+    // Outputs are contiguous and trail the inputs by window/2, so they are written a chunk at a time
+    gsr_window_filter_init(&batch_filter, window);
     for (int i = 0; i < length; i++) {
-        float sum = 0;
-        int count = 0;
-        for (int j = i - window/2; j <= i + window/2; j++) {
-            if (j >= 0 && j < length) {
-                sum += data[j];
-                count++;
-            }
+        if (gsr_window_filter_push(&batch_filter, data[i], &center[n], &mean[n]) &&
+            ++n == GSR_CONVERT_CHUNK) {
+            remove_baseline_chunk(data, batch_filter.n_out, center, mean, n);
+            n = 0;
+        }
+    }
+    while (gsr_window_filter_flush(&batch_filter, &center[n], &mean[n])) {
+        if (++n == GSR_CONVERT_CHUNK) {
+            remove_baseline_chunk(data, batch_filter.n_out, center, mean, n);
+            n = 0;
         }
-        temp_buf[i] = sum / count;
     }
-    // Subtract baseline
-    for (int i = 0; i < length; i++)
-        data[i] -= temp_buf[i];
+    remove_baseline_chunk(data, batch_filter.n_out, center, mean, n);
 }
 /*
 // Calculate SCR count from conductance data
@@ -161,7 +306,7 @@ int calculate_scr_count(int32_t *gsr_data, int length)
         return 0;
     }
 
-    // 1. Convert fixed-point conductance to float µS
+    // 1. Convert raw ADC codes to float µS
     convert_raw_to_uS(gsr_data, gsr_uS, length);
 
     // 2. Smooth the signal
@@ -200,12 +345,18 @@ int calculate_scr_count(int32_t *gsr_data, int length)
     return scr_count;
 }
 */
+static void gsr_stress_score(const int32_t *phasic, int sample_count, float tonic_level,
+                             int duration_sec, struct hpi_gsr_stress_index_t *result);
+static void gsr_stress_level(float tonic_level, int scr_count, float peak_amplitude_sum,
+                             float max_peak_amplitude, int duration_sec,
+                             struct hpi_gsr_stress_index_t *result);
+
 /**
  * @brief Calculate GSR stress index from sample buffer
  *
  * Algorithm:
- * 1. Convert fixed-point conductance to float µS
- * 2. Calculate tonic level (SCL) as mean of smoothed signal
+ * 1. Convert raw ADC codes to Q11.20 µS
+ * 2. Calculate tonic level (SCL) as mean of the conductance
  * 3. Extract phasic component and detect SCR peaks
  * 4. Calculate stress level based on tonic level, SCR rate, and peak amplitude
  */
@@ -226,28 +377,36 @@ void calculate_gsr_stress_index(const int32_t *gsr_data, int sample_count,
         return;
     }
 
-    // Step 1: Convert fixed-point conductance to float µS
-    convert_raw_to_uS(gsr_data, gsr_uS, sample_count);
+    // Step 1: Convert raw ADC codes to Q11.20 µS
+    gsr_raw_to_q(gsr_data, gsr_q, sample_count);
 
     // Step 2: Calculate tonic level (SCL) - mean conductance before baseline removal
-    float tonic_sum = 0.0f;
-    for (int i = 0; i < sample_count; i++) {
-        tonic_sum += gsr_uS[i];
-    }
-    float tonic_level = tonic_sum / sample_count;
+    q31_t tonic_q;
+    arm_mean_q31(gsr_q, sample_count, &tonic_q);
+    float tonic_level = GSR_Q_TO_US(tonic_q);
     LOG_DBG("GSR baseline (tonic SCL) = %.3f uS", (double)tonic_level);
     
     // Store tonic level (x100 for integer storage)
     result->tonic_level_x100 = (uint16_t)(tonic_level * 100.0f);
 
     // Step 3: Smooth the signal for peak detection
-    smooth_gsr(gsr_uS, sample_count, 5);
+    smooth_gsr(gsr_q, sample_count, GSR_SMOOTH_WINDOW);
 
     // Step 4: Remove baseline to get phasic component
-    remove_baseline(gsr_uS, sample_count, 128);
+    remove_baseline(gsr_q, sample_count, GSR_BASELINE_WINDOW);
+
+    gsr_stress_score(gsr_q, sample_count, tonic_level, duration_sec, result);
+}
 
+/*
+ * Steps 5-6 of the stress index on the phasic signal: adaptive threshold,
+ * SCR detection and the composite score.
+ */
+static void gsr_stress_score(const int32_t *phasic, int sample_count, float tonic_level,
+                             int duration_sec, struct hpi_gsr_stress_index_t *result)
+{
     // Calculate adaptive threshold for SCR detection
-    float scr_threshold = calculate_adaptive_threshold(gsr_uS, sample_count);
+    float scr_threshold = calculate_adaptive_threshold(phasic, sample_count);
     LOG_DBG("GSR Threshold = %.3f uS", (double)scr_threshold);
 
     // Step 5: Detect SCR peaks and calculate metrics
@@ -258,25 +417,25 @@ void calculate_gsr_stress_index(const int32_t *gsr_data, int sample_count,
 
     for (int i = 1; i < sample_count - 1; i++) {
         // Find local minimum (trough)
-        if (gsr_uS[i] < gsr_uS[i - 1] && gsr_uS[i] < gsr_uS[i + 1]) {
+        if (phasic[i] < phasic[i - 1] && phasic[i] < phasic[i + 1]) {
             int trough = i;
             int peak_index = -1;
-            float peak_value = gsr_uS[trough];
+            int32_t peak_value = phasic[trough];
 
             for (int j = trough + 1; j < sample_count - 1; j++) {
 
                 /* stop when signal falls below trough again */
-                if (gsr_uS[j] < gsr_uS[trough])
+                if (phasic[j] < phasic[trough])
                     break;
 
-                if (gsr_uS[j] > peak_value) {
-                    peak_value = gsr_uS[j];
+                if (phasic[j] > peak_value) {
+                    peak_value = phasic[j];
                     peak_index = j;
                 }
             }
 
             if (peak_index >= 0) {
-                float amplitude = gsr_uS[peak_index] - gsr_uS[trough];
+                float amplitude = GSR_Q_TO_US((int64_t)phasic[peak_index] - phasic[trough]);
 
                 if (amplitude >= scr_threshold &&
                     (peak_index - last_peak_index) >= SCR_MIN_INTERVAL) {
@@ -299,6 +458,19 @@ void calculate_gsr_stress_index(const int32_t *gsr_data, int sample_count,
         }
     }
 
+    gsr_stress_level(tonic_level, scr_count, peak_amplitude_sum, max_peak_amplitude,
+                     duration_sec, result);
+
+    LOG_INF("GSR Stress Index: level=%u, tonic=%.2f uS, SCR=%u/30s, mean_amp=%.3f uS",
+            result->stress_level, (double)tonic_level, result->peaks_per_minute,
+            scr_count > 0 ? (double)(peak_amplitude_sum / scr_count) : 0.0);
+}
+
+/* Metrics and composite score, shared by the session and continuous indexes */
+static void gsr_stress_level(float tonic_level, int scr_count, float peak_amplitude_sum,
+                             float max_peak_amplitude, int duration_sec,
+                             struct hpi_gsr_stress_index_t *result)
+{
     // Calculate peaks per minute
     result->peaks_per_minute = (uint8_t)scr_count;//per 30s 
 
@@ -357,8 +529,245 @@ void calculate_gsr_stress_index(const int32_t *gsr_data, int sample_count,
     // Mark data as ready
     result->stress_data_ready = true;
     result->last_peak_timestamp = k_uptime_get();
+}
 
-    LOG_INF("GSR Stress Index: level=%u, tonic=%.2f uS, SCR=%u/30s, mean_amp=%.3f uS",
-            result->stress_level, (double)tonic_level, result->peaks_per_minute,
-            scr_count > 0 ? (double)(peak_amplitude_sum / scr_count) : 0.0);
+void gsr_stress_stream_reset(struct gsr_stress_stream *s)
+{
+    gsr_window_filter_init(&s->smooth, GSR_SMOOTH_WINDOW);
+    gsr_window_filter_init(&s->baseline, GSR_BASELINE_WINDOW);
+    s->tonic_sum = 0;
+    s->count = 0;
+    s->phasic_count = 0;
+}
+
+static void gsr_stress_stream_baseline(struct gsr_stress_stream *s, int32_t smoothed)
+{
+    int32_t center, mean;
+
+    if (gsr_window_filter_push(&s->baseline, smoothed, &center, &mean) &&
+        s->phasic_count < GSR_STREAM_MAX_SAMPLES) {
+        s->phasic[s->phasic_count++] = center - mean;
+    }
+}
+
+void gsr_stress_stream_add(struct gsr_stress_stream *s, const int32_t *raw_gsr_data, int sample_count)
+{
+    q31_t uS[GSR_CONVERT_CHUNK];
+
+    sample_count = MIN(sample_count, (int)(GSR_STREAM_MAX_SAMPLES - s->count));
+
+    for (int i = 0; i < sample_count; i += GSR_CONVERT_CHUNK) {
+        int n = MIN(sample_count - i, GSR_CONVERT_CHUNK);
+
+        gsr_raw_to_q(&raw_gsr_data[i], uS, n);
+
+        for (int j = 0; j < n; j++) {
+            int32_t center, smoothed;
+
+            s->tonic_sum += uS[j];
+            s->count++;
+
+            if (gsr_window_filter_push(&s->smooth, uS[j], &center, &smoothed)) {
+                gsr_stress_stream_baseline(s, smoothed);
+            }
+        }
+    }
+}
+
+void gsr_stress_stream_finish(struct gsr_stress_stream *s, int duration_sec,
+                              struct hpi_gsr_stress_index_t *result)
+{
+    int32_t center, value;
+
+    if (result == NULL) {
+        return;
+    }
+    memset(result, 0, sizeof(struct hpi_gsr_stress_index_t));
+
+    if (s->count == 0 || duration_sec <= 0) {
+        LOG_ERR("Invalid stress index input: count=%u, duration=%d", s->count, duration_sec);
+        return;
+    }
+
+    // Drain the tails of both filters (windows truncated at the end of the signal)
+    while (gsr_window_filter_flush(&s->smooth, &center, &value)) {
+        gsr_stress_stream_baseline(s, value);
+    }
+    while (gsr_window_filter_flush(&s->baseline, &center, &value)) {
+        if (s->phasic_count < GSR_STREAM_MAX_SAMPLES) {
+            s->phasic[s->phasic_count++] = center - value;
+        }
+    }
+
+    // Truncated like arm_mean_q31() in the batch index
+    float tonic_level = GSR_Q_TO_US((int32_t)(s->tonic_sum / s->count));
+    LOG_DBG("GSR baseline (tonic SCL) = %.3f uS", (double)tonic_level);
+    result->tonic_level_x100 = (uint16_t)(tonic_level * 100.0f);
+
+    gsr_stress_score(s->phasic, s->phasic_count, tonic_level, duration_sec, result);
+}
+
+void gsr_stress_monitor_init(struct gsr_stress_monitor *m, int epoch_sec, int window_sec)
+{
+    if (epoch_sec < 1) {
+        epoch_sec = 1;
+    }
+
+    int window_epochs = window_sec / epoch_sec;
+    if (window_epochs < 1) {
+        window_epochs = 1;
+    }
+    if (window_epochs > GSR_MONITOR_MAX_EPOCHS) {
+        window_epochs = GSR_MONITOR_MAX_EPOCHS;
+    }
+
+    memset(m, 0, sizeof(*m));
+    gsr_window_filter_init(&m->smooth, GSR_SMOOTH_WINDOW);
+    gsr_window_filter_init(&m->baseline, GSR_BASELINE_WINDOW);
+    m->epoch_samples = epoch_sec * GSR_SAMPLE_RATE_HZ;
+    m->window_epochs = window_epochs;
+}
+
+/* Threshold from the noise floor of the window, including the epoch in progress */
+static float gsr_monitor_threshold(const struct gsr_stress_monitor *m)
+{
+    int64_t noise = 0;
+    uint32_t count = 0;
+
+    for (int i = 0; i < m->window_epochs; i++) {
+        noise += m->epochs[i].noise_sum;
+        count += m->epochs[i].count;
+    }
+
+    if (count < 10) {
+        return 0.03f;   // Safe physiological default, as for short buffers
+    }
+    return scr_threshold_from_noise(GSR_Q_TO_US(noise) / count);
+}
+
+static void gsr_monitor_close_response(struct gsr_stress_monitor *m)
+{
+    struct gsr_monitor_epoch *e = &m->epochs[m->head];
+
+    m->rising = false;
+
+    float amplitude = GSR_Q_TO_US((int64_t)m->peak - m->trough);
+
+    if (amplitude >= gsr_monitor_threshold(m) &&
+        (m->last_peak_n == 0 || m->peak_n - m->last_peak_n >= SCR_MIN_INTERVAL)) {
+        e->scr_count++;
+        e->amp_sum += amplitude;
+        if (amplitude > e->amp_max) {
+            e->amp_max = amplitude;
+        }
+        m->last_peak_n = m->peak_n;
+    }
+}
+
+static void gsr_monitor_detect(struct gsr_stress_monitor *m, int32_t x)
+{
+    if (m->rising) {
+        if (x < m->trough || m->n - m->trough_n > GSR_MONITOR_MAX_RISE) {
+            gsr_monitor_close_response(m);
+        } else if (x > m->peak) {
+            m->peak = x;
+            m->peak_n = m->n;
+        }
+    }
+
+    // prev[0] is a local minimum: open a response there
+    if (!m->rising && m->n >= 2 && m->prev[0] < m->prev[1] && m->prev[0] < x) {
+        m->rising = true;
+        m->trough = m->prev[0];
+        m->trough_n = m->n - 1;
+        m->peak = x;
+        m->peak_n = m->n;
+    }
+
+    m->prev[1] = m->prev[0];
+    m->prev[0] = x;
+    m->n++;
+}
+
+/* Aggregate the window into result once the ring is full */
+static bool gsr_monitor_close_epoch(struct gsr_stress_monitor *m, struct hpi_gsr_stress_index_t *result)
+{
+    if (m->filled < m->window_epochs) {
+        m->filled++;
+    }
+
+    bool ready = (m->filled == m->window_epochs);
+
+    if (ready) {
+        int64_t tonic_sum = 0;
+        float amp_sum = 0.0f, amp_max = 0.0f;
+        uint32_t count = 0;
+        int scr_count = 0;
+
+        for (int i = 0; i < m->window_epochs; i++) {
+            const struct gsr_monitor_epoch *e = &m->epochs[i];
+
+            tonic_sum += e->tonic_sum;
+            count += e->count;
+            scr_count += e->scr_count;
+            amp_sum += e->amp_sum;
+            if (e->amp_max > amp_max) {
+                amp_max = e->amp_max;
+            }
+        }
+
+        int duration_sec = count / GSR_SAMPLE_RATE_HZ;
+        float tonic_level = GSR_Q_TO_US(tonic_sum) / count;
+
+        memset(result, 0, sizeof(struct hpi_gsr_stress_index_t));
+        result->tonic_level_x100 = (uint16_t)(tonic_level * 100.0f);
+        gsr_stress_level(tonic_level, scr_count, amp_sum, amp_max, duration_sec, result);
+        result->peaks_per_minute = (uint8_t)((scr_count * 60 + duration_sec / 2) / duration_sec);
+
+        LOG_DBG("GSR continuous: level=%u, tonic=%.2f uS, SCR=%d/%ds",
+                result->stress_level, (double)tonic_level, scr_count, duration_sec);
+    }
+
+    m->head = (m->head + 1) % m->window_epochs;
+    memset(&m->epochs[m->head], 0, sizeof(m->epochs[m->head]));
+
+    return ready;
+}
+
+bool gsr_stress_monitor_add(struct gsr_stress_monitor *m, const int32_t *raw_gsr_data,
+                            int sample_count, struct hpi_gsr_stress_index_t *result)
+{
+    q31_t uS[GSR_CONVERT_CHUNK];
+    bool ready = false;
+
+    for (int i = 0; i < sample_count; i++) {
+        int32_t center, smoothed, tonic;
+
+        if (i % GSR_CONVERT_CHUNK == 0) {
+            gsr_raw_to_q(&raw_gsr_data[i], uS, MIN(sample_count - i, GSR_CONVERT_CHUNK));
+        }
+
+        if (!gsr_window_filter_push(&m->smooth, uS[i % GSR_CONVERT_CHUNK], &center, &smoothed) ||
+            !gsr_window_filter_push(&m->baseline, smoothed, &center, &tonic)) {
+            continue;
+        }
+
+        struct gsr_monitor_epoch *e = &m->epochs[m->head];
+        // Both are non-negative Q11.20, the difference fits
+        int32_t phasic = center - tonic;
+
+        if (m->n > 0) {
+            e->noise_sum += llabs((int64_t)phasic - m->prev[0]);
+        }
+        e->tonic_sum += tonic;
+        e->count++;
+
+        gsr_monitor_detect(m, phasic);
+
+        if (e->count >= m->epoch_samples && gsr_monitor_close_epoch(m, result)) {
+            ready = true;
+        }
+    }
+
+    return ready;
 }
@@ -4,6 +4,15 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/*
+ * Conductance inside the GSR pipeline is fixed point, Q11.20 µS in an int32_t
+ * (q31_t): 1 µS = 2^20, range 0 to 2048 µS, resolution ~1e-6 µS. Values above
+ * the range (near-short impedances) saturate to INT32_MAX.
+ */
+#define GSR_Q_FRAC_BITS     20
+#define GSR_Q_ONE_US        (1 << GSR_Q_FRAC_BITS)
+#define GSR_Q_TO_US(q)      ((float)(q) * (1.0f / GSR_Q_ONE_US))
+
 // Forward declaration for stress index structure
 struct hpi_gsr_stress_index_t;
 
@@ -13,7 +22,7 @@ struct hpi_gsr_stress_index_t;
  * Processes BioZ samples to detect SCR peaks indicating arousal/stress responses.
  * Uses signal smoothing, baseline removal, and peak detection algorithm.
  *
- * @param gsr_buffer Pointer to conductance samples (µS × 100 fixed-point from driver)
+ * @param gsr_buffer Pointer to raw BioZ ADC codes from the driver
  * @param sample_count Number of samples in buffer (max 1024)
  * @return Number of SCR events detected, or 0 on error
  */
@@ -28,7 +37,7 @@ int calculate_scr_count(int32_t *gsr_buffer, int sample_count);
  * - Peak Amplitude: Mean amplitude of detected SCR peaks
  * - Stress Level: Composite score 0-100
  *
- * @param raw_gsr_data Pointer to conductance samples (µS × 100 fixed-point from driver)
+ * @param raw_gsr_data Pointer to raw BioZ ADC codes from the driver
  * @param sample_count Number of samples in buffer (typically 960 for 30s @ 32Hz)
  * @param duration_sec Duration of measurement in seconds
  * @param result Output structure for stress metrics
@@ -37,18 +46,158 @@ void calculate_gsr_stress_index(const int32_t *raw_gsr_data, int sample_count,
                                  int duration_sec, struct hpi_gsr_stress_index_t *result);
 
 /**
- * @brief Convert fixed-point conductance to float µS values
+ * @brief Convert raw BioZ ADC codes to Q11.20 conductance
  *
- * The MAX30001 driver outputs conductance as fixed-point (µS × 100).
- * This function converts to actual float µS values.
+ * The single conversion used by the algorithms and the display (units in
+ * max30001_bioz.h, gain and current from the max30001 devicetree node).
+ * One float divide per sample, rounded to Q11.20 and saturated at
+ * INT32_MAX. Within 1 LSB plus 1e-6 relative of convert_raw_to_uS().
  *
- * @param raw_data Input array of fixed-point conductance values
- * @param gsr_data Output array of float conductance in µS
+ * @param raw_data Input array of raw ADC codes
+ * @param gsr_q_data Output array of Q11.20 µS, 0 for no contact; may alias raw_data
  * @param length Number of samples to convert
  */
+void gsr_raw_to_q(const int32_t *raw_data, int32_t *gsr_q_data, int length);
+
+/* The same conversion in float µS, for the display and tools */
 void convert_raw_to_uS(const int32_t *raw_data, float *gsr_data, int length);
 
-void smooth_gsr(float *data, int length, int window);
-void remove_baseline(float *data, int length, int window);
+/* Single-sample convert_raw_to_uS() */
+float gsr_raw_sample_to_uS(int32_t raw);
+
+#define GSR_SAMPLE_RATE_HZ      32
+#define GSR_SMOOTH_WINDOW       5       // Moving average for peak detection
+#define GSR_BASELINE_WINDOW     128     // 4 s at 32 Hz, tonic estimate removed from the phasic signal
+#define GSR_FILTER_MAX_WINDOW   128
+#define GSR_STREAM_MAX_SAMPLES  1024
+
+/**
+ * @brief Centered moving average over [i - window/2, i + window/2]
+ *
+ * The window is truncated at both ends of the signal. Runs in O(1) per sample
+ * from an exact 64-bit running sum of Q11.20 samples, divided by a Q31
+ * reciprocal of the window length; samples are held in a ring until their
+ * window closes, so output i is available once input i + window/2 has been
+ * pushed (or on flush at the end of the signal).
+ */
+struct gsr_window_filter
+{
+    int32_t ring[GSR_FILTER_MAX_WINDOW + 1];
+    int64_t sum;        // Sum over the current window
+    uint32_t recip;     // floor(2^31 / len)
+    uint32_t n_in;
+    uint32_t n_out;
+    uint16_t half;
+    uint16_t len;       // Ring slots in use, 2 * half + 1
+    uint16_t in_pos;    // Ring slot for the next input
+    uint16_t out_pos;   // Ring slot of the next output position
+    uint16_t drop_pos;  // Ring slot of the next sample to leave the window
+};
+
+/**
+ * @brief Reset a moving average filter
+ * @param window Window length, clamped to GSR_FILTER_MAX_WINDOW
+ */
+void gsr_window_filter_init(struct gsr_window_filter *f, int window);
+
+/**
+ * @brief Push one sample
+ * @param center Set to the input sample at the output position
+ * @param mean Set to the window mean at the output position
+ * @return true if an output (index f->n_out - 1) was produced
+ */
+bool gsr_window_filter_push(struct gsr_window_filter *f, int32_t x, int32_t *center, int32_t *mean);
+
+/**
+ * @brief Produce the next remaining output at the end of the signal
+ * @return true if an output was produced; call until it returns false
+ */
+bool gsr_window_filter_flush(struct gsr_window_filter *f, int32_t *center, int32_t *mean);
+
+/* In-place batch filters on Q11.20 conductance, O(n) in the signal length */
+void smooth_gsr(int32_t *data, int length, int window);
+void remove_baseline(int32_t *data, int length, int window);
+
+/**
+ * @brief Incremental stress index
+ *
+ * Same result as calculate_gsr_stress_index() on the concatenated samples,
+ * but the conversion, smoothing and baseline removal run as samples arrive,
+ * leaving only threshold, SCR detection and scoring for the finish call.
+ */
+struct gsr_stress_stream
+{
+    struct gsr_window_filter smooth;
+    struct gsr_window_filter baseline;
+    int64_t tonic_sum;              // Q11.20
+    uint32_t count;
+    uint32_t phasic_count;
+    int32_t phasic[GSR_STREAM_MAX_SAMPLES];  // Q11.20
+};
+
+void gsr_stress_stream_reset(struct gsr_stress_stream *s);
+void gsr_stress_stream_add(struct gsr_stress_stream *s, const int32_t *raw_gsr_data, int sample_count);
+void gsr_stress_stream_finish(struct gsr_stress_stream *s, int duration_sec,
+                              struct hpi_gsr_stress_index_t *result);
+
+#define GSR_MONITOR_MAX_EPOCHS  16
+#define GSR_MONITOR_MAX_RISE    (10 * GSR_SAMPLE_RATE_HZ)  // Longest SCR rise tracked, samples
+
+/* Per-epoch summary kept by the continuous monitor */
+struct gsr_monitor_epoch
+{
+    int64_t tonic_sum;  // Q11.20
+    int64_t noise_sum;  // Sum of |phasic[i] - phasic[i-1]| for the adaptive threshold, Q11.20
+    float amp_sum;      // µS
+    float amp_max;
+    uint16_t count;
+    uint16_t scr_count;
+};
+
+/**
+ * @brief Continuous stress index over a sliding window
+ *
+ * For all-day background monitoring. Tonic (baseline window mean) and phasic
+ * (smoothed signal minus baseline) components are separated as samples
+ * arrive, and SCRs are detected online with the trough-to-peak rule of the
+ * session index. A response is closed when the signal falls back below its
+ * trough or after GSR_MONITOR_MAX_RISE samples. Only per-epoch summaries are
+ * kept, so memory is fixed regardless of wear time.
+ */
+struct gsr_stress_monitor
+{
+    struct gsr_window_filter smooth;
+    struct gsr_window_filter baseline;
+    struct gsr_monitor_epoch epochs[GSR_MONITOR_MAX_EPOCHS];
+    uint16_t epoch_samples;     // Phasic samples per epoch
+    uint8_t window_epochs;      // Epochs per window, ring length
+    uint8_t head;               // Epoch being filled
+    uint8_t filled;             // Completed epochs in the ring
+
+    // Online SCR detector
+    int32_t prev[2];            // Previous two phasic samples (Q11.20), most recent first
+    uint32_t n;                 // Phasic samples since init
+    bool rising;
+    int32_t trough;
+    int32_t peak;
+    uint32_t trough_n;
+    uint32_t peak_n;
+    uint32_t last_peak_n;
+};
+
+/**
+ * @brief Reset the monitor
+ * @param epoch_sec Publish interval, one index per completed epoch
+ * @param window_sec Sliding window the index covers, at most GSR_MONITOR_MAX_EPOCHS epochs
+ */
+void gsr_stress_monitor_init(struct gsr_stress_monitor *m, int epoch_sec, int window_sec);
+
+/**
+ * @brief Feed raw BioZ ADC codes from the driver
+ * @return true if an epoch completed with a full window; result then holds the
+ *         index over the window, with peaks_per_minute normalised to one minute
+ */
+bool gsr_stress_monitor_add(struct gsr_stress_monitor *m, const int32_t *raw_gsr_data,
+                            int sample_count, struct hpi_gsr_stress_index_t *result);
 
 #endif // GSR_ALGO_H
@@ -55,7 +55,8 @@ enum hpi_ppg_status
 
 struct hpi_ecg_bioz_sensor_data_t
 {
-    int32_t ecg_samples[ECG_POINTS_PER_SAMPLE];
+    int32_t ecg_samples[ECG_POINTS_PER_SAMPLE];         // Stream profile: recording, BLE, QRS/HRV
+    int32_t ecg_plot_samples[ECG_POINTS_PER_SAMPLE];    // DISPLAY profile, live plot only
     int32_t bioz_sample[BIOZ_POINTS_PER_SAMPLE];
 
     uint8_t ecg_num_samples;
@@ -67,12 +68,12 @@ struct hpi_ecg_bioz_sensor_data_t
     uint8_t bioz_lead_off;
     bool _bioZSkipSample;
 
-    uint8_t rrint;
+    uint8_t rrint;      // 1 when rtor is a new interval from this FIFO read
 };
 
 struct hpi_gsr_sensor_data_t
 {
-    int32_t bioz_samples[BIOZ_POINTS_PER_SAMPLE];  // Conductance in µS × 100 (fixed-point from driver)
+    int32_t bioz_samples[BIOZ_POINTS_PER_SAMPLE];  // Raw 20-bit BioZ ADC codes, see max30001_bioz.h
     uint8_t bioz_num_samples;                      // Number of valid samples in this batch
     uint8_t bioz_lead_off;                         // Lead-off detection status
 };
@@ -81,12 +82,12 @@ struct hpi_gsr_sensor_data_t
  * Lightweight BioZ-only sample used for internal producer/consumer queues
  * when ECG decoding is not required. Keeps the copy footprint small.
  *
- * Note: bioz_samples contains conductance values in µS × 100 (fixed-point).
- * The MAX30001 driver performs ADC-to-conductance conversion internally.
+ * Note: bioz_samples carries raw 20-bit BioZ ADC codes as delivered by the
+ * MAX30001 driver; convert_raw_to_uS() derives conductance from them.
  */
 struct hpi_bioz_sample_t
 {
-    int32_t bioz_samples[BIOZ_POINTS_PER_SAMPLE];  // Conductance in µS × 100 (fixed-point from driver)
+    int32_t bioz_samples[BIOZ_POINTS_PER_SAMPLE];  // Raw 20-bit BioZ ADC codes
     uint8_t bioz_num_samples;
     uint8_t bioz_lead_off;
     int64_t timestamp;
@@ -152,6 +153,25 @@ struct hpi_ppg_fi_data_t
     uint32_t 
 }*/
 
+// Sample sources serviced by the data thread dispatcher
+enum hpi_data_src
+{
+    HPI_DATA_SRC_ECG = 0,
+    HPI_DATA_SRC_BIOZ,
+    HPI_DATA_SRC_PPG_FI,
+    HPI_DATA_SRC_PPG_WR,
+    HPI_DATA_SRC_COUNT,
+};
+
+// Data thread dispatcher counters (wake-ups vs. batches drained per source)
+struct hpi_data_thread_stats_t
+{
+    uint32_t wakeups;                        // Number of times the thread returned from k_poll
+    uint32_t drains[HPI_DATA_SRC_COUNT];     // Number of drain passes that found data
+    uint32_t batches[HPI_DATA_SRC_COUNT];    // Total sample batches consumed
+    uint16_t max_burst[HPI_DATA_SRC_COUNT];  // Largest number of batches drained in one pass
+};
+
 struct hpi_computed_hrv_t
 {
     int32_t hrv_max;
@@ -325,6 +345,7 @@ struct hpi_gsr_stress_index_t
     uint16_t mean_peak_amplitude_x100; // Average peak amplitude in μS * 100
     int64_t last_peak_timestamp;       // Timestamp of last detected peak
     bool stress_data_ready;            // Flag indicating valid stress data
+    bool continuous;                   // From the background monitor, not a 30 s session
 };
 
 // Live GSR measurement status (mirrors ECG status concept for timers)
@@ -6,13 +6,18 @@
  * Copyright (c) 2025 Protocentral Electronics
  *
  * Implementation of measurement storage using Zephyr's settings subsystem.
- * Uses settings_save_one() for immediate persistence and settings_load_one()
- * for loading individual values.
+ *
+ * Saves only update the RAM cache and mark the entry dirty; they are called
+ * from zbus listeners on the sampling threads and must not touch flash. The
+ * HPI sys thread writes dirty entries with settings_save_one() once they
+ * have coalesced for CONFIG_HPI_MEAS_FLUSH_INTERVAL_S, and hpi_meas_flush()
+ * forces the write before a reset, shutdown, low battery or DFU.
  */
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/settings/settings.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "hpi_measurement_settings.h"
@@ -30,7 +35,7 @@ LOG_MODULE_REGISTER(hpi_meas_settings, LOG_LEVEL_DBG);
 #define KEY_HRV        HPI_MEAS_SETTINGS_SUBTREE "/hrv"
 
 /* RAM cache for fast access - populated on init, updated on save */
-static struct {
+struct meas_cache_t {
     struct hpi_meas_hr_t hr;
     struct hpi_meas_spo2_t spo2;
     struct hpi_meas_bp_t bp;
@@ -40,11 +45,68 @@ static struct {
     struct hpi_meas_gsr_stress_t gsr_stress;
     struct hpi_meas_hrv_t hrv;
     bool initialized;
-} meas_cache;
+};
+
+static struct meas_cache_t meas_cache;
 
 /* Mutex for thread-safe access to cache */
 K_MUTEX_DEFINE(meas_cache_mutex);
 
+enum meas_slot {
+    MEAS_HR,
+    MEAS_SPO2,
+    MEAS_BP,
+    MEAS_ECG,
+    MEAS_TEMP,
+    MEAS_STEPS,
+    MEAS_GSR_STRESS,
+    MEAS_HRV,
+    MEAS_SLOT_COUNT,
+};
+
+#define MEAS_SLOT(_key, _member) \
+    {.key = _key, .offset = offsetof(struct meas_cache_t, _member), \
+     .size = sizeof(((struct meas_cache_t *)0)->_member)}
+
+static const struct {
+    const char *key;
+    size_t offset;
+    size_t size;
+} meas_slots[MEAS_SLOT_COUNT] = {
+    [MEAS_HR] = MEAS_SLOT(KEY_HR, hr),
+    [MEAS_SPO2] = MEAS_SLOT(KEY_SPO2, spo2),
+    [MEAS_BP] = MEAS_SLOT(KEY_BP, bp),
+    [MEAS_ECG] = MEAS_SLOT(KEY_ECG, ecg),
+    [MEAS_TEMP] = MEAS_SLOT(KEY_TEMP, temp),
+    [MEAS_STEPS] = MEAS_SLOT(KEY_STEPS, steps),
+    [MEAS_GSR_STRESS] = MEAS_SLOT(KEY_GSR_STRESS, gsr_stress),
+    [MEAS_HRV] = MEAS_SLOT(KEY_HRV, hrv),
+};
+
+/* Flush scratch, large enough for any entry */
+union meas_entry {
+    struct hpi_meas_hr_t hr;
+    struct hpi_meas_spo2_t spo2;
+    struct hpi_meas_bp_t bp;
+    struct hpi_meas_ecg_t ecg;
+    struct hpi_meas_temp_t temp;
+    struct hpi_meas_steps_t steps;
+    struct hpi_meas_gsr_stress_t gsr_stress;
+    struct hpi_meas_hrv_t hrv;
+};
+
+/* Write-behind state, guarded by meas_cache_mutex */
+static uint32_t meas_dirty;
+static struct hpi_meas_cache_stats_t meas_stats;
+static uint32_t meas_hour;
+static uint32_t meas_writes_this_hour;
+
+/* Given when the cache goes from clean to dirty */
+K_SEM_DEFINE(sem_meas_dirty, 0, 1);
+
+/* One flush at a time: the writer thread and forced flushes may race */
+K_MUTEX_DEFINE(meas_flush_mutex);
+
 /*
  * Settings handler callbacks for the "hpim" subtree.
  * These are called by the settings subsystem during settings_load().
@@ -248,16 +310,111 @@ int hpi_measurement_settings_init(void)
     return 0;
 }
 
-/* Helper macro for save functions */
-#define SAVE_MEASUREMENT(key, data) \
-    do { \
-        int rc = settings_save_one(key, data, sizeof(*data)); \
-        if (rc != 0) { \
-            LOG_ERR("Failed to save %s: %d", key, rc); \
-            return rc; \
-        } \
-        return 0; \
-    } while (0)
+/* Caller holds meas_cache_mutex */
+static void meas_mark_dirty(enum meas_slot slot)
+{
+    bool was_clean = (meas_dirty == 0);
+
+    meas_dirty |= BIT(slot);
+    meas_stats.updates++;
+
+    if (was_clean) {
+        k_sem_give(&sem_meas_dirty);
+    }
+}
+
+/* Roll the per-hour write counters forward. Caller holds meas_cache_mutex */
+static void meas_roll_hour(void)
+{
+    uint32_t hour = (uint32_t)(k_uptime_get() / (3600LL * MSEC_PER_SEC));
+
+    if (hour != meas_hour) {
+        meas_stats.writes_last_hour = (hour == meas_hour + 1) ? meas_writes_this_hour : 0;
+        meas_writes_this_hour = 0;
+        meas_hour = hour;
+    }
+}
+
+int hpi_meas_wait_dirty(k_timeout_t timeout)
+{
+    return k_sem_take(&sem_meas_dirty, timeout);
+}
+
+int hpi_meas_flush(void)
+{
+    union meas_entry buf;
+    int ret = 0;
+    uint32_t written = 0;
+
+    k_mutex_lock(&meas_flush_mutex, K_FOREVER);
+
+    for (int i = 0; i < MEAS_SLOT_COUNT; i++) {
+        // Snapshot under the cache lock, write without it so publishers never wait on flash
+        k_mutex_lock(&meas_cache_mutex, K_FOREVER);
+        if (!(meas_dirty & BIT(i))) {
+            k_mutex_unlock(&meas_cache_mutex);
+            continue;
+        }
+        memcpy(&buf, (const uint8_t *)&meas_cache + meas_slots[i].offset, meas_slots[i].size);
+        meas_dirty &= ~BIT(i);
+        k_mutex_unlock(&meas_cache_mutex);
+
+        int rc = settings_save_one(meas_slots[i].key, &buf, meas_slots[i].size);
+
+        k_mutex_lock(&meas_cache_mutex, K_FOREVER);
+        if (rc != 0) {
+            meas_dirty |= BIT(i);
+            meas_stats.write_errors++;
+            ret = rc;
+        } else {
+            meas_roll_hour();
+            meas_stats.writes++;
+            meas_writes_this_hour++;
+            written++;
+        }
+        k_mutex_unlock(&meas_cache_mutex);
+
+        if (rc != 0) {
+            LOG_ERR("Failed to save %s: %d", meas_slots[i].key, rc);
+        }
+    }
+
+    if (written > 0) {
+        k_mutex_lock(&meas_cache_mutex, K_FOREVER);
+        meas_stats.flushes++;
+        k_mutex_unlock(&meas_cache_mutex);
+        LOG_DBG("Measurement cache: %u entries written", written);
+    }
+
+    // Saves that landed during the pass, or failed writes, found the mask already
+    // non-zero and did not wake the writer: wake it for another pass
+    k_mutex_lock(&meas_cache_mutex, K_FOREVER);
+    if (meas_dirty != 0) {
+        k_sem_give(&sem_meas_dirty);
+    }
+    k_mutex_unlock(&meas_cache_mutex);
+
+    k_mutex_unlock(&meas_flush_mutex);
+    return ret;
+}
+
+void hpi_meas_get_cache_stats(struct hpi_meas_cache_stats_t *stats)
+{
+    k_mutex_lock(&meas_cache_mutex, K_FOREVER);
+    meas_roll_hour();
+    *stats = meas_stats;
+    stats->writes_this_hour = meas_writes_this_hour;
+    stats->dirty_mask = meas_dirty;
+    k_mutex_unlock(&meas_cache_mutex);
+}
+
+void hpi_meas_reset_cache_stats(void)
+{
+    k_mutex_lock(&meas_cache_mutex, K_FOREVER);
+    memset(&meas_stats, 0, sizeof(meas_stats));
+    meas_writes_this_hour = 0;
+    k_mutex_unlock(&meas_cache_mutex);
+}
 
 int hpi_meas_save_hr(uint16_t value, int64_t timestamp)
 {
@@ -267,13 +424,10 @@ int hpi_meas_save_hr(uint16_t value, int64_t timestamp)
     meas_cache.hr.value = value;
     meas_cache.hr.timestamp = timestamp;
 
-    int rc = settings_save_one(KEY_HR, &meas_cache.hr, sizeof(meas_cache.hr));
+    meas_mark_dirty(MEAS_HR);
     k_mutex_unlock(&meas_cache_mutex);
 
-    if (rc != 0) {
-        LOG_ERR("Failed to save HR: %d", rc);
-    }
-    return rc;
+    return 0;
 }
 
 int hpi_meas_load_hr(uint16_t *value, int64_t *timestamp)
@@ -298,13 +452,10 @@ int hpi_meas_save_spo2(uint8_t value, int64_t timestamp)
     meas_cache.spo2.value = value;
     meas_cache.spo2.timestamp = timestamp;
 
-    int rc = settings_save_one(KEY_SPO2, &meas_cache.spo2, sizeof(meas_cache.spo2));
+    meas_mark_dirty(MEAS_SPO2);
     k_mutex_unlock(&meas_cache_mutex);
 
-    if (rc != 0) {
-        LOG_ERR("Failed to save SpO2: %d", rc);
-    }
-    return rc;
+    return 0;
 }
 
 int hpi_meas_load_spo2(uint8_t *value, int64_t *timestamp)
@@ -330,13 +481,10 @@ int hpi_meas_save_bp(uint8_t sys, uint8_t dia, int64_t timestamp)
     meas_cache.bp.dia = dia;
     meas_cache.bp.timestamp = timestamp;
 
-    int rc = settings_save_one(KEY_BP, &meas_cache.bp, sizeof(meas_cache.bp));
+    meas_mark_dirty(MEAS_BP);
     k_mutex_unlock(&meas_cache_mutex);
 
-    if (rc != 0) {
-        LOG_ERR("Failed to save BP: %d", rc);
-    }
-    return rc;
+    return 0;
 }
 
 int hpi_meas_load_bp(uint8_t *sys, uint8_t *dia, int64_t *timestamp)
@@ -362,13 +510,10 @@ int hpi_meas_save_ecg(uint8_t hr, int64_t timestamp)
     meas_cache.ecg.hr = hr;
     meas_cache.ecg.timestamp = timestamp;
 
-    int rc = settings_save_one(KEY_ECG, &meas_cache.ecg, sizeof(meas_cache.ecg));
+    meas_mark_dirty(MEAS_ECG);
     k_mutex_unlock(&meas_cache_mutex);
 
-    if (rc != 0) {
-        LOG_ERR("Failed to save ECG: %d", rc);
-    }
-    return rc;
+    return 0;
 }
 
 int hpi_meas_load_ecg(uint8_t *hr, int64_t *timestamp)
@@ -393,13 +538,10 @@ int hpi_meas_save_temp(uint16_t value_x100, int64_t timestamp)
     meas_cache.temp.value_x100 = value_x100;
     meas_cache.temp.timestamp = timestamp;
 
-    int rc = settings_save_one(KEY_TEMP, &meas_cache.temp, sizeof(meas_cache.temp));
+    meas_mark_dirty(MEAS_TEMP);
     k_mutex_unlock(&meas_cache_mutex);
 
-    if (rc != 0) {
-        LOG_ERR("Failed to save Temp: %d", rc);
-    }
-    return rc;
+    return 0;
 }
 
 int hpi_meas_load_temp(uint16_t *value_x100, int64_t *timestamp)
@@ -424,13 +566,10 @@ int hpi_meas_save_steps(uint16_t value, int64_t timestamp)
     meas_cache.steps.value = value;
     meas_cache.steps.timestamp = timestamp;
 
-    int rc = settings_save_one(KEY_STEPS, &meas_cache.steps, sizeof(meas_cache.steps));
+    meas_mark_dirty(MEAS_STEPS);
     k_mutex_unlock(&meas_cache_mutex);
 
-    if (rc != 0) {
-        LOG_ERR("Failed to save Steps: %d", rc);
-    }
-    return rc;
+    return 0;
 }
 
 int hpi_meas_load_steps(uint16_t *value, int64_t *timestamp)
@@ -458,17 +597,10 @@ int hpi_meas_save_gsr_stress(uint8_t stress_level, uint16_t tonic_x100,
     meas_cache.gsr_stress.peaks_per_minute = peaks_per_minute;
     meas_cache.gsr_stress.timestamp = timestamp;
 
-    int rc = settings_save_one(KEY_GSR_STRESS, &meas_cache.gsr_stress,
-                                sizeof(meas_cache.gsr_stress));
+    meas_mark_dirty(MEAS_GSR_STRESS);
     k_mutex_unlock(&meas_cache_mutex);
 
-    if (rc != 0) {
-        LOG_ERR("Failed to save GSR stress: %d", rc);
-    } else {
-        LOG_DBG("Saved GSR: stress=%u, tonic=%u.%02u, SCR=%u/min",
-                stress_level, tonic_x100 / 100, tonic_x100 % 100, peaks_per_minute);
-    }
-    return rc;
+    return 0;
 }
 
 int hpi_meas_load_gsr_stress(uint8_t *stress_level, uint16_t *tonic_x100,
@@ -499,18 +631,10 @@ int hpi_meas_save_hrv(uint16_t lf_hf_ratio_x100, uint16_t sdnn_x10,
     meas_cache.hrv.rmssd_x10 = rmssd_x10;
     meas_cache.hrv.timestamp = timestamp;
 
-    int rc = settings_save_one(KEY_HRV, &meas_cache.hrv, sizeof(meas_cache.hrv));
+    meas_mark_dirty(MEAS_HRV);
     k_mutex_unlock(&meas_cache_mutex);
 
-    if (rc != 0) {
-        LOG_ERR("Failed to save HRV: %d", rc);
-    } else {
-        LOG_DBG("Saved HRV: LF/HF=%u.%02u, SDNN=%u.%u ms, RMSSD=%u.%u ms",
-                lf_hf_ratio_x100 / 100, lf_hf_ratio_x100 % 100,
-                sdnn_x10 / 10, sdnn_x10 % 10,
-                rmssd_x10 / 10, rmssd_x10 % 10);
-    }
-    return rc;
+    return 0;
 }
 
 int hpi_meas_load_hrv(uint16_t *lf_hf_ratio_x100, uint16_t *sdnn_x10,
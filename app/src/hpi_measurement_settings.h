@@ -7,6 +7,7 @@
  *
  * Stores last measurement values and timestamps using Zephyr's settings subsystem.
  * Uses a separate "hpim" subtree to avoid conflicts with BLE bonds ("bt" subtree).
+ * Saves update a RAM cache that is written behind to flash, see hpi_meas_flush().
  */
 
 #ifndef HPI_MEASUREMENT_SETTINGS_H
@@ -82,6 +83,17 @@ struct hpi_meas_hrv_t {
     int64_t timestamp;
 } __packed;
 
+/* Write-behind counters (see hpi_meas_get_cache_stats) */
+struct hpi_meas_cache_stats_t {
+    uint32_t updates;           /* Cache updates from save calls */
+    uint32_t writes;            /* settings_save_one() calls */
+    uint32_t flushes;           /* Flush passes that wrote something */
+    uint32_t write_errors;
+    uint32_t writes_last_hour;  /* Flash writes in the previous uptime hour */
+    uint32_t writes_this_hour;  /* ...and so far in the current one */
+    uint32_t dirty_mask;        /* Entries waiting for the next flush */
+};
+
 /**
  * @brief Initialize the measurement settings subsystem
  *
@@ -234,4 +246,25 @@ int hpi_meas_save_hrv(uint16_t lf_hf_ratio_x100, uint16_t sdnn_x10,
 int hpi_meas_load_hrv(uint16_t *lf_hf_ratio_x100, uint16_t *sdnn_x10,
                       uint16_t *rmssd_x10, int64_t *timestamp);
 
+/**
+ * @brief Block until a save marks the clean cache dirty
+ * @param timeout How long to wait
+ * @return 0 when there is something to flush, -EAGAIN on timeout
+ */
+int hpi_meas_wait_dirty(k_timeout_t timeout);
+
+/**
+ * @brief Write all dirty cache entries to the settings storage now
+ *
+ * Called by the writer after the coalescing interval, and directly before a
+ * reset, shutdown or DFU so no measurement is lost. Entries that fail to
+ * write stay dirty.
+ *
+ * @return 0 on success, last settings error otherwise
+ */
+int hpi_meas_flush(void);
+
+void hpi_meas_get_cache_stats(struct hpi_meas_cache_stats_t *stats);
+void hpi_meas_reset_cache_stats(void);
+
 #endif /* HPI_MEASUREMENT_SETTINGS_H */
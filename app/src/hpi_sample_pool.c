@@ -0,0 +1,131 @@
+/*
+ * HealthyPi Move - Shared Sample Block Pool
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <string.h>
+
+#include "hpi_sample_pool.h"
+
+LOG_MODULE_REGISTER(hpi_sample_pool, LOG_LEVEL_INF);
+
+// With every queue full and each thread holding its block, an allocation must still succeed
+BUILD_ASSERT(CONFIG_HPI_SAMPLE_POOL_BLOCKS >= HPI_SAMPLE_POOL_MIN_BLOCKS,
+             "HPI_SAMPLE_POOL_BLOCKS is smaller than the sample queue depths plus in-flight blocks");
+
+K_MEM_SLAB_DEFINE_STATIC(sample_block_slab, sizeof(struct hpi_sample_block),
+                         CONFIG_HPI_SAMPLE_POOL_BLOCKS, 4);
+
+static struct hpi_sample_pool_stats_t pool_stats = {
+    .total = CONFIG_HPI_SAMPLE_POOL_BLOCKS,
+};
+static struct k_spinlock pool_stats_lock;
+
+struct hpi_sample_block *hpi_sample_block_alloc(uint8_t type)
+{
+    struct hpi_sample_block *blk = NULL;
+
+    if (k_mem_slab_alloc(&sample_block_slab, (void **)&blk, K_NO_WAIT) != 0)
+    {
+        k_spinlock_key_t key = k_spin_lock(&pool_stats_lock);
+        pool_stats.alloc_failures++;
+        uint32_t failures = pool_stats.alloc_failures;
+        k_spin_unlock(&pool_stats_lock, key);
+
+        if ((failures % 10) == 1)
+        {
+            LOG_WRN("Sample pool exhausted - %u allocations refused", failures);
+        }
+        return NULL;
+    }
+
+    // Only the header is initialised; producers fill the payload fields they use
+    atomic_set(&blk->refcnt, 1);
+    blk->type = type;
+
+    k_spinlock_key_t key = k_spin_lock(&pool_stats_lock);
+    pool_stats.allocs++;
+    pool_stats.in_use++;
+    if (pool_stats.in_use > pool_stats.peak_in_use)
+    {
+        pool_stats.peak_in_use = pool_stats.in_use;
+    }
+    k_spin_unlock(&pool_stats_lock, key);
+
+    return blk;
+}
+
+struct hpi_sample_block *hpi_sample_block_ref(struct hpi_sample_block *blk)
+{
+    if (blk != NULL)
+    {
+        atomic_inc(&blk->refcnt);
+    }
+    return blk;
+}
+
+void hpi_sample_block_unref(struct hpi_sample_block *blk)
+{
+    if (blk == NULL)
+    {
+        return;
+    }
+
+    // atomic_dec returns the previous value
+    atomic_val_t prev = atomic_dec(&blk->refcnt);
+    __ASSERT(prev > 0, "Sample block over-released");
+
+    if (prev == 1)
+    {
+        k_mem_slab_free(&sample_block_slab, (void *)blk);
+
+        k_spinlock_key_t key = k_spin_lock(&pool_stats_lock);
+        pool_stats.in_use--;
+        k_spin_unlock(&pool_stats_lock, key);
+    }
+}
+
+int hpi_sample_block_publish(struct k_msgq *q, struct hpi_sample_block *blk)
+{
+    hpi_sample_block_ref(blk);
+
+    int ret = k_msgq_put(q, &blk, K_NO_WAIT);
+    if (ret != 0)
+    {
+        hpi_sample_block_unref(blk);
+
+        k_spinlock_key_t key = k_spin_lock(&pool_stats_lock);
+        pool_stats.publish_drops++;
+        k_spin_unlock(&pool_stats_lock, key);
+    }
+
+    return ret;
+}
+
+void hpi_sample_block_queue_flush(struct k_msgq *q)
+{
+    struct hpi_sample_block *blk;
+
+    while (k_msgq_get(q, &blk, K_NO_WAIT) == 0)
+    {
+        hpi_sample_block_unref(blk);
+    }
+}
+
+void hpi_sample_pool_get_stats(struct hpi_sample_pool_stats_t *out)
+{
+    if (out == NULL)
+    {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&pool_stats_lock);
+    *out = pool_stats;
+    k_spin_unlock(&pool_stats_lock, key);
+}
@@ -0,0 +1,119 @@
+/*
+ * HealthyPi Move - Shared Sample Block Pool
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <stdint.h>
+
+#include "hpi_common_types.h"
+
+/*
+ * Reference-counted sample blocks shared by all sensor producers.
+ *
+ * A producer allocates a block, fills the payload in place and publishes the
+ * block pointer on its sample queue. Each consumer (BLE, plot, recording,
+ * HRV) that needs the data beyond the current call takes its own reference
+ * and releases it when done; the block returns to the pool when the last
+ * reference is dropped. Queues only carry pointers, so a batch is never
+ * copied between threads.
+ */
+
+enum hpi_sample_block_type {
+    HPI_SAMPLE_BLOCK_ECG = 0,
+    HPI_SAMPLE_BLOCK_BIOZ,
+    HPI_SAMPLE_BLOCK_PPG_WR,
+    HPI_SAMPLE_BLOCK_PPG_FI,
+};
+
+struct hpi_sample_block {
+    atomic_t refcnt;
+    uint8_t  type;              /* enum hpi_sample_block_type */
+    union {
+        struct hpi_ecg_bioz_sensor_data_t ecg;
+        struct hpi_bioz_sample_t bioz;
+        struct hpi_ppg_wr_data_t ppg_wr;
+        struct hpi_ppg_fi_data_t ppg_fi;
+    };
+};
+
+/* Pool usage counters */
+struct hpi_sample_pool_stats_t {
+    uint32_t allocs;            /* Successful allocations */
+    uint32_t alloc_failures;    /* Allocations refused because the pool was empty */
+    uint32_t publish_drops;     /* Publishes refused because the target queue was full */
+    uint16_t in_use;            /* Blocks currently referenced */
+    uint16_t peak_in_use;       /* High-water mark of in_use */
+    uint16_t total;             /* Pool capacity in blocks */
+};
+
+/*
+ * Depths of the queues that carry blocks. Every queued pointer holds a
+ * reference, so the pool is sized from these (see hpi_sample_pool.c).
+ */
+#define HPI_SAMPLE_QDEPTH_ECG           16  /* q_ecg_sample, acquisition -> data thread */
+#define HPI_SAMPLE_QDEPTH_BIOZ          8   /* q_bioz_sample */
+#define HPI_SAMPLE_QDEPTH_PPG_WR        8   /* q_ppg_wrist_sample */
+#define HPI_SAMPLE_QDEPTH_PPG_FI        8   /* q_ppg_fi_sample */
+#define HPI_SAMPLE_QDEPTH_PLOT_ECG      16  /* q_plot_ecg, data -> display thread */
+#define HPI_SAMPLE_QDEPTH_PLOT_GSR      16  /* q_plot_gsr */
+#define HPI_SAMPLE_QDEPTH_PLOT_PPG_WR   8   /* q_plot_ppg_wrist */
+#define HPI_SAMPLE_QDEPTH_PLOT_PPG_FI   8   /* q_plot_ppg_fi */
+
+/*
+ * Blocks referenced outside any queue: one being filled by each producer
+ * (ECG/BioZ acquisition, PPG finger, PPG wrist), the one the data thread is
+ * handing to recording, BLE and HRV, and the one the display is drawing.
+ */
+#define HPI_SAMPLE_POOL_IN_FLIGHT       (3 + 1 + 1)
+
+#define HPI_SAMPLE_POOL_MIN_BLOCKS                                              \
+    (HPI_SAMPLE_QDEPTH_ECG + HPI_SAMPLE_QDEPTH_BIOZ + HPI_SAMPLE_QDEPTH_PPG_WR + \
+     HPI_SAMPLE_QDEPTH_PPG_FI + HPI_SAMPLE_QDEPTH_PLOT_ECG +                    \
+     HPI_SAMPLE_QDEPTH_PLOT_GSR + HPI_SAMPLE_QDEPTH_PLOT_PPG_WR +               \
+     HPI_SAMPLE_QDEPTH_PLOT_PPG_FI + HPI_SAMPLE_POOL_IN_FLIGHT)
+
+/* Define a message queue that carries struct hpi_sample_block pointers */
+#define HPI_SAMPLE_BLOCK_MSGQ_DEFINE(name, depth) \
+    K_MSGQ_DEFINE(name, sizeof(struct hpi_sample_block *), depth, 4)
+
+/**
+ * @brief Allocate a block with a single reference owned by the caller
+ * @param type Payload type (enum hpi_sample_block_type)
+ * @return Block pointer, or NULL if the pool is exhausted
+ */
+struct hpi_sample_block *hpi_sample_block_alloc(uint8_t type);
+
+/**
+ * @brief Take an additional reference on a block
+ */
+struct hpi_sample_block *hpi_sample_block_ref(struct hpi_sample_block *blk);
+
+/**
+ * @brief Drop one reference; the block is freed when the count reaches zero
+ */
+void hpi_sample_block_unref(struct hpi_sample_block *blk);
+
+/**
+ * @brief Queue a block for a consumer
+ *
+ * Takes a new reference on behalf of the receiver. The caller keeps its own
+ * reference either way. The receiver must call hpi_sample_block_unref() once
+ * it is done with the block.
+ *
+ * @return 0 on success, negative errno if the queue was full
+ */
+int hpi_sample_block_publish(struct k_msgq *q, struct hpi_sample_block *blk);
+
+/**
+ * @brief Discard every block waiting in a queue, releasing its reference
+ */
+void hpi_sample_block_queue_flush(struct k_msgq *q);
+
+void hpi_sample_pool_get_stats(struct hpi_sample_pool_stats_t *out);
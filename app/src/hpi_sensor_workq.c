@@ -0,0 +1,177 @@
+/*
+ * HealthyPi Move - Sensor Acquisition Work Queues
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <errno.h>
+#include <string.h>
+
+#include "hpi_sensor_workq.h"
+
+LOG_MODULE_REGISTER(hpi_sensor_workq, LOG_LEVEL_INF);
+
+#if defined(CONFIG_SENSOR_MAX30001_WORKQ_PRIORITY)
+// The MAX30001 FIFO drain must not sit behind the display, data and BLE threads
+BUILD_ASSERT(CONFIG_SENSOR_MAX30001_WORKQ_PRIORITY <= CONFIG_HPI_SENSOR_WQ_PRIORITY,
+             "MAX30001 work queue must run at or above the sensor queue priority");
+#endif
+
+K_THREAD_STACK_ARRAY_DEFINE(sensor_wq_stacks, HPI_SENSOR_WQ_COUNT, CONFIG_HPI_SENSOR_WQ_STACK_SIZE);
+static struct k_work_q sensor_wq[HPI_SENSOR_WQ_COUNT];
+
+static const char *const sensor_wq_names[HPI_SENSOR_WQ_COUNT] = {
+    [HPI_SENSOR_WQ_I2C1] = "sensor_wq_i2c1",
+    [HPI_SENSOR_WQ_I2C2] = "sensor_wq_i2c2",
+};
+
+struct sensor_work_acc {
+    uint32_t runs;
+    uint32_t coalesced;
+    uint32_t deadline_misses;
+    uint32_t exec_max_us;
+    uint32_t wait_max_us;
+    uint64_t exec_total_us;
+    uint64_t wait_total_us;
+};
+
+static struct sensor_work_acc work_acc[HPI_SENSOR_WORK_COUNT];
+static struct k_spinlock work_acc_lock;
+
+static inline uint32_t cyc_to_us(uint32_t cyc)
+{
+    return (uint32_t)k_cyc_to_us_floor64(cyc);
+}
+
+void hpi_sensor_work_account(uint8_t id, uint32_t wait_us, uint32_t exec_us, uint32_t deadline_us)
+{
+    if (id >= HPI_SENSOR_WORK_COUNT)
+    {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&work_acc_lock);
+    struct sensor_work_acc *acc = &work_acc[id];
+
+    acc->runs++;
+    acc->exec_total_us += exec_us;
+    acc->wait_total_us += wait_us;
+    acc->exec_max_us = MAX(acc->exec_max_us, exec_us);
+    acc->wait_max_us = MAX(acc->wait_max_us, wait_us);
+    bool missed = (deadline_us != 0) && ((uint64_t)wait_us + exec_us > deadline_us);
+    if (missed)
+    {
+        acc->deadline_misses++;
+    }
+    uint32_t misses = acc->deadline_misses;
+
+    k_spin_unlock(&work_acc_lock, key);
+
+    if (missed && (misses % 10) == 1)
+    {
+        LOG_WRN("Sensor work %u missed its %u us deadline (wait %u, exec %u), %u misses",
+                id, deadline_us, wait_us, exec_us, misses);
+    }
+}
+
+void hpi_sensor_work_run(struct k_work *work)
+{
+    struct hpi_sensor_work *sw = CONTAINER_OF(work, struct hpi_sensor_work, work);
+    uint32_t start = k_cycle_get_32();
+
+    sw->handler(work);
+
+    uint32_t end = k_cycle_get_32();
+    hpi_sensor_work_account(sw->id, cyc_to_us(start - sw->submit_cyc), cyc_to_us(end - start),
+                            sw->deadline_us);
+}
+
+int hpi_sensor_work_submit(struct hpi_sensor_work *sw)
+{
+    if (sw->wq >= HPI_SENSOR_WQ_COUNT)
+    {
+        return -EINVAL;
+    }
+
+    if (!sw->work_ready)
+    {
+        k_spinlock_key_t key = k_spin_lock(&work_acc_lock);
+        if (!sw->work_ready)
+        {
+            k_work_init(&sw->work, hpi_sensor_work_run);
+            sw->work_ready = true;
+        }
+        k_spin_unlock(&work_acc_lock, key);
+    }
+
+    // Still waiting from the previous submit: this period is lost, keep the older timestamp
+    if (k_work_busy_get(&sw->work) & K_WORK_QUEUED)
+    {
+        k_spinlock_key_t key = k_spin_lock(&work_acc_lock);
+        work_acc[sw->id].coalesced++;
+        k_spin_unlock(&work_acc_lock, key);
+        return 0;
+    }
+
+    sw->submit_cyc = k_cycle_get_32();
+    return k_work_submit_to_queue(&sensor_wq[sw->wq], &sw->work);
+}
+
+int hpi_sensor_work_get_stats(uint8_t id, struct hpi_sensor_work_stats_t *stats)
+{
+    if (id >= HPI_SENSOR_WORK_COUNT || stats == NULL)
+    {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&work_acc_lock);
+    const struct sensor_work_acc *acc = &work_acc[id];
+
+    stats->runs = acc->runs;
+    stats->coalesced = acc->coalesced;
+    stats->deadline_misses = acc->deadline_misses;
+    stats->exec_avg_us = acc->runs ? (uint32_t)(acc->exec_total_us / acc->runs) : 0;
+    stats->exec_max_us = acc->exec_max_us;
+    stats->wait_avg_us = acc->runs ? (uint32_t)(acc->wait_total_us / acc->runs) : 0;
+    stats->wait_max_us = acc->wait_max_us;
+
+    k_spin_unlock(&work_acc_lock, key);
+    return 0;
+}
+
+int hpi_sensor_work_reset_stats(uint8_t id)
+{
+    if (id >= HPI_SENSOR_WORK_COUNT)
+    {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&work_acc_lock);
+    memset(&work_acc[id], 0, sizeof(work_acc[id]));
+    k_spin_unlock(&work_acc_lock, key);
+    return 0;
+}
+
+static int hpi_sensor_workq_init(void)
+{
+    for (int i = 0; i < HPI_SENSOR_WQ_COUNT; i++)
+    {
+        struct k_work_queue_config cfg = {
+            .name = sensor_wq_names[i],
+        };
+
+        k_work_queue_start(&sensor_wq[i], sensor_wq_stacks[i],
+                           K_THREAD_STACK_SIZEOF(sensor_wq_stacks[i]),
+                           CONFIG_HPI_SENSOR_WQ_PRIORITY, &cfg);
+    }
+
+    return 0;
+}
+
+// Before the application threads that start the sampling timers
+SYS_INIT(hpi_sensor_workq_init, APPLICATION, 0);
@@ -0,0 +1,99 @@
+/*
+ * HealthyPi Move - Sensor Acquisition Work Queues
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+
+/*
+ * Sensor reads run on their own high-priority work queues, one per bus, so a
+ * slow transaction on one sensor (or a long LVGL/BLE item on the system work
+ * queue) cannot hold up another sensor's FIFO service.
+ *
+ * Each instrumented work item records how long it waited in the queue after
+ * submission, how long it ran, and how often wait + run exceeded its deadline
+ * (normally the sampling period). A submit that finds the item still queued
+ * is merged into the pending run and counted as coalesced: that sampling
+ * period was skipped. The MAX30001 (SPI) is drained by its driver's work
+ * queue and decoded on the ECG/BioZ acquisition thread, both at the sensor
+ * queue priority; it reports through hpi_sensor_work_account().
+ */
+
+enum hpi_sensor_wq {
+    HPI_SENSOR_WQ_I2C1 = 0,     /* MAX32664D finger PPG */
+    HPI_SENSOR_WQ_I2C2,         /* MAX32664C wrist PPG */
+    HPI_SENSOR_WQ_COUNT,
+};
+
+enum hpi_sensor_work_id {
+    HPI_SENSOR_WORK_ECG_BIOZ = 0,   /* MAX30001 FIFO event processing (SPI) */
+    HPI_SENSOR_WORK_PPG_FINGER,     /* MAX32664D sample read */
+    HPI_SENSOR_WORK_PPG_WRIST_READ, /* MAX32664C async read submit */
+    HPI_SENSOR_WORK_PPG_WRIST_DECODE, /* MAX32664C completion decode */
+    HPI_SENSOR_WORK_COUNT,
+};
+
+struct hpi_sensor_work {
+    struct k_work work;         /* k_work_init() on first submit */
+    k_work_handler_t handler;
+    uint32_t submit_cyc;        /* Cycle count at submission */
+    uint32_t deadline_us;
+    uint8_t wq;                 /* enum hpi_sensor_wq */
+    uint8_t id;                 /* enum hpi_sensor_work_id */
+    bool work_ready;
+};
+
+/* Per work item counters; times in microseconds */
+struct hpi_sensor_work_stats_t {
+    uint32_t runs;
+    uint32_t coalesced;         /* Submits merged into a run that was still queued */
+    uint32_t deadline_misses;   /* Runs where wait + execution exceeded the deadline */
+    uint32_t exec_avg_us;
+    uint32_t exec_max_us;
+    uint32_t wait_avg_us;
+    uint32_t wait_max_us;
+};
+
+void hpi_sensor_work_run(struct k_work *work);
+
+/* Define an instrumented work item running _handler on queue _wq */
+#define HPI_SENSOR_WORK_DEFINE(name, _handler, _wq, _id, _deadline_us) \
+    struct hpi_sensor_work name = {                                   \
+        .handler = _handler,                                          \
+        .deadline_us = _deadline_us,                                  \
+        .wq = _wq,                                                    \
+        .id = _id,                                                    \
+    }
+
+/**
+ * @brief Queue an instrumented work item on its sensor queue (ISR safe)
+ * @return 1 if queued, 0 if it was already queued (coalesced), negative on error
+ */
+int hpi_sensor_work_submit(struct hpi_sensor_work *sw);
+
+/**
+ * @brief Record one run of work done outside the sensor queues
+ * @param id Work item (enum hpi_sensor_work_id)
+ * @param wait_us Time from data ready to start of processing
+ * @param exec_us Processing time
+ * @param deadline_us Budget for wait + exec, 0 for none
+ */
+void hpi_sensor_work_account(uint8_t id, uint32_t wait_us, uint32_t exec_us, uint32_t deadline_us);
+
+/**
+ * @brief Copy the counters of one work item
+ * @return 0 on success, -EINVAL for an unknown id
+ */
+int hpi_sensor_work_get_stats(uint8_t id, struct hpi_sensor_work_stats_t *stats);
+
+/**
+ * @brief Clear the counters of one work item
+ * @return 0 on success, -EINVAL for an unknown id
+ */
+int hpi_sensor_work_reset_stats(uint8_t id);
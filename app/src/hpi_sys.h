@@ -55,6 +55,56 @@ bool hpi_sys_get_device_on_skin(void);
 
 void hpi_display_signal_touch_wakeup(void);
 
+// Display frame timing for the current screen (smf_display.c)
+struct hpi_disp_frame_stats_t {
+    uint8_t screen;             // Screen the counters belong to
+    uint16_t fps_x10;           // Achievable frame rate from the averages
+    uint32_t frames;            // LVGL passes that flushed pixels
+    uint32_t areas;
+    uint32_t bytes;
+    uint32_t render_us;         // Total LVGL time, excluding waits on the panel
+    uint32_t render_max_us;
+    uint32_t transfer_us;       // Total time pixel data was on the wire
+    uint32_t transfer_max_us;
+    uint32_t wait_us;           // Total time rendering stalled on a busy transfer
+};
+
+void hpi_disp_get_frame_stats(struct hpi_disp_frame_stats_t *stats);
+void hpi_disp_reset_frame_stats(void);
+
+// Display thread duty cycle per screen (smf_display.c), the last few screens shown
+struct hpi_disp_sched_stats_t {
+    uint8_t screen;
+    uint16_t duty_permille;     // Busy time over elapsed time
+    uint32_t elapsed_ms;        // Time on the screen while the display was on
+    uint32_t busy_us;           // State machine and LVGL time
+    uint32_t wakeups;           // Display thread passes
+    uint32_t data_wakeups;      // Woken by plot data
+    uint32_t event_wakeups;     // Woken by touch, crown key or a screen change
+};
+
+#define HPI_DISP_SCHED_CURR_SCREEN 0xFF
+
+// screen is a screen id or HPI_DISP_SCHED_CURR_SCREEN, -ENOENT if it has no counters
+int hpi_disp_get_sched_stats(uint8_t screen, struct hpi_disp_sched_stats_t *stats);
+void hpi_disp_reset_sched_stats(void);
+
+// Carousel screen cache (ui/hpi_scr_cache.c), latencies are swipe to first flushed frame
+struct hpi_scr_cache_stats_t {
+    uint8_t screens;            // Screens held
+    uint32_t bytes;             // Their measured or estimated heap use
+    uint32_t hits;
+    uint32_t misses;            // Screen built from scratch
+    uint32_t evictions;
+    uint32_t hit_latency_avg_us;
+    uint32_t hit_latency_max_us;
+    uint32_t miss_latency_avg_us;
+    uint32_t miss_latency_max_us;
+};
+
+void hpi_scr_cache_get_stats(struct hpi_scr_cache_stats_t *stats);
+void hpi_scr_cache_reset_stats(void);
+
 int hpi_helper_get_relative_time_str(int64_t in_ts, char *out_str, size_t out_str_size);
 int hpi_sys_set_sys_time(struct tm *tm);
 int64_t hw_get_sys_time_ts(void);
@@ -96,5 +146,12 @@ void hpi_data_hrv_record_to_file(bool active);
 struct hpi_hrv_eval_result_t hpi_data_get_hrv_result(void);
 void hpi_data_reset_hrv_record_buffer(void);
 
+struct hpi_data_thread_stats_t;
+void hpi_data_get_thread_stats(struct hpi_data_thread_stats_t *out);
+void hpi_data_reset_thread_stats(void);
+
 void gsr_background_start(void);
 void gsr_background_stop(void);
+
+void imu_background_start(void);
+void imu_background_stop(void);
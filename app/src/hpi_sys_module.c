@@ -72,6 +72,12 @@ enum mgmt_cb_return dfu_callback_func(uint32_t event, enum mgmt_cb_return prev_s
     LOG_DBG("DFU callback event: %d, prev_status: %d, rc: %d, group: %d, abort_more: %d",
             event, prev_status, *rc, *group, *abort_more);
 
+    // The new image runs after the next reset; persist cached measurements before that
+    if (event == MGMT_EVT_OP_IMG_MGMT_DFU_STARTED || event == MGMT_EVT_OP_IMG_MGMT_DFU_PENDING)
+    {
+        hpi_meas_flush();
+    }
+
     /* Return OK status code to continue with acceptance to underlying handler */
     return MGMT_CB_OK;
 }
@@ -606,10 +612,12 @@ void hpi_sys_thread(void)
 
     LOG_INF("Measurement settings loaded from persistent storage");
 
-    // Thread now just sleeps - all saves happen immediately via settings subsystem
+    // Measurement cache writer: let updates coalesce after the first one, then write them in one pass
     while (1)
     {
-        k_sleep(K_FOREVER);
+        hpi_meas_wait_dirty(K_FOREVER);
+        k_sleep(K_SECONDS(CONFIG_HPI_MEAS_FLUSH_INTERVAL_S));
+        hpi_meas_flush();
     }
 }
 
@@ -115,7 +115,7 @@ ZBUS_CHAN_DEFINE(gsr_stress_chan, /* Name */
                  struct hpi_gsr_stress_index_t,
                  NULL, /* Validator */
                  NULL, /* User Data */
-                 ZBUS_OBSERVERS(disp_gsr_stress_lis),
+                 ZBUS_OBSERVERS(disp_gsr_stress_lis, trend_gsr_lis),
                  ZBUS_MSG_INIT(0) /* Initial value {0} */
 );
 #endif
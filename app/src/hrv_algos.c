@@ -3,8 +3,10 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/sensor.h>
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 #include "hrv_algos.h"
+#include "hrv_spectrum.h"
 #include "ui/move_ui.h"
 #include "log_module.h"
 #include "hpi_sys.h"
@@ -14,16 +16,6 @@
 
 LOG_MODULE_REGISTER(hrv_algos, LOG_LEVEL_DBG);
 
-// Required buffer sizes to process LF and HF power
-float32_t rr_time[MAX_RR_INTERVALS + 1]; // Time taken to collect samples (cumulative time processed from RR intervals)
-float32_t rr_values[MAX_RR_INTERVALS + 1]; // RR intervals in seconds
-float32_t interp_signal[FFT_SIZE * 4];  // Larger buffer for interpolated signal
-float32_t fft_input[FFT_SIZE * 2];      // Complex FFT input
-float32_t fft_output[FFT_SIZE * 2];     // Complex FFT output
-float32_t psd[FFT_SIZE];                // Power spectral density
-float32_t window[FFT_SIZE];             // Hanning window
-
-
 // Static variables for HRV frequency analysis
 float lf_power_compact = 0.0f;
 float hf_power_compact = 0.0f;
@@ -123,238 +115,154 @@ uint32_t hrv_calculate_max(uint16_t * rr_buffer, int count)
 }
 
 
-/*Linear interpolation helper function */
-static float32_t linear_interp(float32_t x, float32_t x0, float32_t x1, float32_t y0, float32_t y1)
+/*
+ * Streaming HRV
+ *
+ * Each accepted R-R interval updates the time-domain accumulators (Welford
+ * mean/variance for SDNN, successive-difference sums for RMSSD and pNN50) and
+ * is handed to the spectral estimator selected by CONFIG_HPI_HRV_PSD_*, so
+ * LF/HF is available at any time and the end of the measurement only has to
+ * read it out. See hrv_spectrum.h for the estimators.
+ */
+static struct
 {
-    if (x1 == x0) return y0;
-    return y0 + (x - x0) * (y1 - y0) / (x1 - x0);
+    uint32_t count;
+    float mean;
+    float m2;
+    float sum_sq_diff;
+    uint32_t diffs;         // Successive differences, none across a gap
+    uint32_t nn50;
+    uint16_t last_rr;
+    uint16_t min_rr;
+    uint16_t max_rr;
+
+#if defined(CONFIG_HPI_HRV_PSD_LOMB)
+    struct hrv_lomb psd;
+#else
+    struct hrv_welch psd;
+#endif
+} hrv_stream;
+
+K_MUTEX_DEFINE(hrv_stream_mutex);
+
+#if defined(CONFIG_HPI_HRV_PSD_LOMB)
+#define hrv_psd_reset           hrv_lomb_reset
+#define hrv_psd_add             hrv_lomb_add
+#define hrv_psd_band_powers     hrv_lomb_band_powers
+#else
+#define hrv_psd_reset           hrv_welch_reset
+#define hrv_psd_add             hrv_welch_add
+#define hrv_psd_band_powers     hrv_welch_band_powers
+#endif
+
+void hpi_hrv_stream_reset(void)
+{
+    k_mutex_lock(&hrv_stream_mutex, K_FOREVER);
+
+    hrv_stream.count = 0;
+    hrv_stream.mean = 0.0f;
+    hrv_stream.m2 = 0.0f;
+    hrv_stream.sum_sq_diff = 0.0f;
+    hrv_stream.diffs = 0;
+    hrv_stream.nn50 = 0;
+    hrv_stream.last_rr = 0;
+    hrv_stream.min_rr = 0;
+    hrv_stream.max_rr = 0;
+    hrv_psd_reset(&hrv_stream.psd);
+
+    k_mutex_unlock(&hrv_stream_mutex);
 }
 
-/* Interpolate RR intervals to evenly sampled signal */
-
-static uint32_t interpolate_rr_intervals(uint16_t *rr_ms, uint32_t num_intervals,float32_t fs,float32_t *rr_time, float32_t *rr_values,
-    float32_t *interp_signal,uint32_t max_interp_samples)
- {
-    //Convert RR intervals to seconds and create time vector
-    rr_time[0] = 0.0f;
-    rr_values[0] = rr_ms[0] / 1000.0f;  // First interval at t=0
-    
-    for (uint32_t i = 1; i < num_intervals; i++) { 
-        rr_values[i] = rr_ms[i] / 1000.0f;
-        rr_time[i] = rr_time[i-1] + rr_values[i-1];    
-    }
-
-    // Calculate number of interpolated samples
-    rr_time[num_intervals] = rr_time[num_intervals-1] + rr_values[num_intervals-1];
-    float32_t total_time = rr_time[num_intervals];
-   
-    LOG_INF("Total RR time: %.2f seconds", total_time);
-    uint32_t num_samples = (uint32_t)(total_time * fs);
-    
-    if (num_samples > max_interp_samples) {
-        num_samples = max_interp_samples;
-    }
-
-    LOG_INF("Number of interpolated samples: %d", num_samples);
-    
-    // Interpolate using linear interpolation (simple and fast)
-    float32_t dt = 1.0f / fs;
-    uint32_t idx = 0;
-    
-    for (uint32_t i = 0; i < num_samples; i++)
-    {
-        float32_t t = i * dt;
-        
-        // Find the interval containing time t
-        while (idx < num_intervals && rr_time[idx + 1] < t) 
-            idx++;
-        
-        
-        if (idx >= num_intervals) 
-            break;
-        
-        // Linear interpolation
-        interp_signal[i] = linear_interp(t, rr_time[idx], rr_time[idx + 1],rr_values[idx], rr_values[idx + 1]);
+void hpi_hrv_stream_add(uint16_t rr_ms, uint32_t gap_ms)
+{
+    k_mutex_lock(&hrv_stream_mutex, K_FOREVER);
+
+    float x = (float)rr_ms;
+
+    /* Welford running mean / variance */
+    hrv_stream.count++;
+    float delta = x - hrv_stream.mean;
+    hrv_stream.mean += delta / hrv_stream.count;
+    hrv_stream.m2 += delta * (x - hrv_stream.mean);
+
+    if (hrv_stream.count == 1) {
+        hrv_stream.min_rr = rr_ms;
+        hrv_stream.max_rr = rr_ms;
+    } else {
+        // After a gap the previous interval is not this one's neighbour
+        if (gap_ms == 0) {
+            int32_t diff = (int32_t)rr_ms - (int32_t)hrv_stream.last_rr;
+            hrv_stream.sum_sq_diff += (float)(diff * diff);
+            hrv_stream.diffs++;
+            if (abs(diff) > 50) {
+                hrv_stream.nn50++;
+            }
+        }
+        hrv_stream.min_rr = MIN(hrv_stream.min_rr, rr_ms);
+        hrv_stream.max_rr = MAX(hrv_stream.max_rr, rr_ms);
     }
-    
-    return num_samples;
-}
+    hrv_stream.last_rr = rr_ms;
 
-/* Create Hanning window using CMSIS-DSP */
+    hrv_psd_add(&hrv_stream.psd, rr_ms / 1000.0f, gap_ms / 1000.0f);
 
-static void create_hanning_window(float32_t *window, uint32_t size) {
-    for (uint32_t i = 0; i < size; i++) {
-         window[i] = 0.5f * (1.0f - arm_cos_f32(2.0f * PI * i / (size - 1)));
-    }
+    k_mutex_unlock(&hrv_stream_mutex);
 }
 
-/* Remove mean from signal using CMSIS-DSP */
-static void remove_mean(float32_t *signal, uint32_t length)
- {
-        
-    if (length == 0) return;
-    
-    float32_t sum = 0.0f;
-    
-    // Calculate initial mean
-    for (uint32_t i = 0; i < length; i++) {
-        sum += signal[i];
-    }
-    
-    float32_t initial_mean = sum / length;
-
-    // Remove mean
-    for (uint32_t i = 0; i < length; i++) {
-        signal[i] -= initial_mean;
+/* Caller holds hrv_stream_mutex */
+static void hrv_stream_time_domain(struct hpi_hrv_live_t *out)
+{
+    memset(out, 0, sizeof(*out));
+
+    uint32_t n = hrv_stream.count;
+    out->count = n;
+    out->mean = hrv_stream.mean;
+    out->min = hrv_stream.min_rr;
+    out->max = hrv_stream.max_rr;
+    if (n >= 2) {
+        out->sdnn = sqrtf(hrv_stream.m2 / (n - 1));
     }
-    
-    // Verify mean is now zero
-    sum = 0.0f;
-    for (uint32_t i = 0; i < length; i++) {
-        sum += signal[i];
+    if (hrv_stream.diffs > 0) {
+        out->rmssd = sqrtf(hrv_stream.sum_sq_diff / hrv_stream.diffs);
+        out->pnn50 = (float)hrv_stream.nn50 * 100.0f / hrv_stream.diffs;
     }
-    
-    float32_t final_mean = sum / length;
-    LOG_DBG("Final mean after removal: %.10f s (should be ~0)", final_mean);  
-
 }
 
-/* Calculate PSD using Welch's method with CMSIS-DSP FFT */
-
-static void calculate_psd_welch(float32_t *signal, uint32_t signal_len,float32_t *window, float32_t *fft_input,float32_t *fft_output, 
-    float32_t *psd,uint32_t fft_size, float32_t fs) 
+void hpi_hrv_stream_get_time_domain(struct hpi_hrv_live_t *out)
 {
+    k_mutex_lock(&hrv_stream_mutex, K_FOREVER);
+    hrv_stream_time_domain(out);
+    k_mutex_unlock(&hrv_stream_mutex);
+}
 
-    if (signal_len < fft_size) {
-      LOG_WRN("signal_len (%u) < fft_size (%u) -> no PSD", signal_len, fft_size);
-      return;
-    }
-    // Initialize PSD to zero
-    memset(psd, 0, sizeof(float32_t) * fft_size);
-    
-     float32_t window_power = 0.0f;
-    for (uint32_t i = 0; i < fft_size; i++) {
-        window_power += window[i] * window[i];
-    }
-     LOG_DBG("Window power: %.3f", window_power);
-    // Calculate step size for 50% overlap
-    uint32_t step = fft_size / 2;
-    uint32_t num_segments = 0;
-    
-    // FFT instance (use appropriate size from arm_const_structs.h)
-    const arm_cfft_instance_f32 *fft_instance;
-    
-    // Select appropriate FFT instance based on size
-    switch(fft_size) {
-        case 64 : fft_instance = &arm_cfft_sR_f32_len64; break;
-        case 128: fft_instance = &arm_cfft_sR_f32_len128; break;
-        case 256:  fft_instance = &arm_cfft_sR_f32_len256; break;
-        case 512:  fft_instance = &arm_cfft_sR_f32_len512; break;
-        case 1024: fft_instance = &arm_cfft_sR_f32_len1024; break;
-        default:   return; // Unsupported FFT size
-    }
-    
-    // Process overlapping segments
-    for (uint32_t start = 0; start <= signal_len - fft_size; start += step) 
-    {
-        // Copy segment and apply window
-
-         for (uint32_t i = 0; i < fft_size; i++) {
-            float32_t windowed = signal[start + i] * window[i];
-            fft_input[2 * i] = windowed;      // Real part
-            fft_input[2 * i + 1] = 0.0f;      // Imaginary part
-        }
-
-    
-        // Perform FFT
-        arm_copy_f32(fft_input, fft_output, fft_size * 2);
-        arm_cfft_f32(fft_instance, fft_output, 0, 1);
-        
-        // Calculate magnitude squared and accumulate
-        for (uint32_t i = 0; i < fft_size; i++) 
-        {
-            float32_t real = fft_output[2 * i];
-            float32_t imag = fft_output[2 * i + 1];
-            psd[i] += (real * real + imag * imag);
-        }
-        
-        num_segments++;
-    }
-    LOG_INF("Processed %d segments (signal_len=%u, fft_size=%u, step=%u)", 
-            num_segments, signal_len, fft_size, step);
-
-    if (num_segments == 0) {
-      LOG_WRN("No PSD segments processed (signal_len=%u, fft_size=%u)", signal_len, fft_size);
-      return;
-      }
-    // Average the PSD and normalize
-     LOG_INF("Number of segments: %d", num_segments);
-    float32_t scale = 1.0f / (num_segments * window_power * fs );
+void hpi_hrv_stream_get(struct hpi_hrv_live_t *out)
+{
+    k_mutex_lock(&hrv_stream_mutex, K_FOREVER);
 
-   //  LOG_DBG("Scaling factor: %.6f (window_power=%.3f, fs=%.1f, N=%d)", scale, window_power, fs, num_segments);
-     arm_scale_f32(psd, scale, psd, fft_size);
+    hrv_stream_time_domain(out);
+    out->psd_valid = hrv_psd_band_powers(&hrv_stream.psd, &out->lf_power, &out->hf_power);
 
+    k_mutex_unlock(&hrv_stream_mutex);
 }
 
-/* Integrate power in frequency band using trapezoidal rule */
+void hpi_hrv_stream_finalize(void)
+{
+    struct hpi_hrv_live_t live;
 
-static float32_t integrate_band_power(float32_t *psd, uint32_t fft_size,float32_t fs, float32_t f_low, float32_t f_high)
- {
-    float32_t df = fs / fft_size;
-    uint32_t idx_low = (uint32_t)roundf(f_low / df);
-    uint32_t idx_high = (uint32_t)roundf(f_high / df);
+    hpi_hrv_stream_get(&live);
 
-    // Clamp indices
-    if (idx_high >= fft_size / 2) idx_high = fft_size / 2 - 1;
-    if (idx_low > idx_high) return 0.0f;
-    
-    // Trapezoidal integration
-    float32_t power = 0.0f;
+    tm_metrics.mean = live.mean;
+    tm_metrics.sdnn = live.sdnn;
+    tm_metrics.rmssd = live.rmssd;
+    tm_metrics.pnn50 = live.pnn50;
+    tm_metrics.hrv_min = (float)live.min;
+    tm_metrics.hrv_max = (float)live.max;
 
-   // LOG_DBG("---- Per-bin power (%.2f-%.2f Hz) ----", f_low, f_high);
-    for (uint32_t i = idx_low; i <= idx_high; i++) {
-        float32_t power_bin_s2 = psd[i] * df;            // in s^2
-      //  LOG_DBG("Bin %3d | Freq = %.3f Hz | PSD = %.6f", i, (double)(i * df), (double)psd[i]);
+    if (!live.psd_valid) {
+        LOG_WRN("Not enough R-R data for an LF/HF estimate (%u intervals)", live.count);
     }
-    
-    for (uint32_t i = idx_low; i < idx_high; i++) {
-      power += (psd[i] + psd[i + 1]) * 0.5f * df;
-    }
-    
-    // Convert from s^2 to ms^2
-    power *= 1000000.0f;
-
-   // LOG_DBG("Integrated power from %.2f Hz to %.2f Hz: %.3f ms^2", (double)f_low, (double)f_high, (double)power);
-    
-    return power;
-}
 
-void hpi_hrv_frequency_compact_update_spectrum(uint16_t *rr_intervals, int num_intervals)
- {
-
-        tm_metrics.mean = hrv_calculate_mean(rr_intervals, num_intervals);
-        tm_metrics.sdnn = hrv_calculate_sdnn(rr_intervals, num_intervals);
-        tm_metrics.rmssd = hrv_calculate_rmssd(rr_intervals, num_intervals);
-        tm_metrics.pnn50 = hrv_calculate_pnn50(rr_intervals, num_intervals);    
-        tm_metrics.hrv_min = (float)hrv_calculate_min(rr_intervals, num_intervals);
-        tm_metrics.hrv_max = (float)hrv_calculate_max(rr_intervals, num_intervals);
-
-    // Interpolate RR intervals
-    uint32_t num_interp_samples = interpolate_rr_intervals(rr_intervals, num_intervals,INTERP_FS,rr_time,rr_values,
-        interp_signal,FFT_SIZE * 4);
-  
-     // Remove mean
-     remove_mean(interp_signal, num_interp_samples);
-
-      // Create Hanning window
-     create_hanning_window(window, FFT_SIZE);
-     
-     // Calculate PSD using Welch's method
-     calculate_psd_welch(interp_signal, num_interp_samples, window, fft_input, fft_output, psd, FFT_SIZE, INTERP_FS);
-    
-    // Integrate power in LF, HF bands    
-    lf_power_compact = integrate_band_power(psd,FFT_SIZE, INTERP_FS, LF_LOW, LF_HIGH);
-    hf_power_compact = integrate_band_power(psd, FFT_SIZE, INTERP_FS,HF_LOW, HF_HIGH);
+    lf_power_compact = live.lf_power;
+    hf_power_compact = live.hf_power;
     stress_score_compact = get_stress_percentage(lf_power_compact, hf_power_compact);
     sdnn_val = tm_metrics.sdnn;
     rmssd_val = tm_metrics.rmssd; 
@@ -376,17 +284,28 @@ void hpi_hrv_frequency_compact_update_spectrum(uint16_t *rr_intervals, int num_i
         LOG_WRN("HRV ratio is zero or negative (%.2f), not saving to settings", ratio);
     }
 
+    if (live.count == 0) {
+        return;
+    }
 
     LOG_INF("HRV interval Collection Completed: \nSamples : %d\nMean : %.1f\nSDNN : %.1f\nRMSSD : %.1f\nPnn50 : %.1f\nMIN : %.1f ms - %.1f bpm\nMAX : %.1f ms - %.1f bpm",
-             num_intervals,tm_metrics.mean, sdnn_val,rmssd_val, tm_metrics.pnn50, 
+             live.count,tm_metrics.mean, sdnn_val,rmssd_val, tm_metrics.pnn50, 
              tm_metrics.hrv_max, (60000/tm_metrics.hrv_max), tm_metrics.hrv_min, (60000/tm_metrics.hrv_min));
 
     LOG_INF("LF Power (Compact): %f", lf_power_compact);
     LOG_INF("HF Power (Compact): %f", hf_power_compact);
-    LOG_INF("LF/HF Ratio (Compact): %f", lf_power_compact / hf_power_compact);
+    LOG_INF("LF/HF Ratio (Compact): %f", ratio);
     LOG_INF("Stress Score (Compact): %f", stress_score_compact);
-   
- }
+}
+
+void hpi_hrv_frequency_compact_update_spectrum(uint16_t *rr_intervals, int num_intervals)
+{
+    hpi_hrv_stream_reset();
+    for (int i = 0; i < num_intervals; i++) {
+        hpi_hrv_stream_add(rr_intervals[i], 0);
+    }
+    hpi_hrv_stream_finalize();
+}
  float hpi_get_lf_hf_ratio(void) {
    
     return (hf_power_compact == 0.0f) ? 0.0f : lf_power_compact / hf_power_compact;
@@ -29,6 +29,7 @@
 
 
 #pragma once
+#include <stdbool.h>
 #include "arm_math.h"
 
 
@@ -60,10 +61,38 @@ typedef struct
 
 }time_domain;
 
+/* Live HRV snapshot from the streaming engine */
+struct hpi_hrv_live_t
+{
+  uint32_t count;         // Accepted R-R intervals
+  float mean;             // ms
+  float sdnn;             // ms
+  float rmssd;            // ms
+  float pnn50;            // %
+  uint16_t min;           // ms
+  uint16_t max;           // ms
+  float lf_power;         // ms^2
+  float hf_power;         // ms^2
+  bool psd_valid;         // false until enough data for an LF/HF estimate
+};
+
 float hrv_calculate_mean(uint16_t * rr_buffer, int count);
 float hrv_calculate_sdnn(uint16_t * rr_buffer, int count);
 float hrv_calculate_pnn50(uint16_t * rr_buffer, int count);
 uint32_t hrv_calculate_min(uint16_t * rr_buffer, int count);
 uint32_t hrv_calculate_max(uint16_t * rr_buffer, int count);
 void hpi_hrv_frequency_compact_update_spectrum(uint16_t *rr_intervals, int num_intervals);
+
+// Streaming engine: reset at the start of a measurement, add each accepted
+// R-R interval as it arrives, finalize once to publish and store the result.
+// gap_ms is the time since the previous accepted interval ended when beats
+// were dropped in between (0 when contiguous): successive differences
+// restart there and the spectral time axis skips the gap.
+void hpi_hrv_stream_reset(void);
+void hpi_hrv_stream_add(uint16_t rr_ms, uint32_t gap_ms);
+void hpi_hrv_stream_get(struct hpi_hrv_live_t *out);
+// Same snapshot without the spectral estimate (psd_valid false, LF/HF zero);
+// cheap enough to call on every display refresh.
+void hpi_hrv_stream_get_time_domain(struct hpi_hrv_live_t *out);
+void hpi_hrv_stream_finalize(void);
 float hpi_get_lf_hf_ratio(void);
\ No newline at end of file
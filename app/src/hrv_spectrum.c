@@ -0,0 +1,268 @@
+/*
+ * HealthyPi Move - HRV Spectral Estimators
+ *
+ * Streaming Welch and Lomb-Scargle LF/HF estimators, see hrv_spectrum.h.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "hrv_spectrum.h"
+
+#define HRV_WELCH_STEP (FFT_SIZE / 2)
+
+_Static_assert(FFT_SIZE == 64, "hrv_hann_window is generated for FFT_SIZE 64");
+_Static_assert((HRV_LOMB_BINS - 0.5f) * HRV_LOMB_DF >= HF_HIGH, "Lomb grid must cover the HF band");
+
+/* Symmetric Hann window, 0.5 * (1 - cos(2 pi i / (N - 1))) */
+static const float32_t hrv_hann_window[FFT_SIZE] = {
+    0.000000000f, 0.002484612f, 0.009913756f, 0.022213597f,
+    0.039261894f, 0.060889213f, 0.086880613f, 0.116977778f,
+    0.150881591f, 0.188255099f, 0.228726868f, 0.271894671f,
+    0.317329488f, 0.364579766f, 0.413175911f, 0.462634953f,
+    0.512465346f, 0.562171852f, 0.611260467f, 0.659243325f,
+    0.705643552f, 0.750000000f, 0.791871836f, 0.830842919f,
+    0.866525936f, 0.898566254f, 0.926645441f, 0.950484434f,
+    0.969846310f, 0.984538643f, 0.994415413f, 0.999378461f,
+    0.999378461f, 0.994415413f, 0.984538643f, 0.969846310f,
+    0.950484434f, 0.926645441f, 0.898566254f, 0.866525936f,
+    0.830842919f, 0.791871836f, 0.750000000f, 0.705643552f,
+    0.659243325f, 0.611260467f, 0.562171852f, 0.512465346f,
+    0.462634953f, 0.413175911f, 0.364579766f, 0.317329488f,
+    0.271894671f, 0.228726868f, 0.188255099f, 0.150881591f,
+    0.116977778f, 0.086880613f, 0.060889213f, 0.039261894f,
+    0.022213597f, 0.009913756f, 0.002484612f, 0.000000000f,
+};
+
+/* Sum of squared window coefficients */
+#define HRV_HANN_WINDOW_POWER 23.625f
+
+/* Shared scratch; callers are serialised */
+static arm_rfft_fast_instance_f32 hrv_rfft;
+static bool hrv_rfft_ready;
+static float32_t fft_scratch[FFT_SIZE];
+static float32_t fft_out[FFT_SIZE];
+
+static float32_t lomb_yc[HRV_LOMB_BINS];
+static float32_t lomb_ys[HRV_LOMB_BINS];
+static float32_t lomb_c2[HRV_LOMB_BINS];
+static float32_t lomb_s2[HRV_LOMB_BINS];
+
+/* Trapezoidal integration of a one-sided PSD (s^2/Hz) sampled every df, result in ms^2 */
+static float integrate_band_power(const float32_t *psd, uint32_t bins, float32_t df,
+                                  float32_t f_low, float32_t f_high)
+{
+    uint32_t idx_low = (uint32_t)roundf(f_low / df);
+    uint32_t idx_high = (uint32_t)roundf(f_high / df);
+
+    if (idx_high >= bins) {
+        idx_high = bins - 1;
+    }
+    if (idx_low >= idx_high) {
+        return 0.0f;
+    }
+
+    float32_t power = 0.0f;
+    for (uint32_t i = idx_low; i < idx_high; i++) {
+        power += (psd[i] + psd[i + 1]) * 0.5f * df;
+    }
+
+    return power * 1000000.0f;
+}
+
+/*
+ * Welch
+ */
+
+static void hrv_welch_add_segment(struct hrv_welch *w)
+{
+    float32_t mean;
+
+    arm_mean_f32(w->seg, FFT_SIZE, &mean);
+    for (uint32_t i = 0; i < FFT_SIZE; i++) {
+        fft_scratch[i] = (w->seg[i] - mean) * hrv_hann_window[i];
+    }
+
+    /* Packed output: [DC, Nyquist, re1, im1, re2, im2, ...] */
+    arm_rfft_fast_f32(&hrv_rfft, fft_scratch, fft_out, 0);
+
+    w->psd_acc[0] += fft_out[0] * fft_out[0];
+    for (uint32_t k = 1; k < HRV_WELCH_BINS; k++) {
+        float32_t re = fft_out[2 * k];
+        float32_t im = fft_out[2 * k + 1];
+        w->psd_acc[k] += re * re + im * im;
+    }
+    w->segments++;
+
+    /* Slide by half a segment */
+    memmove(w->seg, &w->seg[HRV_WELCH_STEP], sizeof(float32_t) * (FFT_SIZE - HRV_WELCH_STEP));
+    w->seg_fill = FFT_SIZE - HRV_WELCH_STEP;
+}
+
+void hrv_welch_reset(struct hrv_welch *w)
+{
+    if (!hrv_rfft_ready) {
+        arm_rfft_fast_init_f32(&hrv_rfft, FFT_SIZE);
+        hrv_rfft_ready = true;
+    }
+    memset(w, 0, sizeof(*w));
+}
+
+void hrv_welch_add(struct hrv_welch *w, float32_t rr_s, float32_t gap_s)
+{
+    if (w->beats++ == 0) {
+        w->t_prev = 0.0f;
+        w->v_prev = rr_s;
+        return;
+    }
+
+    /* Emit the 4 Hz grid samples between the previous beat and this one, interpolating over a gap */
+    float32_t t_cur = w->t_prev + w->v_prev + gap_s;
+    float32_t slope = (rr_s - w->v_prev) / (t_cur - w->t_prev);
+    float32_t t;
+
+    while ((t = w->n_resampled / INTERP_FS) <= t_cur) {
+        w->seg[w->seg_fill++] = w->v_prev + (t - w->t_prev) * slope;
+        if (w->seg_fill == FFT_SIZE) {
+            hrv_welch_add_segment(w);
+        }
+        w->n_resampled++;
+    }
+
+    w->t_prev = t_cur;
+    w->v_prev = rr_s;
+}
+
+bool hrv_welch_band_powers(const struct hrv_welch *w, float *lf, float *hf)
+{
+    float32_t psd[HRV_WELCH_BINS];
+
+    *lf = 0.0f;
+    *hf = 0.0f;
+    if (w->segments == 0) {
+        return false;
+    }
+
+    /* One-sided density: every bin but DC carries its negative-frequency twin */
+    float32_t scale = 2.0f / (w->segments * HRV_HANN_WINDOW_POWER * INTERP_FS);
+    arm_scale_f32(w->psd_acc, scale, psd, HRV_WELCH_BINS);
+    psd[0] *= 0.5f;
+
+    *lf = integrate_band_power(psd, HRV_WELCH_BINS, INTERP_FS / FFT_SIZE, LF_LOW, LF_HIGH);
+    *hf = integrate_band_power(psd, HRV_WELCH_BINS, INTERP_FS / FFT_SIZE, HF_LOW, HF_HIGH);
+
+    return true;
+}
+
+/*
+ * Lomb-Scargle
+ */
+
+void hrv_lomb_reset(struct hrv_lomb *l)
+{
+    l->n = 0;
+    l->t_next = 0.0f;
+}
+
+void hrv_lomb_add(struct hrv_lomb *l, float32_t rr_s, float32_t gap_s)
+{
+    if (l->n > 0) {
+        l->t_next += gap_s;
+    }
+    if (l->n < MAX_RR_INTERVALS) {
+        l->t[l->n] = l->t_next;
+        l->y[l->n] = rr_s;
+        l->n++;
+    }
+    l->t_next += rr_s;
+}
+
+bool hrv_lomb_band_powers(const struct hrv_lomb *l, float *lf, float *hf)
+{
+    float32_t psd[HRV_LOMB_BINS];
+    uint32_t n = l->n;
+
+    *lf = 0.0f;
+    *hf = 0.0f;
+    if (n < HRV_LOMB_MIN_BEATS) {
+        return false;
+    }
+
+    float32_t mean;
+    arm_mean_f32(l->y, n, &mean);
+
+    memset(lomb_yc, 0, sizeof(lomb_yc));
+    memset(lomb_ys, 0, sizeof(lomb_ys));
+    memset(lomb_c2, 0, sizeof(lomb_c2));
+    memset(lomb_s2, 0, sizeof(lomb_s2));
+
+    /*
+     * For each beat walk the grid w_k = k * dw with the rotation
+     * (c, s) <- (c cd - s sd, s cd + c sd), accumulating
+     *   yc = sum y cos(wt), ys = sum y sin(wt),
+     *   c2 = sum cos(2wt),  s2 = sum sin(2wt).
+     */
+    for (uint32_t i = 0; i < n; i++) {
+        float32_t y = l->y[i] - mean;
+        float32_t a = 2.0f * PI * HRV_LOMB_DF * (l->t[i] - l->t[0]);
+        float32_t cd = arm_cos_f32(a);
+        float32_t sd = arm_sin_f32(a);
+        float32_t c = cd;
+        float32_t s = sd;
+
+        for (uint32_t k = 1; k < HRV_LOMB_BINS; k++) {
+            lomb_yc[k] += y * c;
+            lomb_ys[k] += y * s;
+            lomb_c2[k] += c * c - s * s;
+            lomb_s2[k] += 2.0f * c * s;
+
+            float32_t c_next = c * cd - s * sd;
+            s = s * cd + c * sd;
+            c = c_next;
+        }
+    }
+
+    /*
+     * With tan(2 w tau) = s2 / c2 and h = |(c2, s2)|:
+     *   sum cos^2(w(t - tau)) = (n + h) / 2, sum sin^2 = (n - h) / 2
+     * P(w) = 1/2 [ (yc cos + ys sin)^2 / cc + (ys cos - yc sin)^2 / ss ]
+     * Scaled by 2 / fs_mean (fs_mean = n / T) to a one-sided density in
+     * s^2/Hz, which matches the Welch scaling for evenly spaced beats.
+     */
+    float32_t span = l->t_next - l->t[0];
+    float32_t psd_scale = 2.0f * span / (float32_t)n;
+
+    psd[0] = 0.0f;
+    for (uint32_t k = 1; k < HRV_LOMB_BINS; k++) {
+        float32_t h;
+        arm_sqrt_f32(lomb_c2[k] * lomb_c2[k] + lomb_s2[k] * lomb_s2[k], &h);
+
+        float32_t cos_tau = 1.0f;
+        float32_t sin_tau = 0.0f;
+        if (h > 0.0f) {
+            float32_t cos_2tau = lomb_c2[k] / h;
+            arm_sqrt_f32(0.5f * (1.0f + cos_2tau), &cos_tau);
+            arm_sqrt_f32(0.5f * (1.0f - cos_2tau), &sin_tau);
+            if (lomb_s2[k] < 0.0f) {
+                sin_tau = -sin_tau;
+            }
+        }
+
+        float32_t cc = 0.5f * (n + h);
+        float32_t ss = 0.5f * (n - h);
+        float32_t yc = lomb_yc[k] * cos_tau + lomb_ys[k] * sin_tau;
+        float32_t ys = lomb_ys[k] * cos_tau - lomb_yc[k] * sin_tau;
+
+        float32_t p = (cc > 0.0f ? yc * yc / cc : 0.0f) + (ss > 0.0f ? ys * ys / ss : 0.0f);
+        psd[k] = 0.5f * p * psd_scale;
+    }
+
+    *lf = integrate_band_power(psd, HRV_LOMB_BINS, HRV_LOMB_DF, LF_LOW, LF_HIGH);
+    *hf = integrate_band_power(psd, HRV_LOMB_BINS, HRV_LOMB_DF, HF_LOW, HF_HIGH);
+
+    return true;
+}
@@ -0,0 +1,69 @@
+/*
+ * HealthyPi Move - HRV Spectral Estimators
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hrv_algos.h"
+
+/*
+ * Two interchangeable LF/HF estimators fed one R-R interval (seconds) at a
+ * time. Beat n is placed at the sum of the intervals before it, plus gap_s
+ * for any dropped intervals, so rejected beats do not compress the time axis.
+ *
+ * Welch: the tachogram is linearly resampled to INTERP_FS and every
+ * FFT_SIZE / 2 new samples a Hann-windowed, mean-removed FFT_SIZE segment is
+ * added to a running periodogram (50% overlap).
+ *
+ * Lomb-Scargle: the beats are kept as-is and the periodogram is evaluated
+ * directly on the uneven series over a fixed HRV_LOMB_DF grid up to HF_HIGH,
+ * in the Press-Rybicki form (time offset tau from the sin/cos 2wt sums).
+ * The per-beat cos/sin across the grid come from a rotation recurrence, so
+ * each estimate costs two trig calls per beat.
+ *
+ * Both return one-sided band powers in ms^2. Neither is thread safe; the
+ * caller serialises access. This file has no Zephyr dependencies so
+ * tools/hrv_psd_bench can build it on the host.
+ */
+
+#define HRV_WELCH_BINS      (FFT_SIZE / 2)
+
+#define HRV_LOMB_DF         0.005f  /* Frequency grid spacing (Hz) */
+#define HRV_LOMB_BINS       81      /* 0 .. HF_HIGH inclusive */
+#define HRV_LOMB_MIN_BEATS  16      /* Fewer beats than this gives no estimate */
+
+struct hrv_welch
+{
+    float t_prev;               /* Time of the previous beat (s) */
+    float v_prev;               /* Previous interval (s) */
+    uint32_t beats;
+    uint32_t n_resampled;       /* Grid samples emitted so far */
+    float32_t seg[FFT_SIZE];
+    uint32_t seg_fill;
+    float32_t psd_acc[HRV_WELCH_BINS];
+    uint32_t segments;
+};
+
+struct hrv_lomb
+{
+    float32_t t[MAX_RR_INTERVALS];  /* Beat times (s) */
+    float32_t y[MAX_RR_INTERVALS];  /* Intervals (s) */
+    uint32_t n;
+    float t_next;                   /* Time of the next beat (s) */
+};
+
+void hrv_welch_reset(struct hrv_welch *w);
+void hrv_welch_add(struct hrv_welch *w, float32_t rr_s, float32_t gap_s);
+/* Returns false (and zero powers) until the first segment is complete */
+bool hrv_welch_band_powers(const struct hrv_welch *w, float *lf, float *hf);
+
+void hrv_lomb_reset(struct hrv_lomb *l);
+void hrv_lomb_add(struct hrv_lomb *l, float32_t rr_s, float32_t gap_s);
+/* Returns false (and zero powers) below HRV_LOMB_MIN_BEATS */
+bool hrv_lomb_band_powers(const struct hrv_lomb *l, float *lf, float *hf);
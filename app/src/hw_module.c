@@ -76,6 +76,8 @@
 #include "hw_module.h"
 #include "battery_module.h"
 #include "fs_module.h"
+#include "log_module.h"
+#include "hpi_measurement_settings.h"
 #include "ui/move_ui.h"
 #include "hpi_common_types.h"
 #include "ble_module.h"
@@ -321,6 +323,8 @@ static void gpio_keys_cb_handler(struct input_event *evt, void *user_data)
             break;
         case INPUT_KEY_HOME:
             LOG_INF("Extra Key Pressed");
+            log_trend_flush_all();
+            hpi_meas_flush();
             sys_reboot(SYS_REBOOT_COLD);
             // printk("Entering Ship Mode\n");
             // regulator_parent_ship_mode(regulators);
@@ -751,6 +755,7 @@ void hw_module_init(void)
     }
 
     fs_module_init();
+    log_trend_init();
 
 #if defined(CONFIG_HPI_RECORDING_MODULE)
     hpi_recording_init();
@@ -0,0 +1,120 @@
+/*
+ * HealthyPi Move - IMU Module
+ *
+ * BMI323 accelerometer/gyroscope capture for background recording. The
+ * sensor buffers frames in its own FIFO at 100 Hz, so sample timing comes
+ * from the IMU clock; this thread only empties the FIFO periodically and
+ * hands the frames to the recorder.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/logging/log.h>
+
+#include "bmi323_hpi.h"
+#include "recording_module.h"
+#include "hpi_sys.h"
+
+LOG_MODULE_REGISTER(imu_module, LOG_LEVEL_DBG);
+
+#define IMU_THREAD_STACKSIZE 1536
+#define IMU_THREAD_PRIORITY 7
+
+// Frames drained per poll; the BMI323 FIFO holds ~170 accel+gyro frames
+#define IMU_FIFO_MAX_FRAMES 32
+// Recorder API accepts at most 16 samples per call
+#define IMU_REC_CHUNK 16
+
+static const struct device *const imu_dev = DEVICE_DT_GET(DT_NODELABEL(bmi323));
+
+K_SEM_DEFINE(sem_imu_bg_start, 0, 1);
+static atomic_t g_imu_bg_active = ATOMIC_INIT(0);
+
+static int16_t imu_acc[IMU_FIFO_MAX_FRAMES * 3];
+static int16_t imu_gyr[IMU_FIFO_MAX_FRAMES * 3];
+static int16_t imu_x[IMU_REC_CHUNK];
+static int16_t imu_y[IMU_REC_CHUNK];
+static int16_t imu_z[IMU_REC_CHUNK];
+
+static void imu_push_axis_chunks(const int16_t *xyz, int frames, bool gyro)
+{
+    for (int base = 0; base < frames; base += IMU_REC_CHUNK)
+    {
+        int n = MIN(IMU_REC_CHUNK, frames - base);
+
+        for (int i = 0; i < n; i++)
+        {
+            imu_x[i] = xyz[(base + i) * 3 + 0];
+            imu_y[i] = xyz[(base + i) * 3 + 1];
+            imu_z[i] = xyz[(base + i) * 3 + 2];
+        }
+
+        if (gyro)
+        {
+            hpi_rec_add_imu_gyro_samples(imu_x, imu_y, imu_z, n);
+        }
+        else
+        {
+            hpi_rec_add_imu_accel_samples(imu_x, imu_y, imu_z, n);
+        }
+    }
+}
+
+void imu_background_start(void)
+{
+    if (atomic_cas(&g_imu_bg_active, 0, 1))
+    {
+        LOG_INF("IMU background START");
+        k_sem_give(&sem_imu_bg_start);
+    }
+}
+
+void imu_background_stop(void)
+{
+    if (atomic_cas(&g_imu_bg_active, 1, 0))
+    {
+        LOG_INF("IMU background STOP");
+    }
+}
+
+static void imu_thread(void)
+{
+    if (!device_is_ready(imu_dev))
+    {
+        LOG_ERR("IMU device not ready, background capture disabled");
+        return;
+    }
+
+    for (;;)
+    {
+        k_sem_take(&sem_imu_bg_start, K_FOREVER);
+
+        if (bmi323_hpi_fifo_start(imu_dev) < 0)
+        {
+            atomic_set(&g_imu_bg_active, 0);
+            continue;
+        }
+
+        while (atomic_get(&g_imu_bg_active))
+        {
+            k_sleep(K_MSEC(CONFIG_HPI_IMU_FIFO_POLL_MS));
+
+            int frames = bmi323_hpi_fifo_read(imu_dev, imu_acc, imu_gyr, IMU_FIFO_MAX_FRAMES);
+            if (frames <= 0)
+            {
+                continue;
+            }
+
+            imu_push_axis_chunks(imu_acc, frames, false);
+            imu_push_axis_chunks(imu_gyr, frames, true);
+        }
+
+        bmi323_hpi_fifo_stop(imu_dev);
+    }
+}
+
+K_THREAD_DEFINE(imu_thread_id, IMU_THREAD_STACKSIZE, imu_thread, NULL, NULL, NULL, IMU_THREAD_PRIORITY, 0, 1000);
@@ -35,6 +35,8 @@
 
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/littlefs.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/linker/section_tags.h>
 #include <time.h>
 
 #include "log_module.h"
@@ -71,6 +73,7 @@ static const char* const log_paths[] = {
     [HPI_LOG_TYPE_TREND_TEMP] = "/lfs/trtemp/",
     [HPI_LOG_TYPE_TREND_STEPS] = "/lfs/trsteps/",
     [HPI_LOG_TYPE_TREND_BPT] = "/lfs/trbpt/",
+    [HPI_LOG_TYPE_TREND_GSR] = "/lfs/trgsr/",
     [HPI_LOG_TYPE_ECG_RECORD] = "/lfs/ecg/",
     [HPI_LOG_TYPE_BIOZ_RECORD] = "/lfs/bioz/",
     [HPI_LOG_TYPE_PPG_WRIST_RECORD] = "/lfs/ppgw/",
@@ -192,34 +195,286 @@ void hpi_write_hrv_record_file(const uint16_t *hrv_record_buffer, uint16_t hrv_r
                         hrv_record_length * sizeof(uint16_t), start_ts);
 }
 
+/*
+ * Trend write-behind
+ *
+ * Trend points arrive about once a minute per signal. Instead of an
+ * open/write/sync/close per point, each trend type collects points for its
+ * current day file in a RAM batch that is appended to flash in one go when
+ * it fills, when it is older than CONFIG_HPI_TREND_WB_FLUSH_INTERVAL_S, when
+ * the day changes, before the file is read back, or on shutdown.
+ *
+ * The batches live in .noinit RAM with a magic and CRC, so they double as a
+ * journal: after a watchdog, fault or software reset log_trend_init() finds
+ * the batches that were not committed yet and writes them out. Power loss
+ * clears RAM; the low-battery shutdown path flushes before the PMIC cuts it.
+ */
+#define TREND_WB_MAGIC 0x54574231 // "TWB1"
+#define TREND_WB_COUNT (HPI_LOG_TYPE_TREND_GSR - HPI_LOG_TYPE_TREND_HR + 1)
+
+struct trend_wb_batch {
+    uint32_t magic;
+    uint8_t log_type;
+    uint16_t len;
+    int64_t day_ts;
+    uint32_t crc;  // CRC-32 of data[0..len)
+    uint8_t data[CONFIG_HPI_TREND_WB_BATCH_BYTES];
+};
+
+static __noinit struct trend_wb_batch trend_wb[TREND_WB_COUNT];
+static int64_t trend_wb_first_ms[TREND_WB_COUNT];
+static bool trend_wb_ready;
+static struct hpi_trend_wb_stats_t trend_wb_stats;
+
+K_MUTEX_DEFINE(mutex_trend_wb);
+
+static inline int trend_wb_index(uint8_t log_type)
+{
+    if (log_type < HPI_LOG_TYPE_TREND_HR || log_type > HPI_LOG_TYPE_TREND_GSR) {
+        return -1;
+    }
+    return log_type - HPI_LOG_TYPE_TREND_HR;
+}
+
+static void trend_wb_clear(int idx)
+{
+    struct trend_wb_batch *b = &trend_wb[idx];
+
+    b->magic = TREND_WB_MAGIC;
+    b->log_type = HPI_LOG_TYPE_TREND_HR + idx;
+    b->len = 0;
+    b->day_ts = 0;
+    b->crc = 0;
+    trend_wb_first_ms[idx] = 0;
+}
+
+// Append one batch to its day file. Caller holds mutex_trend_wb.
+static int trend_wb_commit(int idx)
+{
+    struct trend_wb_batch *b = &trend_wb[idx];
+
+    if (b->len == 0) {
+        return 0;
+    }
+
+    uint32_t t0 = k_cycle_get_32();
+    int ret = write_trend_to_file(b->log_type, b->data, b->len, b->day_ts);
+    uint32_t commit_us = k_cyc_to_us_floor32(k_cycle_get_32() - t0);
+
+    if (ret < 0) {
+        trend_wb_stats.write_errors++;
+        return ret;
+    }
+
+    trend_wb_stats.commits++;
+    trend_wb_stats.bytes_written += b->len;
+    trend_wb_stats.max_commit_us = MAX(trend_wb_stats.max_commit_us, commit_us);
+    LOG_DBG("Trend %d: committed %u bytes in %u us", b->log_type, b->len, commit_us);
+
+    trend_wb_clear(idx);
+    return 0;
+}
+
+static void trend_wb_append(uint8_t log_type, const void *data, size_t data_size, int64_t day_ts)
+{
+    int idx = trend_wb_index(log_type);
+
+    if (idx < 0 || data_size > CONFIG_HPI_TREND_WB_BATCH_BYTES) {
+        return;
+    }
+
+    if (!is_timestamp_valid(day_ts)) {
+        LOG_ERR("Invalid timestamp: %" PRId64, day_ts);
+        return;
+    }
+
+    k_mutex_lock(&mutex_trend_wb, K_FOREVER);
+
+    if (!trend_wb_ready) {
+        // Journal not validated yet (file system still mounting) - write through
+        k_mutex_unlock(&mutex_trend_wb);
+        write_trend_to_file(log_type, data, data_size, day_ts);
+        return;
+    }
+
+    struct trend_wb_batch *b = &trend_wb[idx];
+
+    // A batch only ever holds points for one day file
+    bool day_change = (b->len > 0 && b->day_ts != day_ts);
+
+    if (day_change || b->len + data_size > sizeof(b->data)) {
+        if (day_change) {
+            trend_wb_stats.commits_forced++;
+        } else {
+            trend_wb_stats.commits_full++;
+        }
+        if (trend_wb_commit(idx) < 0) {
+            // Flash keeps failing; drop the old batch rather than block the caller
+            trend_wb_stats.dropped_bytes += b->len;
+            trend_wb_clear(idx);
+        }
+    }
+
+    if (b->len == 0) {
+        b->day_ts = day_ts;
+        trend_wb_first_ms[idx] = k_uptime_get();
+    }
+
+    // Data first, then CRC, then length. These are separate stores: a reset between
+    // the last two leaves a CRC that does not match len, and recovery discards the
+    // batch instead of replaying it. A reset before the CRC store keeps the old batch.
+    memcpy(&b->data[b->len], data, data_size);
+    b->crc = crc32_ieee_update(b->crc, &b->data[b->len], data_size);
+    b->len += data_size;
+
+    trend_wb_stats.points++;
+
+    k_mutex_unlock(&mutex_trend_wb);
+}
+
+void log_trend_init(void)
+{
+    k_mutex_lock(&mutex_trend_wb, K_FOREVER);
+
+    for (int i = 0; i < TREND_WB_COUNT; i++) {
+        struct trend_wb_batch *b = &trend_wb[i];
+
+        if (b->magic == TREND_WB_MAGIC && b->log_type == HPI_LOG_TYPE_TREND_HR + i &&
+            b->len > 0 && b->len <= sizeof(b->data) &&
+            b->crc == crc32_ieee(b->data, b->len)) {
+            LOG_INF("Trend %d: recovering %u bytes from journal", b->log_type, b->len);
+            trend_wb_stats.replayed_bytes += b->len;
+            trend_wb_commit(i);
+        }
+
+        trend_wb_clear(i);
+    }
+
+    trend_wb_ready = true;
+
+    k_mutex_unlock(&mutex_trend_wb);
+}
+
+int log_trend_flush(uint8_t log_type)
+{
+    int idx = trend_wb_index(log_type);
+    int ret = 0;
+
+    if (idx < 0) {
+        return 0;
+    }
+
+    k_mutex_lock(&mutex_trend_wb, K_FOREVER);
+    if (trend_wb_ready && trend_wb[idx].len > 0) {
+        trend_wb_stats.commits_forced++;
+        ret = trend_wb_commit(idx);
+    }
+    k_mutex_unlock(&mutex_trend_wb);
+
+    return ret;
+}
+
+int log_trend_flush_all(void)
+{
+    int ret = 0;
+
+    for (uint8_t t = HPI_LOG_TYPE_TREND_HR; t <= HPI_LOG_TYPE_TREND_GSR; t++) {
+        int r = log_trend_flush(t);
+        if (r < 0) {
+            ret = r;
+        }
+    }
+
+    return ret;
+}
+
+void log_trend_poll(void)
+{
+    if (CONFIG_HPI_TREND_WB_FLUSH_INTERVAL_S == 0) {
+        return;
+    }
+
+    int64_t now = k_uptime_get();
+
+    k_mutex_lock(&mutex_trend_wb, K_FOREVER);
+    for (int i = 0; trend_wb_ready && i < TREND_WB_COUNT; i++) {
+        if (trend_wb[i].len > 0 &&
+            now - trend_wb_first_ms[i] >= CONFIG_HPI_TREND_WB_FLUSH_INTERVAL_S * 1000LL) {
+            trend_wb_stats.commits_timer++;
+            trend_wb_commit(i);
+        }
+    }
+    k_mutex_unlock(&mutex_trend_wb);
+}
+
+// Drop pending points whose day file is being deleted
+static void trend_wb_discard(uint8_t log_type, int64_t day_ts, bool any_day)
+{
+    int idx = trend_wb_index(log_type);
+
+    if (idx < 0) {
+        return;
+    }
+
+    k_mutex_lock(&mutex_trend_wb, K_FOREVER);
+    if (trend_wb_ready && (any_day || trend_wb[idx].day_ts == day_ts)) {
+        trend_wb_clear(idx);
+    }
+    k_mutex_unlock(&mutex_trend_wb);
+}
+
+void log_trend_get_stats(struct hpi_trend_wb_stats_t *stats)
+{
+    k_mutex_lock(&mutex_trend_wb, K_FOREVER);
+    *stats = trend_wb_stats;
+    stats->pending_bytes = 0;
+    for (int i = 0; i < TREND_WB_COUNT; i++) {
+        stats->pending_bytes += trend_wb_ready ? trend_wb[i].len : 0;
+    }
+    k_mutex_unlock(&mutex_trend_wb);
+}
+
+void log_trend_reset_stats(void)
+{
+    k_mutex_lock(&mutex_trend_wb, K_FOREVER);
+    memset(&trend_wb_stats, 0, sizeof(trend_wb_stats));
+    k_mutex_unlock(&mutex_trend_wb);
+}
+
 void hpi_hr_trend_wr_point_to_file(struct hpi_hr_trend_point_t m_trend_point, int64_t day_ts)
 {
-    write_trend_to_file(HPI_LOG_TYPE_TREND_HR, &m_trend_point, 
-                       sizeof(m_trend_point), day_ts);
+    trend_wb_append(HPI_LOG_TYPE_TREND_HR, &m_trend_point, 
+                    sizeof(m_trend_point), day_ts);
 }
 
 void hpi_spo2_trend_wr_point_to_file(struct hpi_spo2_point_t m_spo2_point, int64_t day_ts)
 {
-    write_trend_to_file(HPI_LOG_TYPE_TREND_SPO2, &m_spo2_point, 
-                       sizeof(m_spo2_point), day_ts);
+    trend_wb_append(HPI_LOG_TYPE_TREND_SPO2, &m_spo2_point, 
+                    sizeof(m_spo2_point), day_ts);
 }
 
 void hpi_bpt_trend_wr_point_to_file(struct hpi_bpt_point_t m_bpt_point, int64_t day_ts)
 {
-    write_trend_to_file(HPI_LOG_TYPE_TREND_BPT, &m_bpt_point, 
-                       sizeof(m_bpt_point), day_ts);
+    trend_wb_append(HPI_LOG_TYPE_TREND_BPT, &m_bpt_point, 
+                    sizeof(m_bpt_point), day_ts);
+}
+
+void hpi_gsr_trend_wr_point_to_file(struct hpi_gsr_trend_point_t m_gsr_point, int64_t day_ts)
+{
+    trend_wb_append(HPI_LOG_TYPE_TREND_GSR, &m_gsr_point,
+                    sizeof(m_gsr_point), day_ts);
 }
 
 void hpi_temp_trend_wr_point_to_file(struct hpi_temp_trend_point_t m_temp_point, int64_t day_ts)
 {
-    write_trend_to_file(HPI_LOG_TYPE_TREND_TEMP, &m_temp_point, 
-                       sizeof(m_temp_point), day_ts);
+    trend_wb_append(HPI_LOG_TYPE_TREND_TEMP, &m_temp_point, 
+                    sizeof(m_temp_point), day_ts);
 }
 
 void hpi_steps_trend_wr_point_to_file(struct hpi_steps_t m_steps_point, int64_t day_ts)
 {
-    write_trend_to_file(HPI_LOG_TYPE_TREND_STEPS, &m_steps_point, 
-                       sizeof(m_steps_point), day_ts);
+    trend_wb_append(HPI_LOG_TYPE_TREND_STEPS, &m_steps_point, 
+                    sizeof(m_steps_point), day_ts);
 }
 
 // Generic directory iterator function to reduce duplication
@@ -242,6 +497,9 @@ static int iterate_directory(uint8_t log_type, dir_operation_t operation)
         return -EINVAL;
     }
 
+    // Pending trend points may create today's file or change its size
+    log_trend_flush(log_type);
+
     res = fs_opendir(&dirp, m_path);
     if (res) {
         LOG_ERR("Error opening dir %s [%d]", m_path, res);
@@ -313,12 +571,12 @@ int log_get_index(uint8_t m_log_type)
     return iterate_directory(m_log_type, DIR_OP_INDEX);
 }
 
-void log_get(uint8_t log_type, int64_t file_id)
+void log_get_range(uint8_t log_type, int64_t file_id, uint32_t offset, uint32_t length)
 {
     char base_path[HPI_LOG_PATH_MAX];
     char file_path[HPI_LOG_FNAME_MAX];
 
-    LOG_DBG("Getting Log type %d, File ID %" PRId64, log_type, file_id);
+    LOG_DBG("Getting Log type %d, File ID %" PRId64 " from %u (%u bytes)", log_type, file_id, offset, length);
 
     if (hpi_log_get_path(base_path, sizeof(base_path), log_type) != 0) {
         LOG_ERR("Failed to get path for log type %d", log_type);
@@ -326,7 +584,13 @@ void log_get(uint8_t log_type, int64_t file_id)
     }
 
     snprintf(file_path, sizeof(file_path), "%s%" PRId64, base_path, file_id);
-    transfer_send_file(file_path);
+    log_trend_flush(log_type);
+    transfer_send_file_range(file_path, offset, length);
+}
+
+void log_get(uint8_t log_type, int64_t file_id)
+{
+    log_get_range(log_type, file_id, 0, 0);
 }
 
 void log_delete(uint16_t file_id)
@@ -351,7 +615,9 @@ void log_delete_by_timestamp(uint8_t log_type, int64_t timestamp)
 
     snprintf(file_path, sizeof(file_path), "%s%" PRId64, base_path, timestamp);
     LOG_DBG("Deleting %s", file_path);
+    trend_wb_discard(log_type, timestamp, false);
     fs_unlink(file_path);
+    hpi_trend_rollup_remove(log_type, timestamp);
 }
 
 void log_wipe_folder(const char *folder_path)
@@ -413,6 +679,7 @@ static void wipe_log_types(const uint8_t *log_types, size_t count, const char *d
     LOG_DBG("Wiping %s", description);
 
     for (size_t i = 0; i < count; i++) {
+        trend_wb_discard(log_types[i], 0, true);
         if (hpi_log_get_path(log_file_name, sizeof(log_file_name), log_types[i]) == 0) {
             log_wipe_folder(log_file_name);
         }
@@ -427,12 +694,14 @@ void log_wipe_trends(void)
         HPI_LOG_TYPE_TREND_TEMP,
         HPI_LOG_TYPE_TREND_STEPS,
         HPI_LOG_TYPE_TREND_BPT,
+        HPI_LOG_TYPE_TREND_GSR,
         HPI_LOG_TYPE_ECG_RECORD,
         HPI_LOG_TYPE_GSR_RECORD, 
         HPI_LOG_TYPE_HRV_RECORD,
     };
     
     wipe_log_types(trend_types, sizeof(trend_types), "all trend logs");
+    log_wipe_folder("/lfs/trsum/");
     hpi_recording_wipe_all(); // To delete research recording files
     /* Legacy file removed - measurement data now stored via Zephyr settings subsystem */
     hpi_disp_reset_all_last_updated();
@@ -40,6 +40,7 @@ enum hpi_log_types
     HPI_LOG_TYPE_TREND_TEMP,
     HPI_LOG_TYPE_TREND_STEPS,
     HPI_LOG_TYPE_TREND_BPT,
+    HPI_LOG_TYPE_TREND_GSR,
     
     HPI_LOG_TYPE_ECG_RECORD = 0x10,
     HPI_LOG_TYPE_BIOZ_RECORD,
@@ -49,6 +50,22 @@ enum hpi_log_types
     HPI_LOG_TYPE_HRV_RECORD,
 };
 
+/* Trend write-behind counters (see log_trend_get_stats) */
+struct hpi_trend_wb_stats_t
+{
+    uint32_t points;         // Trend points accepted
+    uint32_t commits;        // Batches appended to flash
+    uint32_t commits_full;   // ...because the batch was full
+    uint32_t commits_timer;  // ...because the batch aged out
+    uint32_t commits_forced; // ...for a day change, read-back or shutdown
+    uint32_t bytes_written;
+    uint32_t write_errors;
+    uint32_t dropped_bytes;  // Discarded after repeated write failures
+    uint32_t replayed_bytes; // Recovered from the RAM journal at boot
+    uint32_t max_commit_us;
+    uint32_t pending_bytes;  // Currently buffered in RAM
+};
+
 char* log_get_current_session_id_str(void);
 void log_session_add_point(uint16_t time, int16_t current, uint16_t impedance);
 //void log_write_to_file(struct tes_session_log_t *m_session_log);
@@ -58,16 +75,25 @@ void log_wipe_records(uint8_t recording_type);
 
 void log_delete(uint16_t session_id);
 void log_get(uint8_t log_type, int64_t file_id);
+void log_get_range(uint8_t log_type, int64_t file_id, uint32_t offset, uint32_t length);
 void log_delete_by_timestamp(uint8_t log_type, int64_t timestamp);
 int log_get_index(uint8_t m_log_type);
 void log_seq_init(void);
 uint16_t log_get_count(uint8_t m_log_type);
 
+void log_trend_init(void);
+void log_trend_poll(void);
+int log_trend_flush(uint8_t log_type);
+int log_trend_flush_all(void);
+void log_trend_get_stats(struct hpi_trend_wb_stats_t *stats);
+void log_trend_reset_stats(void);
+
 void hpi_hr_trend_wr_point_to_file(struct hpi_hr_trend_point_t m_hr_trend_point, int64_t day_ts);
 void hpi_spo2_trend_wr_point_to_file(struct hpi_spo2_point_t m_spo2_point, int64_t day_ts);
 void hpi_temp_trend_wr_point_to_file(struct hpi_temp_trend_point_t m_temp_point, int64_t day_ts);
 void hpi_steps_trend_wr_point_to_file(struct hpi_steps_t m_steps_point, int64_t day_ts);
 void hpi_bpt_trend_wr_point_to_file(struct hpi_bpt_point_t m_bpt_point, int64_t day_ts);
+void hpi_gsr_trend_wr_point_to_file(struct hpi_gsr_trend_point_t m_gsr_point, int64_t day_ts);
 
 void hpi_write_ecg_record_file(const int32_t *ecg_record_buffer, uint16_t ecg_record_length, int64_t start_ts);
 void hpi_write_gsr_record_file(const int32_t *samples, uint16_t num_samples, int64_t timestamp);
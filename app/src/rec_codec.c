@@ -0,0 +1,205 @@
+/*
+ * HealthyPi Move - Recording Block Codec
+ *
+ * Lossless delta + Rice coding for recorded sensor blocks (HPIR v2).
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include "rec_codec.h"
+
+#define REC_CODEC_MAX_ORDER 2
+#define REC_CODEC_MAX_K     30
+
+struct bit_writer {
+    uint8_t *buf;
+    size_t cap;
+    size_t byte;
+    uint8_t bit;        /* Bits already used in buf[byte], MSB first */
+    bool overflow;
+};
+
+static void bw_put_bit(struct bit_writer *bw, uint32_t v)
+{
+    if (bw->byte >= bw->cap) {
+        bw->overflow = true;
+        return;
+    }
+    if (bw->bit == 0) {
+        bw->buf[bw->byte] = 0;
+    }
+    if (v) {
+        bw->buf[bw->byte] |= (uint8_t)(0x80 >> bw->bit);
+    }
+    if (++bw->bit == 8) {
+        bw->bit = 0;
+        bw->byte++;
+    }
+}
+
+static void bw_put_bits(struct bit_writer *bw, uint64_t v, uint8_t n)
+{
+    while (n-- > 0 && !bw->overflow) {
+        bw_put_bit(bw, (uint32_t)((v >> n) & 1U));
+    }
+}
+
+static void bw_align(struct bit_writer *bw)
+{
+    if (bw->bit != 0) {
+        bw->bit = 0;
+        bw->byte++;
+    }
+}
+
+static inline int32_t read_sample(const uint8_t *p, uint8_t width)
+{
+    return (width == 2) ? (int16_t)sys_get_le16(p) : (int32_t)sys_get_le32(p);
+}
+
+static inline uint64_t zigzag64(int64_t r)
+{
+    return ((uint64_t)r << 1) ^ (uint64_t)(r >> 63);
+}
+
+static inline int64_t residual(const int32_t *x, int i, uint8_t order)
+{
+    switch (order) {
+    case 0:
+        return x[i];
+    case 1:
+        return (int64_t)x[i] - x[i - 1];
+    default:
+        return (int64_t)x[i] - 2 * (int64_t)x[i - 1] + x[i - 2];
+    }
+}
+
+/* Pick the fixed predictor with the smallest residual sum, then a Rice parameter for it */
+static void choose_params(const int32_t *x, uint16_t n, uint8_t *order_out, uint8_t *k_out)
+{
+    uint64_t best_sum = UINT64_MAX;
+    uint8_t best_order = 0;
+
+    for (uint8_t order = 0; order <= REC_CODEC_MAX_ORDER && order < n; order++) {
+        uint64_t sum = 0;
+        for (int i = order; i < n; i++) {
+            sum += zigzag64(residual(x, i, order));
+        }
+        if (sum < best_sum) {
+            best_sum = sum;
+            best_order = order;
+        }
+    }
+
+    uint16_t count = (n > best_order) ? (n - best_order) : 1;
+    uint8_t k = 0;
+    while (k < REC_CODEC_MAX_K && ((uint64_t)count << (k + 1)) < best_sum) {
+        k++;
+    }
+
+    *order_out = best_order;
+    *k_out = k;
+}
+
+static int encode_rice(const uint8_t *raw, uint16_t n, uint8_t channels, uint8_t width,
+                       uint8_t *out, size_t cap)
+{
+    static int32_t x[HPI_REC_BLOCK_MAX_SAMPLES];
+    size_t stride = (size_t)channels * width;
+    size_t pos = 0;
+
+    for (uint8_t c = 0; c < channels; c++) {
+        for (int i = 0; i < n; i++) {
+            x[i] = read_sample(&raw[i * stride + c * width], width);
+        }
+
+        uint8_t order, k;
+        choose_params(x, n, &order, &k);
+
+        if (pos + 2 + 4 * order > cap) {
+            return -ENOSPC;
+        }
+        out[pos++] = order;
+        out[pos++] = k;
+        for (int i = 0; i < order; i++) {
+            sys_put_le32((uint32_t)x[i], &out[pos]);
+            pos += 4;
+        }
+
+        struct bit_writer bw = {.buf = &out[pos], .cap = cap - pos};
+
+        for (int i = order; i < n && !bw.overflow; i++) {
+            uint64_t u = zigzag64(residual(x, i, order));
+            uint64_t q = u >> k;
+
+            if (q < HPI_REC_RICE_ESCAPE) {
+                for (uint64_t j = 0; j < q; j++) {
+                    bw_put_bit(&bw, 1);
+                }
+                bw_put_bit(&bw, 0);
+                bw_put_bits(&bw, u, k);
+            } else {
+                for (int j = 0; j < HPI_REC_RICE_ESCAPE; j++) {
+                    bw_put_bit(&bw, 1);
+                }
+                bw_put_bits(&bw, u, 64);
+            }
+        }
+        bw_align(&bw);
+
+        if (bw.overflow || bw.byte > bw.cap) {
+            return -ENOSPC;
+        }
+        pos += bw.byte;
+    }
+
+    return (int)pos;
+}
+
+int hpi_rec_encode_block(const uint8_t *raw, uint16_t num_samples, uint8_t channels,
+                         uint8_t width, uint32_t first_sample, uint8_t *out, size_t out_cap)
+{
+    if (num_samples == 0 || num_samples > HPI_REC_BLOCK_MAX_SAMPLES ||
+        channels == 0 || channels > HPI_REC_BLOCK_MAX_CHANNELS ||
+        (width != 2 && width != 4)) {
+        return -EINVAL;
+    }
+
+    size_t raw_len = (size_t)num_samples * channels * width;
+    if (out_cap < HPI_REC_BLOCK_HEADER_SIZE + raw_len) {
+        return -ENOSPC;
+    }
+
+    uint8_t *payload = &out[HPI_REC_BLOCK_HEADER_SIZE];
+    uint8_t codec = HPI_REC_CODEC_RICE;
+
+    /* Only keep the coded form if it beats the raw samples */
+    int len = encode_rice(raw, num_samples, channels, width, payload, raw_len);
+    if (len < 0) {
+        codec = HPI_REC_CODEC_RAW;
+        memcpy(payload, raw, raw_len);
+        len = (int)raw_len;
+    }
+
+    struct hpi_rec_block_header_t hdr = {
+        .sync = sys_cpu_to_le16(HPI_REC_BLOCK_SYNC),
+        .codec = codec,
+        .channels = channels,
+        .num_samples = sys_cpu_to_le16(num_samples),
+        .payload_len = sys_cpu_to_le16((uint16_t)len),
+        .first_sample = sys_cpu_to_le32(first_sample),
+        .crc32 = sys_cpu_to_le32(crc32_ieee(payload, len)),
+    };
+    memcpy(out, &hdr, sizeof(hdr));
+
+    return HPI_REC_BLOCK_HEADER_SIZE + len;
+}
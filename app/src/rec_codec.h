@@ -0,0 +1,75 @@
+/*
+ * HealthyPi Move - Recording Block Codec
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+
+/*
+ * HPIR v2 files carry the same 28-byte file header as v1 (version = 2),
+ * followed by a sequence of self-contained blocks:
+ *
+ *   struct hpi_rec_block_header_t  (16 bytes, little-endian)
+ *   payload                         (payload_len bytes)
+ *
+ * RAW payload: num_samples interleaved samples, identical to v1 data.
+ *
+ * RICE payload, for each channel in turn:
+ *   [order u8][k u8]                fixed predictor order (0-2), Rice parameter
+ *   order x int32 LE                warm-up samples
+ *   bitstream (MSB first)           (num_samples - order) residuals, zig-zag
+ *                                   mapped and Rice coded with parameter k;
+ *                                   a quotient of HPI_REC_RICE_ESCAPE ones is
+ *                                   followed by the raw 64-bit zig-zag value.
+ *                                   Padded to a byte boundary.
+ *
+ * Residuals follow the FLAC fixed predictors: order 1 is x[n] - x[n-1],
+ * order 2 is x[n] - 2x[n-1] + x[n-2], computed in 64 bits.
+ */
+
+#define HPI_REC_BLOCK_SYNC          0xB10C
+#define HPI_REC_CODEC_RAW           0
+#define HPI_REC_CODEC_RICE          1
+
+#define HPI_REC_BLOCK_MAX_SAMPLES   128
+#define HPI_REC_BLOCK_MAX_CHANNELS  3
+#define HPI_REC_RICE_ESCAPE         32
+
+struct hpi_rec_block_header_t {
+    uint16_t sync;              /* HPI_REC_BLOCK_SYNC */
+    uint8_t  codec;             /* HPI_REC_CODEC_* */
+    uint8_t  channels;
+    uint16_t num_samples;
+    uint16_t payload_len;
+    uint32_t first_sample;      /* Index of the first sample since session start */
+    uint32_t crc32;             /* CRC-32 (IEEE) of the payload */
+} __packed;
+
+#define HPI_REC_BLOCK_HEADER_SIZE   16
+
+/* Worst case block size for a given sample layout (RAW fallback) */
+#define HPI_REC_BLOCK_MAX_SIZE(sample_bytes) \
+    (HPI_REC_BLOCK_HEADER_SIZE + HPI_REC_BLOCK_MAX_SAMPLES * (sample_bytes))
+
+/**
+ * @brief Encode interleaved samples into one HPIR v2 block
+ * @param raw Interleaved little-endian signed samples, channels x width bytes each
+ * @param num_samples Number of samples (1..HPI_REC_BLOCK_MAX_SAMPLES)
+ * @param channels Channels per sample (1..HPI_REC_BLOCK_MAX_CHANNELS)
+ * @param width Bytes per channel value (2 or 4)
+ * @param first_sample Index of the first sample since session start
+ * @param out Output buffer, at least HPI_REC_BLOCK_MAX_SIZE(channels * width)
+ * @param out_cap Size of out
+ * @return Block length in bytes (header included), or negative error code
+ *
+ * Falls back to a RAW block whenever Rice coding would not be smaller.
+ */
+int hpi_rec_encode_block(const uint8_t *raw, uint16_t num_samples, uint8_t channels,
+                         uint8_t width, uint32_t first_sample, uint8_t *out, size_t out_cap);
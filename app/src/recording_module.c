@@ -21,6 +21,7 @@
 #include <time.h>
 
 #include "recording_module.h"
+#include "rec_codec.h"
 #include "cmd_module.h"
 #include "fs_module.h"
 #include "hw_module.h"
@@ -35,27 +36,142 @@ atomic_t g_recording_signal_mask = ATOMIC_INIT(0);
 /* Synchronization primitives */
 K_SEM_DEFINE(sem_rec_start, 0, 1);
 K_SEM_DEFINE(sem_rec_stop, 0, 1);
-K_SEM_DEFINE(sem_rec_flush, 0, 10);  /* Counted semaphore for flush requests */
+K_SEM_DEFINE(sem_rec_flush, 0, 10);  /* Counted semaphore for drain requests */
 K_MUTEX_DEFINE(mutex_rec_config);
 K_MUTEX_DEFINE(mutex_rec_state);
+K_MUTEX_DEFINE(mutex_rec_files);  /* Serialises writer and control thread access to open files */
 
 /* Current configuration and session state */
 static struct hpi_recording_config_t current_config;
 static struct hpi_recording_session_t current_session;
 static bool config_valid = false;
 
-/* Per-signal dual buffers */
+/* Write path statistics for the current/last session (protected by mutex_rec_state) */
+static struct {
+    uint32_t bytes_written;
+    uint32_t flushes;
+    uint32_t syncs;
+    uint32_t max_flush_us;
+    uint32_t max_sync_us;
+    int64_t  start_ms;
+    int64_t  end_ms;
+} rec_write_stats;
+
+/*
+ * Decimation uses a 3rd-order CIC (cascaded integrator-comb) filter per
+ * channel rather than dropping samples: its response has nulls at every
+ * multiple of the output rate, which is exactly where content would alias
+ * back into the kept band. Integer-only, any factor, and a few words of state
+ * per channel. Integrators wrap modulo 2^64; the comb differences undo the
+ * wrap, so the output is exact as long as it fits (gain R^3, R <= 16).
+ */
+#define REC_CIC_ORDER        3
+#define REC_MAX_CHANNELS     3
+
+struct rec_decimator {
+    uint64_t integ[REC_MAX_CHANNELS][REC_CIC_ORDER];
+    uint64_t comb[REC_MAX_CHANNELS][REC_CIC_ORDER];
+    uint8_t  phase;
+};
+
+/* Decimation factor for the running session, fixed while recording */
+static uint8_t rec_decimation = 1;
+
+/*
+ * Push one multi-channel input sample. Returns true and overwrites ch[] with
+ * the filtered output every rec_decimation inputs.
+ */
+static bool rec_decimate(struct rec_decimator *d, int32_t *ch, uint8_t nch)
+{
+    uint32_t r = rec_decimation;
+
+    if (r <= 1) {
+        return true;
+    }
+
+    for (int c = 0; c < nch; c++) {
+        uint64_t x = (uint64_t)(int64_t)ch[c];
+        for (int k = 0; k < REC_CIC_ORDER; k++) {
+            d->integ[c][k] += x;
+            x = d->integ[c][k];
+        }
+    }
+
+    if (++d->phase < r) {
+        return false;
+    }
+    d->phase = 0;
+
+    for (int c = 0; c < nch; c++) {
+        uint64_t y = d->integ[c][REC_CIC_ORDER - 1];
+        for (int k = 0; k < REC_CIC_ORDER; k++) {
+            uint64_t prev = d->comb[c][k];
+            d->comb[c][k] = y;
+            y -= prev;
+        }
+        /* Unity DC gain */
+        ch[c] = (int32_t)((int64_t)y / (int64_t)(r * r * r));
+    }
+
+    return true;
+}
+
+/*
+ * Per-signal single-producer/single-consumer byte rings. The data thread is
+ * the only producer and advances head; the writer (or the control thread at
+ * finalize, serialised by mutex_rec_files) is the only consumer and advances
+ * tail. Indices run freely and are masked on access, so head - tail is the fill
+ * level. A batch that does not fit is dropped whole and counted as an overrun
+ * rather than overwriting data that has not reached flash yet.
+ */
 struct rec_signal_buffer {
-    uint8_t  buffer_a[REC_BUFFER_SIZE];
-    uint8_t  buffer_b[REC_BUFFER_SIZE];
-    uint16_t write_idx;           /* Current write position in active buffer */
-    uint8_t  active_buffer;       /* 0 = A, 1 = B */
-    atomic_t flush_pending;       /* Buffer index ready to flush (0, 1, or -1 for none) */
-    uint32_t total_samples;       /* Running count of samples written to file */
-    struct fs_file_t file;        /* Open file handle */
+    uint8_t  *ring;               /* Backing storage, power-of-two sized */
+    uint32_t size;
+    atomic_t head;                /* Producer index (free running) */
+    atomic_t tail;                /* Consumer index (free running) */
+    atomic_t drain_requested;     /* Set by producer when the ring crosses half full */
+    uint32_t overruns;            /* Batches dropped because the ring was full */
+    uint32_t dropped_bytes;
+    uint32_t high_water;          /* Peak fill level in bytes */
+    uint32_t total_bytes;         /* Bytes written to file this session */
+    uint32_t total_samples;       /* Samples written to file this session */
+    struct fs_file_t file;        /* Open file handle, kept for the whole session */
     bool     file_open;           /* File is currently open */
+    uint32_t unsynced_bytes;      /* Written since the last fs_sync() */
+    int64_t  last_sync_ms;        /* Uptime of the last fs_sync() */
     uint16_t sample_rate;         /* Sample rate for this signal */
     uint8_t  sample_size;         /* Size of one sample in bytes */
+    struct rec_decimator decim;   /* Anti-alias decimation state (producer only) */
+};
+
+BUILD_ASSERT(sizeof(struct hpi_recording_file_header_t) == REC_FILE_HEADER_SIZE,
+             "Recording file header layout changed");
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_HPI_RECORDING_RING_PPG_WRIST), "Ring size must be a power of two");
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_HPI_RECORDING_RING_PPG_FINGER), "Ring size must be a power of two");
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_HPI_RECORDING_RING_IMU_ACCEL), "Ring size must be a power of two");
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_HPI_RECORDING_RING_IMU_GYRO), "Ring size must be a power of two");
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_HPI_RECORDING_RING_GSR), "Ring size must be a power of two");
+
+static uint8_t ring_ppg_wrist[CONFIG_HPI_RECORDING_RING_PPG_WRIST];
+static uint8_t ring_ppg_finger[CONFIG_HPI_RECORDING_RING_PPG_FINGER];
+static uint8_t ring_imu_accel[CONFIG_HPI_RECORDING_RING_IMU_ACCEL];
+static uint8_t ring_imu_gyro[CONFIG_HPI_RECORDING_RING_IMU_GYRO];
+static uint8_t ring_gsr[CONFIG_HPI_RECORDING_RING_GSR];
+
+static uint8_t *const signal_rings[REC_TYPE_COUNT] = {
+    [REC_TYPE_PPG_WRIST]  = ring_ppg_wrist,
+    [REC_TYPE_PPG_FINGER] = ring_ppg_finger,
+    [REC_TYPE_IMU_ACCEL]  = ring_imu_accel,
+    [REC_TYPE_IMU_GYRO]   = ring_imu_gyro,
+    [REC_TYPE_GSR]        = ring_gsr,
+};
+
+static const uint32_t signal_ring_sizes[REC_TYPE_COUNT] = {
+    [REC_TYPE_PPG_WRIST]  = sizeof(ring_ppg_wrist),
+    [REC_TYPE_PPG_FINGER] = sizeof(ring_ppg_finger),
+    [REC_TYPE_IMU_ACCEL]  = sizeof(ring_imu_accel),
+    [REC_TYPE_IMU_GYRO]   = sizeof(ring_imu_gyro),
+    [REC_TYPE_GSR]        = sizeof(ring_gsr),
 };
 
 static struct rec_signal_buffer rec_buffers[REC_TYPE_COUNT];
@@ -69,6 +185,15 @@ static const uint16_t signal_sample_rates[REC_TYPE_COUNT] = {
     [REC_TYPE_GSR]        = REC_SAMPLE_RATE_GSR,
 };
 
+/* Channels interleaved in one sample; channel width is sample_size / channels */
+static const uint8_t signal_channels[REC_TYPE_COUNT] = {
+    [REC_TYPE_PPG_WRIST]  = 3,
+    [REC_TYPE_PPG_FINGER] = 2,
+    [REC_TYPE_IMU_ACCEL]  = 3,
+    [REC_TYPE_IMU_GYRO]   = 3,
+    [REC_TYPE_GSR]        = 1,
+};
+
 static const uint8_t signal_sample_sizes[REC_TYPE_COUNT] = {
     [REC_TYPE_PPG_WRIST]  = REC_SAMPLE_SIZE_PPG_WRIST,
     [REC_TYPE_PPG_FINGER] = REC_SAMPLE_SIZE_PPG_FINGER,
@@ -99,9 +224,9 @@ static void rec_ctrl_thread_fn(void *, void *, void *);
 static void rec_writer_thread_fn(void *, void *, void *);
 static void rec_timer_thread_fn(void *, void *, void *);
 static int create_session_directory(int64_t timestamp, char *path_out, size_t path_len);
-static int flush_buffer(enum hpi_rec_signal_type signal_type, uint8_t buffer_idx);
-static int write_file_headers(int64_t timestamp);
-static int update_file_headers(void);
+static int drain_signal(enum hpi_rec_signal_type signal_type, bool final);
+static int open_signal_files(int64_t timestamp);
+static int close_signal_files(void);
 
 /* Thread definitions */
 #define REC_CTRL_THREAD_STACKSIZE   2048  /* Needs stack for fs_mkdir, fs_open, fs_write */
@@ -136,9 +261,10 @@ int hpi_recording_init(void)
     for (int i = 0; i < REC_TYPE_COUNT; i++) {
         memset(&rec_buffers[i], 0, sizeof(struct rec_signal_buffer));
         fs_file_t_init(&rec_buffers[i].file);
+        rec_buffers[i].ring = signal_rings[i];
+        rec_buffers[i].size = signal_ring_sizes[i];
         rec_buffers[i].sample_rate = signal_sample_rates[i];
         rec_buffers[i].sample_size = signal_sample_sizes[i];
-        atomic_set(&rec_buffers[i].flush_pending, -1);
     }
 
     /* Initialize session state */
@@ -199,6 +325,11 @@ int hpi_recording_configure(const struct hpi_recording_config_t *config)
         return -REC_ERR_INVALID_CONFIG;
     }
 
+    if (config->sample_decimation > REC_MAX_DECIMATION) {
+        LOG_ERR("Invalid decimation: %d (max %d)", config->sample_decimation, REC_MAX_DECIMATION);
+        return -REC_ERR_INVALID_CONFIG;
+    }
+
     k_mutex_lock(&mutex_rec_config, K_FOREVER);
 
     /* Check if recording is active */
@@ -306,6 +437,18 @@ int hpi_recording_get_status(struct hpi_recording_status_t *status)
     status->signal_mask = current_session.signal_mask;
     status->state = current_session.state;
     status->active = (current_session.state == REC_STATE_RECORDING);
+
+    int64_t end_ms = status->active ? k_uptime_get() : rec_write_stats.end_ms;
+    int64_t span_ms = end_ms - rec_write_stats.start_ms;
+    status->bytes_written = rec_write_stats.bytes_written;
+    status->write_bps = (span_ms > 0) ?
+                        (uint32_t)(((uint64_t)rec_write_stats.bytes_written * 1000U) / span_ms) : 0;
+    status->max_flush_us = rec_write_stats.max_flush_us;
+    status->max_sync_us = rec_write_stats.max_sync_us;
+    status->overruns = 0;
+    for (int i = 0; i < REC_TYPE_COUNT; i++) {
+        status->overruns += rec_buffers[i].overruns;
+    }
     k_mutex_unlock(&mutex_rec_state);
 
     return 0;
@@ -328,25 +471,34 @@ static void add_samples_to_buffer(enum hpi_rec_signal_type type,
     }
 
     struct rec_signal_buffer *buf = &rec_buffers[type];
-    uint8_t *active = (buf->active_buffer == 0) ? buf->buffer_a : buf->buffer_b;
+    uint32_t head = (uint32_t)atomic_get(&buf->head);
+    uint32_t used = head - (uint32_t)atomic_get(&buf->tail);
 
-    /* Check if adding samples would overflow */
-    if (buf->write_idx + size > REC_BUFFER_SIZE) {
-        /* Mark current buffer for flush */
-        atomic_set(&buf->flush_pending, buf->active_buffer);
+    if (size > buf->size - used) {
+        /* Writer has fallen behind - drop this batch, keep what is queued intact */
+        buf->overruns++;
+        buf->dropped_bytes += size;
+        return;
+    }
 
-        /* Swap to other buffer */
-        buf->active_buffer ^= 1;
-        buf->write_idx = 0;
-        active = (buf->active_buffer == 0) ? buf->buffer_a : buf->buffer_b;
+    /* Copy in at most two spans around the wrap point */
+    uint32_t offset = head & (buf->size - 1);
+    uint32_t first = MIN((uint32_t)size, buf->size - offset);
+    memcpy(&buf->ring[offset], samples, first);
+    memcpy(buf->ring, (const uint8_t *)samples + first, size - first);
 
+    /* Publish after the copy; atomic_set orders the data writes before the index */
+    atomic_set(&buf->head, (atomic_val_t)(head + size));
+
+    used += size;
+    if (used > buf->high_water) {
+        buf->high_water = used;
+    }
+
+    if (used >= buf->size / 2 && atomic_cas(&buf->drain_requested, 0, 1)) {
         /* Signal writer thread */
         k_sem_give(&sem_rec_flush);
     }
-
-    /* Copy samples to active buffer */
-    memcpy(&active[buf->write_idx], samples, size);
-    buf->write_idx += size;
 }
 
 void hpi_rec_add_ppg_wrist_samples(const uint32_t *ir, const uint32_t *red,
@@ -359,17 +511,20 @@ void hpi_rec_add_ppg_wrist_samples(const uint32_t *ir, const uint32_t *red,
     /* Pack samples: IR, Red, Green interleaved */
     uint8_t packed[REC_SAMPLE_SIZE_PPG_WRIST * 8];  /* Max 8 samples per call */
     uint16_t offset = 0;
+    struct rec_decimator *d = &rec_buffers[REC_TYPE_PPG_WRIST].decim;
 
     for (uint8_t i = 0; i < num_samples && i < 8; i++) {
-        memcpy(&packed[offset], &ir[i], sizeof(uint32_t));
-        offset += sizeof(uint32_t);
-        memcpy(&packed[offset], &red[i], sizeof(uint32_t));
-        offset += sizeof(uint32_t);
-        memcpy(&packed[offset], &green[i], sizeof(uint32_t));
-        offset += sizeof(uint32_t);
+        int32_t ch[3] = {(int32_t)ir[i], (int32_t)red[i], (int32_t)green[i]};
+        if (!rec_decimate(d, ch, 3)) {
+            continue;
+        }
+        memcpy(&packed[offset], ch, sizeof(ch));
+        offset += sizeof(ch);
     }
 
-    add_samples_to_buffer(REC_TYPE_PPG_WRIST, packed, offset);
+    if (offset > 0) {
+        add_samples_to_buffer(REC_TYPE_PPG_WRIST, packed, offset);
+    }
 }
 
 void hpi_rec_add_ppg_finger_samples(const uint32_t *ir, const uint32_t *red,
@@ -382,15 +537,20 @@ void hpi_rec_add_ppg_finger_samples(const uint32_t *ir, const uint32_t *red,
     /* Pack samples: IR, Red interleaved */
     uint8_t packed[REC_SAMPLE_SIZE_PPG_FINGER * 32];  /* Max 32 samples per call */
     uint16_t offset = 0;
+    struct rec_decimator *d = &rec_buffers[REC_TYPE_PPG_FINGER].decim;
 
     for (uint8_t i = 0; i < num_samples && i < 32; i++) {
-        memcpy(&packed[offset], &ir[i], sizeof(uint32_t));
-        offset += sizeof(uint32_t);
-        memcpy(&packed[offset], &red[i], sizeof(uint32_t));
-        offset += sizeof(uint32_t);
+        int32_t ch[2] = {(int32_t)ir[i], (int32_t)red[i]};
+        if (!rec_decimate(d, ch, 2)) {
+            continue;
+        }
+        memcpy(&packed[offset], ch, sizeof(ch));
+        offset += sizeof(ch);
     }
 
-    add_samples_to_buffer(REC_TYPE_PPG_FINGER, packed, offset);
+    if (offset > 0) {
+        add_samples_to_buffer(REC_TYPE_PPG_FINGER, packed, offset);
+    }
 }
 
 void hpi_rec_add_gsr_samples(const int32_t *samples, uint8_t num_samples)
@@ -399,7 +559,48 @@ void hpi_rec_add_gsr_samples(const int32_t *samples, uint8_t num_samples)
         return;
     }
 
-    add_samples_to_buffer(REC_TYPE_GSR, samples, num_samples * sizeof(int32_t));
+    if (rec_decimation <= 1) {
+        add_samples_to_buffer(REC_TYPE_GSR, samples, num_samples * sizeof(int32_t));
+        return;
+    }
+
+    int32_t out[32];
+    uint8_t n = 0;
+    struct rec_decimator *d = &rec_buffers[REC_TYPE_GSR].decim;
+
+    for (uint8_t i = 0; i < num_samples && i < ARRAY_SIZE(out); i++) {
+        int32_t ch = samples[i];
+        if (rec_decimate(d, &ch, 1)) {
+            out[n++] = ch;
+        }
+    }
+
+    if (n > 0) {
+        add_samples_to_buffer(REC_TYPE_GSR, out, n * sizeof(int32_t));
+    }
+}
+
+static void add_imu_samples(enum hpi_rec_signal_type type, const int16_t *x,
+                            const int16_t *y, const int16_t *z, uint8_t num_samples)
+{
+    /* Pack samples: X, Y, Z interleaved */
+    int16_t packed[3 * 16];
+    uint16_t n = 0;
+    struct rec_decimator *d = &rec_buffers[type].decim;
+
+    for (uint8_t i = 0; i < num_samples && i < 16; i++) {
+        int32_t ch[3] = {x[i], y[i], z[i]};
+        if (!rec_decimate(d, ch, 3)) {
+            continue;
+        }
+        packed[n++] = (int16_t)ch[0];
+        packed[n++] = (int16_t)ch[1];
+        packed[n++] = (int16_t)ch[2];
+    }
+
+    if (n > 0) {
+        add_samples_to_buffer(type, packed, n * sizeof(int16_t));
+    }
 }
 
 void hpi_rec_add_imu_accel_samples(const int16_t *x, const int16_t *y,
@@ -409,20 +610,7 @@ void hpi_rec_add_imu_accel_samples(const int16_t *x, const int16_t *y,
         return;
     }
 
-    /* Pack samples: X, Y, Z interleaved */
-    uint8_t packed[REC_SAMPLE_SIZE_IMU_ACCEL * 16];
-    uint16_t offset = 0;
-
-    for (uint8_t i = 0; i < num_samples && i < 16; i++) {
-        memcpy(&packed[offset], &x[i], sizeof(int16_t));
-        offset += sizeof(int16_t);
-        memcpy(&packed[offset], &y[i], sizeof(int16_t));
-        offset += sizeof(int16_t);
-        memcpy(&packed[offset], &z[i], sizeof(int16_t));
-        offset += sizeof(int16_t);
-    }
-
-    add_samples_to_buffer(REC_TYPE_IMU_ACCEL, packed, offset);
+    add_imu_samples(REC_TYPE_IMU_ACCEL, x, y, z, num_samples);
 }
 
 void hpi_rec_add_imu_gyro_samples(const int16_t *x, const int16_t *y,
@@ -432,20 +620,7 @@ void hpi_rec_add_imu_gyro_samples(const int16_t *x, const int16_t *y,
         return;
     }
 
-    /* Pack samples: X, Y, Z interleaved */
-    uint8_t packed[REC_SAMPLE_SIZE_IMU_GYRO * 16];
-    uint16_t offset = 0;
-
-    for (uint8_t i = 0; i < num_samples && i < 16; i++) {
-        memcpy(&packed[offset], &x[i], sizeof(int16_t));
-        offset += sizeof(int16_t);
-        memcpy(&packed[offset], &y[i], sizeof(int16_t));
-        offset += sizeof(int16_t);
-        memcpy(&packed[offset], &z[i], sizeof(int16_t));
-        offset += sizeof(int16_t);
-    }
-
-    add_samples_to_buffer(REC_TYPE_IMU_GYRO, packed, offset);
+    add_imu_samples(REC_TYPE_IMU_GYRO, x, y, z, num_samples);
 }
 
 /*
@@ -640,191 +815,344 @@ static int create_session_directory(int64_t timestamp, char *path_out, size_t pa
 
     return 0;
 }
-static int write_file_headers(int64_t timestamp)
+/*
+ * Each signal file is opened once when the session starts and written through
+ * the same handle until stop. LittleFS commits metadata on open/close and
+ * sync, so reopening per 1 KB buffer dominated the write cost; data is now
+ * committed every CONFIG_HPI_RECORDING_SYNC_INTERVAL_MS instead, which bounds how
+ * much is lost on a reset mid-session.
+ */
+
+static void close_signal_file(struct rec_signal_buffer *buf)
+{
+    if (buf->file_open) {
+        fs_close(&buf->file);
+        buf->file_open = false;
+    }
+}
+
+static int open_signal_files(int64_t timestamp)
 {
     uint8_t signal_mask = current_session.signal_mask;
     char session_path[48];
     char file_path[80];
-    struct fs_file_t tmp_file;
-    
+    int ret = 0;
+
     snprintf(session_path, sizeof(session_path), "%s%" PRId64 "/",
              REC_BASE_PATH, timestamp);
-    
+
+    k_mutex_lock(&mutex_rec_files, K_FOREVER);
+
     for (int i = 0; i < REC_TYPE_COUNT; i++) {
-        if (signal_mask & signal_to_mask[i]) {
-            /* Build file path */
-            snprintf(file_path, sizeof(file_path), "%s%s",
-                     session_path, signal_filenames[i]);
-            
-            /* TEMP FILE: Open → Write header → Close */
-            fs_file_t_init(&tmp_file);
-            int ret = fs_open(&tmp_file, file_path, FS_O_CREATE | FS_O_WRITE | FS_O_TRUNC);
-            if (ret < 0) {
-                LOG_ERR("Header open %s failed: %d", signal_filenames[i], ret);
-                continue;
-            }
-            
-            struct hpi_recording_file_header_t header = {
-                .magic = REC_FILE_MAGIC,
-                .version = REC_FILE_VERSION,
-                .signal_type = i,
-                .sample_rate_hz = signal_sample_rates[i],
-                .start_timestamp = timestamp,
-                .num_samples = 0,  /* Updated later */
-                .reserved = {0, 0},
-            };
-            
-            ret = fs_write(&tmp_file, &header, sizeof(header));
-            fs_close(&tmp_file);
-            
-            if (ret < 0) {
-                LOG_ERR("Header write %s failed: %d", signal_filenames[i], ret);
-            } else {
-                LOG_INF("Header written: %s", signal_filenames[i]);
-            }
+        if (!(signal_mask & signal_to_mask[i])) {
+            continue;
+        }
+
+        struct rec_signal_buffer *buf = &rec_buffers[i];
+
+        /* Build file path */
+        snprintf(file_path, sizeof(file_path), "%s%s",
+                 session_path, signal_filenames[i]);
+
+        fs_file_t_init(&buf->file);
+        ret = fs_open(&buf->file, file_path, FS_O_CREATE | FS_O_WRITE | FS_O_TRUNC);
+        if (ret < 0) {
+            LOG_ERR("Open %s failed: %d", signal_filenames[i], ret);
+            break;
+        }
+        buf->file_open = true;
+
+        struct hpi_recording_file_header_t header = {
+            .magic = REC_FILE_MAGIC,
+            .version = REC_FILE_VERSION,
+            .signal_type = i,
+            .sample_rate_hz = signal_sample_rates[i],
+            .start_timestamp = timestamp,
+            .num_samples = 0,  /* Updated at close */
+            .decimation = rec_decimation,
+            .reserved = 0,
+        };
+
+        ret = fs_write(&buf->file, &header, sizeof(header));
+        if (ret < 0) {
+            LOG_ERR("Header write %s failed: %d", signal_filenames[i], ret);
+            break;
         }
+
+        ret = 0;
+        buf->total_bytes = 0;
+        buf->total_samples = 0;
+        buf->unsynced_bytes = 0;
+        buf->last_sync_ms = k_uptime_get();
+        LOG_INF("Opened %s", signal_filenames[i]);
     }
-    
-    return 0;
+
+    if (ret < 0) {
+        for (int i = 0; i < REC_TYPE_COUNT; i++) {
+            close_signal_file(&rec_buffers[i]);
+        }
+    }
+
+    k_mutex_unlock(&mutex_rec_files);
+
+    return ret;
 }
-static int update_file_headers(void)
+
+static int close_signal_files(void)
 {
-    uint8_t signal_mask = current_session.signal_mask;
-    char session_path[48];
-    char file_path[80];
-    struct fs_file_t tmp_file;
-    
-    snprintf(session_path, sizeof(session_path), "%s%" PRId64 "/",
-             REC_BASE_PATH, current_session.start_timestamp);
-    
+    k_mutex_lock(&mutex_rec_files, K_FOREVER);
+
     for (int i = 0; i < REC_TYPE_COUNT; i++) {
-        if (signal_mask & signal_to_mask[i]) {
-            /* Build file path */
-            snprintf(file_path, sizeof(file_path), "%s%s",
-                     session_path, signal_filenames[i]);
-            
-            /* TEMP FILE: Open → Seek → Update → Close */
-            fs_file_t_init(&tmp_file);
-            int ret = fs_open(&tmp_file, file_path, FS_O_WRITE);
-            if (ret < 0) {
-                LOG_ERR("Update open %s failed: %d", signal_filenames[i], ret);
-                continue;
-            }
-            
-            /* Seek to num_samples field (offset 24 bytes from start) */
-            ret = fs_seek(&tmp_file, offsetof(struct hpi_recording_file_header_t, num_samples), FS_SEEK_SET);
-            if (ret < 0) {
-                LOG_ERR("Update seek %s failed: %d", signal_filenames[i], ret);
-                fs_close(&tmp_file);
-                continue;
-            }
-            
-            /* Write final sample count */
-            uint32_t num_samples = rec_buffers[i].total_samples;
-            ret = fs_write(&tmp_file, &num_samples, sizeof(num_samples));
-            fs_close(&tmp_file);
-            
-            if (ret >= 0) {
-                LOG_INF("%s: %u samples finalized", signal_filenames[i], num_samples);
-            } else {
-                LOG_ERR("Update write %s failed: %d", signal_filenames[i], ret);
-            }
+        struct rec_signal_buffer *buf = &rec_buffers[i];
+
+        if (!buf->file_open) {
+            continue;
         }
+
+        /* Patch the final sample count into the header, then close (which commits) */
+        uint32_t num_samples = buf->total_samples;
+        int ret = fs_seek(&buf->file, offsetof(struct hpi_recording_file_header_t, num_samples),
+                          FS_SEEK_SET);
+        if (ret == 0) {
+            ret = fs_write(&buf->file, &num_samples, sizeof(num_samples));
+        }
+
+        if (ret >= 0) {
+            LOG_INF("%s: %u samples finalized", signal_filenames[i], num_samples);
+        } else {
+            LOG_ERR("Header update %s failed: %d", signal_filenames[i], ret);
+        }
+
+        close_signal_file(buf);
     }
-    
+
+    k_mutex_unlock(&mutex_rec_files);
+
     return 0;
 }
 
-static int flush_buffer(enum hpi_rec_signal_type signal_type, uint8_t buffer_idx)
+/* Append data holding num_samples samples to an open signal file and sync on the configured cadence */
+static int write_signal_data(enum hpi_rec_signal_type signal_type, const uint8_t *data, uint16_t size,
+                             uint32_t num_samples)
 {
     struct rec_signal_buffer *buf = &rec_buffers[signal_type];
-    char session_path[48];
-    char file_path[80];
-    struct fs_file_t tmp_file;  
-    
-    /* Get buffer data */
-    uint8_t *data = (buffer_idx == 0) ? buf->buffer_a : buf->buffer_b;
-    uint16_t size = REC_BUFFER_SIZE;
+    uint32_t sync_us = 0;
+    int ret;
 
-    /* Build signal file path */
-    snprintf(session_path, sizeof(session_path), "%s%" PRId64 "/",
-             REC_BASE_PATH, current_session.start_timestamp);
-    snprintf(file_path, sizeof(file_path), "%s%s",
-             session_path, signal_filenames[signal_type]);  
+    k_mutex_lock(&mutex_rec_files, K_FOREVER);
+
+    if (!buf->file_open) {
+        k_mutex_unlock(&mutex_rec_files);
+        return -EBADF;
+    }
+
+    uint32_t t0 = k_cycle_get_32();
+    ret = fs_write(&buf->file, data, size);
+    uint32_t flush_us = k_cyc_to_us_floor32(k_cycle_get_32() - t0);
+
+    if (ret >= 0 && ret != size) {
+        /* Drop the partial tail so the samples stay queued and a later flush can't duplicate them */
+        LOG_ERR("Short write %s: %d of %u", signal_filenames[signal_type], ret, size);
+        if (ret > 0 && fs_seek(&buf->file, -ret, FS_SEEK_CUR) == 0) {
+            fs_truncate(&buf->file, fs_tell(&buf->file));
+        }
+        ret = -ENOSPC;
+    }
+
+    if (ret > 0) {
+        buf->total_bytes += ret;
+        buf->total_samples += num_samples;
+        buf->unsynced_bytes += ret;
+
+        int64_t now = k_uptime_get();
+        if (CONFIG_HPI_RECORDING_SYNC_INTERVAL_MS > 0 &&
+            now - buf->last_sync_ms >= CONFIG_HPI_RECORDING_SYNC_INTERVAL_MS) {
+            t0 = k_cycle_get_32();
+            int sync_ret = fs_sync(&buf->file);
+            sync_us = k_cyc_to_us_floor32(k_cycle_get_32() - t0);
+            if (sync_ret < 0) {
+                LOG_ERR("Sync %s failed: %d", signal_filenames[signal_type], sync_ret);
+            }
+            buf->unsynced_bytes = 0;
+            buf->last_sync_ms = now;
+        }
+    }
+
+    k_mutex_unlock(&mutex_rec_files);
 
-    /* Open signal file -> write data -> close */
-    fs_file_t_init(&tmp_file);
-    int ret = fs_open(&tmp_file, file_path, FS_O_CREATE | FS_O_WRITE | FS_O_APPEND);
     if (ret < 0) {
-        LOG_ERR("Flush open %s failed: %d", signal_filenames[signal_type], ret);
+        LOG_ERR("Write %s failed: %d", signal_filenames[signal_type], ret);
         return ret;
     }
-    
 
-    ret = fs_write(&tmp_file, data, size);
-    fs_close(&tmp_file); 
-    
-    if (ret > 0) {
-        buf->total_samples += size / buf->sample_size;
-        LOG_DBG("%s: flushed %d bytes (buffer %d)", 
-                signal_filenames[signal_type], ret, buffer_idx);
-        return 0;
+    k_mutex_lock(&mutex_rec_state, K_FOREVER);
+    rec_write_stats.bytes_written += ret;
+    rec_write_stats.flushes++;
+    rec_write_stats.max_flush_us = MAX(rec_write_stats.max_flush_us, flush_us);
+    if (sync_us > 0) {
+        rec_write_stats.syncs++;
+        rec_write_stats.max_sync_us = MAX(rec_write_stats.max_sync_us, sync_us);
     }
-    
-    LOG_ERR("Flush write %s failed: %d", signal_filenames[signal_type], ret);
+    current_session.samples_written += num_samples;
+    k_mutex_unlock(&mutex_rec_state);
+
     return ret;
 }
 
+#if defined(CONFIG_HPI_RECORDING_COMPRESSION)
+/*
+ * Block staging for the encoder, sized for the widest sample. Only touched
+ * with mutex_rec_files held, so one pair serves every signal.
+ */
+static uint8_t rec_block_raw[HPI_REC_BLOCK_MAX_SAMPLES * REC_SAMPLE_SIZE_PPG_WRIST];
+static uint8_t rec_block_out[HPI_REC_BLOCK_MAX_SIZE(REC_SAMPLE_SIZE_PPG_WRIST)];
+
+/*
+ * Write queued samples for one signal as encoded blocks of up to
+ * HPI_REC_BLOCK_MAX_SAMPLES. Producers only publish whole samples, so the
+ * ring always holds a whole number of them; a sample may straddle the wrap
+ * and is copied out in two pieces. Without final, stops once less than half
+ * the ring is queued so blocks (and flash writes) stay large.
+ */
+static int drain_signal(enum hpi_rec_signal_type signal_type, bool final)
+{
+    struct rec_signal_buffer *buf = &rec_buffers[signal_type];
+    uint8_t channels = signal_channels[signal_type];
+    int total = 0;
+
+    k_mutex_lock(&mutex_rec_files, K_FOREVER);
+
+    atomic_set(&buf->drain_requested, 0);
+
+    for (;;) {
+        uint32_t tail = (uint32_t)atomic_get(&buf->tail);
+        uint32_t avail = (uint32_t)atomic_get(&buf->head) - tail;
+        uint32_t samples = MIN(avail / buf->sample_size, HPI_REC_BLOCK_MAX_SAMPLES);
+
+        if (samples == 0 || (!final && total > 0 && avail < buf->size / 2)) {
+            break;
+        }
+
+        uint32_t len = samples * buf->sample_size;
+        uint32_t offset = tail & (buf->size - 1);
+        uint32_t first = MIN(len, buf->size - offset);
+        memcpy(rec_block_raw, &buf->ring[offset], first);
+        memcpy(&rec_block_raw[first], buf->ring, len - first);
+
+        int block_len = hpi_rec_encode_block(rec_block_raw, (uint16_t)samples, channels,
+                                             buf->sample_size / channels, buf->total_samples,
+                                             rec_block_out, sizeof(rec_block_out));
+        if (block_len < 0) {
+            k_mutex_unlock(&mutex_rec_files);
+            LOG_ERR("%s: block encode failed: %d", signal_filenames[signal_type], block_len);
+            return block_len;
+        }
+
+        int ret = write_signal_data(signal_type, rec_block_out, (uint16_t)block_len, samples);
+        if (ret < 0) {
+            k_mutex_unlock(&mutex_rec_files);
+            return ret;
+        }
+
+        /* Release the space only after it has been handed to the file system */
+        atomic_set(&buf->tail, (atomic_val_t)(tail + len));
+        total += len;
+    }
+
+    k_mutex_unlock(&mutex_rec_files);
+
+    if (total > 0) {
+        LOG_DBG("%s: drained %d bytes (%u in file)", signal_filenames[signal_type], total,
+                buf->total_bytes);
+    }
+    return total;
+}
+#else
+/*
+ * Write queued bytes for one signal straight from the ring in contiguous
+ * spans. Without final, stops once less than half the ring is queued so
+ * flash writes stay large.
+ */
+static int drain_signal(enum hpi_rec_signal_type signal_type, bool final)
+{
+    struct rec_signal_buffer *buf = &rec_buffers[signal_type];
+    int total = 0;
+
+    k_mutex_lock(&mutex_rec_files, K_FOREVER);
+
+    atomic_set(&buf->drain_requested, 0);
+
+    for (;;) {
+        uint32_t tail = (uint32_t)atomic_get(&buf->tail);
+        uint32_t avail = (uint32_t)atomic_get(&buf->head) - tail;
+
+        if (avail == 0 || (!final && total > 0 && avail < buf->size / 2)) {
+            break;
+        }
+
+        uint32_t offset = tail & (buf->size - 1);
+        uint32_t span = MIN(avail, buf->size - offset);
+
+        /* Spans are not sample aligned; tail counts bytes from session start */
+        uint32_t samples = (tail + span) / buf->sample_size - tail / buf->sample_size;
+
+        int ret = write_signal_data(signal_type, &buf->ring[offset], (uint16_t)span, samples);
+        if (ret < 0) {
+            k_mutex_unlock(&mutex_rec_files);
+            return ret;
+        }
+
+        /* Release the space only after it has been handed to the file system */
+        atomic_set(&buf->tail, (atomic_val_t)(tail + span));
+        total += span;
+    }
+
+    k_mutex_unlock(&mutex_rec_files);
+
+    if (total > 0) {
+        LOG_DBG("%s: drained %d bytes", signal_filenames[signal_type], total);
+    }
+    return total;
+}
+#endif /* CONFIG_HPI_RECORDING_COMPRESSION */
+
 static int flush_remaining_buffers(void)
 {
     uint8_t signal_mask = current_session.signal_mask;
-    char session_path[48];
-    char file_path[80];
-    struct fs_file_t tmp_file;
-    
-    snprintf(session_path, sizeof(session_path), "%s%" PRId64 "/",
-             REC_BASE_PATH, current_session.start_timestamp);
-    
     int total_written = 0;
-    
+
     for (int i = 0; i < REC_TYPE_COUNT; i++) {
         if ((signal_mask & signal_to_mask[i])) {
-            struct rec_signal_buffer *buf = &rec_buffers[i];
-            
-            /* Flush any remaining data in active buffer */
-            if (buf->write_idx > 0) {
-                uint8_t *data = (buf->active_buffer == 0) ? buf->buffer_a : buf->buffer_b;
-
-                /* Build signal file path */
-                snprintf(file_path, sizeof(file_path), "%s%s",
-                         session_path, signal_filenames[i]);
-
-               /* Open signal file -> write data -> close */
-                fs_file_t_init(&tmp_file);
-                int ret = fs_open(&tmp_file, file_path, FS_O_CREATE | FS_O_WRITE | FS_O_APPEND);
-                if (ret >= 0) {
-                    ret = fs_write(&tmp_file, data, buf->write_idx);
-                    fs_close(&tmp_file);
-                    
-                    if (ret > 0) {
-                        buf->total_samples += buf->write_idx / buf->sample_size;
-                        total_written += ret;
-                        LOG_DBG("Final %s: flushed %d bytes", signal_filenames[i], ret);
-                    } else {
-                        LOG_ERR("Final flush %s failed: %d", signal_filenames[i], ret);
-                    }
-                }
-                
-                /* Reset buffer */
-                buf->write_idx = 0;
+            int ret = drain_signal(i, true);
+            if (ret > 0) {
+                total_written += ret;
             }
         }
     }
-    
+
     LOG_INF("Final flush complete: %d bytes written", total_written);
     return 0;
 }
 
+int hpi_recording_get_signal_stats(uint8_t signal_type, struct hpi_recording_signal_stats_t *stats)
+{
+    if (signal_type >= REC_TYPE_COUNT || stats == NULL) {
+        return -EINVAL;
+    }
+
+    struct rec_signal_buffer *buf = &rec_buffers[signal_type];
+
+    stats->ring_size = buf->size;
+    stats->fill = (uint32_t)atomic_get(&buf->head) - (uint32_t)atomic_get(&buf->tail);
+    stats->high_water = buf->high_water;
+    stats->overruns = buf->overruns;
+    stats->dropped_bytes = buf->dropped_bytes;
+    stats->bytes_written = buf->total_bytes;
+    stats->samples_written = buf->total_samples;
+
+    return 0;
+}
+
 /*
  * Thread Functions
  */
@@ -858,13 +1186,20 @@ static void rec_ctrl_thread_fn(void *p1, void *p2, void *p3)
             continue;
         }
 
-        /* Write file headers */
-        ret = write_file_headers(start_ts);
+        /* Latch decimation for this session; producers are idle so filters reset safely */
+        k_mutex_lock(&mutex_rec_config, K_FOREVER);
+        rec_decimation = MAX(current_config.sample_decimation, 1);
+        k_mutex_unlock(&mutex_rec_config);
+        for (int i = 0; i < REC_TYPE_COUNT; i++) {
+            memset(&rec_buffers[i].decim, 0, sizeof(rec_buffers[i].decim));
+        }
+
+        /* Open signal files and write headers; handles stay open until stop */
+        ret = open_signal_files(start_ts);
         if (ret < 0) {
-            LOG_ERR("Failed to write file headers");
-        //    close_signal_files();
+            LOG_ERR("Failed to open signal files");
             current_session.state = REC_STATE_ERROR;
-            current_session.error_code = REC_ERR_FILE_WRITE;
+            current_session.error_code = REC_ERR_FILE_CREATE;
             continue;
         }
 
@@ -876,8 +1211,20 @@ static void rec_ctrl_thread_fn(void *p1, void *p2, void *p3)
         current_session.samples_written = 0;
         current_session.state = REC_STATE_RECORDING;
         current_session.error_code = REC_ERR_NONE;
+        memset(&rec_write_stats, 0, sizeof(rec_write_stats));
+        rec_write_stats.start_ms = k_uptime_get();
         k_mutex_unlock(&mutex_rec_state);
 
+        /* Producers are idle here, so the rings can be reset without racing */
+        for (int i = 0; i < REC_TYPE_COUNT; i++) {
+            atomic_set(&rec_buffers[i].head, 0);
+            atomic_set(&rec_buffers[i].tail, 0);
+            atomic_set(&rec_buffers[i].drain_requested, 0);
+            rec_buffers[i].overruns = 0;
+            rec_buffers[i].dropped_bytes = 0;
+            rec_buffers[i].high_water = 0;
+        }
+
         /* Enable recording in data path */
         atomic_set(&g_recording_signal_mask, current_session.signal_mask);
         atomic_set(&g_recording_active, 1);
@@ -886,6 +1233,10 @@ static void rec_ctrl_thread_fn(void *p1, void *p2, void *p3)
             gsr_background_start();
         }
 
+        if (current_session.signal_mask & (REC_SIGNAL_IMU_ACCEL | REC_SIGNAL_IMU_GYRO)) {
+            imu_background_start();
+        }
+
         LOG_INF("Recording started: session=%" PRId64 ", signals=0x%02X, duration=%ds",
                 start_ts, current_session.signal_mask, current_session.duration_s);
 
@@ -897,6 +1248,7 @@ static void rec_ctrl_thread_fn(void *p1, void *p2, void *p3)
         atomic_set(&g_recording_signal_mask, 0);
 
         gsr_background_stop();
+        imu_background_stop();
         LOG_INF("Recording stopped, finalizing...");
 
         /* Update state */
@@ -904,34 +1256,26 @@ static void rec_ctrl_thread_fn(void *p1, void *p2, void *p3)
         current_session.state = REC_STATE_FINALIZING;
         k_mutex_unlock(&mutex_rec_state);
 
-        /* Flush any pending buffers */
-        while (k_sem_take(&sem_rec_flush, K_NO_WAIT) == 0) {
-            /* Process pending flushes */
-            for (int i = 0; i < REC_TYPE_COUNT; i++) {
-                int pending = atomic_get(&rec_buffers[i].flush_pending);
-                if (pending >= 0) {
-                    flush_buffer(i, pending);
-                    atomic_set(&rec_buffers[i].flush_pending, -1);
-                }
-            }
-        }
-
-        /* Flush remaining data in active buffers */
+        /* Drain everything still queued in the rings */
+        k_sem_reset(&sem_rec_flush);
         flush_remaining_buffers();
 
-        /* Update file headers with final sample counts */
-        update_file_headers();
-        
+        /* Write final sample counts and close the session's files */
+        close_signal_files();
+
         print_littlefs_usage();
 
         /* Update session state */
         k_mutex_lock(&mutex_rec_state, K_FOREVER);
         current_session.end_timestamp = hw_get_synced_system_time();
         current_session.state = REC_STATE_IDLE;
+        rec_write_stats.end_ms = k_uptime_get();
         config_valid = false;  /* Require reconfiguration for next recording */
         k_mutex_unlock(&mutex_rec_state);
 
-        LOG_INF("Recording finalized: duration=%ds", current_session.elapsed_s);
+        LOG_INF("Recording finalized: duration=%ds, %u bytes, %u flushes (max %u us), %u syncs (max %u us)",
+                current_session.elapsed_s, rec_write_stats.bytes_written, rec_write_stats.flushes,
+                rec_write_stats.max_flush_us, rec_write_stats.syncs, rec_write_stats.max_sync_us);
 
         /* Publish final status */
         struct hpi_recording_status_t status;
@@ -956,12 +1300,10 @@ static void rec_writer_thread_fn(void *p1, void *p2, void *p3)
             continue;  /* Recording stopped, skip flush */
         }
 
-        /* Check all signals for pending flushes */
+        /* Drain every signal that crossed its threshold */
         for (int i = 0; i < REC_TYPE_COUNT; i++) {
-            int pending = atomic_get(&rec_buffers[i].flush_pending);
-            if (pending >= 0) {
-                flush_buffer(i, pending);
-                atomic_set(&rec_buffers[i].flush_pending, -1);
+            if (atomic_get(&rec_buffers[i].drain_requested)) {
+                drain_signal(i, false);
             }
         }
     }
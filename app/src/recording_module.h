@@ -60,7 +60,7 @@ enum hpi_recording_error {
 struct hpi_recording_config_t {
     uint16_t duration_s;        /* Recording duration in seconds (max 3600 = 1 hour) */
     uint8_t  signal_mask;       /* Bitmask of REC_SIGNAL_* flags */
-    uint8_t  sample_decimation; /* Decimation factor (1 = full rate, 2 = half, etc.) */
+    uint8_t  sample_decimation; /* Decimation factor (1 = full rate, 2 = half, etc., max REC_MAX_DECIMATION) */
 };
 
 /* Recording session metadata */
@@ -83,11 +83,34 @@ struct hpi_recording_status_t {
     uint8_t  signal_mask;       /* Active signals being recorded */
     uint8_t  state;             /* Current recording state */
     bool     active;            /* Quick check if recording is active */
+    uint32_t bytes_written;     /* Sample bytes written to flash this session */
+    uint32_t write_bps;         /* Average write throughput (bytes/s) */
+    uint32_t max_flush_us;      /* Worst-case single buffer write */
+    uint32_t max_sync_us;       /* Worst-case fs_sync() */
+    uint32_t overruns;          /* Sample batches dropped across all signals */
 };
 
-/* File format header - 32 bytes */
+/* Per-signal ring buffer statistics */
+struct hpi_recording_signal_stats_t {
+    uint32_t ring_size;         /* Ring capacity in bytes */
+    uint32_t fill;              /* Bytes currently queued */
+    uint32_t high_water;        /* Peak bytes queued this session */
+    uint32_t overruns;          /* Batches dropped because the ring was full */
+    uint32_t dropped_bytes;     /* Bytes in those batches */
+    uint32_t bytes_written;     /* Bytes written to the signal file */
+    uint32_t samples_written;   /* Samples those bytes hold (ratio = samples * size / bytes) */
+};
+
+/* File format header - 28 bytes */
 #define REC_FILE_MAGIC      0x48504952  /* "HPIR" - HealthyPi Recording */
-#define REC_FILE_VERSION    1
+#define REC_FILE_VERSION_RAW    1   /* Interleaved raw samples follow the header */
+#define REC_FILE_VERSION_BLOCK  2   /* rec_codec.h blocks follow the header */
+
+#if defined(CONFIG_HPI_RECORDING_COMPRESSION)
+#define REC_FILE_VERSION    REC_FILE_VERSION_BLOCK
+#else
+#define REC_FILE_VERSION    REC_FILE_VERSION_RAW
+#endif
 
 struct hpi_recording_file_header_t {
     uint32_t magic;             /* REC_FILE_MAGIC */
@@ -96,10 +119,11 @@ struct hpi_recording_file_header_t {
     uint16_t sample_rate_hz;    /* Sample rate for this signal */
     int64_t  start_timestamp;   /* Unix timestamp */
     uint32_t num_samples;       /* Total samples in file (updated at finalize) */
-    uint32_t reserved[2];       /* Future use */
+    uint32_t decimation;        /* Stored rate = sample_rate_hz / decimation (0 in older files = 1) */
+    uint32_t reserved;          /* Future use */
 } __packed;
 
-#define REC_FILE_HEADER_SIZE 32
+#define REC_FILE_HEADER_SIZE 28
 
 /* Session index entry for BLE listing */
 struct hpi_recording_index_t {
@@ -125,8 +149,10 @@ struct hpi_recording_index_t {
 #define REC_SAMPLE_SIZE_IMU_GYRO    6   /* 3 x int16 (X, Y, Z) */
 #define REC_SAMPLE_SIZE_GSR         4   /* 1 x int32 */
 
-/* Buffer configuration - reduced to save RAM (5 signals x 2 buffers x size) */
-#define REC_BUFFER_SIZE  1024  /* 1KB per buffer (10KB total for all signals) */
+/* Per-signal ring buffer sizes are set by CONFIG_HPI_RECORDING_RING_* */
+
+/* Maximum anti-alias decimation factor (CIC gain R^3 must fit the filter state) */
+#define REC_MAX_DECIMATION  16
 
 /* Maximum recording duration in seconds */
 #define REC_MAX_DURATION_S  3600  /* 1 hour */
@@ -149,6 +175,7 @@ int hpi_recording_stop(void);
 /* Status */
 int hpi_recording_get_status(struct hpi_recording_status_t *status);
 bool hpi_recording_is_active(void);
+int hpi_recording_get_signal_stats(uint8_t signal_type, struct hpi_recording_signal_stats_t *stats);
 
 /* Fast inline check for data_thread - no mutex, uses atomic */
 static inline bool hpi_recording_is_signal_enabled(uint8_t signal);
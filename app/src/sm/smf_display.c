@@ -41,8 +41,10 @@
 #include "ui/move_ui.h"
 #include "max32664_updater.h"
 #include "hpi_sys.h"
+#include "hpi_sample_pool.h"
 #include "hpi_user_settings_api.h"
 #include "recording_module.h"
+#include "gsr_algos.h"
 
 LOG_MODULE_REGISTER(smf_display, LOG_LEVEL_DBG);
 
@@ -74,11 +76,12 @@ static uint32_t get_sleep_timeout_ms(void)
     return timeout_ms;
 }
 
-K_MSGQ_DEFINE(q_plot_ecg, sizeof(struct hpi_ecg_bioz_sensor_data_t), 128, 1);
-K_MSGQ_DEFINE(q_plot_ppg_wrist, sizeof(struct hpi_ppg_wr_data_t), 32, 1);
-K_MSGQ_DEFINE(q_plot_ppg_fi, sizeof(struct hpi_ppg_fi_data_t), 32, 1);
+// Plot queues carry pooled sample block pointers; the display releases each block after drawing
+HPI_SAMPLE_BLOCK_MSGQ_DEFINE(q_plot_ecg, HPI_SAMPLE_QDEPTH_PLOT_ECG);
+HPI_SAMPLE_BLOCK_MSGQ_DEFINE(q_plot_ppg_wrist, HPI_SAMPLE_QDEPTH_PLOT_PPG_WR);
+HPI_SAMPLE_BLOCK_MSGQ_DEFINE(q_plot_ppg_fi, HPI_SAMPLE_QDEPTH_PLOT_PPG_FI);
 K_MSGQ_DEFINE(q_plot_hrv, sizeof(struct hpi_computed_hrv_t), 16, 1);
-K_MSGQ_DEFINE(q_plot_gsr, sizeof(struct hpi_gsr_sensor_data_t), 128, 1);
+HPI_SAMPLE_BLOCK_MSGQ_DEFINE(q_plot_gsr, HPI_SAMPLE_QDEPTH_PLOT_GSR);
 K_MSGQ_DEFINE(q_disp_boot_msg, sizeof(struct hpi_boot_msg_t), 4, 1);
 
 K_SEM_DEFINE(sem_disp_ready, 0, 1);
@@ -643,12 +646,7 @@ extern struct k_sem sem_disp_smf_start;
 extern struct k_sem sem_disp_boot_complete;
 extern struct k_sem sem_boot_update_req;
 
-extern struct k_msgq q_ecg_sample;
-extern struct k_msgq q_ppg_wrist_sample;
-extern struct k_msgq q_plot_ecg;
-extern struct k_msgq q_plot_ppg_wrist;
 extern struct k_msgq q_plot_hrv;
-extern struct k_msgq q_plot_gsr;
 
 extern struct k_sem sem_crown_key_pressed;
 
@@ -881,7 +879,7 @@ static void st_display_progress_exit(void *o)
     lv_disp_trig_activity(NULL);
 }
 
-static void hpi_disp_process_ppg_fi_data(struct hpi_ppg_fi_data_t ppg_sensor_sample)
+static void hpi_disp_process_ppg_fi_data(const struct hpi_ppg_fi_data_t *ppg_sensor_sample)
 {
     if (hpi_disp_get_curr_screen() == SCR_SPL_BPT_MEASURE)
     {
@@ -890,7 +888,7 @@ static void hpi_disp_process_ppg_fi_data(struct hpi_ppg_fi_data_t ppg_sensor_sam
         if (k_uptime_get_32() - m_disp_bp_last_refresh > 1000)
         {
             m_disp_bp_last_refresh = k_uptime_get_32();
-            hpi_disp_bpt_update_progress(ppg_sensor_sample.bpt_progress);
+            hpi_disp_bpt_update_progress(ppg_sensor_sample->bpt_progress);
         }
 
         lv_disp_trig_activity(NULL);
@@ -902,9 +900,9 @@ static void hpi_disp_process_ppg_fi_data(struct hpi_ppg_fi_data_t ppg_sensor_sam
         {
             m_disp_bp_last_refresh = k_uptime_get_32();
             char progress_str[32];
-            snprintf(progress_str, sizeof(progress_str), "Calibrating... %d%%", ppg_sensor_sample.bpt_progress);
+            snprintf(progress_str, sizeof(progress_str), "Calibrating... %d%%", ppg_sensor_sample->bpt_progress);
             scr_bpt_cal_progress_update_text(progress_str);
-            LOG_INF("BPT Cal Progress: %d%%", ppg_sensor_sample.bpt_progress);
+            LOG_INF("BPT Cal Progress: %d%%", ppg_sensor_sample->bpt_progress);
         }
         lv_disp_trig_activity(NULL);
     }
@@ -912,18 +910,18 @@ static void hpi_disp_process_ppg_fi_data(struct hpi_ppg_fi_data_t ppg_sensor_sam
     {
      
         hpi_disp_spo2_plot_fi_ppg(ppg_sensor_sample);
-        hpi_disp_spo2_update_progress(ppg_sensor_sample.spo2_valid_percent_complete, ppg_sensor_sample.spo2_state, ppg_sensor_sample.spo2, ppg_sensor_sample.hr);
+        hpi_disp_spo2_update_progress(ppg_sensor_sample->spo2_valid_percent_complete, ppg_sensor_sample->spo2_state, ppg_sensor_sample->spo2, ppg_sensor_sample->hr);
         lv_disp_trig_activity(NULL);
     }
 }
 
-static void hpi_disp_process_ppg_wr_data(struct hpi_ppg_wr_data_t ppg_sensor_sample)
+static void hpi_disp_process_ppg_wr_data(const struct hpi_ppg_wr_data_t *ppg_sensor_sample)
 {
     if (hpi_disp_get_curr_screen() == SCR_SPL_SPO2_MEASURE )
     {
         lv_disp_trig_activity(NULL);
         hpi_disp_spo2_plot_wrist_ppg(ppg_sensor_sample);
-        hpi_disp_spo2_update_progress(ppg_sensor_sample.spo2_valid_percent_complete, ppg_sensor_sample.spo2_state, ppg_sensor_sample.spo2, ppg_sensor_sample.hr);
+        hpi_disp_spo2_update_progress(ppg_sensor_sample->spo2_valid_percent_complete, ppg_sensor_sample->spo2_state, ppg_sensor_sample->spo2, ppg_sensor_sample->hr);
     }
     else if (hpi_disp_get_curr_screen() == SCR_SPL_RAW_PPG)
     {
@@ -931,19 +929,19 @@ static void hpi_disp_process_ppg_wr_data(struct hpi_ppg_wr_data_t ppg_sensor_sam
         lv_disp_trig_activity(NULL);
         hpi_disp_ppg_draw_plotPPG(ppg_sensor_sample);
         /* Update the HR label on raw PPG screen if available */
-        hpi_ppg_disp_update_hr(ppg_sensor_sample.hr);
+        hpi_ppg_disp_update_hr(ppg_sensor_sample->hr);
     }
 }
 
-static void hpi_disp_process_ecg_data(struct hpi_ecg_bioz_sensor_data_t ecg_sensor_sample)
+static void hpi_disp_process_ecg_data(const struct hpi_ecg_bioz_sensor_data_t *ecg_sensor_sample)
 {
     if (hpi_disp_get_curr_screen() == SCR_SPL_ECG_SCR2)
     {
-        hpi_ecg_disp_draw_plotECG(ecg_sensor_sample.ecg_samples, ecg_sensor_sample.ecg_num_samples, ecg_sensor_sample.ecg_lead_off);
+        hpi_ecg_disp_draw_plotECG(ecg_sensor_sample->ecg_plot_samples, ecg_sensor_sample->ecg_num_samples, ecg_sensor_sample->ecg_lead_off);
     }
     else if (hpi_disp_get_curr_screen() == SCR_SPL_HRV_EVAL_PROGRESS)
     {
-        hpi_ecg_disp_draw_plotECG_hrv(ecg_sensor_sample.ecg_samples, ecg_sensor_sample.ecg_num_samples, ecg_sensor_sample.ecg_lead_off);
+        hpi_ecg_disp_draw_plotECG_hrv(ecg_sensor_sample->ecg_plot_samples, ecg_sensor_sample->ecg_num_samples, ecg_sensor_sample->ecg_lead_off);
     }
     /*else if (hpi_disp_get_curr_screen() == SCR_PLOT_EDA)
     {
@@ -962,36 +960,18 @@ static inline int32_t bioz_extract_24bit(int32_t raw)
     return raw;
 }
 
-/**
- * @brief Convert driver-provided BioZ sample to conductance in µS
- *
- * The MAX30001 driver now performs the ADC-to-conductance conversion internally
- * using the datasheet formula and outputs values as fixed-point (µS × 100).
- * This function simply converts from fixed-point to float.
- *
- * Driver conversion (in max30001.h):
- *   Z (Ω) = ADC × VREF / (2^19 × CGMAG × GAIN)
- *   Conductance (µS) = 1/Z × 10^6
- */
-static float convert_raw_sample_to_uS(int32_t raw)
-{
-    /* Driver outputs conductance as fixed-point: µS × 100
-     * Divide by 100 to get actual µS value */
-    return (float)raw / 100.0f;
-}
-
-static void hpi_disp_process_gsr_data(struct hpi_gsr_sensor_data_t gsr_sensor_sample)
+static void hpi_disp_process_gsr_data(const struct hpi_bioz_sample_t *gsr_sensor_sample)
 {
     if (hpi_disp_get_curr_screen() == SCR_SPL_PLOT_GSR)
     {
         // Call batched GSR plot function (bioz_samples contains multiple samples)
-        hpi_gsr_disp_draw_plotGSR(gsr_sensor_sample.bioz_samples, gsr_sensor_sample.bioz_num_samples, gsr_sensor_sample.bioz_lead_off != 0);
-        if (gsr_sensor_sample.bioz_num_samples > 0)
+        hpi_gsr_disp_draw_plotGSR(gsr_sensor_sample->bioz_samples, gsr_sensor_sample->bioz_num_samples, gsr_sensor_sample->bioz_lead_off != 0);
+        if (gsr_sensor_sample->bioz_num_samples > 0)
         {
             /* Use latest sample (same as ECG uses latest RR) */
-            int32_t raw = gsr_sensor_sample.bioz_samples[gsr_sensor_sample.bioz_num_samples - 1];
+            int32_t raw = gsr_sensor_sample->bioz_samples[gsr_sensor_sample->bioz_num_samples - 1];
 
-            m_disp_gsr_us = convert_raw_sample_to_uS(raw);
+            m_disp_gsr_us = gsr_raw_sample_to_uS(raw);
            // hpi_gsr_disp_update_us(m_disp_gsr_us);
         }
         
@@ -1306,42 +1286,33 @@ void hpi_load_scr_spl(int m_screen, enum scroll_dir m_scroll_dir, uint32_t arg1,
 
 static void st_display_active_run(void *o)
 {
-    struct hpi_ecg_bioz_sensor_data_t ecg_sensor_sample;
-    struct hpi_gsr_sensor_data_t gsr_sensor_sample;
-    struct hpi_ppg_wr_data_t ppg_sensor_sample;
-    struct hpi_ppg_fi_data_t ppg_fi_sensor_sample;
+    struct hpi_sample_block *blk;
 
-    if (k_msgq_get(&q_plot_ppg_wrist, &ppg_sensor_sample, K_NO_WAIT) == 0)
+    // Drain everything that arrived since the last pass, the scheduler paces
+    // passes to one per frame so the queues never hold more than a frame's worth
+    while (k_msgq_get(&q_plot_ppg_wrist, &blk, K_NO_WAIT) == 0)
     {
-        hpi_disp_process_ppg_wr_data(ppg_sensor_sample);
+        hpi_disp_process_ppg_wr_data(&blk->ppg_wr);
+        hpi_sample_block_unref(blk);
     }
 
-    // Process multiple ECG samples per cycle to prevent queue backups
-    int ecg_processed_count = 0;
-    while (k_msgq_get(&q_plot_ecg, &ecg_sensor_sample, K_NO_WAIT) == 0)
+    while (k_msgq_get(&q_plot_ecg, &blk, K_NO_WAIT) == 0)
     {
-        hpi_disp_process_ecg_data(ecg_sensor_sample);
-        ecg_processed_count++;
-
-        if (ecg_processed_count >= 8)
-            break; // Prevent blocking other processing
+        hpi_disp_process_ecg_data(&blk->ecg);
+        hpi_sample_block_unref(blk);
     }
 
-    // Process GSR queue data (allow multiple batches per cycle to keep up with producer)
-    int gsr_processed_count = 0;
-    while (k_msgq_get(&q_plot_gsr, &gsr_sensor_sample, K_NO_WAIT) == 0)
+    while (k_msgq_get(&q_plot_gsr, &blk, K_NO_WAIT) == 0)
     {
-        hpi_disp_process_gsr_data(gsr_sensor_sample);
+        hpi_disp_process_gsr_data(&blk->bioz);
+        hpi_sample_block_unref(blk);
         lv_disp_trig_activity(NULL);
-        gsr_processed_count++;
-
-        if (gsr_processed_count >= 8)
-            break; // Prevent blocking other processing
     }
 
-    if (k_msgq_get(&q_plot_ppg_fi, &ppg_fi_sensor_sample, K_NO_WAIT) == 0)
+    while (k_msgq_get(&q_plot_ppg_fi, &blk, K_NO_WAIT) == 0)
     {
-        hpi_disp_process_ppg_fi_data(ppg_fi_sensor_sample);
+        hpi_disp_process_ppg_fi_data(&blk->ppg_fi);
+        hpi_sample_block_unref(blk);
     }
 
     // Do screen specific updates
@@ -1459,8 +1430,14 @@ static void st_display_active_run(void *o)
         // CRITICAL: Set transition flag to block all screen updates
         screen_transition_in_progress = true;
         
-        if (screen_func_table[g_screen].draw)
+        if (g_screen > SCR_LIST_START && g_screen < SCR_LIST_END)
         {
+            // Carousel screens may still be cached, never build a second copy
+            hpi_load_screen(g_screen, g_scroll_dir);
+        }
+        else if (screen_func_table[g_screen].draw)
+        {
+            hpi_scr_cache_trim();
             screen_func_table[g_screen].draw(g_scroll_dir, g_arg1, g_arg2, g_arg3, g_arg4);
         }
         
@@ -1521,6 +1498,12 @@ static void st_display_sleep_entry(void *o)
 
 static void st_display_sleep_run(void *o)
 {
+    // Nothing is drawn while asleep - release queued plot blocks so they don't pin the sample pool
+    hpi_sample_block_queue_flush(&q_plot_ecg);
+    hpi_sample_block_queue_flush(&q_plot_gsr);
+    hpi_sample_block_queue_flush(&q_plot_ppg_wrist);
+    hpi_sample_block_queue_flush(&q_plot_ppg_fi);
+
     // Check for crown button wakeup
     if (k_sem_take(&sem_crown_key_pressed, K_NO_WAIT) == 0)
     {
@@ -1611,6 +1594,397 @@ static const struct smf_state display_states[] = {
     [HPI_DISPLAY_STATE_ON] = SMF_CREATE_STATE(st_display_on_entry, NULL, NULL, NULL, NULL),
 };
 
+/*
+ * Frame timing: one frame is an lv_task_handler() pass that flushed at least
+ * one area. Render time is the pass minus the time spent in the driver on
+ * the wire: with async flush, the stalls waiting for the previous transfer;
+ * with blocking flush, the transfers themselves. Transfer time is what
+ * completed on the wire during the pass (with async flush the last area's
+ * tail may land in the next one).
+ * Counters restart when the screen changes, so a diag read covers one screen.
+ */
+static struct hpi_disp_frame_stats_t disp_frame_stats;
+static struct sh8601_flush_stats disp_flush_prev;
+K_MUTEX_DEFINE(mutex_disp_frame_stats);
+
+static void hpi_disp_account_frame(uint32_t handler_cycles)
+{
+    struct sh8601_flush_stats flush;
+    sh8601_get_flush_stats(display_dev, &flush);
+
+    uint32_t areas = flush.areas - disp_flush_prev.areas;
+    uint32_t bytes = flush.bytes - disp_flush_prev.bytes;
+    uint32_t transfer_us = flush.transfer_us - disp_flush_prev.transfer_us;
+    uint32_t wait_us = flush.wait_us - disp_flush_prev.wait_us;
+    disp_flush_prev = flush;
+
+    if (areas == 0)
+    {
+        return;
+    }
+
+    hpi_scr_cache_frame_flushed();
+
+    uint32_t handler_us = k_cyc_to_us_floor32(handler_cycles);
+#if defined(CONFIG_SH8601_ASYNC_FLUSH)
+    uint32_t blocked_us = wait_us;
+#else
+    // wait_us is 0, every transfer ran inside the pass
+    uint32_t blocked_us = transfer_us;
+#endif
+    uint32_t render_us = (handler_us > blocked_us) ? (handler_us - blocked_us) : 0;
+    int screen = hpi_disp_get_curr_screen();
+
+    k_mutex_lock(&mutex_disp_frame_stats, K_FOREVER);
+    if (disp_frame_stats.screen != screen)
+    {
+        memset(&disp_frame_stats, 0, sizeof(disp_frame_stats));
+        disp_frame_stats.screen = screen;
+    }
+    disp_frame_stats.frames++;
+    disp_frame_stats.areas += areas;
+    disp_frame_stats.bytes += bytes;
+    disp_frame_stats.render_us += render_us;
+    disp_frame_stats.transfer_us += transfer_us;
+    disp_frame_stats.wait_us += wait_us;
+    if (render_us > disp_frame_stats.render_max_us)
+    {
+        disp_frame_stats.render_max_us = render_us;
+    }
+    if (transfer_us > disp_frame_stats.transfer_max_us)
+    {
+        disp_frame_stats.transfer_max_us = transfer_us;
+    }
+    k_mutex_unlock(&mutex_disp_frame_stats);
+}
+
+void hpi_disp_get_frame_stats(struct hpi_disp_frame_stats_t *stats)
+{
+    k_mutex_lock(&mutex_disp_frame_stats, K_FOREVER);
+    *stats = disp_frame_stats;
+    k_mutex_unlock(&mutex_disp_frame_stats);
+
+    stats->fps_x10 = 0;
+    if (stats->frames > 0)
+    {
+        uint32_t render_avg = stats->render_us / stats->frames;
+        uint32_t transfer_avg = stats->transfer_us / stats->frames;
+#if defined(CONFIG_SH8601_ASYNC_FLUSH)
+        // Rendering and transfer overlap, the slower one sets the pace
+        uint32_t frame_us = MAX(render_avg, transfer_avg);
+#else
+        uint32_t frame_us = render_avg + transfer_avg;
+#endif
+        if (frame_us > 0)
+        {
+            stats->fps_x10 = MIN(10000000U / frame_us, UINT16_MAX);
+        }
+    }
+}
+
+void hpi_disp_reset_frame_stats(void)
+{
+    k_mutex_lock(&mutex_disp_frame_stats, K_FOREVER);
+    memset(&disp_frame_stats, 0, sizeof(disp_frame_stats));
+    disp_frame_stats.screen = hpi_disp_get_curr_screen();
+    k_mutex_unlock(&mutex_disp_frame_stats);
+}
+
+/*
+ * Refresh scheduling: instead of a fixed 20 ms tick the thread sleeps until
+ * the next LVGL timer is due, plot data arrives, the touch controller, crown
+ * key or a screen change signals, or the screen's idle interval runs out.
+ * Plot screens are paced to one pass per frame period so several sample
+ * blocks share one flush. The touch read timer only runs for a short while
+ * after a touch; the touch driver's wake signal restarts it.
+ */
+#define HPI_DISP_SCHED_POLL_MS      100     // Screens that poll semaphores from other modules
+#define HPI_DISP_SCHED_BOOT_MS      20      // Init, splash, boot and progress states
+#define HPI_DISP_SCHED_TOUCH_HOLD_MS 1000   // Keep reading touch this long after the last report
+#define HPI_DISP_SCHED_MIN_MS       2
+#define HPI_DISP_SCHED_NUM_SCREENS  8       // Screens tracked in the duty cycle table
+
+#define HPI_DISP_PLOT_FRAME_MS      (1000 / CONFIG_HPI_DISP_PLOT_FPS)
+
+enum hpi_disp_sched_event
+{
+    HPI_DISP_EVT_TOUCH,
+    HPI_DISP_EVT_CROWN,
+    HPI_DISP_EVT_CHANGE_SCREEN, // Only taken in the active state
+    HPI_DISP_EVT_ECG,           // Plot queues, only polled on screens that draw them
+    HPI_DISP_EVT_PPG_WRIST,
+    HPI_DISP_EVT_PPG_FI,
+    HPI_DISP_EVT_GSR,
+    HPI_DISP_EVT_COUNT,
+};
+
+static struct k_poll_event disp_sched_events[HPI_DISP_EVT_COUNT] = {
+    [HPI_DISP_EVT_TOUCH] = K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &sem_touch_wakeup, 0),
+    [HPI_DISP_EVT_CROWN] = K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &sem_crown_key_pressed, 0),
+    [HPI_DISP_EVT_CHANGE_SCREEN] = K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &sem_change_screen, 0),
+    [HPI_DISP_EVT_ECG] = K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &q_plot_ecg, 0),
+    [HPI_DISP_EVT_PPG_WRIST] = K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &q_plot_ppg_wrist, 0),
+    [HPI_DISP_EVT_PPG_FI] = K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &q_plot_ppg_fi, 0),
+    [HPI_DISP_EVT_GSR] = K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &q_plot_gsr, 0),
+};
+
+static struct
+{
+    int64_t last_wake;
+    int64_t last_account;
+    int64_t last_touch;
+    bool input_paused;
+    enum hpi_disp_sched_event wake_evt; // HPI_DISP_EVT_COUNT when the timeout expired
+} disp_sched;
+
+static struct hpi_disp_sched_stats_t disp_sched_stats[HPI_DISP_SCHED_NUM_SCREENS];
+static int64_t disp_sched_stats_seen[HPI_DISP_SCHED_NUM_SCREENS];
+K_MUTEX_DEFINE(mutex_disp_sched_stats);
+
+/* Screens that draw live plot queue data */
+static bool hpi_disp_sched_is_plot_screen(int screen)
+{
+    switch (screen)
+    {
+    case SCR_SPL_ECG_SCR2:
+    case SCR_SPL_HRV_EVAL_PROGRESS:
+    case SCR_SPL_PLOT_GSR:
+    case SCR_SPL_RAW_PPG:
+    case SCR_SPL_SPO2_MEASURE:
+    case SCR_SPL_BPT_MEASURE:
+    case SCR_SPL_BPT_CAL_PROGRESS:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* Longest sleep with nothing pending on this screen */
+static uint32_t hpi_disp_sched_idle_ms(int screen)
+{
+    // Carousel screens only show clock, battery and last values, refreshed at 1 Hz
+    if (screen > SCR_LIST_START && screen < SCR_LIST_END)
+    {
+        return CONFIG_HPI_DISP_IDLE_REFRESH_MS;
+    }
+
+    return HPI_DISP_SCHED_POLL_MS;
+}
+
+static void hpi_disp_sched_set_input_paused(bool paused)
+{
+    if (paused == disp_sched.input_paused)
+    {
+        return;
+    }
+    disp_sched.input_paused = paused;
+
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev != NULL; indev = lv_indev_get_next(indev))
+    {
+        lv_timer_t *read_timer = lv_indev_get_read_timer(indev);
+        if (read_timer == NULL)
+        {
+            continue;
+        }
+
+        if (paused)
+        {
+            lv_timer_pause(read_timer);
+        }
+        else
+        {
+            lv_timer_resume(read_timer);
+            lv_timer_ready(read_timer);
+        }
+    }
+}
+
+static void hpi_disp_account_sched(int screen, uint32_t busy_cycles, uint32_t elapsed_ms)
+{
+    int slot = 0;
+
+    k_mutex_lock(&mutex_disp_sched_stats, K_FOREVER);
+    for (int i = 0; i < HPI_DISP_SCHED_NUM_SCREENS; i++)
+    {
+        if (disp_sched_stats[i].wakeups > 0 && disp_sched_stats[i].screen == screen)
+        {
+            slot = i;
+            break;
+        }
+        // Otherwise reuse the screen that was shown longest ago
+        if (disp_sched_stats_seen[i] < disp_sched_stats_seen[slot])
+        {
+            slot = i;
+        }
+    }
+
+    struct hpi_disp_sched_stats_t *st = &disp_sched_stats[slot];
+    if (st->wakeups == 0 || st->screen != screen)
+    {
+        memset(st, 0, sizeof(*st));
+        st->screen = screen;
+    }
+
+    st->wakeups++;
+    st->busy_us += k_cyc_to_us_floor32(busy_cycles);
+    st->elapsed_ms += elapsed_ms;
+    if (disp_sched.wake_evt >= HPI_DISP_EVT_ECG && disp_sched.wake_evt < HPI_DISP_EVT_COUNT)
+    {
+        st->data_wakeups++;
+    }
+    else if (disp_sched.wake_evt < HPI_DISP_EVT_ECG)
+    {
+        st->event_wakeups++;
+    }
+    disp_sched_stats_seen[slot] = k_uptime_get();
+    k_mutex_unlock(&mutex_disp_sched_stats);
+}
+
+/*
+ * Sleep until the next pass is needed. lv_next_ms is what lv_task_handler()
+ * returned, busy_cycles the time the thread spent since it last woke.
+ */
+static void hpi_disp_sched_wait(uint32_t lv_next_ms, uint32_t busy_cycles)
+{
+    const struct smf_state *state = SMF_CTX(&s_disp_obj)->current;
+    int screen = hpi_disp_get_curr_screen();
+    int64_t now = k_uptime_get();
+    int64_t elapsed_ms = (disp_sched.last_account > 0) ? (now - disp_sched.last_account) : 0;
+    int num_events;
+    uint32_t wait_ms;
+
+    // One pass plus the sleep before it, charged to the wake reason of that sleep
+    disp_sched.last_account = now;
+
+    if (state == &display_states[HPI_DISPLAY_STATE_ACTIVE])
+    {
+        hpi_disp_account_sched(screen, busy_cycles, (uint32_t)elapsed_ms);
+
+        bool touching = (now - disp_sched.last_touch) < HPI_DISP_SCHED_TOUCH_HOLD_MS;
+        hpi_disp_sched_set_input_paused(!touching);
+
+        wait_ms = MIN(lv_next_ms, hpi_disp_sched_idle_ms(screen));
+        num_events = hpi_disp_sched_is_plot_screen(screen) ? HPI_DISP_EVT_COUNT : HPI_DISP_EVT_ECG;
+    }
+    else if (state == &display_states[HPI_DISPLAY_STATE_SLEEP])
+    {
+        // Only the wake sources; the sleep state releases plot blocks on each pass
+        hpi_disp_sched_set_input_paused(false);
+        wait_ms = HPI_DISP_SCHED_POLL_MS;
+        num_events = HPI_DISP_EVT_CHANGE_SCREEN;
+    }
+    else
+    {
+        hpi_disp_sched_set_input_paused(false);
+        wait_ms = MIN(lv_next_ms, HPI_DISP_SCHED_BOOT_MS);
+        num_events = 0;
+    }
+
+    int64_t deadline = now + MAX(wait_ms, HPI_DISP_SCHED_MIN_MS);
+    disp_sched.wake_evt = HPI_DISP_EVT_COUNT;
+
+    for (;;)
+    {
+        // Data that arrives within a frame of the last pass waits for the frame boundary
+        if (num_events > HPI_DISP_EVT_ECG &&
+            (k_msgq_num_used_get(&q_plot_ecg) || k_msgq_num_used_get(&q_plot_ppg_wrist) ||
+             k_msgq_num_used_get(&q_plot_ppg_fi) || k_msgq_num_used_get(&q_plot_gsr)))
+        {
+            deadline = MIN(deadline, disp_sched.last_wake + HPI_DISP_PLOT_FRAME_MS);
+            num_events = HPI_DISP_EVT_ECG;
+            disp_sched.wake_evt = HPI_DISP_EVT_ECG;
+        }
+
+        int64_t timeout_ms = deadline - k_uptime_get();
+        if (timeout_ms <= 0)
+        {
+            break;
+        }
+
+        if (num_events == 0)
+        {
+            k_msleep((int32_t)timeout_ms);
+            break;
+        }
+
+        for (int i = 0; i < num_events; i++)
+        {
+            disp_sched_events[i].state = K_POLL_STATE_NOT_READY;
+        }
+
+        if (k_poll(disp_sched_events, num_events, K_MSEC(timeout_ms)) != 0)
+        {
+            break;
+        }
+
+        int fired = -1;
+        for (int i = 0; i < HPI_DISP_EVT_ECG && i < num_events; i++)
+        {
+            if (disp_sched_events[i].state != K_POLL_STATE_NOT_READY)
+            {
+                fired = i;
+                break;
+            }
+        }
+
+        if (fired >= 0)
+        {
+            disp_sched.wake_evt = fired;
+            break;
+        }
+        // Only plot data: go round to pace it to the frame period
+    }
+
+    now = k_uptime_get();
+
+    // Touch reports while awake restart the read timer; the sleep state takes the semaphore itself
+    if (state == &display_states[HPI_DISPLAY_STATE_ACTIVE] && k_sem_take(&sem_touch_wakeup, K_NO_WAIT) == 0)
+    {
+        disp_sched.last_touch = now;
+        hpi_disp_sched_set_input_paused(false);
+    }
+
+    disp_sched.last_wake = now;
+}
+
+int hpi_disp_get_sched_stats(uint8_t screen, struct hpi_disp_sched_stats_t *stats)
+{
+    int ret = -ENOENT;
+
+    if (screen == HPI_DISP_SCHED_CURR_SCREEN)
+    {
+        screen = hpi_disp_get_curr_screen();
+    }
+
+    k_mutex_lock(&mutex_disp_sched_stats, K_FOREVER);
+    for (int i = 0; i < HPI_DISP_SCHED_NUM_SCREENS; i++)
+    {
+        if (disp_sched_stats[i].wakeups > 0 && disp_sched_stats[i].screen == screen)
+        {
+            *stats = disp_sched_stats[i];
+            ret = 0;
+            break;
+        }
+    }
+    k_mutex_unlock(&mutex_disp_sched_stats);
+
+    if (ret == 0)
+    {
+        uint64_t elapsed_us = (uint64_t)stats->elapsed_ms * 1000U;
+        stats->duty_permille = (elapsed_us > 0) ? (uint16_t)MIN((uint64_t)stats->busy_us * 1000U / elapsed_us, 1000U) : 0;
+    }
+
+    return ret;
+}
+
+void hpi_disp_reset_sched_stats(void)
+{
+    k_mutex_lock(&mutex_disp_sched_stats, K_FOREVER);
+    memset(disp_sched_stats, 0, sizeof(disp_sched_stats));
+    memset(disp_sched_stats_seen, 0, sizeof(disp_sched_stats_seen));
+    k_mutex_unlock(&mutex_disp_sched_stats);
+}
+
 void smf_display_thread(void)
 {
     int ret;
@@ -1623,6 +1997,8 @@ void smf_display_thread(void)
 
     for (;;)
     {
+        uint32_t wake = k_cycle_get_32();
+
         ret = smf_run_state(SMF_CTX(&s_disp_obj));
         if (ret != 0)
         {
@@ -1630,8 +2006,11 @@ void smf_display_thread(void)
             break;
         }
 
-        lv_task_handler();
-        k_msleep(20);
+        uint32_t start = k_cycle_get_32();
+        uint32_t lv_next_ms = lv_task_handler();
+        hpi_disp_account_frame(k_cycle_get_32() - start);
+
+        hpi_disp_sched_wait(lv_next_ms, k_cycle_get_32() - wake);
     }
 }
 
@@ -1731,7 +2110,7 @@ static void disp_gsr_stress_listener(const struct zbus_channel *chan)
 {
     const struct hpi_gsr_stress_index_t *stress_data = zbus_chan_const_msg(chan);
     
-    if (stress_data && stress_data->stress_data_ready) {
+    if (stress_data && stress_data->stress_data_ready && !stress_data->continuous) {
         // Update the GSR complete screen if it's currently displayed
         hpi_gsr_complete_update_results(stress_data);
         
@@ -47,14 +47,19 @@
 #include "ui/move_ui.h"
 #include "hpi_sys.h"
 #include "hpi_user_settings_api.h"
+#include "hpi_sample_pool.h"
+#include "hpi_sensor_workq.h"
+#include "hrv_algos.h"
+#include "ecg_filter.h"
 
 LOG_MODULE_REGISTER(smf_ecg, LOG_LEVEL_DBG);
 
 SENSOR_DT_READ_IODEV(max30001_iodev, DT_ALIAS(max30001), SENSOR_CHAN_VOLTAGE);
 
-K_MSGQ_DEFINE(q_ecg_sample, sizeof(struct hpi_ecg_bioz_sensor_data_t), 64, 1);  // Reduced from 128 to 64
-/* Lightweight queue for BioZ-only samples to reduce copy overhead when ECG not needed */
-K_MSGQ_DEFINE(q_bioz_sample, sizeof(struct hpi_bioz_sample_t), 64, 1);
+// Sample queues carry pooled block pointers (see hpi_sample_pool.h)
+HPI_SAMPLE_BLOCK_MSGQ_DEFINE(q_ecg_sample, HPI_SAMPLE_QDEPTH_ECG);
+/* Lightweight queue for BioZ-only samples when ECG decoding is not required */
+HPI_SAMPLE_BLOCK_MSGQ_DEFINE(q_bioz_sample, HPI_SAMPLE_QDEPTH_BIOZ);
 
 /* `sem_ecg_start` is defined in `hw_module.c`; declare extern below. */
 K_SEM_DEFINE(sem_ecg_lon, 0, 1);
@@ -128,8 +133,6 @@ K_MUTEX_DEFINE(ecg_timer_mutex);
 ZBUS_CHAN_DECLARE(ecg_stat_chan);
 ZBUS_CHAN_DECLARE(ecg_lead_on_off_chan);
 
-#define ECG_SAMPLING_INTERVAL_MS 125
-#define BIOZ_SAMPLING_INTERVAL_MS 62  // ~16 Hz polling for 32 SPS BioZ to prevent FIFO overflow
 #define ECG_RECORD_DURATION_S 30
 #define ECG_STABILIZATION_DURATION_S 5  // Wait 5 seconds for signal to stabilize
 #define ECG_LEAD_PLACEMENT_TIMEOUT_S 15 // Timeout if leads not placed within 15 seconds
@@ -141,91 +144,6 @@ static int64_t lead_placement_wait_start = 0;
 #define MAX_ECG_SAMPLES 32
 #define MAX_BIOZ_SAMPLES 32
 
-// ECG Signal Smoothing Configuration
-#define ECG_FILTER_WINDOW_SIZE 5  // Moving average window size
-#define ECG_FILTER_BUFFER_SIZE ECG_FILTER_WINDOW_SIZE
-
-// Allow runtime configuration of smoothing (optional)
-#ifndef CONFIG_ECG_SMOOTHING_ENABLED
-#define CONFIG_ECG_SMOOTHING_ENABLED 0  // Disable smoothing for testing
-#endif
-
-#if CONFIG_ECG_SMOOTHING_ENABLED
-// ECG smoothing filter state
-static int32_t ecg_filter_buffer[ECG_FILTER_BUFFER_SIZE];
-static uint8_t ecg_filter_index = 0;
-static bool ecg_filter_initialized = false;
-
-/**
- * @brief Apply moving average filter to smooth ECG sample
- * @param raw_sample Raw ECG sample value
- * @return Smoothed ECG sample value
- * 
- * NOTE: ISR-safe version - uses spinlock instead of mutex
- */
-static int32_t ecg_smooth_sample(int32_t raw_sample)
-{
-    static struct k_spinlock ecg_filter_lock;
-    k_spinlock_key_t key = k_spin_lock(&ecg_filter_lock);
-    
-    // Add new sample to circular buffer
-    ecg_filter_buffer[ecg_filter_index] = raw_sample;
-    ecg_filter_index = (ecg_filter_index + 1) % ECG_FILTER_BUFFER_SIZE;
-    
-    // Calculate moving average
-    int64_t sum = 0;
-    uint8_t valid_samples = 0;
-    
-    if (!ecg_filter_initialized) {
-        // During initialization, use only available samples
-        for (int i = 0; i <= ecg_filter_index; i++) {
-            sum += ecg_filter_buffer[i];
-            valid_samples++;
-        }
-        
-        if (ecg_filter_index == ECG_FILTER_BUFFER_SIZE - 1) {
-            ecg_filter_initialized = true;
-        }
-    } else {
-        // Use full window
-        for (int i = 0; i < ECG_FILTER_BUFFER_SIZE; i++) {
-            sum += ecg_filter_buffer[i];
-        }
-        valid_samples = ECG_FILTER_BUFFER_SIZE;
-    }
-    
-    int32_t smoothed_sample = (int32_t)(sum / valid_samples);
-    
-    k_spin_unlock(&ecg_filter_lock, key);
-    return smoothed_sample;
-}
-
-/**
- * @brief Reset ECG smoothing filter state
- * ISR-safe version using spinlock
- */
-static void ecg_smooth_reset(void)
-{
-    static struct k_spinlock ecg_filter_lock;
-    k_spinlock_key_t key = k_spin_lock(&ecg_filter_lock);
-    memset(ecg_filter_buffer, 0, sizeof(ecg_filter_buffer));
-    ecg_filter_index = 0;
-    ecg_filter_initialized = false;
-    k_spin_unlock(&ecg_filter_lock, key);
-}
-#else
-// ECG smoothing disabled - no-op functions
-static int32_t ecg_smooth_sample(int32_t raw_sample)
-{
-    return raw_sample;
-}
-
-static void ecg_smooth_reset(void)
-{
-    // No-op when smoothing is disabled
-}
-#endif
-
 static int ecg_last_timer_val = 0;
 static int ecg_countdown_val = 0;
 static int ecg_stabilization_countdown = 0;
@@ -512,7 +430,9 @@ static void sensor_ecg_process_decode(uint8_t *buf, uint32_t buf_len)
     }
 
     const struct max30001_encoded_data *edata = (const struct max30001_encoded_data *)buf;
-    struct hpi_ecg_bioz_sensor_data_t ecg_sensor_sample;
+    static struct hpi_ecg_bioz_sensor_data_t ecg_scratch;
+    struct hpi_sample_block *blk = NULL;
+    struct hpi_ecg_bioz_sensor_data_t *ecg_sensor_sample = &ecg_scratch;
 
     uint8_t ecg_num_samples = edata->num_samples_ecg;
     uint8_t bioz_samples = edata->num_samples_bioz;
@@ -529,30 +449,38 @@ static void sensor_ecg_process_decode(uint8_t *buf, uint32_t buf_len)
 
     if (ecg_num_samples > 0 || bioz_samples > 0) 
     {
-    ecg_sensor_sample.ecg_num_samples = edata->num_samples_ecg;
-    ecg_sensor_sample.bioz_num_samples = edata->num_samples_bioz;
-
-        // Apply smoothing filter to ECG samples if enabled
-        for (int i = 0; i < edata->num_samples_ecg; i++)
+        // Fill the pooled block in place; fall back to scratch so lead detection still runs if the pool is empty
+        if (get_ecg_active() || get_gsr_active())
         {
-            int32_t raw_sample = edata->ecg_samples[i];
-            ecg_sensor_sample.ecg_samples[i] = ecg_smooth_sample(raw_sample);
+            blk = hpi_sample_block_alloc(HPI_SAMPLE_BLOCK_ECG);
+            if (blk != NULL)
+            {
+                ecg_sensor_sample = &blk->ecg;
+            }
         }
+        memset(ecg_sensor_sample, 0, sizeof(*ecg_sensor_sample));
+
+    ecg_sensor_sample->ecg_num_samples = edata->num_samples_ecg;
+    ecg_sensor_sample->bioz_num_samples = edata->num_samples_bioz;
+
+        // Stream profile for recording, BLE and QRS; 0.5-40 Hz display filtering for the plot only
+        hpi_ecg_filter_process(edata->ecg_samples, ecg_sensor_sample->ecg_samples,
+                               ecg_sensor_sample->ecg_plot_samples, edata->num_samples_ecg);
 
         for (int i = 0; i < edata->num_samples_bioz; i++)
         {
-            ecg_sensor_sample.bioz_sample[i] = edata->bioz_samples[i];
+            ecg_sensor_sample->bioz_sample[i] = edata->bioz_samples[i];
         }
 
-    ecg_sensor_sample.hr = edata->hr;
-    ecg_sensor_sample.rtor = edata->rri;
+    ecg_sensor_sample->hr = edata->hr;
+    ecg_sensor_sample->rtor = edata->rri;
+    ecg_sensor_sample->rrint = edata->rrint;
 
         set_ecg_hr(edata->hr);
-        // ecg_bioz_sensor_sample.rrint = edata->rri;
 
         // LOG_DBG("RRI: %d", edata->rri);
 
-    ecg_sensor_sample.ecg_lead_off = edata->ecg_lead_off;
+    ecg_sensor_sample->ecg_lead_off = edata->ecg_lead_off;
 
         // Thread-safe lead detection logic with debouncing
         bool current_lead_state = get_ecg_lead_on_off();
@@ -605,12 +533,17 @@ static void sensor_ecg_process_decode(uint8_t *buf, uint32_t buf_len)
             // else: already in lead-on state, nothing to do
         }
 
-        if (get_ecg_active() || get_gsr_active())
+        if (blk != NULL)
         {
-    int ret = k_msgq_put(&q_ecg_sample, &ecg_sensor_sample, K_NO_WAIT);
+            int ret = hpi_sample_block_publish(&q_ecg_sample, blk);
             if (ret != 0) {
                 LOG_WRN("ECG/GSR sample dropped - queue full (ret=%d)", ret);
             }
+            hpi_sample_block_unref(blk);
+        }
+        else if (get_ecg_active() || get_gsr_active())
+        {
+            LOG_WRN("ECG/GSR sample dropped - sample pool empty");
         }
     }
     else
@@ -619,23 +552,6 @@ static void sensor_ecg_process_decode(uint8_t *buf, uint32_t buf_len)
     }
 }
 
-static void work_ecg_sample_handler(struct k_work *work)
-{
-    uint8_t ecg_bioz_buf[512];
-    int ret;
-    
-    ret = sensor_read(&max30001_iodev, &max30001_read_rtio_poll_ctx, ecg_bioz_buf, sizeof(ecg_bioz_buf));
-    if (ret < 0) {
-        LOG_ERR("Error reading sensor data: %d", ret);
-        return;
-    }
-    if (ret == 0) {
-        return;
-    }
-    sensor_ecg_process_decode(ecg_bioz_buf, ret);
-}
-
-K_WORK_DEFINE(work_ecg_sample, work_ecg_sample_handler);
 /**
  * @brief Process only BioZ samples from the encoded RTIO buffer.
  * This is a lightweight decoder used when only GSR/BioZ sampling is active.
@@ -649,7 +565,6 @@ static void sensor_bioz_only_process_decode(uint8_t *buf, uint32_t buf_len)
     }
 
     const struct max30001_encoded_data *edata = (const struct max30001_encoded_data *)buf;
-    struct hpi_ecg_bioz_sensor_data_t sample;
 
     uint8_t bioz_samples = edata->num_samples_bioz;
     if (bioz_samples == 0) {
@@ -661,18 +576,6 @@ static void sensor_bioz_only_process_decode(uint8_t *buf, uint32_t buf_len)
         return;
     }
 
-    // Zero out ECG portion since this decoder only handles BioZ
-    sample.ecg_num_samples = 0;
-    sample.bioz_num_samples = bioz_samples;
-    for (int i = 0; i < bioz_samples; i++) {
-        sample.bioz_sample[i] = edata->bioz_samples[i];
-    }
-
-    sample.hr = edata->hr;
-    sample.rtor = edata->rri;
-    sample.ecg_lead_off = edata->ecg_lead_off;
-
-
   //  LOG_DBG("GSR sensor data: bioz_lead_off=%d", edata->bioz_lead_off);
     
     if (edata->bioz_lead_off == 1)
@@ -691,55 +594,93 @@ static void sensor_bioz_only_process_decode(uint8_t *buf, uint32_t buf_len)
     }
 
     if (get_gsr_active() || hpi_recording_is_signal_enabled(REC_SIGNAL_GSR)) {
-        struct hpi_bioz_sample_t bsample = {0};
-        bsample.bioz_num_samples = sample.bioz_num_samples;
-        bsample.bioz_lead_off = sample.bioz_lead_off;
-        bsample.timestamp = k_uptime_get();
-        for (int i = 0; i < sample.bioz_num_samples && i < BIOZ_POINTS_PER_SAMPLE; i++) {
-            bsample.bioz_samples[i] = sample.bioz_sample[i];
+        struct hpi_sample_block *bblk = hpi_sample_block_alloc(HPI_SAMPLE_BLOCK_BIOZ);
+        if (bblk == NULL) {
+            LOG_WRN("BioZ sample dropped - sample pool empty");
+            return;
+        }
+        struct hpi_bioz_sample_t *bsample = &bblk->bioz;
+        bsample->bioz_num_samples = MIN(bioz_samples, BIOZ_POINTS_PER_SAMPLE);
+        bsample->bioz_lead_off = edata->bioz_lead_off;
+        bsample->timestamp = k_uptime_get();
+        for (int i = 0; i < bsample->bioz_num_samples; i++) {
+            bsample->bioz_samples[i] = edata->bioz_samples[i];
         }
-        int ret = k_msgq_put(&q_bioz_sample, &bsample, K_NO_WAIT);
+        int ret = hpi_sample_block_publish(&q_bioz_sample, bblk);
         if (ret != 0) {
             LOG_WRN("BioZ sample dropped - bqueue full (ret=%d)", ret);
         }
+        hpi_sample_block_unref(bblk);
     }
 }
 
-static void work_bioz_sample_handler(struct k_work *work)
-{
-    uint8_t ecg_bioz_buf[512];
-    int ret;
+/*
+ * ECG/BioZ acquisition. sensor_read() on the MAX30001 only completes when its
+ * FIFO-threshold interrupt fires (or the driver's timeout expires), so this
+ * thread sleeps between FIFO events instead of being woken by sampling timers.
+ */
+#define ECG_BIOZ_ACQ_ECG  BIT(0)
+#define ECG_BIOZ_ACQ_BIOZ BIT(1)
+#define ECG_BIOZ_ACQ_ERR_BACKOFF_MS 100
 
-    ret = sensor_read(&max30001_iodev, &max30001_read_rtio_poll_ctx, ecg_bioz_buf, sizeof(ecg_bioz_buf));
-    if (ret < 0) {
-        LOG_ERR("Error reading sensor data (BioZ only): %d", ret);
-        return;
-    }
-    if (ret == 0) {
-        return;
+static atomic_t ecg_bioz_acq_mask = ATOMIC_INIT(0);
+K_SEM_DEFINE(sem_ecg_bioz_acq, 0, 1);
+
+static void ecg_bioz_acq_start(atomic_val_t which)
+{
+    if (atomic_or(&ecg_bioz_acq_mask, which) == 0) {
+        k_sem_give(&sem_ecg_bioz_acq);
     }
-    sensor_bioz_only_process_decode(ecg_bioz_buf, ret);
 }
 
-K_WORK_DEFINE(work_bioz_sample, work_bioz_sample_handler);
-
-static void ecg_sampling_handler(struct k_timer *dummy)
+static void ecg_bioz_acq_stop(atomic_val_t which)
 {
-    if (get_ecg_active()) {
-        k_work_submit(&work_ecg_sample);
-    }
+    // The read in flight finishes at the next FIFO event or driver timeout
+    atomic_and(&ecg_bioz_acq_mask, ~which);
 }
 
-static void bioz_sampling_handler(struct k_timer *dummy)
+static void ecg_bioz_acq_thread(void)
 {
-    if (get_gsr_active() || hpi_recording_is_signal_enabled(REC_SIGNAL_GSR)) {
-        k_work_submit(&work_bioz_sample);
+    static uint8_t ecg_bioz_buf[sizeof(struct max30001_encoded_data)];
+
+    for (;;)
+    {
+        k_sem_take(&sem_ecg_bioz_acq, K_FOREVER);
+
+        atomic_val_t mask;
+        while ((mask = atomic_get(&ecg_bioz_acq_mask)) != 0)
+        {
+            int ret = sensor_read(&max30001_iodev, &max30001_read_rtio_poll_ctx, ecg_bioz_buf, sizeof(ecg_bioz_buf));
+            if (ret < 0) {
+                LOG_ERR("Error reading sensor data: %d", ret);
+                k_msleep(ECG_BIOZ_ACQ_ERR_BACKOFF_MS);
+                continue;
+            }
+            if (ret == 0) {
+                continue;
+            }
+
+            // Wait is measured from the driver draining the FIFO (header timestamp)
+            uint64_t start_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+            uint64_t ready_ns = ((const struct max30001_encoded_data *)ecg_bioz_buf)->header.timestamp;
+            uint32_t start_cyc = k_cycle_get_32();
+
+            if ((mask & ECG_BIOZ_ACQ_ECG) && get_ecg_active()) {
+                sensor_ecg_process_decode(ecg_bioz_buf, ret);
+            }
+            if ((mask & ECG_BIOZ_ACQ_BIOZ) &&
+                (get_gsr_active() || hpi_recording_is_signal_enabled(REC_SIGNAL_GSR))) {
+                sensor_bioz_only_process_decode(ecg_bioz_buf, ret);
+            }
+
+            hpi_sensor_work_account(HPI_SENSOR_WORK_ECG_BIOZ,
+                                    (uint32_t)((start_ns - MIN(ready_ns, start_ns)) / 1000),
+                                    (uint32_t)k_cyc_to_us_floor64(k_cycle_get_32() - start_cyc),
+                                    CONFIG_SENSOR_MAX30001_FIFO_LATENCY_MS * 1000);
+        }
     }
 }
 
-K_TIMER_DEFINE(tmr_ecg_sampling, ecg_sampling_handler, NULL);
-K_TIMER_DEFINE(tmr_bioz_sampling, bioz_sampling_handler, NULL);
-
 static int hw_max30001_bioz_enable(void) __attribute__((unused));
 static int hw_max30001_bioz_enable(void)
 {
@@ -834,9 +775,7 @@ void gsr_background_start(void)
     hpi_data_set_gsr_record_active(false);
     hw_max30001_gsr_enable();
 
-    k_timer_start(&tmr_bioz_sampling,
-                  K_MSEC(BIOZ_SAMPLING_INTERVAL_MS),
-                  K_MSEC(BIOZ_SAMPLING_INTERVAL_MS));
+    ecg_bioz_acq_start(ECG_BIOZ_ACQ_BIOZ);
 }
 
 void gsr_background_stop(void)
@@ -852,7 +791,7 @@ void gsr_background_stop(void)
 
     if( !hpi_data_is_gsr_measurement_active() ) {
       set_gsr_active(false);
-      k_timer_stop(&tmr_bioz_sampling);
+      ecg_bioz_acq_stop(ECG_BIOZ_ACQ_BIOZ);
       hw_max30001_gsr_disable();
     }
     
@@ -871,10 +810,10 @@ static void st_ecg_idle_entry(void *o)
         LOG_ERR("Failed to disable ECG in idle entry: %d", ret);
     }
 
-    // Only stop timers if GSR is also not active
+    // Keep BioZ acquisition running if GSR is still active
+    ecg_bioz_acq_stop(ECG_BIOZ_ACQ_ECG);
     if (!get_gsr_active()) {
-        k_timer_stop(&tmr_ecg_sampling);
-        k_timer_stop(&tmr_bioz_sampling);
+        ecg_bioz_acq_stop(ECG_BIOZ_ACQ_BIOZ);
 
         ret = hw_max30001_bioz_disable();
         if (ret != 0) {
@@ -939,9 +878,7 @@ static void st_gsr_entry_run(void *o)
     gsr_countdown_val = GSR_MEASUREMENT_DURATION_S;
     prev_gsr_contact_ok =  gsr_contact_ok;  // reset state
 
-    k_timer_start(&tmr_bioz_sampling,
-                  K_MSEC(BIOZ_SAMPLING_INTERVAL_MS),
-                  K_MSEC(BIOZ_SAMPLING_INTERVAL_MS));
+    ecg_bioz_acq_start(ECG_BIOZ_ACQ_BIOZ);
 
     bool current_lead_off = get_gsr_lead_on_off();
     if (current_lead_off) {
@@ -1017,11 +954,10 @@ static void st_gsr_stream_run(void *o)
 static void st_gsr_stream_exit(void *o)
 {
     LOG_DBG("BioZ SM Stream Exit");
-     // k_timer_stop(&tmr_bioz_sampling);
    if (!hpi_recording_is_signal_enabled(REC_SIGNAL_GSR))
     {
         hpi_data_set_gsr_measurement_active(false);
-        k_timer_stop(&tmr_bioz_sampling);
+        ecg_bioz_acq_stop(ECG_BIOZ_ACQ_BIOZ);
         int  ret = hw_max30001_gsr_disable();
 
         if (ret != 0) {
@@ -1094,11 +1030,11 @@ static void st_ecg_wait_for_lead_entry(void *o)
             smf_set_state(SMF_CTX(&s_ecg_obj), &ecg_states[HPI_ECG_STATE_IDLE]);
             return;
         }
-        k_timer_start(&tmr_ecg_sampling, K_MSEC(ECG_SAMPLING_INTERVAL_MS), K_MSEC(ECG_SAMPLING_INTERVAL_MS));
+        ecg_bioz_acq_start(ECG_BIOZ_ACQ_ECG);
     }
 
     // Reset smoothing filter
-    ecg_smooth_reset();
+    hpi_ecg_filter_reset();
 
     // Start lead placement timeout
     lead_placement_wait_start = k_uptime_get();
@@ -1202,7 +1138,7 @@ static void st_ecg_stabilizing_entry(void *o)
     LOG_INF("ECG SMF: Entering STABILIZING state - %d seconds", ECG_STABILIZATION_DURATION_S);
 
     // Reset smoothing filter
-    ecg_smooth_reset();
+    hpi_ecg_filter_reset();
 
     // Initialize stabilization countdown
     set_ecg_stabilization_values(ECG_STABILIZATION_DURATION_S, false);
@@ -1212,6 +1148,7 @@ static void st_ecg_stabilizing_entry(void *o)
     if (get_hrv_active()) {
         hrv_interval_count = 0;
         memset(hrv_intervals, 0, sizeof(hrv_intervals));
+        hpi_hrv_stream_reset();
         hrv_last_status_pub_s = 0;
     }
 
@@ -1331,6 +1268,7 @@ static void st_ecg_recording_entry(void *o)
         LOG_INF("ECG SMF: HRV recording started");
         hrv_interval_count = 0;
         memset(hrv_intervals, 0, sizeof(hrv_intervals));
+        hpi_hrv_stream_reset();
         hrv_last_status_pub_s = 0;
     }
 }
@@ -1416,10 +1354,10 @@ static void st_ecg_complete_entry(void *o)
     // Stop recording - this is the successful completion path
     hpi_data_set_ecg_record_active(false);
 
-    // Only stop timer if GSR is also not active
+    // Keep BioZ acquisition running if GSR is still active
+    ecg_bioz_acq_stop(ECG_BIOZ_ACQ_ECG);
     if (!get_gsr_active()) {
-        k_timer_stop(&tmr_ecg_sampling);
-        k_timer_stop(&tmr_bioz_sampling);
+        ecg_bioz_acq_stop(ECG_BIOZ_ACQ_BIOZ);
     }
 
     ret = hw_max30001_ecg_disable();
@@ -1525,3 +1463,9 @@ void smf_ecg_thread(void)
 // File writes require ~500-700 bytes for LittleFS operations, path buffers,
 // and file structures. 1024 bytes was causing stack overflow crashes.
 K_THREAD_DEFINE(smf_ecg_thread_id, 4096, smf_ecg_thread, NULL, NULL, NULL, 10, 0, 0);
+
+#define ECG_BIOZ_ACQ_THREAD_STACKSIZE 2048
+// Decode and publish at the same priority as the other sensors' work queues
+#define ECG_BIOZ_ACQ_THREAD_PRIORITY CONFIG_HPI_SENSOR_WQ_PRIORITY
+
+K_THREAD_DEFINE(ecg_bioz_acq_thread_id, ECG_BIOZ_ACQ_THREAD_STACKSIZE, ecg_bioz_acq_thread, NULL, NULL, NULL, ECG_BIOZ_ACQ_THREAD_PRIORITY, 0, 0);
@@ -33,6 +33,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/zbus/zbus.h>
 #include <errno.h>
+#include <string.h>
 
 LOG_MODULE_REGISTER(smf_ppg_finger, LOG_LEVEL_DBG);
 
@@ -43,6 +44,8 @@ LOG_MODULE_REGISTER(smf_ppg_finger, LOG_LEVEL_DBG);
 #include "ui/move_ui.h"
 #include "cmd_module.h"
 #include "hpi_sys.h"
+#include "hpi_sample_pool.h"
+#include "hpi_sensor_workq.h"
 
 #define PPG_FI_SAMPLING_INTERVAL_MS 20
 #define MAX30101_SENSOR_ID 0x15
@@ -75,7 +78,7 @@ K_SEM_DEFINE(sem_finger_contact_timeout, 0, 1);
 
 ZBUS_CHAN_DECLARE(bpt_chan);
 
-K_MSGQ_DEFINE(q_ppg_fi_sample, sizeof(struct hpi_ppg_fi_data_t), 64, 1);
+HPI_SAMPLE_BLOCK_MSGQ_DEFINE(q_ppg_fi_sample, HPI_SAMPLE_QDEPTH_PPG_FI);
 
 SENSOR_DT_READ_IODEV(max32664d_iodev, DT_ALIAS(max32664d), {SENSOR_CHAN_VOLTAGE});
 RTIO_DEFINE(max32664d_read_rtio_poll_ctx, 8, 8);
@@ -170,7 +173,9 @@ void hpi_bpt_set_cal_vals(uint8_t cal_index, uint8_t cal_sys, uint8_t cal_dia)
 static void sensor_ppg_finger_decode(uint8_t *buf, uint32_t buf_len, uint8_t m_ppg_op_mode)
 {
     const struct max32664d_encoded_data *edata = (const struct max32664d_encoded_data *)buf;
-    struct hpi_ppg_fi_data_t ppg_sensor_sample;
+    static struct hpi_ppg_fi_data_t ppg_scratch;
+    struct hpi_sample_block *blk = NULL;
+    struct hpi_ppg_fi_data_t *ppg_sensor_sample = &ppg_scratch;
 
     uint8_t finger_status = edata->bpt_status ;
 
@@ -225,33 +230,42 @@ static void sensor_ppg_finger_decode(uint8_t *buf, uint32_t buf_len, uint8_t m_p
 
     if (_n_samples > 0)
     {
-        ppg_sensor_sample.ppg_num_samples = _n_samples;
+        // Decode straight into a pooled block; scratch keeps the BPT/SpO2 state handling alive if the pool is empty
+        blk = hpi_sample_block_alloc(HPI_SAMPLE_BLOCK_PPG_FI);
+        if (blk != NULL)
+        {
+            ppg_sensor_sample = &blk->ppg_fi;
+        }
+        /* Initialize to zero to prevent garbage values in unused fields */
+        memset(ppg_sensor_sample, 0, sizeof(*ppg_sensor_sample));
+
+        ppg_sensor_sample->ppg_num_samples = _n_samples;
 
         for (int i = 0; i < _n_samples; i++)
         {
-            ppg_sensor_sample.raw_red[i] = edata->red_samples[i];
-            ppg_sensor_sample.raw_ir[i] = edata->ir_samples[i];
+            ppg_sensor_sample->raw_red[i] = edata->red_samples[i];
+            ppg_sensor_sample->raw_ir[i] = edata->ir_samples[i];
         }
-        ppg_sensor_sample.hr = edata->hr;
-        ppg_sensor_sample.spo2 = edata->spo2;
+        ppg_sensor_sample->hr = edata->hr;
+        ppg_sensor_sample->spo2 = edata->spo2;
 
         if (m_ppg_op_mode == PPG_FI_OP_MODE_BPT_EST || m_ppg_op_mode == PPG_FI_OP_MODE_BPT_CAL)
         {
-            ppg_sensor_sample.bp_sys = edata->bpt_sys;
-            ppg_sensor_sample.bp_dia = edata->bpt_dia;
-            ppg_sensor_sample.bpt_status = edata->bpt_status;
-            ppg_sensor_sample.bpt_progress = edata->bpt_progress;
+            ppg_sensor_sample->bp_sys = edata->bpt_sys;
+            ppg_sensor_sample->bp_dia = edata->bpt_dia;
+            ppg_sensor_sample->bpt_status = edata->bpt_status;
+            ppg_sensor_sample->bpt_progress = edata->bpt_progress;
         }
         else if (m_ppg_op_mode == PPG_FI_OP_MODE_SPO2_EST)
         {
-            ppg_sensor_sample.spo2_valid_percent_complete = edata->spo2_conf;
+            ppg_sensor_sample->spo2_valid_percent_complete = edata->spo2_conf;
             if (edata->spo2_conf < 70)
             {
-                ppg_sensor_sample.spo2_state = SPO2_MEAS_COMPUTATION;
+                ppg_sensor_sample->spo2_state = SPO2_MEAS_COMPUTATION;
             }
             else if (spo2_process_done == false)
             {
-                ppg_sensor_sample.spo2_state = SPO2_MEAS_SUCCESS;
+                ppg_sensor_sample->spo2_state = SPO2_MEAS_SUCCESS;
                 LOG_INF("SpO2 Measurement Done");
                 hpi_bpt_stop();  // Stop the sensor algorithms
                 k_sem_give(&sem_spo2_est_complete);
@@ -259,7 +273,11 @@ static void sensor_ppg_finger_decode(uint8_t *buf, uint32_t buf_len, uint8_t m_p
             }
         }
 
-        k_msgq_put(&q_ppg_fi_sample, &ppg_sensor_sample, K_MSEC(1));
+        if (blk != NULL)
+        {
+            hpi_sample_block_publish(&q_ppg_fi_sample, blk);
+            hpi_sample_block_unref(blk);
+        }
         // k_sem_give(&sem_ppg_finger_sample_trigger);
 
         // LOG_DBG("Status: %d Progress: %d Sys: %d Dia: %d SpO2: %d", edata->bpt_status, edata->bpt_progress, edata->bpt_sys, edata->bpt_dia, edata->spo2);
@@ -348,11 +366,12 @@ void work_fi_sample_handler(struct k_work *work)
     consecutive_timeouts = 0;
     sensor_ppg_finger_decode(data_buf, sizeof(data_buf), sens_decode_ppg_fi_op_mode);
 }
-K_WORK_DEFINE(work_fi_sample, work_fi_sample_handler);
+static HPI_SENSOR_WORK_DEFINE(work_fi_sample, work_fi_sample_handler, HPI_SENSOR_WQ_I2C1,
+                              HPI_SENSOR_WORK_PPG_FINGER, PPG_FI_SAMPLING_INTERVAL_MS * 1000);
 
 static void ppg_fi_sampling_handler(struct k_timer *timer_id)
 {
-    k_work_submit(&work_fi_sample);
+    hpi_sensor_work_submit(&work_fi_sample);
 }
 
 K_TIMER_DEFINE(tmr_ppg_fi_sampling, ppg_fi_sampling_handler, NULL);
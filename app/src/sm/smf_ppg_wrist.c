@@ -32,6 +32,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/zbus/zbus.h>
 #include <errno.h>
+#include <string.h>
 
 LOG_MODULE_REGISTER(smf_ppg_wrist, LOG_LEVEL_DBG);
 
@@ -40,6 +41,8 @@ LOG_MODULE_REGISTER(smf_ppg_wrist, LOG_LEVEL_DBG);
 #include "hpi_common_types.h"
 #include "hpi_sys.h"
 #include "ui/move_ui.h"
+#include "hpi_sample_pool.h"
+#include "hpi_sensor_workq.h"
 
 // State machine parameters
 #define PPG_WRIST_SAMPLING_INTERVAL_MS 160
@@ -85,7 +88,7 @@ K_SEM_DEFINE(sem_start_one_shot_spo2, 0, 1);
 K_SEM_DEFINE(sem_stop_one_shot_spo2, 0, 1);
 K_SEM_DEFINE(sem_spo2_cancel, 0, 1);
 
-K_MSGQ_DEFINE(q_ppg_wrist_sample, sizeof(struct hpi_ppg_wr_data_t), 64, 1);
+HPI_SAMPLE_BLOCK_MSGQ_DEFINE(q_ppg_wrist_sample, HPI_SAMPLE_QDEPTH_PPG_WR);
 
 // RTIO context with memory pool for async sensor reads
 RTIO_DEFINE_WITH_MEMPOOL(max32664c_read_rtio_async_ctx, 4, 4, 4, 512, 4);
@@ -195,8 +198,9 @@ static int get_measured_spo2(uint16_t *spo2_value, enum spo2_meas_state *status)
 static void sensor_ppg_wrist_decode(uint8_t *buf, uint32_t buf_len)
 {
     const struct max32664c_encoded_data *edata = (const struct max32664c_encoded_data *)buf;
-    /* Initialize to zero to prevent garbage values in unused fields */
-    struct hpi_ppg_wr_data_t ppg_sensor_sample = {0};
+    static struct hpi_ppg_wr_data_t ppg_scratch;
+    struct hpi_sample_block *blk = NULL;
+    struct hpi_ppg_wr_data_t *ppg_sensor_sample = &ppg_scratch;
 
     uint16_t _n_samples = edata->num_samples;
 
@@ -248,43 +252,52 @@ static void sensor_ppg_wrist_decode(uint8_t *buf, uint32_t buf_len)
         }
         if (_n_samples > 0)
         {
-            ppg_sensor_sample.ppg_num_samples = _n_samples;
+            // Decode straight into a pooled block; scratch keeps SCD/SpO2 handling alive if the pool is empty
+            blk = hpi_sample_block_alloc(HPI_SAMPLE_BLOCK_PPG_WR);
+            if (blk != NULL)
+            {
+                ppg_sensor_sample = &blk->ppg_wr;
+            }
+            /* Initialize to zero to prevent garbage values in unused fields */
+            memset(ppg_sensor_sample, 0, sizeof(*ppg_sensor_sample));
+
+            ppg_sensor_sample->ppg_num_samples = _n_samples;
 
             for (int i = 0; i < _n_samples; i++)
             {
-                ppg_sensor_sample.raw_red[i] = edata->red_samples[i];
-                ppg_sensor_sample.raw_ir[i] = edata->ir_samples[i];
-                ppg_sensor_sample.raw_green[i] = edata->green_samples[i];
+                ppg_sensor_sample->raw_red[i] = edata->red_samples[i];
+                ppg_sensor_sample->raw_ir[i] = edata->ir_samples[i];
+                ppg_sensor_sample->raw_green[i] = edata->green_samples[i];
             }
 
             if (edata->chip_op_mode == MAX32664C_OP_MODE_RAW)
             {
-                ppg_sensor_sample.hr = 0;
-                ppg_sensor_sample.spo2 = 0;
-                ppg_sensor_sample.rtor = 0;
-                ppg_sensor_sample.scd_state = 0;
+                ppg_sensor_sample->hr = 0;
+                ppg_sensor_sample->spo2 = 0;
+                ppg_sensor_sample->rtor = 0;
+                ppg_sensor_sample->scd_state = 0;
             }
             else
             {
-                ppg_sensor_sample.hr = edata->hr;
-                ppg_sensor_sample.spo2 = edata->spo2;
-                ppg_sensor_sample.rtor = edata->rtor;
-                ppg_sensor_sample.scd_state = edata->scd_state;
-                ppg_sensor_sample.hr_confidence = edata->hr_confidence;
-                ppg_sensor_sample.spo2_confidence = edata->spo2_confidence;
-                ppg_sensor_sample.spo2_excessive_motion = edata->spo2_excessive_motion;
-                ppg_sensor_sample.spo2_valid_percent_complete = edata->spo2_valid_percent_complete;
-                ppg_sensor_sample.spo2_state = edata->spo2_state;
-                ppg_sensor_sample.spo2_low_pi = edata->spo2_low_pi;
+                ppg_sensor_sample->hr = edata->hr;
+                ppg_sensor_sample->spo2 = edata->spo2;
+                ppg_sensor_sample->rtor = edata->rtor;
+                ppg_sensor_sample->scd_state = edata->scd_state;
+                ppg_sensor_sample->hr_confidence = edata->hr_confidence;
+                ppg_sensor_sample->spo2_confidence = edata->spo2_confidence;
+                ppg_sensor_sample->spo2_excessive_motion = edata->spo2_excessive_motion;
+                ppg_sensor_sample->spo2_valid_percent_complete = edata->spo2_valid_percent_complete;
+                ppg_sensor_sample->spo2_state = edata->spo2_state;
+                ppg_sensor_sample->spo2_low_pi = edata->spo2_low_pi;
             }
 
             // Update current SCD state for general tracking
-            m_curr_scd_state = ppg_sensor_sample.scd_state;
+            m_curr_scd_state = ppg_sensor_sample->scd_state;
 
             // Process SCD state changes for power optimization in ACTIVE state
             if (m_curr_state == PPG_SAMP_STATE_ACTIVE && edata->chip_op_mode == MAX32664C_OP_MODE_ALGO_AEC)
             {
-                if (ppg_sensor_sample.scd_state == MAX32664C_SCD_STATE_ON_SKIN)
+                if (ppg_sensor_sample->scd_state == MAX32664C_SCD_STATE_ON_SKIN)
                 {
                     // Reset off-skin timer if back on skin
                     if (off_skin_timer_active)
@@ -293,7 +306,7 @@ static void sensor_ppg_wrist_decode(uint8_t *buf, uint32_t buf_len)
                         k_work_cancel_delayable(&work_off_skin_threshold);
                     }
                 }
-                else if (ppg_sensor_sample.scd_state == MAX32664C_SCD_STATE_OFF_SKIN)
+                else if (ppg_sensor_sample->scd_state == MAX32664C_SCD_STATE_OFF_SKIN)
                 {
                     // Start off-skin timer if not already started
                     if (!off_skin_timer_active)
@@ -305,53 +318,57 @@ static void sensor_ppg_wrist_decode(uint8_t *buf, uint32_t buf_len)
                 }
             }
 
-            if ((ppg_sensor_sample.spo2_valid_percent_complete == 100) && spo2_measurement_in_progress)
+            if ((ppg_sensor_sample->spo2_valid_percent_complete == 100) && spo2_measurement_in_progress)
             {
                 k_sem_give(&sem_stop_one_shot_spo2);
-                if (ppg_sensor_sample.spo2_confidence > 50)
+                if (ppg_sensor_sample->spo2_confidence > 50)
                 {
                     struct hpi_spo2_point_t spo2_chan_value = {
                         .timestamp = hw_get_sys_time_ts(),
-                        .spo2 = ppg_sensor_sample.spo2,
+                        .spo2 = ppg_sensor_sample->spo2,
                     };
                     zbus_chan_pub(&spo2_chan, &spo2_chan_value, K_SECONDS(1));
 
-                    smf_ppg_spo2_last_measured_value = ppg_sensor_sample.spo2;
+                    smf_ppg_spo2_last_measured_value = ppg_sensor_sample->spo2;
                     smf_ppg_spo2_last_measured_time = hw_get_sys_time_ts();
-                    hpi_sys_set_last_spo2_update(ppg_sensor_sample.spo2, smf_ppg_spo2_last_measured_time);
-                    set_measured_spo2(ppg_sensor_sample.spo2, SPO2_MEAS_SUCCESS);
+                    hpi_sys_set_last_spo2_update(ppg_sensor_sample->spo2, smf_ppg_spo2_last_measured_time);
+                    set_measured_spo2(ppg_sensor_sample->spo2, SPO2_MEAS_SUCCESS);
                 }
                 else
                 {
                    LOG_DBG("SpO2 invalid: conf=%d, motion=%d, low_pi=%d, scd=%d",
-                   ppg_sensor_sample.spo2_confidence,
-                   ppg_sensor_sample.spo2_excessive_motion,
-                   ppg_sensor_sample.spo2_low_pi,
-                   ppg_sensor_sample.scd_state);
+                   ppg_sensor_sample->spo2_confidence,
+                   ppg_sensor_sample->spo2_excessive_motion,
+                   ppg_sensor_sample->spo2_low_pi,
+                   ppg_sensor_sample->scd_state);
                 }
                 spo2_measurement_in_progress = false;
             }
             else if(spo2_measurement_in_progress)
             {
                 LOG_INF("Spo2 : %d | Confidence : %d | Progress : %d | SCD : %d | Low PI : %d",
-                   ppg_sensor_sample.spo2,
-                   ppg_sensor_sample.spo2_confidence,
-                   ppg_sensor_sample.spo2_valid_percent_complete,
-                   ppg_sensor_sample.scd_state,
-                   ppg_sensor_sample.spo2_low_pi);
+                   ppg_sensor_sample->spo2,
+                   ppg_sensor_sample->spo2_confidence,
+                   ppg_sensor_sample->spo2_valid_percent_complete,
+                   ppg_sensor_sample->scd_state,
+                   ppg_sensor_sample->spo2_low_pi);
             }
 
-            if (ppg_sensor_sample.spo2_state == SPO2_MEAS_TIMEOUT)
+            if (ppg_sensor_sample->spo2_state == SPO2_MEAS_TIMEOUT)
             {
                 k_sem_give(&sem_stop_one_shot_spo2);
                 set_measured_spo2(0, SPO2_MEAS_TIMEOUT);
                 spo2_measurement_in_progress = false;
             }
 
-            m_curr_scd_state = ppg_sensor_sample.scd_state;
-            if (ppg_sensor_sample.scd_state == MAX32664C_SCD_STATE_ON_SKIN)
+            m_curr_scd_state = ppg_sensor_sample->scd_state;
+            if (blk != NULL)
             {
-                k_msgq_put(&q_ppg_wrist_sample, &ppg_sensor_sample, K_MSEC(1));
+                if (ppg_sensor_sample->scd_state == MAX32664C_SCD_STATE_ON_SKIN)
+                {
+                    hpi_sample_block_publish(&q_ppg_wrist_sample, blk);
+                }
+                hpi_sample_block_unref(blk);
             }
         }
     }
@@ -395,16 +412,15 @@ static void sensor_rtio_completion_handler(struct k_work *work)
     }
 }
 
-K_WORK_DEFINE(sensor_rtio_completion_work, sensor_rtio_completion_handler);
+static HPI_SENSOR_WORK_DEFINE(sensor_rtio_completion_work, sensor_rtio_completion_handler,
+                              HPI_SENSOR_WQ_I2C2, HPI_SENSOR_WORK_PPG_WRIST_DECODE,
+                              PPG_WRIST_SAMPLING_INTERVAL_MS * 1000);
 
 // Separate work item for initiating async sensor reads
 static void sensor_read_work_handler(struct k_work *work)
 {
     int ret;
 
-    // Process any pending completions first
-    k_work_submit(&sensor_rtio_completion_work);
-
     // Start async sensor read with mempool
     ret = sensor_read_async_mempool(&max32664c_iodev, &max32664c_read_rtio_async_ctx, &max32664c_iodev);
     if (ret < 0)
@@ -413,21 +429,17 @@ static void sensor_read_work_handler(struct k_work *work)
         return;
     }
 
-    // The read is now in progress - completion will be handled by the RTIO completion work
-}
-
-K_WORK_DEFINE(sensor_read_work, sensor_read_work_handler);
-
-void work_sample_handler(struct k_work *work)
-{
-    k_work_submit(&sensor_read_work);
+    // Completions (this one, or any still outstanding) are decoded by the completion work,
+    // queued behind this item on the same bus queue
+    hpi_sensor_work_submit(&sensor_rtio_completion_work);
 }
 
-K_WORK_DEFINE(work_sample, work_sample_handler);
+static HPI_SENSOR_WORK_DEFINE(sensor_read_work, sensor_read_work_handler, HPI_SENSOR_WQ_I2C2,
+                              HPI_SENSOR_WORK_PPG_WRIST_READ, PPG_WRIST_SAMPLING_INTERVAL_MS * 1000);
 
 void ppg_wrist_sampling_handler(struct k_timer *dummy)
 {
-    k_work_submit(&work_sample);
+    hpi_sensor_work_submit(&sensor_read_work);
 }
 
 K_TIMER_DEFINE(tmr_ppg_wrist_sampling, ppg_wrist_sampling_handler, NULL);
@@ -64,8 +64,14 @@ LOG_MODULE_REGISTER(trends_module, LOG_LEVEL_DBG);
 #define TEMP_TREND_MINUTE_PTS 12
 
 #define NUM_HOURS 24
-#define MAX_POINTS_PER_HOUR 60
-#define MAX_POINTS_SPO2_PER_HOUR 10
+
+// Day files are read in chunks of whole records, two flash pages at a time
+#define TREND_READ_CHUNK (32 * HPI_TREND_POINT_SIZE)
+
+// Hourly rollup sidecars: /lfs/trsum/<log_type>_<day_ts>
+#define TREND_ROLLUP_DIR "/lfs/trsum"
+#define TREND_ROLLUP_MAGIC 0x54525355 // "TRSU"
+#define TREND_ROLLUP_VERSION 1
 
 // Store raw HR values for the current minute
 static uint16_t m_hr_curr_minute[60] = {0};   // Assumed max 60 points per minute
@@ -74,15 +80,70 @@ static uint16_t m_temp_curr_minute[13] = {0}; // Assumed max 10 points per minut
 static uint16_t m_spo2 = 0;
 K_SEM_DEFINE(sem_spo2_updated, 0, 1);
 
+#if defined(CONFIG_HPI_GSR_STRESS_INDEX)
+// GSR stress levels published during the current minute, folded as they arrive
+static struct
+{
+    uint32_t sum;
+    uint16_t count;
+    uint16_t max;
+    uint16_t min;
+    uint16_t latest;
+} m_gsr_curr_minute;
+static struct k_spinlock gsr_minute_lock;
+#endif
+
 static uint8_t m_trends_curr_minute_counter = 0;
 
 static uint8_t m_trends_temp_minute_sample_counter = 0;
 static uint8_t m_trends_hr_minute_sample_counter = 0;
 
-// Static buffers to avoid large stack allocations (51KB total)
-// These replace the problematic stack arrays in hpi_trend_load_trend()
-static struct hpi_hr_trend_point_t trend_day_points[NUM_HOURS][MAX_POINTS_PER_HOUR];
-static struct hpi_hr_trend_point_t trend_point_all[1440];
+/*
+ * Hourly rollup of one day file. covered_bytes is the size of the day file
+ * already folded in, so only points appended since then are read on the
+ * next query. Slots keep sums rather than averages so they merge exactly.
+ */
+struct trend_rollup_hour
+{
+    uint16_t max;
+    uint16_t min;
+    uint32_t sum;
+    uint16_t count;
+    uint16_t latest;
+} __packed;
+
+struct trend_rollup_file
+{
+    uint32_t magic;
+    uint8_t version;
+    uint8_t log_type;
+    uint16_t reserved;
+    uint32_t covered_bytes;
+    struct trend_rollup_hour hours[NUM_HOURS];
+} __packed;
+
+static const uint8_t trend_log_types[] = {
+    [TREND_HR] = HPI_LOG_TYPE_TREND_HR,
+    [TREND_SPO2] = HPI_LOG_TYPE_TREND_SPO2,
+    [TREND_TEMP] = HPI_LOG_TYPE_TREND_TEMP,
+    [TREND_BPT] = HPI_LOG_TYPE_TREND_BPT,
+    [TREND_STEPS] = HPI_LOG_TYPE_TREND_STEPS,
+    [TREND_GSR] = HPI_LOG_TYPE_TREND_GSR,
+};
+
+static const char *const trend_dirs[] = {
+    [TREND_HR] = "/lfs/trhr/",
+    [TREND_SPO2] = "/lfs/trspo2/",
+    [TREND_TEMP] = "/lfs/trtemp/",
+    [TREND_BPT] = "/lfs/trbpt/",
+    [TREND_STEPS] = "/lfs/trsteps/",
+    [TREND_GSR] = "/lfs/trgsr/",
+};
+
+// Shared by all queries, serialised by mutex_trend_query
+static uint8_t trend_read_buf[TREND_READ_CHUNK];
+static struct trend_rollup_file trend_rollup;
+K_MUTEX_DEFINE(mutex_trend_query);
 
 // Time variables
 static struct tm m_trend_sys_time_tm;
@@ -93,6 +154,7 @@ K_MSGQ_DEFINE(q_spo2_trend, sizeof(struct hpi_spo2_point_t), 8, 4);
 K_MSGQ_DEFINE(q_temp_trend, sizeof(struct hpi_temp_trend_point_t), 8, 1);
 K_MSGQ_DEFINE(q_steps_trend, sizeof(struct hpi_steps_t), 8, 1);
 K_MSGQ_DEFINE(q_bpt_trend, sizeof(struct hpi_bpt_point_t), 4, 1);
+K_MSGQ_DEFINE(q_gsr_trend, sizeof(struct hpi_gsr_trend_point_t), 4, 1);
 
 static int hpi_trend_process_points()
 {
@@ -169,6 +231,23 @@ static int hpi_trend_process_points()
         k_msgq_put(&q_spo2_trend, &spo2_trend_point, K_NO_WAIT);
     }
 
+#if defined(CONFIG_HPI_GSR_STRESS_INDEX)
+    k_spinlock_key_t key = k_spin_lock(&gsr_minute_lock);
+    if (m_gsr_curr_minute.count > 0)
+    {
+        struct hpi_gsr_trend_point_t gsr_trend_point = {
+            .timestamp = m_trend_time_ts,
+            .max = m_gsr_curr_minute.max,
+            .min = m_gsr_curr_minute.min,
+            .avg = m_gsr_curr_minute.sum / m_gsr_curr_minute.count,
+            .latest = m_gsr_curr_minute.latest,
+        };
+        k_msgq_put(&q_gsr_trend, &gsr_trend_point, K_NO_WAIT);
+    }
+    memset(&m_gsr_curr_minute, 0, sizeof(m_gsr_curr_minute));
+    k_spin_unlock(&gsr_minute_lock, key);
+#endif
+
     m_trends_hr_minute_sample_counter = 0;
 }
 
@@ -209,6 +288,7 @@ void hpi_trend_record_thread(void)
     struct hpi_temp_trend_point_t trend_temp;
     struct hpi_steps_t trend_steps;
     struct hpi_bpt_point_t trend_bpt;
+    struct hpi_gsr_trend_point_t trend_gsr;
 
     /* start a periodic timer that expires once every second */
     k_timer_start(&tmr_trend_process, K_SECONDS(1), K_SECONDS(1));
@@ -250,147 +330,429 @@ void hpi_trend_record_thread(void)
             hpi_bpt_trend_wr_point_to_file(trend_bpt, today_ts);
         }
 
+        if (k_msgq_get(&q_gsr_trend, &trend_gsr, K_NO_WAIT) == 0)
+        {
+            int64_t today_ts = hpi_trend_get_day_start_ts(&trend_gsr.timestamp);
+            LOG_DBG("Recd GSR point: %" PRId64 "| %d | %d | %d", trend_gsr.timestamp, trend_gsr.max, trend_gsr.min, trend_gsr.avg);
+            hpi_gsr_trend_wr_point_to_file(trend_gsr, today_ts);
+        }
+
+        log_trend_poll();
+
         k_sleep(K_SECONDS(2));
     }
 }
 
-int hpi_trend_load_trend(struct hpi_hourly_trend_point_t *hourly_trend_points, struct hpi_minutely_trend_point_t *minutely_trend_points, int *num_points, enum trend_type m_trend_type)
+static void trend_decode(enum trend_type type, const uint8_t *rec, struct hpi_trend_sample_t *pt)
 {
-    struct fs_file_t file;
-    int ret = 0;
+    uint16_t v[4];
 
-    struct fs_dirent trend_file_ent;
-    char fname[30];
+    memcpy(&pt->timestamp, rec, sizeof(int64_t));
+    memcpy(v, &rec[sizeof(int64_t)], sizeof(v));
 
-    uint16_t num_trend_points;
+    switch (type)
+    {
+    case TREND_HR:
+    case TREND_TEMP:
+    case TREND_GSR:
+        pt->max = v[0];
+        pt->min = v[1];
+        pt->avg = v[2];
+        pt->latest = v[3];
+        break;
+    case TREND_BPT:
+        pt->max = v[0];    // Systolic
+        pt->min = v[1];    // Diastolic
+        pt->avg = v[2];    // Heart rate
+        pt->latest = v[0];
+        break;
+    default:               // SpO2 and steps carry a single value
+        pt->max = pt->min = pt->avg = pt->latest = v[0];
+        break;
+    }
+}
 
-    int64_t day_ts = hpi_trend_get_day_start_ts(&m_trend_time_ts);
+static bool trend_type_valid(enum trend_type type)
+{
+    return (unsigned int)type < ARRAY_SIZE(trend_dirs) && trend_dirs[type] != NULL;
+}
 
-    fs_file_t_init(&file);
+static int trend_open_day(struct fs_file_t *file, enum trend_type type, int64_t day_ts, uint32_t *size)
+{
+    char fname[40];
+    struct fs_dirent ent;
+
+    snprintf(fname, sizeof(fname), "%s%" PRId64, trend_dirs[type], day_ts);
 
-    // Clear static buffers before use
-    memset(trend_day_points, 0, sizeof(trend_day_points));
-    memset(trend_point_all, 0, sizeof(trend_point_all));
-    if (m_trend_type == TREND_HR)
+    int ret = fs_stat(fname, &ent);
+    if (ret < 0)
     {
-        sprintf(fname, "/lfs/trhr/%" PRId64, day_ts);
+        return ret;
     }
-    else if (m_trend_type == TREND_SPO2)
+
+    // Ignore a torn trailing record
+    *size = ent.size - (ent.size % HPI_TREND_POINT_SIZE);
+
+    fs_file_t_init(file);
+    return fs_open(file, fname, FS_O_READ);
+}
+
+static int64_t trend_read_timestamp(struct fs_file_t *file, uint32_t rec)
+{
+    int64_t ts = INT64_MAX;
+
+    if (fs_seek(file, (off_t)rec * HPI_TREND_POINT_SIZE, FS_SEEK_SET) == 0)
     {
-        sprintf(fname, "/lfs/trspo2/%" PRId64, day_ts);
+        fs_read(file, &ts, sizeof(ts));
     }
-    else
+    return ts;
+}
+
+// Day files are appended in time order: binary search the first record at or after from_ts
+static uint32_t trend_lower_bound(struct fs_file_t *file, uint32_t num_recs, int64_t from_ts)
+{
+    uint32_t lo = 0;
+    uint32_t hi = num_recs;
+
+    while (lo < hi)
     {
-        LOG_ERR("Invalid trend type");
-        return -1;
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (trend_read_timestamp(file, mid) < from_ts)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
     }
+    return lo;
+}
+
+/*
+ * Read [offset, end) in page-sized chunks and hand each record to cb.
+ * Returns the number of records delivered, or a negative error code.
+ */
+static int trend_stream(struct fs_file_t *file, enum trend_type type, uint32_t offset, uint32_t end,
+                        hpi_trend_point_cb_t cb, void *user_data)
+{
+    struct hpi_trend_sample_t pt;
+    int count = 0;
 
-    ret = fs_stat(fname, &trend_file_ent);
+    int ret = fs_seek(file, offset, FS_SEEK_SET);
     if (ret < 0)
     {
-        LOG_ERR("FAIL: stat %s: %d", fname, ret);
-        if (ret == -ENOENT)
+        return ret;
+    }
+
+    while (offset < end)
+    {
+        size_t want = MIN(sizeof(trend_read_buf), end - offset);
+
+        ret = fs_read(file, trend_read_buf, want);
+        if (ret < 0)
+        {
+            LOG_ERR("FAIL: trend read: %d", ret);
+            return ret;
+        }
+
+        int n = ret / HPI_TREND_POINT_SIZE;
+        for (int i = 0; i < n; i++)
+        {
+            trend_decode(type, &trend_read_buf[i * HPI_TREND_POINT_SIZE], &pt);
+            count++;
+            if (!cb(&pt, user_data))
+            {
+                return count;
+            }
+        }
+
+        offset += n * HPI_TREND_POINT_SIZE;
+        if ((size_t)ret < want || n == 0)
         {
-            *num_points = 0;
-            LOG_ERR("File not found: %s", fname);
+            break;
         }
+    }
+
+    return count;
+}
+
+struct trend_range_ctx
+{
+    int64_t to_ts;
+    hpi_trend_point_cb_t cb;
+    void *user_data;
+    int delivered;
+};
+
+static bool trend_range_cb(const struct hpi_trend_sample_t *pt, void *user_data)
+{
+    struct trend_range_ctx *ctx = user_data;
+
+    if (pt->timestamp > ctx->to_ts)
+    {
+        return false;
+    }
+    ctx->delivered++;
+    return ctx->cb(pt, ctx->user_data);
+}
+
+int hpi_trend_query(enum trend_type type, int64_t day_ts, int64_t from_ts, int64_t to_ts,
+                    hpi_trend_point_cb_t cb, void *user_data)
+{
+    struct fs_file_t file;
+    uint32_t size;
+
+    if (!trend_type_valid(type) || cb == NULL)
+    {
+        return -EINVAL;
+    }
+
+    // Pending write-behind points belong in the answer
+    log_trend_flush(trend_log_types[type]);
+
+    k_mutex_lock(&mutex_trend_query, K_FOREVER);
+
+    int ret = trend_open_day(&file, type, day_ts, &size);
+    if (ret < 0)
+    {
+        k_mutex_unlock(&mutex_trend_query);
         return ret;
     }
 
-    LOG_DBG("Read from file %s | Size: %d", fname, trend_file_ent.size);
+    struct trend_range_ctx ctx = {
+        .to_ts = to_ts,
+        .cb = cb,
+        .user_data = user_data,
+    };
+
+    uint32_t first = trend_lower_bound(&file, size / HPI_TREND_POINT_SIZE, from_ts);
+    ret = trend_stream(&file, type, first * HPI_TREND_POINT_SIZE, size, trend_range_cb, &ctx);
+
+    fs_close(&file);
+    k_mutex_unlock(&mutex_trend_query);
+
+    return (ret < 0) ? ret : ctx.delivered;
+}
+
+static void trend_rollup_path(char *buf, size_t len, uint8_t log_type, int64_t day_ts)
+{
+    snprintf(buf, len, TREND_ROLLUP_DIR "/%u_%" PRId64, log_type, day_ts);
+}
 
-    num_trend_points = trend_file_ent.size / sizeof(struct hpi_hr_trend_point_t);
-    *num_points = num_trend_points;
+static void trend_rollup_load(uint8_t log_type, int64_t day_ts)
+{
+    struct fs_file_t file;
+    char fname[40];
+    int ret;
 
-    LOG_DBG("Num Trend Points: %d", num_trend_points);
+    trend_rollup_path(fname, sizeof(fname), log_type, day_ts);
+    fs_file_t_init(&file);
 
     ret = fs_open(&file, fname, FS_O_READ);
+    if (ret == 0)
+    {
+        ret = fs_read(&file, &trend_rollup, sizeof(trend_rollup));
+        fs_close(&file);
+    }
+
+    if (ret != sizeof(trend_rollup) || trend_rollup.magic != TREND_ROLLUP_MAGIC ||
+        trend_rollup.version != TREND_ROLLUP_VERSION || trend_rollup.log_type != log_type)
+    {
+        memset(&trend_rollup, 0, sizeof(trend_rollup));
+        trend_rollup.magic = TREND_ROLLUP_MAGIC;
+        trend_rollup.version = TREND_ROLLUP_VERSION;
+        trend_rollup.log_type = log_type;
+    }
+}
+
+static void trend_rollup_save(int64_t day_ts)
+{
+    static bool dir_ready;
+    struct fs_file_t file;
+    char fname[40];
+
+    if (!dir_ready)
+    {
+        int ret = fs_mkdir(TREND_ROLLUP_DIR);
+        dir_ready = (ret == 0 || ret == -EEXIST);
+    }
+
+    trend_rollup_path(fname, sizeof(fname), trend_rollup.log_type, day_ts);
+    fs_file_t_init(&file);
 
+    int ret = fs_open(&file, fname, FS_O_CREATE | FS_O_WRITE);
     if (ret < 0)
     {
         LOG_ERR("FAIL: open %s: %d", fname, ret);
+        return;
     }
 
-    struct hpi_hr_trend_point_t hr_trend_point;
+    ret = fs_write(&file, &trend_rollup, sizeof(trend_rollup));
+    if (ret < 0)
+    {
+        LOG_ERR("FAIL: write %s: %d", fname, ret);
+    }
+    fs_close(&file);
+}
 
-    int bucket_counts[NUM_HOURS] = {0};
+struct trend_rollup_ctx
+{
+    int64_t day_ts;
+};
+
+static bool trend_rollup_add_cb(const struct hpi_trend_sample_t *pt, void *user_data)
+{
+    const struct trend_rollup_ctx *ctx = user_data;
+    int64_t offset = pt->timestamp - ctx->day_ts;
 
-    for (int i = 0; i < num_trend_points; i++)
+    if (offset < 0 || offset >= NUM_HOURS * 3600)
     {
-        ret = fs_read(&file, &hr_trend_point, sizeof(hr_trend_point));
-        if (ret < 0)
-        {
-            LOG_ERR("FAIL: read %s: %d", fname, ret);
-        }
-        trend_point_all[i] = hr_trend_point;
+        return true;
     }
 
-    ret = fs_close(&file);
-    ret = fs_sync(&file);
+    struct trend_rollup_hour *h = &trend_rollup.hours[offset / 3600];
 
-    for (int i = 0; i < num_trend_points; i++)
+    if (h->count == 0 || pt->max > h->max)
     {
-        struct tm *time_info = gmtime(&trend_point_all[i].timestamp);
-        int hour = time_info->tm_hour;
+        h->max = pt->max;
+    }
+    if (pt->min != 0 && (h->min == 0 || pt->min < h->min))
+    {
+        h->min = pt->min;
+    }
+    h->sum += pt->avg;
+    h->count++;
+    h->latest = pt->latest;
 
-        if (bucket_counts[hour] < MAX_POINTS_PER_HOUR)
-        {
-            trend_day_points[hour][bucket_counts[hour]] = trend_point_all[i];
-            bucket_counts[hour]++;
-        }
-        else
-        {
-            LOG_DBG("Bucket overflow for hour %d\n", hour);
-        }
+    return true;
+}
+
+void hpi_trend_rollup_remove(uint8_t log_type, int64_t day_ts)
+{
+    char fname[40];
+
+    trend_rollup_path(fname, sizeof(fname), log_type, day_ts);
+
+    k_mutex_lock(&mutex_trend_query, K_FOREVER);
+    fs_unlink(fname);
+    k_mutex_unlock(&mutex_trend_query);
+}
+
+int hpi_trend_get_hourly(enum trend_type type, int64_t day_ts, struct hpi_hourly_trend_point_t *hourly)
+{
+    struct fs_file_t file;
+    uint32_t size;
+
+    if (!trend_type_valid(type) || hourly == NULL)
+    {
+        return -EINVAL;
+    }
+
+    uint8_t log_type = trend_log_types[type];
+    log_trend_flush(log_type);
+
+    k_mutex_lock(&mutex_trend_query, K_FOREVER);
+
+    int ret = trend_open_day(&file, type, day_ts, &size);
+    if (ret < 0)
+    {
+        k_mutex_unlock(&mutex_trend_query);
+        return ret;
+    }
+
+    trend_rollup_load(log_type, day_ts);
+
+    if (trend_rollup.covered_bytes > size)
+    {
+        // Day file was replaced - start over
+        memset(trend_rollup.hours, 0, sizeof(trend_rollup.hours));
+        trend_rollup.covered_bytes = 0;
     }
 
-    int8_t minute_counter = 0;
-    for (int i = 0; i < num_trend_points; i++)
+    if (trend_rollup.covered_bytes < size)
     {
-        if (trend_point_all[i].timestamp > m_trend_time_ts - 3600)
+        // Fold in only what was appended since the sidecar was last written
+        struct trend_rollup_ctx ctx = {.day_ts = day_ts};
+
+        ret = trend_stream(&file, type, trend_rollup.covered_bytes, size, trend_rollup_add_cb, &ctx);
+        if (ret >= 0)
         {
-            if (minute_counter >= 60)
-            {
-                LOG_ERR("Minute counter overflow");
-                break;
-            }
-            minutely_trend_points[minute_counter++].avg = trend_point_all[i].avg;
+            LOG_DBG("Rollup %u: folded %d points", log_type, ret);
+            trend_rollup.covered_bytes = size;
+            trend_rollup_save(day_ts);
         }
     }
 
+    fs_close(&file);
+
+    int total = 0;
     for (int i = 0; i < NUM_HOURS; i++)
     {
-        // printf("Hour %d: %d points\n", i, bucket_counts[i]);
+        const struct trend_rollup_hour *h = &trend_rollup.hours[i];
+
+        hourly[i].hour_no = i;
+        hourly[i].max = h->max;
+        hourly[i].min = h->min;
+        hourly[i].avg = (h->count > 0) ? (h->sum / h->count) : 0;
+        hourly[i].latest = h->latest;
+        total += h->count;
+    }
+
+    k_mutex_unlock(&mutex_trend_query);
 
-        hourly_trend_points[i].hour_no = i;
-        hourly_trend_points[i].avg = 0;
-        hourly_trend_points[i].max = 0;
-        hourly_trend_points[i].min = 0;
+    return (ret < 0) ? ret : total;
+}
 
-        uint16_t max = 0;
-        uint16_t min = 255;
+struct trend_minute_ctx
+{
+    int64_t from_ts;
+    struct hpi_minutely_trend_point_t *minutes;
+    int num_minutes;
+};
 
-        for (int j = 0; j < bucket_counts[i]; j++)
-        {
-            if (trend_day_points[i][j].max > max)
-            {
-                hourly_trend_points[i].max = trend_day_points[i][j].max;
-            }
-            if (trend_day_points[i][j].min < min)
-            {
-                hourly_trend_points[i].min = trend_day_points[i][j].min;
-            }
-            hourly_trend_points[i].avg += trend_day_points[i][j].avg;
-            // printf("  Timestamp: %" PRIx64 "\n", trend_day_points[i][j].timestamp);
-        }
-        if (bucket_counts[i] > 0)
-        {
-            hourly_trend_points[i].avg /= bucket_counts[i];
-        }
+static bool trend_minute_cb(const struct hpi_trend_sample_t *pt, void *user_data)
+{
+    struct trend_minute_ctx *ctx = user_data;
+    int64_t slot = (pt->timestamp - ctx->from_ts) / 60;
+
+    if (slot >= 0 && slot < ctx->num_minutes)
+    {
+        struct hpi_minutely_trend_point_t *m = &ctx->minutes[slot];
+        m->minute_no = slot;
+        m->max = pt->max;
+        m->min = pt->min;
+        m->avg = pt->avg;
+        m->latest = pt->latest;
+    }
+    return true;
+}
+
+int hpi_trend_load_trend(struct hpi_hourly_trend_point_t *hourly_trend_points, struct hpi_minutely_trend_point_t *minutely_trend_points, int num_minutes, int *num_points, enum trend_type m_trend_type)
+{
+    int64_t day_ts = hpi_trend_get_day_start_ts(&m_trend_time_ts);
 
-        // LOG_DBG("Hour %d: | %d | %d | %d", hr_hourly_trend_points[i].hour_no, hr_hourly_trend_points[i].max, hr_hourly_trend_points[i].min, hr_hourly_trend_points[i].avg);
+    *num_points = 0;
+
+    int ret = hpi_trend_get_hourly(m_trend_type, day_ts, hourly_trend_points);
+    if (ret < 0)
+    {
+        LOG_ERR("Trend %d: no data for %" PRId64 " (%d)", m_trend_type, day_ts, ret);
+        return ret;
     }
-    return 0;
+    *num_points = ret;
+
+    // Last hour at one-minute resolution, seeking straight to it
+    struct trend_minute_ctx ctx = {
+        .from_ts = m_trend_time_ts - 3600,
+        .minutes = minutely_trend_points,
+        .num_minutes = CLAMP(num_minutes, 0, HPI_TREND_MINUTE_SLOTS),
+    };
+
+    memset(minutely_trend_points, 0, ctx.num_minutes * sizeof(*minutely_trend_points));
+    ret = hpi_trend_query(m_trend_type, day_ts, ctx.from_ts, m_trend_time_ts, trend_minute_cb, &ctx);
+
+    return (ret < 0) ? ret : 0;
 }
 
 static void trend_spo2_listener(const struct zbus_channel *chan)
@@ -449,6 +811,33 @@ static void trend_bpt_listener(const struct zbus_channel *chan)
 }
 ZBUS_LISTENER_DEFINE(trend_bpt_lis, trend_bpt_listener);
 
+#if defined(CONFIG_HPI_GSR_STRESS_INDEX)
+static void trend_gsr_listener(const struct zbus_channel *chan)
+{
+    const struct hpi_gsr_stress_index_t *stress = zbus_chan_const_msg(chan);
+
+    if (!stress->stress_data_ready)
+    {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&gsr_minute_lock);
+    if (m_gsr_curr_minute.count == 0 || stress->stress_level < m_gsr_curr_minute.min)
+    {
+        m_gsr_curr_minute.min = stress->stress_level;
+    }
+    if (stress->stress_level > m_gsr_curr_minute.max)
+    {
+        m_gsr_curr_minute.max = stress->stress_level;
+    }
+    m_gsr_curr_minute.sum += stress->stress_level;
+    m_gsr_curr_minute.latest = stress->stress_level;
+    m_gsr_curr_minute.count++;
+    k_spin_unlock(&gsr_minute_lock, key);
+}
+ZBUS_LISTENER_DEFINE(trend_gsr_lis, trend_gsr_listener);
+#endif
+
 static void trend_sys_time_listener(const struct zbus_channel *chan)
 {
     const struct tm *sys_time = zbus_chan_const_msg(chan);
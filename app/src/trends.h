@@ -30,6 +30,9 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+
 
 struct hpi_hr_trend_point_t
 {
@@ -49,6 +52,16 @@ struct hpi_temp_trend_point_t
     uint16_t latest;
 };
 
+/* GSR stress level (0-100) over one minute of continuous monitoring */
+struct hpi_gsr_trend_point_t
+{
+    int64_t timestamp;
+    uint16_t max;
+    uint16_t min;
+    uint16_t avg;
+    uint16_t latest;
+};
+
 #define HPI_TREND_POINT_SIZE 16
 
 struct hpi_log_index_t
@@ -84,6 +97,38 @@ enum trend_type
     TREND_SPO2,
     TREND_TEMP,
     TREND_BPT,
+    TREND_STEPS,
+    TREND_GSR,
+};
+
+#define HPI_TREND_MINUTE_SLOTS 60
+
+/*
+ * One decoded trend record. HR, temperature and GSR stress fill all fields; SpO2 and
+ * steps repeat their single value; BPT carries systolic in max/latest,
+ * diastolic in min and heart rate in avg.
+ */
+struct hpi_trend_sample_t
+{
+    int64_t timestamp;
+    uint16_t max;
+    uint16_t min;
+    uint16_t avg;
+    uint16_t latest;
 };
 
-int hpi_trend_load_trend(struct hpi_hourly_trend_point_t *hourly_trend_points, struct hpi_minutely_trend_point_t *minute_trend_points, int *num_points, enum trend_type m_trend_type);
+/* Return false to stop the query early */
+typedef bool (*hpi_trend_point_cb_t)(const struct hpi_trend_sample_t *point, void *user_data);
+
+/* Stream the points of one day file with from_ts <= timestamp <= to_ts. Returns points delivered. */
+int hpi_trend_query(enum trend_type type, int64_t day_ts, int64_t from_ts, int64_t to_ts,
+                    hpi_trend_point_cb_t cb, void *user_data);
+
+/* Fill 24 hourly rollups for a day from its sidecar, folding in new points. Returns total points. */
+int hpi_trend_get_hourly(enum trend_type type, int64_t day_ts, struct hpi_hourly_trend_point_t *hourly);
+
+/* Delete the rollup sidecar of a day file that is being removed */
+void hpi_trend_rollup_remove(uint8_t log_type, int64_t day_ts);
+
+/* Today's 24 hourly rollups and the last hour in up to num_minutes (<= HPI_TREND_MINUTE_SLOTS) one-minute slots */
+int hpi_trend_load_trend(struct hpi_hourly_trend_point_t *hourly_trend_points, struct hpi_minutely_trend_point_t *minute_trend_points, int num_minutes, int *num_points, enum trend_type m_trend_type);
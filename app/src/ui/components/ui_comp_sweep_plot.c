@@ -0,0 +1,278 @@
+/*
+ * HealthyPi Move - Sweep waveform plot
+ *
+ * Monitor-style waveform: a write cursor sweeps left to right and overwrites
+ * the previous pass, with a short blank bar ahead of it. Each pixel column
+ * keeps the min/max pixel span of the samples that fell into it, so drawing
+ * is one filled rectangle per column and only the columns touched since the
+ * last frame are invalidated.
+ *
+ * Samples are scaled when they arrive: a range change applies from the
+ * cursor onwards and never forces a full redraw.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <zephyr/kernel.h>
+#include <lvgl.h>
+
+#include "../move_ui.h"
+
+#define SWEEP_GAP_COLS 12 // Blank columns ahead of the cursor
+
+struct ui_sweep_plot
+{
+    lv_obj_t *obj;
+    lv_color_t color;
+    uint32_t samples_per_sweep;
+    uint32_t pos; // Sample index within the current sweep
+    int32_t range_min;
+    int32_t range_max;
+    int16_t cols;
+    int16_t height;
+    int16_t line_w;
+    int16_t cursor; // Column of the newest sample
+    int16_t last_y;
+    bool have_last;
+    // Per-column pixel span, col_min > col_max is a blank column
+    int16_t *col_min;
+    int16_t *col_max;
+};
+
+static void sweep_blank_all(struct ui_sweep_plot *p)
+{
+    for (int16_t c = 0; c < p->cols; c++)
+    {
+        p->col_min[c] = 1;
+        p->col_max[c] = 0;
+    }
+    p->pos = 0;
+    p->cursor = 0;
+    p->have_last = false;
+}
+
+static int16_t sweep_map(const struct ui_sweep_plot *p, int32_t value)
+{
+    // Keep the whole stroke inside the object
+    int32_t top = p->line_w / 2;
+    int32_t span = p->height - p->line_w;
+    int64_t y = ((int64_t)value - p->range_min) * span / ((int64_t)p->range_max - p->range_min);
+
+    if (y < 0)
+    {
+        y = 0;
+    }
+    else if (y > span)
+    {
+        y = span;
+    }
+
+    return (int16_t)(top + span - y);
+}
+
+/* Add one sample, return the number of columns the cursor moved */
+static int sweep_push(struct ui_sweep_plot *p, int32_t value)
+{
+    int16_t y = sweep_map(p, value);
+    int16_t col = (int16_t)((uint64_t)p->pos * p->cols / p->samples_per_sweep);
+    int steps;
+
+    p->pos = (p->pos + 1) % p->samples_per_sweep;
+
+    if (!p->have_last)
+    {
+        p->have_last = true;
+        p->col_min[col] = y;
+        p->col_max[col] = y;
+        steps = 0;
+    }
+    else
+    {
+        steps = col - p->cursor;
+        if (steps < 0)
+        {
+            steps += p->cols;
+        }
+
+        if (steps == 0)
+        {
+            p->col_min[col] = MIN(p->col_min[col], y);
+            p->col_max[col] = MAX(p->col_max[col], y);
+        }
+
+        // Fewer samples than columns: interpolate across the skipped ones
+        int16_t prev = p->last_y;
+        for (int k = 1; k <= steps; k++)
+        {
+            int16_t c = (p->cursor + k) % p->cols;
+            int16_t yk = p->last_y + (y - p->last_y) * k / steps;
+
+            p->col_min[c] = MIN(prev, yk);
+            p->col_max[c] = MAX(prev, yk);
+            prev = yk;
+        }
+    }
+
+    for (int g = 1; g <= SWEEP_GAP_COLS; g++)
+    {
+        int16_t c = (col + g) % p->cols;
+        p->col_min[c] = 1;
+        p->col_max[c] = 0;
+    }
+
+    p->cursor = col;
+    p->last_y = y;
+
+    return steps;
+}
+
+static void sweep_invalidate(struct ui_sweep_plot *p, int16_t first, int advanced)
+{
+    int32_t len = advanced + SWEEP_GAP_COLS + 1;
+    lv_area_t area;
+
+    if (len + 2 * p->line_w >= p->cols)
+    {
+        lv_obj_invalidate(p->obj);
+        return;
+    }
+
+    lv_obj_get_coords(p->obj, &area);
+    int32_t x0 = area.x1;
+    int32_t c1 = first - p->line_w;
+    int32_t c2 = first + len - 1 + p->line_w;
+
+    // LVGL clips each area to the object, the wrapped part goes to the other end
+    area.x1 = x0 + c1;
+    area.x2 = x0 + MIN(c2, p->cols - 1);
+    lv_obj_invalidate_area(p->obj, &area);
+
+    if (c1 < 0)
+    {
+        area.x1 = x0 + p->cols + c1;
+        area.x2 = x0 + p->cols - 1;
+        lv_obj_invalidate_area(p->obj, &area);
+    }
+    if (c2 >= p->cols)
+    {
+        area.x1 = x0;
+        area.x2 = x0 + c2 - p->cols;
+        lv_obj_invalidate_area(p->obj, &area);
+    }
+}
+
+static void sweep_draw_cb(lv_event_t *e)
+{
+    struct ui_sweep_plot *p = lv_event_get_user_data(e);
+    lv_layer_t *layer = lv_event_get_layer(e);
+    lv_area_t coords;
+    lv_draw_rect_dsc_t dsc;
+
+    lv_obj_get_coords(p->obj, &coords);
+
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = p->color;
+    dsc.bg_opa = LV_OPA_COVER;
+    dsc.radius = 0;
+
+    // Only the columns whose stroke reaches the area being redrawn
+    int32_t c_first = MAX(layer->_clip_area.x1 - coords.x1 - p->line_w, 0);
+    int32_t c_last = MIN(layer->_clip_area.x2 - coords.x1 + p->line_w, p->cols - 1);
+    int32_t half = p->line_w / 2;
+
+    for (int32_t c = c_first; c <= c_last; c++)
+    {
+        if (p->col_min[c] > p->col_max[c])
+        {
+            continue;
+        }
+
+        lv_area_t a = {
+            .x1 = coords.x1 + c - half,
+            .x2 = coords.x1 + c - half + p->line_w - 1,
+            .y1 = coords.y1 + p->col_min[c] - half,
+            .y2 = coords.y1 + p->col_max[c] - half + p->line_w - 1,
+        };
+        lv_draw_rect(layer, &dsc, &a);
+    }
+}
+
+static void sweep_delete_cb(lv_event_t *e)
+{
+    lv_free(lv_event_get_user_data(e));
+}
+
+lv_obj_t *ui_sweep_plot_create(lv_obj_t *parent, int32_t width, int32_t height,
+                               uint32_t samples_per_sweep, lv_color_t color, int32_t line_width)
+{
+    struct ui_sweep_plot *p = lv_malloc(sizeof(*p) + 2 * width * sizeof(int16_t));
+    if (p == NULL)
+    {
+        return NULL;
+    }
+
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, width, height);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICK_FOCUSABLE);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_GESTURE_BUBBLE);
+
+    p->obj = obj;
+    p->color = color;
+    p->samples_per_sweep = MAX(samples_per_sweep, 1U);
+    p->range_min = 0;
+    p->range_max = 1;
+    p->cols = (int16_t)width;
+    p->height = (int16_t)height;
+    p->line_w = (int16_t)CLAMP(line_width, 1, height);
+    p->col_min = (int16_t *)(p + 1);
+    p->col_max = p->col_min + width;
+    sweep_blank_all(p);
+
+    lv_obj_add_event_cb(obj, sweep_draw_cb, LV_EVENT_DRAW_MAIN, p);
+    lv_obj_add_event_cb(obj, sweep_delete_cb, LV_EVENT_DELETE, p);
+    lv_obj_set_user_data(obj, p);
+
+    return obj;
+}
+
+void ui_sweep_plot_set_range(lv_obj_t *plot, int32_t min, int32_t max)
+{
+    struct ui_sweep_plot *p = lv_obj_get_user_data(plot);
+
+    p->range_min = min;
+    p->range_max = (max > min) ? max : min + 1;
+}
+
+void ui_sweep_plot_add_samples(lv_obj_t *plot, const int32_t *samples, int num_samples)
+{
+    struct ui_sweep_plot *p = lv_obj_get_user_data(plot);
+    int16_t first = p->cursor;
+    int advanced = 0;
+
+    for (int i = 0; i < num_samples; i++)
+    {
+        advanced += sweep_push(p, samples[i]);
+    }
+
+    if (num_samples > 0)
+    {
+        sweep_invalidate(p, first, advanced);
+    }
+}
+
+void ui_sweep_plot_add_sample(lv_obj_t *plot, int32_t sample)
+{
+    ui_sweep_plot_add_samples(plot, &sample, 1);
+}
+
+void ui_sweep_plot_clear(lv_obj_t *plot)
+{
+    struct ui_sweep_plot *p = lv_obj_get_user_data(plot);
+
+    sweep_blank_all(p);
+    lv_obj_invalidate(plot);
+}
@@ -515,29 +515,76 @@ lv_color_t hpi_get_battery_color(uint8_t level, bool charging)
 
 void hpi_show_screen(lv_obj_t *m_screen, enum scroll_dir m_scroll_dir)
 {
+    lv_obj_t *old_screen = lv_scr_act();
+
+    // Cached screens come through here on every visit, keep a single handler
+    lv_obj_remove_event_cb(m_screen, disp_screen_event);
     lv_obj_add_event_cb(m_screen, disp_screen_event, LV_EVENT_GESTURE, NULL);
 
-    // Let LVGL automatically delete the old screen after animation completes
-    // This is the safest approach as LVGL handles the timing correctly
+    hpi_scr_cache_put(m_screen);
+
+    // A cached screen reloaded onto itself has already been refreshed in place
+    if (m_screen == old_screen)
+    {
+        return;
+    }
+
+    // Let LVGL delete the old screen after the animation completes, unless the cache keeps it
+    bool del_old = !hpi_scr_cache_contains(old_screen);
+
     if (m_scroll_dir == SCROLL_LEFT)
     {
-        lv_scr_load_anim(m_screen, LV_SCR_LOAD_ANIM_OVER_LEFT, SCREEN_TRANS_TIME, 0, true);
+        lv_scr_load_anim(m_screen, LV_SCR_LOAD_ANIM_OVER_LEFT, SCREEN_TRANS_TIME, 0, del_old);
     }
     else if (m_scroll_dir == SCROLL_RIGHT)
     {
-        lv_scr_load_anim(m_screen, LV_SCR_LOAD_ANIM_OVER_RIGHT, SCREEN_TRANS_TIME, 0, true);
+        lv_scr_load_anim(m_screen, LV_SCR_LOAD_ANIM_OVER_RIGHT, SCREEN_TRANS_TIME, 0, del_old);
     }
     else if (m_scroll_dir == SCROLL_UP)
     {
-        lv_scr_load_anim(m_screen, LV_SCR_LOAD_ANIM_OVER_TOP, SCREEN_TRANS_TIME, 0, true);
+        lv_scr_load_anim(m_screen, LV_SCR_LOAD_ANIM_OVER_TOP, SCREEN_TRANS_TIME, 0, del_old);
     }
     else if (m_scroll_dir == SCROLL_DOWN)
     {
-        lv_scr_load_anim(m_screen, LV_SCR_LOAD_ANIM_OVER_BOTTOM, SCREEN_TRANS_TIME, 0, true);
+        lv_scr_load_anim(m_screen, LV_SCR_LOAD_ANIM_OVER_BOTTOM, SCREEN_TRANS_TIME, 0, del_old);
     }
     else
     {
-        lv_scr_load_anim(m_screen, LV_SCR_LOAD_ANIM_NONE, 0, 0, true);
+        lv_scr_load_anim(m_screen, LV_SCR_LOAD_ANIM_NONE, 0, 0, del_old);
+    }
+}
+
+/* Bring a cached carousel screen up to date before it is shown again */
+static void hpi_refresh_cached_screen(int m_screen)
+{
+    switch (m_screen)
+    {
+    case SCR_HOME:
+        hpi_scr_home_refresh();
+        break;
+    case SCR_HR:
+        hpi_scr_hr_refresh();
+        break;
+    case SCR_SPO2:
+        hpi_scr_spo2_refresh();
+        break;
+    case SCR_TEMP:
+        hpi_scr_temp_refresh();
+        break;
+    case SCR_ECG:
+        hpi_scr_ecg_refresh();
+        break;
+    case SCR_HRV:
+        hpi_scr_hrv_refresh();
+        break;
+    case SCR_GSR:
+        hpi_scr_gsr_refresh();
+        break;
+    case SCR_RECORDING:
+        hpi_scr_recording_refresh();
+        break;
+    default:
+        break;
     }
 }
 
@@ -546,7 +593,23 @@ void hpi_load_screen(int m_screen, enum scroll_dir m_scroll_dir)
     // CRITICAL: Set global transition flag to suspend ALL screen updates
     // This protects the entire screen loading process across all screens
     screen_transition_in_progress = true;
-    
+
+    lv_obj_t *cached = hpi_scr_cache_get(m_screen);
+    hpi_scr_cache_begin_load(m_screen, cached != NULL);
+
+    if (cached != NULL)
+    {
+        hpi_refresh_cached_screen(m_screen);
+        hpi_disp_set_curr_screen(m_screen);
+        hpi_show_screen(cached, m_scroll_dir);
+
+        screen_transition_in_progress = false;
+        return;
+    }
+
+    // Building a screen: give back cached ones first if the heap is short
+    hpi_scr_cache_trim();
+
     switch (m_screen)
     {
     case SCR_HOME:
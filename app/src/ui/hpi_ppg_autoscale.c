@@ -1,6 +1,8 @@
 #include <lvgl.h>
 #include <math.h>
 
+#include "ui/move_ui.h"
+
 // Track last applied range to implement hysteresis
 static int32_t last_applied_min = 0;
 static int32_t last_applied_max = 65535;
@@ -125,7 +127,7 @@ void hpi_ppg_disp_do_set_scale_shared(lv_obj_t *chart, float *y_min_ppg, float *
 
         if (should_update)
         {
-            lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, min_v, max_v);
+            ui_sweep_plot_set_range(chart, min_v, max_v);
             last_applied_min = min_v;
             last_applied_max = max_v;
             first_scale = false;
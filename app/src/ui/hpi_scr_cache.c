@@ -0,0 +1,364 @@
+/*
+ * HealthyPi Move - Carousel screen cache
+ *
+ * Main carousel screens stay built after they are swiped away, so coming
+ * back only refreshes their values instead of recreating every object from
+ * the LVGL heap. The least recently shown screen is deleted when the cache
+ * goes over its byte budget, or when the heap runs low where the allocator
+ * can report it. Swipe-to-first-frame time is measured separately for
+ * cached and freshly built screens.
+ *
+ * Everything except the stats runs on the display thread.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <lvgl.h>
+#include <string.h>
+
+#include "move_ui.h"
+#include "hpi_sys.h"
+
+LOG_MODULE_REGISTER(hpi_scr_cache, LOG_LEVEL_INF);
+
+#define SCR_CACHE_SLOTS     8       // One per cacheable screen
+#define SCR_CACHE_OBJ_BYTES 160     // Heap estimate per object when the allocator has no monitor
+#define SCR_CACHE_NONE      (-1)
+
+struct scr_cache_entry
+{
+    lv_obj_t *scr;
+    int screen;
+    uint32_t bytes;
+    int64_t last_used;
+};
+
+static struct scr_cache_entry scr_cache[SCR_CACHE_SLOTS];
+
+// Screen hpi_load_screen() is building, and the heap in use before it started
+static int scr_cache_building = SCR_CACHE_NONE;
+static uint32_t scr_cache_heap_before;
+
+// Load waiting for its first flushed frame
+static bool scr_cache_load_pending;
+static bool scr_cache_load_hit;
+static uint32_t scr_cache_load_start;
+
+static struct
+{
+    uint32_t bytes;
+    uint8_t screens;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t hit_frames;
+    uint64_t hit_latency_us;
+    uint32_t hit_latency_max_us;
+    uint32_t miss_frames;
+    uint64_t miss_latency_us;
+    uint32_t miss_latency_max_us;
+} scr_cache_stats;
+
+K_MUTEX_DEFINE(mutex_scr_cache_stats);
+
+static bool scr_cache_is_cacheable(int screen)
+{
+    switch (screen)
+    {
+    case SCR_HOME:
+    case SCR_HR:
+    case SCR_SPO2:
+    case SCR_TEMP:
+    case SCR_ECG:
+    case SCR_HRV:
+    case SCR_GSR:
+    case SCR_RECORDING:
+        return CONFIG_HPI_SCR_CACHE_BUDGET_BYTES > 0;
+    default:
+        return false;
+    }
+}
+
+/* LVGL heap in use, 0 if the allocator doesn't report it */
+static uint32_t scr_cache_heap_used(void)
+{
+    lv_mem_monitor_t mon;
+
+    lv_mem_monitor(&mon);
+    return (mon.total_size > 0) ? (uint32_t)(mon.total_size - mon.free_size) : 0;
+}
+
+static uint32_t scr_cache_count_objs(lv_obj_t *obj)
+{
+    uint32_t count = 1;
+    uint32_t children = lv_obj_get_child_count(obj);
+
+    for (uint32_t i = 0; i < children; i++)
+    {
+        count += scr_cache_count_objs(lv_obj_get_child(obj, i));
+    }
+
+    return count;
+}
+
+static struct scr_cache_entry *scr_cache_find_scr(lv_obj_t *scr)
+{
+    for (int i = 0; i < SCR_CACHE_SLOTS; i++)
+    {
+        if (scr_cache[i].scr != NULL && scr_cache[i].scr == scr)
+        {
+            return &scr_cache[i];
+        }
+    }
+    return NULL;
+}
+
+static struct scr_cache_entry *scr_cache_find_screen(int screen)
+{
+    for (int i = 0; i < SCR_CACHE_SLOTS; i++)
+    {
+        if (scr_cache[i].scr != NULL && scr_cache[i].screen == screen)
+        {
+            return &scr_cache[i];
+        }
+    }
+    return NULL;
+}
+
+static void scr_cache_forget(struct scr_cache_entry *entry)
+{
+    k_mutex_lock(&mutex_scr_cache_stats, K_FOREVER);
+    scr_cache_stats.bytes -= entry->bytes;
+    scr_cache_stats.screens--;
+    k_mutex_unlock(&mutex_scr_cache_stats);
+
+    memset(entry, 0, sizeof(*entry));
+}
+
+/* Screens deleted from anywhere (eviction included) leave the cache */
+static void scr_cache_delete_cb(lv_event_t *e)
+{
+    struct scr_cache_entry *entry = scr_cache_find_scr(lv_event_get_target(e));
+
+    if (entry != NULL)
+    {
+        scr_cache_forget(entry);
+    }
+}
+
+/* Delete the least recently shown screen that is not on the display, false if there is none */
+static bool scr_cache_evict_one(lv_obj_t *keep)
+{
+    struct scr_cache_entry *victim = NULL;
+    lv_obj_t *act = lv_scr_act();
+
+    for (int i = 0; i < SCR_CACHE_SLOTS; i++)
+    {
+        struct scr_cache_entry *entry = &scr_cache[i];
+
+        // Skip what is shown or still sliding out
+        if (entry->scr == NULL || entry->scr == act || entry->scr == keep ||
+            lv_anim_get(entry->scr, NULL) != NULL)
+        {
+            continue;
+        }
+        if (victim == NULL || entry->last_used < victim->last_used)
+        {
+            victim = entry;
+        }
+    }
+
+    if (victim == NULL)
+    {
+        return false;
+    }
+
+    LOG_DBG("Evict screen %d (%u bytes)", victim->screen, victim->bytes);
+
+    k_mutex_lock(&mutex_scr_cache_stats, K_FOREVER);
+    scr_cache_stats.evictions++;
+    k_mutex_unlock(&mutex_scr_cache_stats);
+
+    lv_obj_delete(victim->scr);
+    return true;
+}
+
+lv_obj_t *hpi_scr_cache_get(int screen)
+{
+    struct scr_cache_entry *entry = scr_cache_find_screen(screen);
+
+    if (entry == NULL)
+    {
+        return NULL;
+    }
+
+    entry->last_used = k_uptime_get();
+    return entry->scr;
+}
+
+bool hpi_scr_cache_contains(lv_obj_t *scr)
+{
+    return scr != NULL && scr_cache_find_scr(scr) != NULL;
+}
+
+void hpi_scr_cache_begin_load(int screen, bool hit)
+{
+    scr_cache_building = hit ? SCR_CACHE_NONE : screen;
+    scr_cache_heap_before = hit ? 0 : scr_cache_heap_used();
+
+    scr_cache_load_pending = true;
+    scr_cache_load_hit = hit;
+    scr_cache_load_start = k_cycle_get_32();
+
+    k_mutex_lock(&mutex_scr_cache_stats, K_FOREVER);
+    if (hit)
+    {
+        scr_cache_stats.hits++;
+    }
+    else
+    {
+        scr_cache_stats.misses++;
+    }
+    k_mutex_unlock(&mutex_scr_cache_stats);
+}
+
+void hpi_scr_cache_put(lv_obj_t *scr)
+{
+    int screen = scr_cache_building;
+
+    scr_cache_building = SCR_CACHE_NONE;
+    if (!scr_cache_is_cacheable(screen))
+    {
+        return;
+    }
+
+    struct scr_cache_entry *entry = scr_cache_find_screen(screen);
+    if (entry != NULL)
+    {
+        if (entry->scr == scr)
+        {
+            return;
+        }
+
+        // Rebuilt while cached: the old copy goes, now or once it has slid out
+        lv_obj_t *old = entry->scr;
+        scr_cache_forget(entry);
+        if (old != lv_scr_act())
+        {
+            lv_obj_delete_async(old);
+        }
+    }
+
+    uint32_t used = scr_cache_heap_used();
+    uint32_t bytes = (used > scr_cache_heap_before && scr_cache_heap_before > 0)
+                         ? used - scr_cache_heap_before
+                         : scr_cache_count_objs(scr) * SCR_CACHE_OBJ_BYTES;
+
+    if (bytes > CONFIG_HPI_SCR_CACHE_BUDGET_BYTES)
+    {
+        LOG_DBG("Screen %d (%u bytes) over the cache budget", screen, bytes);
+        return;
+    }
+
+    // Make room: over budget or no free slot
+    while (scr_cache_stats.bytes + bytes > CONFIG_HPI_SCR_CACHE_BUDGET_BYTES ||
+           scr_cache_stats.screens == SCR_CACHE_SLOTS)
+    {
+        if (!scr_cache_evict_one(scr))
+        {
+            return;
+        }
+    }
+
+    entry = NULL;
+    for (int i = 0; entry == NULL && i < SCR_CACHE_SLOTS; i++)
+    {
+        if (scr_cache[i].scr == NULL)
+        {
+            entry = &scr_cache[i];
+        }
+    }
+
+    entry->scr = scr;
+    entry->screen = screen;
+    entry->bytes = bytes;
+    entry->last_used = k_uptime_get();
+    lv_obj_add_event_cb(scr, scr_cache_delete_cb, LV_EVENT_DELETE, NULL);
+
+    k_mutex_lock(&mutex_scr_cache_stats, K_FOREVER);
+    scr_cache_stats.bytes += bytes;
+    scr_cache_stats.screens++;
+    k_mutex_unlock(&mutex_scr_cache_stats);
+}
+
+void hpi_scr_cache_trim(void)
+{
+    lv_mem_monitor_t mon;
+
+    lv_mem_monitor(&mon);
+    while (mon.total_size > 0 && mon.free_size < CONFIG_HPI_SCR_CACHE_MIN_FREE_BYTES &&
+           scr_cache_evict_one(NULL))
+    {
+        lv_mem_monitor(&mon);
+    }
+}
+
+void hpi_scr_cache_frame_flushed(void)
+{
+    if (!scr_cache_load_pending)
+    {
+        return;
+    }
+    scr_cache_load_pending = false;
+
+    uint32_t latency_us = k_cyc_to_us_floor32(k_cycle_get_32() - scr_cache_load_start);
+
+    k_mutex_lock(&mutex_scr_cache_stats, K_FOREVER);
+    if (scr_cache_load_hit)
+    {
+        scr_cache_stats.hit_frames++;
+        scr_cache_stats.hit_latency_us += latency_us;
+        scr_cache_stats.hit_latency_max_us = MAX(scr_cache_stats.hit_latency_max_us, latency_us);
+    }
+    else
+    {
+        scr_cache_stats.miss_frames++;
+        scr_cache_stats.miss_latency_us += latency_us;
+        scr_cache_stats.miss_latency_max_us = MAX(scr_cache_stats.miss_latency_max_us, latency_us);
+    }
+    k_mutex_unlock(&mutex_scr_cache_stats);
+}
+
+void hpi_scr_cache_get_stats(struct hpi_scr_cache_stats_t *stats)
+{
+    k_mutex_lock(&mutex_scr_cache_stats, K_FOREVER);
+    stats->screens = scr_cache_stats.screens;
+    stats->bytes = scr_cache_stats.bytes;
+    stats->hits = scr_cache_stats.hits;
+    stats->misses = scr_cache_stats.misses;
+    stats->evictions = scr_cache_stats.evictions;
+    stats->hit_latency_avg_us = scr_cache_stats.hit_frames ? (uint32_t)(scr_cache_stats.hit_latency_us / scr_cache_stats.hit_frames) : 0;
+    stats->hit_latency_max_us = scr_cache_stats.hit_latency_max_us;
+    stats->miss_latency_avg_us = scr_cache_stats.miss_frames ? (uint32_t)(scr_cache_stats.miss_latency_us / scr_cache_stats.miss_frames) : 0;
+    stats->miss_latency_max_us = scr_cache_stats.miss_latency_max_us;
+    k_mutex_unlock(&mutex_scr_cache_stats);
+}
+
+void hpi_scr_cache_reset_stats(void)
+{
+    k_mutex_lock(&mutex_scr_cache_stats, K_FOREVER);
+    scr_cache_stats.hits = 0;
+    scr_cache_stats.misses = 0;
+    scr_cache_stats.evictions = 0;
+    scr_cache_stats.hit_frames = 0;
+    scr_cache_stats.hit_latency_us = 0;
+    scr_cache_stats.hit_latency_max_us = 0;
+    scr_cache_stats.miss_frames = 0;
+    scr_cache_stats.miss_latency_us = 0;
+    scr_cache_stats.miss_latency_max_us = 0;
+    k_mutex_unlock(&mutex_scr_cache_stats);
+}
@@ -200,6 +200,7 @@ LV_IMG_DECLARE(icon_spo2_30x35);
 // GSR screens and helpers
 void draw_scr_gsr(enum scroll_dir m_scroll_dir);
 void hpi_gsr_disp_update_gsr_int(uint16_t gsr_value_x100, int64_t gsr_last_update);
+void hpi_scr_gsr_refresh(void);
 // Special GSR plot screen
 void draw_scr_gsr_plot(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4);
 void unload_scr_gsr_plot(void);
@@ -209,7 +210,7 @@ void unload_scr_gsr_complete(void);
 void hpi_gsr_complete_update_results(const struct hpi_gsr_stress_index_t *results);
 // Plot update helper called from sensor path
 void hpi_gsr_disp_plot_add_sample(uint16_t gsr_value_x100);
-void hpi_gsr_disp_draw_plotGSR(int32_t *data_gsr, int num_samples, bool gsr_lead_off);
+void hpi_gsr_disp_draw_plotGSR(const int32_t *data_gsr, int num_samples, bool gsr_lead_off);
 void hpi_gsr_disp_update_timer(uint16_t remaining_s);
 void scr_gsr_lead_on_off_handler(bool lead_on);
 void hpi_gsr_reset_countdown_timer(void);
@@ -218,6 +219,7 @@ void hpi_gsr_disp_update_us(float gsr_us);
 // Stubs when GSR is disabled
 static inline void draw_scr_gsr(enum scroll_dir m_scroll_dir) { ARG_UNUSED(m_scroll_dir); }
 static inline void hpi_gsr_disp_update_gsr_int(uint16_t a, int64_t b) { ARG_UNUSED(a); ARG_UNUSED(b); }
+static inline void hpi_scr_gsr_refresh(void) {}
 static inline void hpi_gsr_process_bioz_sample(int32_t s) { ARG_UNUSED(s); }
 static inline void draw_scr_gsr_plot(enum scroll_dir m_scroll_dir, uint32_t a1, uint32_t a2, uint32_t a3, uint32_t a4) {
     ARG_UNUSED(m_scroll_dir); ARG_UNUSED(a1); ARG_UNUSED(a2); ARG_UNUSED(a3); ARG_UNUSED(a4);
@@ -307,6 +309,7 @@ void hpi_scr_home_update_time_date(struct tm in_time);
 void hpi_home_hr_update(int hr);
 void hpi_home_steps_update(int steps);
 void hpi_scr_home_update_recording_status(struct hpi_recording_status_t *status);
+void hpi_scr_home_refresh(void);
 
 #if defined(CONFIG_HPI_TODAY_SCREEN)
 // Today Screen functions
@@ -318,6 +321,7 @@ void hpi_scr_today_update_all(uint16_t steps, uint16_t kcals, uint16_t active_ti
 void draw_scr_hr(enum scroll_dir m_scroll_dir);
 void hpi_disp_hr_update_hr(uint16_t hr, int64_t last_update_ts);
 void hpi_disp_hr_load_trend(void);
+void hpi_scr_hr_refresh(void);
 void draw_scr_hr_scr2(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4);
 
 // Spo2 Screen functions
@@ -325,13 +329,14 @@ void draw_scr_spo2(enum scroll_dir m_scroll_dir);
 void draw_scr_spo2_scr3(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4);
 void draw_scr_spo2_scr2(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4);
 void hpi_disp_update_spo2(uint8_t spo2, int64_t ts_last_update);
+void hpi_scr_spo2_refresh(void);
 void draw_scr_spo2_select(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4);
 
 int hpi_disp_reset_all_last_updated(void);
 
 void hpi_disp_spo2_load_trend(void);
-void hpi_disp_spo2_plot_wrist_ppg(struct hpi_ppg_wr_data_t ppg_sensor_sample);
-void hpi_disp_spo2_plot_fi_ppg(struct hpi_ppg_fi_data_t ppg_sensor_sample);
+void hpi_disp_spo2_plot_wrist_ppg(const struct hpi_ppg_wr_data_t *ppg_sensor_sample);
+void hpi_disp_spo2_plot_fi_ppg(const struct hpi_ppg_fi_data_t *ppg_sensor_sample);
 
 void hpi_disp_spo2_update_progress(int progress, enum spo2_meas_state state, int spo2, int hr);
 void hpi_disp_spo2_update_hr(int hr);
@@ -344,10 +349,12 @@ void draw_scr_spo2_measure(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t
 // Recording Screen functions
 void draw_scr_recording(enum scroll_dir m_scroll_dir);
 void hpi_scr_recording_update_status(struct hpi_recording_status_t *status);
+void hpi_scr_recording_refresh(void);
 
 // ECG Screen functions
 void draw_scr_ecg(enum scroll_dir m_scroll_dir);
-void hpi_ecg_disp_draw_plotECG(int32_t *data_ecg, int num_samples, bool ecg_lead_off);
+void hpi_scr_ecg_refresh(void);
+void hpi_ecg_disp_draw_plotECG(const int32_t *data_ecg, int num_samples, bool ecg_lead_off);
 void hpi_ecg_disp_update_hr(int hr);
 void hpi_ecg_disp_update_timer(uint16_t remaining_s);
 void draw_scr_ecg_complete(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4);
@@ -392,12 +399,12 @@ void gesture_down_scr_pulldown(void);
 void gesture_down_scr_bpt_cal_required(void);
 void gesture_down_scr_gsr_complete(void);
 // PPG screen functions
-void hpi_disp_ppg_draw_plotPPG(struct hpi_ppg_wr_data_t ppg_sensor_sample);
+void hpi_disp_ppg_draw_plotPPG(const struct hpi_ppg_wr_data_t *ppg_sensor_sample);
 void hpi_ppg_disp_update_hr(int hr);
 void hpi_ppg_check_signal_timeout(void);  // Check for signal timeout periodically
 
-/* Shared autoscale helper for PPG/LVGL charts.
- * chart: LVGL chart object
+/* Shared autoscale helper for PPG sweep plots.
+ * chart: sweep plot object (ui_sweep_plot_create)
  * y_min_ppg, y_max_ppg: pointers to tracked min/max values
  * gx: pointer to sample counter used to decide when to rescale
  * disp_window_size: window size constant used to determine threshold
@@ -415,7 +422,7 @@ void hpi_eda_disp_draw_plotEDA(int32_t *data_eda, int num_samples, bool eda_lead
 // void draw_scr_bpt_calibrate(void);
 void draw_scr_bpt(enum scroll_dir m_scroll_dir);
 // void draw_scr_bpt_measure(void);
-void hpi_disp_bpt_draw_plotPPG(struct hpi_ppg_fi_data_t ppg_sensor_sample);
+void hpi_disp_bpt_draw_plotPPG(const struct hpi_ppg_fi_data_t *ppg_sensor_sample);
 void hpi_disp_bpt_update_progress(int progress);
 void draw_scr_fi_sens_check(enum scroll_dir dir, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4);
 void draw_scr_fi_sens_wear(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4);
@@ -426,6 +433,7 @@ void draw_scr_bpt_cal_required(enum scroll_dir m_scroll_dir, uint32_t arg1, uint
 // HRV screen functions
 void draw_scr_hrv(enum scroll_dir m_scroll_dir,uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4);
 static void hrv_update_display(void);
+void hpi_scr_hrv_refresh(void);
 void hrv_check_and_transition(void);
 void scr_hrv_measure_btn_event_handler(lv_event_t *e);
 
@@ -507,6 +515,14 @@ void ui_spo2_button_update(uint8_t spo2);
 lv_obj_t *ui_steps_button_create(lv_obj_t *comp_parent);
 void ui_steps_button_update(uint16_t steps);
 
+// Sweep waveform plot: samples_per_sweep samples span the full width
+lv_obj_t *ui_sweep_plot_create(lv_obj_t *parent, int32_t width, int32_t height,
+                               uint32_t samples_per_sweep, lv_color_t color, int32_t line_width);
+void ui_sweep_plot_set_range(lv_obj_t *plot, int32_t min, int32_t max);
+void ui_sweep_plot_add_samples(lv_obj_t *plot, const int32_t *samples, int num_samples);
+void ui_sweep_plot_add_sample(lv_obj_t *plot, int32_t sample);
+void ui_sweep_plot_clear(lv_obj_t *plot);
+
 void draw_bg(lv_obj_t *parent);
 
 // Draw special screens
@@ -514,6 +530,7 @@ void draw_scr_spl_raw_ppg(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t
 void draw_scr_spl_plot_ecg(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4);
 
 void draw_scr_temp(enum scroll_dir m_scroll_dir);
+void hpi_scr_temp_refresh(void);
 
 // GSR Screen functions
 void draw_scr_gsr(enum scroll_dir m_scroll_dir);
@@ -528,6 +545,14 @@ void hpi_temp_disp_update_temp_f(double temp_f, int64_t temp_f_last_update);
 void hpi_show_screen(lv_obj_t *parent, enum scroll_dir m_scroll_dir);
 void hpi_show_screen_spl(lv_obj_t *m_screen, enum scroll_dir m_scroll_dir);
 
+// Carousel screen cache (hpi_scr_cache.c), display thread only
+lv_obj_t *hpi_scr_cache_get(int screen);
+bool hpi_scr_cache_contains(lv_obj_t *scr);
+void hpi_scr_cache_begin_load(int screen, bool hit);
+void hpi_scr_cache_put(lv_obj_t *scr);
+void hpi_scr_cache_trim(void);
+void hpi_scr_cache_frame_flushed(void);
+
 // Toast notification utility
 void hpi_disp_show_toast(const char *message, uint32_t duration_ms);
 
@@ -545,7 +570,7 @@ extern uint16_t m_user_height;
 extern uint16_t m_user_weight;
 
 // HRV plot screen functions
-void hpi_ecg_disp_draw_plotECG_hrv(int32_t *data_ecg, int num_samples, bool ecg_lead_off);
+void hpi_ecg_disp_draw_plotECG_hrv(const int32_t *data_ecg, int num_samples, bool ecg_lead_off);
 void scr_hrv_lead_on_off_handler(bool lead_off);
 void gesture_down_scr_ecg_hrv(void);
 static void scr_hrv_btn_start_handler(lv_event_t *e);
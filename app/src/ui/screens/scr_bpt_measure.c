@@ -41,7 +41,6 @@ LOG_MODULE_REGISTER(scr_bpt_measure, LOG_LEVEL_DBG);
 lv_obj_t *scr_bpt_measure;
 
 static lv_obj_t *chart_bpt_ppg;
-static lv_chart_series_t *ser_bpt_ppg;
 
 static lv_obj_t *label_hr_bpm;
 static lv_obj_t *bar_bpt_progress;
@@ -116,50 +115,12 @@ void draw_scr_bpt_measure(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t
     lv_obj_set_style_text_align(label_progress, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
     lv_obj_set_style_text_color(label_progress, lv_color_white(), LV_PART_MAIN);
 
-    // CENTRAL ZONE: PPG Chart (positioned in center area)
-    chart_bpt_ppg = lv_chart_create(scr_bpt_measure);
-    lv_obj_set_size(chart_bpt_ppg, 340, 100);  // Smaller chart for circular design
+    // CENTRAL ZONE: PPG sweep plot (positioned in center area), orange theme matching SpO2/raw PPG screens
+    chart_bpt_ppg = ui_sweep_plot_create(scr_bpt_measure, 330, 90, ECG_DISP_WINDOW_SIZE, lv_palette_main(LV_PALETTE_ORANGE), 6);
     lv_obj_align(chart_bpt_ppg, LV_ALIGN_CENTER, 0, -10);  // Centered position
-    
-    // Configure chart type and fundamental properties
-    lv_chart_set_type(chart_bpt_ppg, LV_CHART_TYPE_LINE);
-    lv_chart_set_point_count(chart_bpt_ppg, ECG_DISP_WINDOW_SIZE);
-    lv_chart_set_update_mode(chart_bpt_ppg, LV_CHART_UPDATE_MODE_CIRCULAR);  // PPG-like behavior
-    
+
     // Set Y-axis range for PPG data
-    lv_chart_set_range(chart_bpt_ppg, LV_CHART_AXIS_PRIMARY_Y, -5000, 5000);
-    
-    // Disable division lines for clean PPG display
-    lv_chart_set_div_line_count(chart_bpt_ppg, 0, 0);
-    
-    // Configure main chart background (transparent for AMOLED)
-    lv_obj_set_style_bg_opa(chart_bpt_ppg, LV_OPA_TRANSP, LV_PART_MAIN);  // Transparent background
-    lv_obj_set_style_border_width(chart_bpt_ppg, 0, LV_PART_MAIN);        // No border (matches SpO2)
-    lv_obj_set_style_outline_width(chart_bpt_ppg, 0, LV_PART_MAIN);       // No outline
-    lv_obj_set_style_pad_all(chart_bpt_ppg, 5, LV_PART_MAIN);             // Minimal padding
-    
-    // Create series for PPG data
-    ser_bpt_ppg = lv_chart_add_series(chart_bpt_ppg, lv_palette_main(LV_PALETTE_ORANGE), LV_CHART_AXIS_PRIMARY_Y);
-    
-    // Configure line series styling - orange theme matching SpO2/raw PPG screens
-    lv_obj_set_style_line_width(chart_bpt_ppg, 6, LV_PART_ITEMS);         // Thicker line matching SpO2
-    lv_obj_set_style_line_color(chart_bpt_ppg, lv_palette_main(LV_PALETTE_ORANGE), LV_PART_ITEMS);
-    lv_obj_set_style_line_opa(chart_bpt_ppg, LV_OPA_COVER, LV_PART_ITEMS); // Full opacity for medical clarity
-    lv_obj_set_style_line_rounded(chart_bpt_ppg, false, LV_PART_ITEMS);   // Sharp lines for precision
-    
-    // Disable points completely
-    lv_obj_set_style_width(chart_bpt_ppg, 0, LV_PART_INDICATOR);          // No point width
-    lv_obj_set_style_height(chart_bpt_ppg, 0, LV_PART_INDICATOR);         // No point height
-    lv_obj_set_style_bg_opa(chart_bpt_ppg, LV_OPA_TRANSP, LV_PART_INDICATOR); // Transparent points
-    lv_obj_set_style_border_opa(chart_bpt_ppg, LV_OPA_TRANSP, LV_PART_INDICATOR); // No point borders
-    
-    // Performance optimizations for real-time PPG display
-    lv_obj_add_flag(chart_bpt_ppg, LV_OBJ_FLAG_IGNORE_LAYOUT);           // Skip layout calculations
-    lv_obj_clear_flag(chart_bpt_ppg, LV_OBJ_FLAG_SCROLLABLE);            // Disable scrolling
-    lv_obj_clear_flag(chart_bpt_ppg, LV_OBJ_FLAG_CLICK_FOCUSABLE);       // No focus events
-    
-    // Initialize chart with baseline values
-    lv_chart_set_all_value(chart_bpt_ppg, ser_bpt_ppg, 0);
+    ui_sweep_plot_set_range(chart_bpt_ppg, -5000, 5000);
 
     // HR Container below chart (following design pattern)
     lv_obj_t *cont_hr = lv_obj_create(scr_bpt_measure);
@@ -227,7 +188,7 @@ static void hpi_bpt_disp_do_set_scale(int disp_window_size)
     if (gx >= (disp_window_size))
     {
 
-        lv_chart_set_range(chart_bpt_ppg, LV_CHART_AXIS_PRIMARY_Y, y_min_ppg, y_max_ppg);
+        ui_sweep_plot_set_range(chart_bpt_ppg, y_min_ppg, y_max_ppg);
 
         gx = 0;
 
@@ -241,11 +202,13 @@ static void hpi_bpt_disp_add_samples(int num_samples)
     gx += num_samples;
 }
 
-void hpi_disp_bpt_draw_plotPPG(struct hpi_ppg_fi_data_t ppg_sensor_sample)
+void hpi_disp_bpt_draw_plotPPG(const struct hpi_ppg_fi_data_t *ppg_sensor_sample)
 {
-    uint32_t *data_ppg = ppg_sensor_sample.raw_red;
+    const uint32_t *data_ppg = ppg_sensor_sample->raw_red;
 
-    uint16_t n_sample = ppg_sensor_sample.ppg_num_samples;
+    uint16_t n_sample = MIN(ppg_sensor_sample->ppg_num_samples, BPT_PPG_POINTS_PER_SAMPLE);
+    int32_t plot_buf[BPT_PPG_POINTS_PER_SAMPLE];
+    int plot_count = 0;
 
     for (int i = 0; i < n_sample; i++)
     {
@@ -253,7 +216,7 @@ void hpi_disp_bpt_draw_plotPPG(struct hpi_ppg_fi_data_t ppg_sensor_sample)
 
         if (data_ppg_i == 0)
         {
-            return;
+            break;
         }
 
         if (data_ppg_i < y_min_ppg)
@@ -266,11 +229,11 @@ void hpi_disp_bpt_draw_plotPPG(struct hpi_ppg_fi_data_t ppg_sensor_sample)
             y_max_ppg = data_ppg_i;
         }
 
-        lv_chart_set_next_value(chart_bpt_ppg, ser_bpt_ppg, data_ppg_i);
+        plot_buf[plot_count++] = (int32_t)data_ppg_i;
 
-        if(ppg_sensor_sample.hr > 0)
+        if(ppg_sensor_sample->hr > 0)
         {
-            lv_label_set_text_fmt(label_hr_bpm, "%d", ppg_sensor_sample.hr);
+            lv_label_set_text_fmt(label_hr_bpm, "%d", ppg_sensor_sample->hr);
         } else
         {
             lv_label_set_text_fmt(label_hr_bpm, "--");
@@ -279,6 +242,8 @@ void hpi_disp_bpt_draw_plotPPG(struct hpi_ppg_fi_data_t ppg_sensor_sample)
         hpi_bpt_disp_add_samples(1);
         hpi_bpt_disp_do_set_scale(BPT_DISP_WINDOW_SIZE);
     }
+
+    ui_sweep_plot_add_samples(chart_bpt_ppg, plot_buf, plot_count);
 }
 
 void gesture_down_scr_bpt_measure(void)
@@ -46,6 +46,8 @@ lv_obj_t *scr_ecg;
 
 static lv_obj_t *btn_ecg_measure;
 static lv_obj_t *label_ecg_hr;
+static lv_obj_t *label_ecg_unit;
+static lv_obj_t *label_ecg_status;
 
 // Externs - Modern style system
 extern lv_style_t style_body_medium;
@@ -131,7 +133,7 @@ void draw_scr_ecg(enum scroll_dir m_scroll_dir)
     lv_obj_add_style(label_ecg_hr, &style_numeric_large, LV_PART_MAIN);
 
     // Inline "BPM" unit (smaller, colored, baseline-aligned)
-    lv_obj_t *label_ecg_unit = lv_label_create(cont_value);
+    label_ecg_unit = lv_label_create(cont_value);
     if (m_ecg_hr == 0) {
         lv_label_set_text(label_ecg_unit, "");
     } else {
@@ -142,7 +144,7 @@ void draw_scr_ecg(enum scroll_dir m_scroll_dir)
     lv_obj_set_style_pad_bottom(label_ecg_unit, 8, LV_PART_MAIN);  // Align with number baseline
 
     // LOWER: Status/last measurement time at y=210
-    lv_obj_t *label_ecg_status = lv_label_create(scr_ecg);
+    label_ecg_status = lv_label_create(scr_ecg);
     if (m_ecg_hr == 0) {
         lv_label_set_text(label_ecg_status, "Electrocardiogram");
     } else {
@@ -179,4 +181,34 @@ void draw_scr_ecg(enum scroll_dir m_scroll_dir)
 
     hpi_disp_set_curr_screen(SCR_ECG);
     hpi_show_screen(scr_ecg, m_scroll_dir);
-}
\ No newline at end of file
+}
+
+/* Cached screen shown again: pick up the last measurement */
+void hpi_scr_ecg_refresh(void)
+{
+    uint8_t m_ecg_hr = 0;
+    int64_t m_ecg_hr_last_update = 0;
+
+    if (label_ecg_hr == NULL || label_ecg_unit == NULL || label_ecg_status == NULL)
+    {
+        return;
+    }
+
+    if (hpi_sys_get_last_ecg_update(&m_ecg_hr, &m_ecg_hr_last_update) != 0)
+    {
+        m_ecg_hr = 0;
+        m_ecg_hr_last_update = 0;
+    }
+
+    if (m_ecg_hr == 0) {
+        lv_label_set_text(label_ecg_hr, "--");
+        lv_label_set_text(label_ecg_unit, "");
+        lv_label_set_text(label_ecg_status, "Electrocardiogram");
+    } else {
+        char last_meas_str[25];
+        hpi_helper_get_relative_time_str(m_ecg_hr_last_update, last_meas_str, sizeof(last_meas_str));
+        lv_label_set_text_fmt(label_ecg_hr, "%d", m_ecg_hr);
+        lv_label_set_text(label_ecg_unit, " BPM");
+        lv_label_set_text(label_ecg_status, last_meas_str);
+    }
+}
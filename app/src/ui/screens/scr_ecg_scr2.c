@@ -49,7 +49,6 @@ K_MUTEX_DEFINE(timer_state_mutex);
 static lv_obj_t *scr_ecg_scr2;
 // static lv_obj_t *btn_ecg_cancel;  // Commented out - not used
 static lv_obj_t *chart_ecg;
-static lv_chart_series_t *ser_ecg;
 static lv_obj_t *label_ecg_hr;
 static lv_obj_t *label_timer;
 static lv_obj_t *label_ecg_lead_off;
@@ -72,19 +71,10 @@ static bool lead_on_detected = false;
 // Timer display cache (moved from function local static to allow reset)
 static int timer_display_last_time = -1;
 
-// Performance optimization variables - LVGL 9.2 optimized
+// Autoscale bookkeeping
 static uint32_t sample_counter = 0;
 static const uint32_t RANGE_UPDATE_INTERVAL = 128; // Update range every 64 samples - Less frequent for better performance
 
-// High-performance batch processing buffer - aligned for LVGL 9.2
-static int32_t batch_data[32] __attribute__((aligned(4))); // Batch buffer for efficiency
-static uint32_t batch_count = 0;
-
-// LVGL 9.2 Chart performance configuration flags
-static bool chart_auto_refresh_enabled = true;
-
-// Function declarations for LVGL 9.2 optimized chart management
-static void ecg_chart_enable_performance_mode(bool enable);
 static void ecg_chart_reset_performance_counters(void);
 
 // Externs
@@ -191,55 +181,16 @@ void draw_scr_ecg_scr2(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg
     chart_ecg_update = true;
 
     // Reset plotting state for fresh start
-    batch_count = 0;
     sample_counter = 0;
     y_max_ecg = -10000;
     y_min_ecg = 10000;
 
-    // CENTRAL ZONE: ECG Chart (positioned in center area)
-    chart_ecg = lv_chart_create(scr_ecg_scr2);
-    lv_obj_set_size(chart_ecg, 340, 100);  // Smaller chart for circular design
+    // CENTRAL ZONE: ECG sweep plot (positioned in center area), orange theme
+    chart_ecg = ui_sweep_plot_create(scr_ecg_scr2, 330, 90, ECG_DISP_WINDOW_SIZE, lv_color_hex(0xFF8C00), 3);
     lv_obj_align(chart_ecg, LV_ALIGN_CENTER, 0, -10);  // Centered position
-    
-    // Configure chart type and fundamental properties
-    lv_chart_set_type(chart_ecg, LV_CHART_TYPE_LINE);
-    lv_chart_set_point_count(chart_ecg, ECG_DISP_WINDOW_SIZE);
-    lv_chart_set_update_mode(chart_ecg, LV_CHART_UPDATE_MODE_CIRCULAR);  // ECG-like behavior
-    
+
     // Set Y-axis range for ECG data - start with reasonable defaults
-    lv_chart_set_range(chart_ecg, LV_CHART_AXIS_PRIMARY_Y, -5000, 5000);
-    
-    // Disable division lines for clean ECG display
-    lv_chart_set_div_line_count(chart_ecg, 0, 0);
-    
-    // Configure main chart background (transparent for AMOLED)
-    lv_obj_set_style_bg_opa(chart_ecg, LV_OPA_TRANSP, LV_PART_MAIN);  // Transparent background
-    lv_obj_set_style_border_width(chart_ecg, 0, LV_PART_MAIN);        // No border
-    lv_obj_set_style_outline_width(chart_ecg, 0, LV_PART_MAIN);       // No outline
-    lv_obj_set_style_pad_all(chart_ecg, 5, LV_PART_MAIN);             // Minimal padding
-    
-    // Create series for ECG data
-    ser_ecg = lv_chart_add_series(chart_ecg, lv_color_hex(0xFF8C00), LV_CHART_AXIS_PRIMARY_Y);
-    
-    // Configure line series styling - orange theme
-    lv_obj_set_style_line_width(chart_ecg, 3, LV_PART_ITEMS);         // Increased line width for better visibility
-    lv_obj_set_style_line_color(chart_ecg, lv_color_hex(0xFF8C00), LV_PART_ITEMS);
-    lv_obj_set_style_line_opa(chart_ecg, LV_OPA_COVER, LV_PART_ITEMS); // Full opacity for medical clarity
-    lv_obj_set_style_line_rounded(chart_ecg, false, LV_PART_ITEMS);   // Sharp lines for precision
-    
-    // Disable points completely
-    lv_obj_set_style_width(chart_ecg, 0, LV_PART_INDICATOR);          // No point width
-    lv_obj_set_style_height(chart_ecg, 0, LV_PART_INDICATOR);         // No point height
-    lv_obj_set_style_bg_opa(chart_ecg, LV_OPA_TRANSP, LV_PART_INDICATOR); // Transparent points
-    lv_obj_set_style_border_opa(chart_ecg, LV_OPA_TRANSP, LV_PART_INDICATOR); // No point borders
-    
-    // Performance optimizations for real-time ECG display
-    lv_obj_add_flag(chart_ecg, LV_OBJ_FLAG_IGNORE_LAYOUT);           // Skip layout calculations
-    lv_obj_clear_flag(chart_ecg, LV_OBJ_FLAG_SCROLLABLE);            // Disable scrolling
-    lv_obj_clear_flag(chart_ecg, LV_OBJ_FLAG_CLICK_FOCUSABLE);       // No focus events
-    
-    // Initialize chart with baseline values
-    lv_chart_set_all_value(chart_ecg, ser_ecg, 0);
+    ui_sweep_plot_set_range(chart_ecg, -5000, 5000);
     
     // HR Container below chart (following design pattern)
     lv_obj_t *cont_hr = lv_obj_create(scr_ecg_scr2);
@@ -287,35 +238,15 @@ void draw_scr_ecg_scr2(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg
     // Set reference for lead on/off handler
     label_info = label_ecg_lead_off;
 
-    // Initialize performance optimization system
     ecg_chart_reset_performance_counters();
-    ecg_chart_enable_performance_mode(true);  // Start in high-performance mode
 
     hpi_disp_set_curr_screen(SCR_SPL_ECG_SCR2);
     hpi_show_screen(scr_ecg_scr2, m_scroll_dir);
 }
 
-// LVGL 9.2 optimized chart management functions
-static void ecg_chart_enable_performance_mode(bool enable)
-{
-    if (chart_ecg == NULL) return;
-    
-    if (enable) {
-        // Enable performance optimizations
-        lv_obj_add_flag(chart_ecg, LV_OBJ_FLAG_IGNORE_LAYOUT);
-        chart_auto_refresh_enabled = false;
-    } else {
-        // Restore normal operation
-        lv_obj_clear_flag(chart_ecg, LV_OBJ_FLAG_IGNORE_LAYOUT);
-        chart_auto_refresh_enabled = true;
-        lv_chart_refresh(chart_ecg);
-    }
-}
-
 static void ecg_chart_reset_performance_counters(void)
 {
     sample_counter = 0;
-    batch_count = 0;
     // Initialize for proper range detection
     y_max_ecg = -10000;
     y_min_ecg = 10000;
@@ -467,10 +398,10 @@ bool hpi_ecg_timer_is_running(void)
     return is_running;
 }
 
-void hpi_ecg_disp_draw_plotECG(int32_t *data_ecg, int num_samples, bool ecg_lead_off)
+void hpi_ecg_disp_draw_plotECG(const int32_t *data_ecg, int num_samples, bool ecg_lead_off)
 {
     // Early validation - LVGL 9.2 best practice
-    if (chart_ecg_update == false || chart_ecg == NULL || ser_ecg == NULL || data_ecg == NULL || num_samples <= 0) {
+    if (chart_ecg_update == false || chart_ecg == NULL || data_ecg == NULL || num_samples <= 0) {
         return;
     }
 
@@ -484,26 +415,16 @@ void hpi_ecg_disp_draw_plotECG(int32_t *data_ecg, int num_samples, bool ecg_lead
         return;
     }
 
-    // Batch processing for efficiency
+    // Track min/max for auto-scaling
     for (int i = 0; i < num_samples; i++)
     {
-        batch_data[batch_count++] = data_ecg[i];
-        
-        // Process batch when full or at end of samples
-        if (batch_count >= 32 || i == num_samples - 1) {
-            // Process batch
-            for (uint32_t j = 0; j < batch_count; j++) {
-                lv_chart_set_next_value(chart_ecg, ser_ecg, batch_data[j]);
-                
-                // Track min/max for auto-scaling
-                if (batch_data[j] < y_min_ecg) y_min_ecg = batch_data[j];
-                if (batch_data[j] > y_max_ecg) y_max_ecg = batch_data[j];
-            }
-            
-            sample_counter += batch_count; // Fix: Update sample counter correctly
-            batch_count = 0;
-        }
+        if (data_ecg[i] < y_min_ecg) y_min_ecg = data_ecg[i];
+        if (data_ecg[i] > y_max_ecg) y_max_ecg = data_ecg[i];
     }
+
+    // Only the columns under the sweep cursor are redrawn
+    ui_sweep_plot_add_samples(chart_ecg, data_ecg, num_samples);
+    sample_counter += num_samples;
     
     // Auto-scaling logic
     if (sample_counter % RANGE_UPDATE_INTERVAL == 0) {
@@ -521,7 +442,7 @@ void hpi_ecg_disp_draw_plotECG(int32_t *data_ecg, int num_samples, bool ecg_lead
                 new_max = center + 500;
             }
             
-            lv_chart_set_range(chart_ecg, LV_CHART_AXIS_PRIMARY_Y, new_min, new_max);
+            ui_sweep_plot_set_range(chart_ecg, new_min, new_max);
         }
         
         // Reset for next interval
@@ -575,7 +496,6 @@ void unload_scr_ecg_scr2(void)
 {
     // Reset state variables
     chart_ecg_update = false;
-    batch_count = 0;
     sample_counter = 0;
     y_max_ecg = -10000;
     y_min_ecg = 10000;
@@ -589,7 +509,6 @@ void unload_scr_ecg_scr2(void)
         lv_obj_del(scr_ecg_scr2);
         scr_ecg_scr2 = NULL;
         chart_ecg = NULL;
-        ser_ecg = NULL;
         label_ecg_hr = NULL;
         label_timer = NULL;
         label_ecg_lead_off = NULL;
@@ -275,6 +275,31 @@ void draw_scr_gsr(enum scroll_dir m_scroll_dir)
     hpi_show_screen(scr_gsr, m_scroll_dir);
 }
 
+/* Cached screen shown again: pick up the last stored measurement */
+void hpi_scr_gsr_refresh(void)
+{
+    uint8_t stored_stress_level = 0;
+    uint16_t stored_tonic_x100 = 0;
+    uint8_t stored_peaks_per_min = 0;
+    int64_t gsr_last_update_stored = 0;
+
+    if (label_scr_rate_value == NULL || label_gsr_last_update == NULL) {
+        return;
+    }
+
+    hpi_sys_get_last_gsr_stress(&stored_stress_level, &stored_tonic_x100, &stored_peaks_per_min, &gsr_last_update_stored);
+
+    if (gsr_last_update_stored > 0) {
+        char last_meas_str[25];
+        hpi_helper_get_relative_time_str(gsr_last_update_stored, last_meas_str, sizeof(last_meas_str));
+        lv_label_set_text_fmt(label_scr_rate_value, "%u", stored_peaks_per_min);
+        lv_label_set_text(label_gsr_last_update, last_meas_str);
+    } else {
+        lv_label_set_text(label_scr_rate_value, "--");
+        lv_label_set_text(label_gsr_last_update, "No measurement yet");
+    }
+}
+
 /**
  * @brief Update GSR display with stress index data
  * @param stress_index Stress index data structure with all metrics
@@ -18,7 +18,6 @@ extern struct k_sem sem_gsr_cancel;
 // GUI
 static lv_obj_t *scr_gsr_plot;
 static lv_obj_t *chart_gsr_trend;
-static lv_chart_series_t *ser_gsr_trend;
 static lv_obj_t *btn_stop;
 static lv_obj_t *label_timer; // shows remaining countdown
 static lv_obj_t *arc_gsr_progress; // progress arc for measurement duration
@@ -38,12 +37,7 @@ static float y_max_gsr = -10000;
 static float y_min_gsr = 10000;
 static uint32_t gsr_sample_counter = 0;
 static const uint32_t GSR_RANGE_UPDATE_INTERVAL = 128;
-static int32_t gsr_batch_data[32] __attribute__((aligned(4)));
-static uint32_t gsr_batch_count = 0;
-static bool gsr_chart_auto_refresh_enabled = true;
 
-// Function declarations for LVGL 9.2 optimized chart management
-static void gsr_chart_enable_performance_mode(bool enable);
 static void gsr_chart_reset_performance_counters(void);
 
 // Simple timer update function (called from display thread, mirrors ECG pattern)
@@ -105,11 +99,11 @@ static void gsr_touch_event_cb(lv_event_t *e)
 //     }
 // }
 // LVGL 9.2 optimized batch plot function (ECG-like flow adapted for GSR)
-void hpi_gsr_disp_draw_plotGSR(int32_t *data_gsr, int num_samples, bool gsr_lead_off)
+void hpi_gsr_disp_draw_plotGSR(const int32_t *data_gsr, int num_samples, bool gsr_lead_off)
 {
 
     // Early validation
-    if (!plot_ready || chart_gsr_trend == NULL || ser_gsr_trend == NULL || data_gsr == NULL || num_samples <= 0) {
+    if (!plot_ready || chart_gsr_trend == NULL || data_gsr == NULL || num_samples <= 0) {
         return;
     }
 
@@ -119,23 +113,14 @@ void hpi_gsr_disp_draw_plotGSR(int32_t *data_gsr, int num_samples, bool gsr_lead
     }
 
 
-    // Batch processing for efficiency
     for (int i = 0; i < num_samples; i++) {
-        gsr_batch_data[gsr_batch_count++] = data_gsr[i];
-
-        if (gsr_batch_count >= 32 || i == num_samples - 1) {
-            for (uint32_t j = 0; j < gsr_batch_count; j++) {
-                lv_chart_set_next_value(chart_gsr_trend, ser_gsr_trend, gsr_batch_data[j]);
-
-                if (gsr_batch_data[j] < y_min_gsr) y_min_gsr = gsr_batch_data[j];
-                if (gsr_batch_data[j] > y_max_gsr) y_max_gsr = gsr_batch_data[j];
-            }
-
-            gsr_sample_counter += gsr_batch_count;
-            gsr_batch_count = 0;
-        }
+        if (data_gsr[i] < y_min_gsr) y_min_gsr = data_gsr[i];
+        if (data_gsr[i] > y_max_gsr) y_max_gsr = data_gsr[i];
     }
 
+    ui_sweep_plot_add_samples(chart_gsr_trend, data_gsr, num_samples);
+    gsr_sample_counter += num_samples;
+
     // Auto-scaling logic (follow ECG pattern)
     if (gsr_sample_counter % GSR_RANGE_UPDATE_INTERVAL == 0) {
         if (y_max_gsr > y_min_gsr) {
@@ -152,18 +137,13 @@ void hpi_gsr_disp_draw_plotGSR(int32_t *data_gsr, int num_samples, bool gsr_lead
                 new_max = center + 100;
             }
 
-            lv_chart_set_range(chart_gsr_trend, LV_CHART_AXIS_PRIMARY_Y, new_min, new_max);
+            ui_sweep_plot_set_range(chart_gsr_trend, new_min, new_max);
         }
 
         // Reset extrema for next interval
         y_min_gsr = 10000;
         y_max_gsr = -10000;
     }
-
-    // Refresh depending on auto-refresh flag (keep behavior similar to ECG)
-    if (gsr_chart_auto_refresh_enabled) {
-        lv_chart_refresh(chart_gsr_trend);
-    }
 }
 
 void draw_scr_gsr_plot(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4)
@@ -231,47 +211,10 @@ void draw_scr_gsr_plot(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg
     lv_obj_add_style(label_timer_unit, &style_caption, LV_PART_MAIN);
     lv_obj_set_style_text_color(label_timer_unit, lv_color_hex(0xFFFFFF), LV_PART_MAIN);  // Orange accent
 
-    // Chart - positioned in center area
-    chart_gsr_trend = lv_chart_create(scr_gsr_plot);
-    lv_obj_set_size(chart_gsr_trend, 340, 120);
+    // Sweep plot - positioned in center area, blue theme for GSR
+    chart_gsr_trend = ui_sweep_plot_create(scr_gsr_plot, 330, 110, GSR_DISP_WINDOW_SIZE, lv_color_hex(COLOR_PRIMARY_BLUE), 3);
     lv_obj_align(chart_gsr_trend, LV_ALIGN_CENTER, 0, -20);
 
-    // Configure chart properties
-    lv_chart_set_type(chart_gsr_trend, LV_CHART_TYPE_LINE);
-    lv_chart_set_point_count(chart_gsr_trend, GSR_DISP_WINDOW_SIZE);
-    lv_chart_set_update_mode(chart_gsr_trend, LV_CHART_UPDATE_MODE_CIRCULAR);
-    lv_chart_set_div_line_count(chart_gsr_trend, 0, 0);
-    
-    // Configure main chart background (transparent for AMOLED)
-    lv_obj_set_style_bg_opa(chart_gsr_trend, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_width(chart_gsr_trend, 0, LV_PART_MAIN);
-    lv_obj_set_style_outline_width(chart_gsr_trend, 0, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(chart_gsr_trend, 5, LV_PART_MAIN);
-    
-    // Create series for GSR data
-    ser_gsr_trend = lv_chart_add_series(chart_gsr_trend, lv_color_hex(COLOR_PRIMARY_BLUE), LV_CHART_AXIS_PRIMARY_Y);
-    
-    // Configure line series styling - blue theme for GSR
-    lv_obj_set_style_line_width(chart_gsr_trend, 3, LV_PART_ITEMS);
-    lv_obj_set_style_line_color(chart_gsr_trend, lv_color_hex(COLOR_PRIMARY_BLUE), LV_PART_ITEMS);
-    lv_obj_set_style_line_opa(chart_gsr_trend, LV_OPA_COVER, LV_PART_ITEMS);
-    lv_obj_set_style_line_rounded(chart_gsr_trend, false, LV_PART_ITEMS);
-    
-    // Disable points completely
-    lv_obj_set_style_width(chart_gsr_trend, 0, LV_PART_INDICATOR);
-    lv_obj_set_style_height(chart_gsr_trend, 0, LV_PART_INDICATOR);
-    lv_obj_set_style_bg_opa(chart_gsr_trend, LV_OPA_TRANSP, LV_PART_INDICATOR);
-    lv_obj_set_style_border_opa(chart_gsr_trend, LV_OPA_TRANSP, LV_PART_INDICATOR);
-    
-    // Performance optimizations for real-time GSR display
-    lv_obj_add_flag(chart_gsr_trend, LV_OBJ_FLAG_IGNORE_LAYOUT);           // Skip layout calculations
-    lv_obj_clear_flag(chart_gsr_trend, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_clear_flag(chart_gsr_trend, LV_OBJ_FLAG_CLICK_FOCUSABLE);
-    /* Allow gesture to bubble up to screen */
-    lv_obj_add_flag(chart_gsr_trend, LV_OBJ_FLAG_GESTURE_BUBBLE);
-    // Initialize chart with baseline values
-    lv_chart_set_all_value(chart_gsr_trend, ser_gsr_trend, 0);
-
     // Note: Real-time uS display disabled - final tonic level shown on results screen
     // Set label_gsr_value to NULL since we're not creating it
     label_gsr_value = NULL;
@@ -306,9 +249,7 @@ void draw_scr_gsr_plot(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg
     // This ensures the button is always on top and can receive touch events
    // lv_obj_move_foreground(btn_stop);
 
-    // Initialize performance optimization system
     gsr_chart_reset_performance_counters();
-    gsr_chart_enable_performance_mode(true);  // Start in high-performance mode
     plot_ready = true;
 
     lv_obj_add_event_cb(scr_gsr_plot, gsr_gesture_event_cb, LV_EVENT_GESTURE, NULL);
@@ -317,27 +258,9 @@ void draw_scr_gsr_plot(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg
     hpi_show_screen(scr_gsr_plot, m_scroll_dir);
 }
 
-// LVGL 9.2 optimized chart management functions
-static void gsr_chart_enable_performance_mode(bool enable)
-{
-    if (chart_gsr_trend == NULL) return;
-    
-    if (enable) {
-        // Enable performance optimizations
-        lv_obj_add_flag(chart_gsr_trend, LV_OBJ_FLAG_IGNORE_LAYOUT);
-        gsr_chart_auto_refresh_enabled = false;
-    } else {
-        // Restore normal operation
-        lv_obj_clear_flag(chart_gsr_trend, LV_OBJ_FLAG_IGNORE_LAYOUT);
-        gsr_chart_auto_refresh_enabled = true;
-        lv_chart_refresh(chart_gsr_trend);
-    }
-}
-
 static void gsr_chart_reset_performance_counters(void)
 {
     gsr_sample_counter = 0;
-    gsr_batch_count = 0;
     // Initialize for proper range detection
     y_max_gsr = -10000;
     y_min_gsr = 10000;
@@ -463,6 +463,40 @@ void draw_scr_home(enum scroll_dir m_scroll_dir)
     hpi_show_screen(scr_home, m_scroll_dir);
 }
 
+/* Cached screen shown again: bring time, vitals, battery and recording state up to date */
+void hpi_scr_home_refresh(void)
+{
+    if (scr_home == NULL) {
+        return;
+    }
+
+    hpi_scr_home_update_time_date(hpi_sys_get_current_time());
+    hpi_disp_home_update_batt_level(battery_get_level(), battery_get_charging());
+
+    uint16_t hr = 0;
+    uint16_t steps = 0;
+    int64_t last_update_ts = 0;
+    if (hpi_sys_get_last_hr_update(&hr, &last_update_ts) == 0) {
+        hpi_home_hr_update(hr);
+    }
+    if (hpi_sys_get_last_steps_update(&steps, &last_update_ts) == 0) {
+        hpi_home_steps_update(steps);
+    }
+
+    struct hpi_recording_status_t rec_status;
+    if (hpi_recording_get_status(&rec_status) == 0) {
+        hpi_scr_home_update_recording_status(&rec_status);
+    }
+
+    if (label_time_not_set != NULL) {
+        if (hpi_sys_is_time_valid()) {
+            lv_obj_add_flag(label_time_not_set, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_clear_flag(label_time_not_set, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+
 void hpi_scr_home_update_time_date(struct tm in_time)
 {
     if (ui_home_label_hour == NULL || ui_home_label_date == NULL)
@@ -184,6 +184,20 @@ void hpi_disp_hr_update_hr(uint16_t hr, int64_t last_update_ts)
     }
 }
 
+/* Cached screen shown again: pick up the latest reading */
+void hpi_scr_hr_refresh(void)
+{
+    uint16_t hr = 0;
+    int64_t last_update_ts = 0;
+
+    if (hpi_sys_get_last_hr_update(&hr, &last_update_ts) != 0)
+    {
+        hr = 0;
+        last_update_ts = 0;
+    }
+    hpi_disp_hr_update_hr(hr, last_update_ts);
+}
+
 /* Event handler to open Raw PPG special screen */
 static void scr_hr_btn_raw_event_handler(lv_event_t *e)
 {
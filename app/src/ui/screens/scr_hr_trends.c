@@ -222,16 +222,11 @@ void draw_scr_hr_scr2(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg2
 void hpi_disp_hr_load_trend(void)
 {
     struct hpi_hourly_trend_point_t hr_hourly_trend_points[HR_SCR_TREND_MAX_POINTS];
-    struct hpi_minutely_trend_point_t hr_minutely_trend_points[60];
-
-    for(int i=0; i<60; i++)
-    {
-        hr_minutely_trend_points[i].avg = 0;
-    }
+    struct hpi_minutely_trend_point_t hr_minutely_trend_points[HPI_TREND_MINUTE_SLOTS];
 
     int m_num_points = 0;
 
-    if (hpi_trend_load_trend(hr_hourly_trend_points, hr_minutely_trend_points, &m_num_points, TREND_HR) == 0)
+    if (hpi_trend_load_trend(hr_hourly_trend_points, hr_minutely_trend_points, ARRAY_SIZE(hr_minutely_trend_points), &m_num_points, TREND_HR) == 0)
     {
         if (chart_hr_day_trend == NULL)
         {
@@ -256,7 +251,7 @@ void hpi_disp_hr_load_trend(void)
             }
         }
 
-        for(int i=0; i<60; i++)
+        for(int i=0; i<HPI_TREND_MINUTE_SLOTS; i++)
         {
             lv_chart_set_value_by_id(chart_hr_hour_trend, ser_hr_hour_trend, i, hr_minutely_trend_points[i].max);
         }
@@ -294,6 +294,12 @@ void draw_scr_hrv(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t arg2, ui
     hpi_show_screen(scr_hrv, m_scroll_dir);
 }
 
+/* Cached screen shown again: pick up the last measurement */
+void hpi_scr_hrv_refresh(void)
+{
+    hrv_update_display();
+}
+
 static void hrv_update_display(void)
 {
     if (label_hrv_value == NULL || label_hrv_status == NULL) {
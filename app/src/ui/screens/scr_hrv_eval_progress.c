@@ -9,6 +9,7 @@
 #include "ui/move_ui.h"
 #include "hw_module.h"
 #include "hpi_sys.h"
+#include "hrv_algos.h"
 
 LOG_MODULE_REGISTER(hpi_disp_scr_hrv_eval_progress, LOG_LEVEL_DBG);
 
@@ -17,15 +18,12 @@ lv_obj_t *scr_hrv_eval_progress;
 static lv_obj_t *label_timer = NULL;
 static lv_obj_t *label_ecg_lead_off = NULL;
 static lv_obj_t *chart_ecg = NULL;
-static lv_chart_series_t *ser_ecg = NULL;
 static lv_obj_t *arc_hrv_zone = NULL;
 static lv_obj_t *label_intervals_count = NULL;
 
 // ECG chart state
 static float y_max_ecg = -10000;
 static float y_min_ecg = 10000;
-static int32_t batch_data[32] __attribute__((aligned(4)));
-static uint32_t batch_count = 0;
 static uint32_t sample_counter = 0;
 static const uint32_t RANGE_UPDATE_INTERVAL = 128;
 
@@ -115,9 +113,16 @@ void hpi_hrv_disp_update_timer(uint16_t remaining_s)
         }
         lv_obj_set_style_arc_color(arc_hrv_zone, lv_color_hex(0x8B0000), LV_PART_INDICATOR); 
 
-        // Update interval count display
+        // Update interval count and live RMSSD from the streaming HRV engine
         if (label_intervals_count != NULL) {
-            lv_label_set_text_fmt(label_intervals_count, "Intervals: %d", hrv_interval_count);
+            struct hpi_hrv_live_t live;
+            hpi_hrv_stream_get_time_domain(&live);
+            if (live.count >= 2) {
+                lv_label_set_text_fmt(label_intervals_count, "Intervals: %d  RMSSD: %d ms",
+                                      hrv_interval_count, (int)(live.rmssd + 0.5f));
+            } else {
+                lv_label_set_text_fmt(label_intervals_count, "Intervals: %d", hrv_interval_count);
+            }
         }
     }
 }
@@ -179,54 +184,14 @@ void draw_scr_spl_hrv_eval_progress(enum scroll_dir m_scroll_dir, uint32_t arg1,
     lv_obj_add_style(label_timer_unit, &style_caption, LV_PART_MAIN);
     lv_obj_set_style_text_color(label_timer_unit, lv_color_white(), LV_PART_MAIN);  
 
-    chart_ecg = lv_chart_create(scr_hrv_eval_progress);
-    lv_obj_set_size(chart_ecg, 340, 100);  // Smaller chart for circular design
+    // ECG sweep plot - dark red theme for HRV measurement
+    chart_ecg = ui_sweep_plot_create(scr_hrv_eval_progress, 330, 90, ECG_DISP_WINDOW_SIZE, lv_color_hex(0x8B0000), 3);
     lv_obj_align(chart_ecg, LV_ALIGN_CENTER, 0, -10);  // Centered position
-    
-    // Configure chart type and fundamental properties
-    lv_chart_set_type(chart_ecg, LV_CHART_TYPE_LINE);
-    lv_chart_set_point_count(chart_ecg, ECG_DISP_WINDOW_SIZE);
-    lv_chart_set_update_mode(chart_ecg, LV_CHART_UPDATE_MODE_CIRCULAR);
-    
-    // Set Y-axis range for ECG data
-    lv_chart_set_range(chart_ecg, LV_CHART_AXIS_PRIMARY_Y, -5000, 5000);
-    
-    // Disable division lines for clean ECG display
-    lv_chart_set_div_line_count(chart_ecg, 0, 0);
-    
-    // Configure main chart background (transparent for AMOLED)
-    lv_obj_set_style_bg_opa(chart_ecg, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_width(chart_ecg, 0, LV_PART_MAIN);
-    lv_obj_set_style_outline_width(chart_ecg, 0, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(chart_ecg, 5, LV_PART_MAIN);
-    
-    // Create series for ECG data - pink theme for HRV
-    ser_ecg = lv_chart_add_series(chart_ecg, lv_color_hex(0x8B0000), LV_CHART_AXIS_PRIMARY_Y);
-    
-    // Configure line series styling - pink theme for HRV measurement
-    lv_obj_set_style_line_width(chart_ecg, 3, LV_PART_ITEMS);
-    lv_obj_set_style_line_color(chart_ecg, lv_color_hex(0x8B0000), LV_PART_ITEMS);
-    lv_obj_set_style_line_opa(chart_ecg, LV_OPA_COVER, LV_PART_ITEMS);
-    lv_obj_set_style_line_rounded(chart_ecg, false, LV_PART_ITEMS);
-    
-    // Disable points completely
-    lv_obj_set_style_width(chart_ecg, 0, LV_PART_INDICATOR);
-    lv_obj_set_style_height(chart_ecg, 0, LV_PART_INDICATOR);
-    lv_obj_set_style_bg_opa(chart_ecg, LV_OPA_TRANSP, LV_PART_INDICATOR);
-    lv_obj_set_style_border_opa(chart_ecg, LV_OPA_TRANSP, LV_PART_INDICATOR);
-    
-    // Performance optimizations
-    lv_obj_add_flag(chart_ecg, LV_OBJ_FLAG_IGNORE_LAYOUT);
-    lv_obj_clear_flag(chart_ecg, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_clear_flag(chart_ecg, LV_OBJ_FLAG_CLICK_FOCUSABLE);
-    
-    // Initialize chart with baseline values
-    lv_chart_set_all_value(chart_ecg, ser_ecg, 0); 
+    ui_sweep_plot_set_range(chart_ecg, -5000, 5000);
   
-    batch_count = 0;
     sample_counter = 0;
     hrv_plot_enabled = true;
-    LOG_INF("HRV Chart RESET: batch=%d samples=%d", batch_count, sample_counter);
+    LOG_INF("HRV Chart RESET: samples=%d", sample_counter);
             
     // Lead status display - overlay on chart area
     label_ecg_lead_off = lv_label_create(scr_hrv_eval_progress);
@@ -270,10 +235,10 @@ void gesture_down_scr_spl_hrv_eval_progress(void)
     hpi_load_screen(SCR_HRV, SCROLL_DOWN);
 }
 
-void hpi_ecg_disp_draw_plotECG_hrv(int32_t *data_ecg, int num_samples, bool ecg_lead_off)
+void hpi_ecg_disp_draw_plotECG_hrv(const int32_t *data_ecg, int num_samples, bool ecg_lead_off)
 {
     // Early validation - LVGL 9.2 best practice
-    if (!hrv_plot_enabled || chart_ecg == NULL || ser_ecg == NULL || data_ecg == NULL || num_samples <= 0) {
+    if (!hrv_plot_enabled || chart_ecg == NULL || data_ecg == NULL || num_samples <= 0) {
         return;
     }
 
@@ -287,26 +252,15 @@ void hpi_ecg_disp_draw_plotECG_hrv(int32_t *data_ecg, int num_samples, bool ecg_
         return;
     }
 
-    // Batch processing for efficiency
+    // Track min/max for auto-scaling
     for (int i = 0; i < num_samples; i++)
     {
-        batch_data[batch_count++] = data_ecg[i];
-        
-        // Process batch when full or at end of samples
-        if (batch_count >= 32 || i == num_samples - 1) {
-            // Process batch
-            for (uint32_t j = 0; j < batch_count; j++) {
-                lv_chart_set_next_value(chart_ecg, ser_ecg, batch_data[j]);
-                
-                // Track min/max for auto-scaling
-                if (batch_data[j] < y_min_ecg) y_min_ecg = batch_data[j];
-                if (batch_data[j] > y_max_ecg) y_max_ecg = batch_data[j];
-            }
-            
-            sample_counter += batch_count; // Fix: Update sample counter correctly
-            batch_count = 0;
-        }
+        if (data_ecg[i] < y_min_ecg) y_min_ecg = data_ecg[i];
+        if (data_ecg[i] > y_max_ecg) y_max_ecg = data_ecg[i];
     }
+
+    ui_sweep_plot_add_samples(chart_ecg, data_ecg, num_samples);
+    sample_counter += num_samples;
     
     // Auto-scaling logic
     if (sample_counter % RANGE_UPDATE_INTERVAL == 0) {
@@ -324,7 +278,7 @@ void hpi_ecg_disp_draw_plotECG_hrv(int32_t *data_ecg, int num_samples, bool ecg_
                 new_max = center + 500;
             }
             
-            lv_chart_set_range(chart_ecg, LV_CHART_AXIS_PRIMARY_Y, new_min, new_max);
+            ui_sweep_plot_set_range(chart_ecg, new_min, new_max);
         }
         
         // Reset for next interval
@@ -362,14 +316,14 @@ void scr_hrv_lead_on_off_handler(bool lead_off)
 void unload_scr_hrv_eval_progress(void)
 {
     scr_hrv_progress_active = false;
-    batch_count = 0; sample_counter = 0;
+    sample_counter = 0;
     y_max_ecg = -10000; y_min_ecg = 10000;
     lead_on_detected = false;
     
     if (scr_hrv_eval_progress) {
         lv_obj_del(scr_hrv_eval_progress);
         scr_hrv_eval_progress = NULL;
-        chart_ecg = NULL; ser_ecg = NULL;
+        chart_ecg = NULL;
         label_timer = NULL; label_ecg_lead_off = NULL;
     }
 }
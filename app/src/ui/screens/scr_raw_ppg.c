@@ -43,7 +43,6 @@ lv_obj_t *scr_raw_ppg;
 
 // GUI Charts
 static lv_obj_t *chart_ppg;
-static lv_chart_series_t *ser_ppg;
 
 // GUI Labels
 static lv_obj_t *label_ppg_hr;
@@ -102,23 +101,13 @@ void draw_scr_spl_raw_ppg(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t
     lv_label_set_text(label_signal, "PPG");
     lv_obj_align(label_signal, LV_ALIGN_TOP_MID, 0, 5);
 
-    chart_ppg = lv_chart_create(cont_col);
-    /* Match SpO2 measure chart styling */
-    lv_obj_set_size(chart_ppg, 390, 140);
-    lv_obj_set_style_bg_color(chart_ppg, lv_color_black(), LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(chart_ppg, 0, LV_PART_MAIN);
-    lv_obj_set_style_border_width(chart_ppg, 0, LV_PART_MAIN);
-    lv_chart_set_point_count(chart_ppg, PPG_RAW_WINDOW_SIZE);
-    lv_chart_set_div_line_count(chart_ppg, 0, 0);
-    lv_chart_set_update_mode(chart_ppg, LV_CHART_UPDATE_MODE_CIRCULAR);
+    /* Match SpO2 measure plot styling */
+    chart_ppg = ui_sweep_plot_create(cont_col, 390, 140, PPG_RAW_WINDOW_SIZE, lv_palette_main(LV_PALETTE_ORANGE), 6);
     lv_obj_align(chart_ppg, LV_ALIGN_CENTER, 0, -35);
     
     // Set initial Y-axis range suitable for PPG data (typically 0-65535 for raw values)
     // Start with a reasonable range around typical PPG baseline
-    lv_chart_set_range(chart_ppg, LV_CHART_AXIS_PRIMARY_Y, 0, 65535);
-
-    ser_ppg = lv_chart_add_series(chart_ppg, lv_palette_main(LV_PALETTE_ORANGE), LV_CHART_AXIS_PRIMARY_Y);
-    lv_obj_set_style_line_width(chart_ppg, 6, LV_PART_ITEMS);
+    ui_sweep_plot_set_range(chart_ppg, 0, 65535);
 
     // Draw BPM container
     lv_obj_t *cont_hr = lv_obj_create(cont_col);
@@ -254,24 +243,24 @@ static void hpi_ppg_update_signal_status(enum hpi_ppg_status scd_state)
     }
 }
 
-void hpi_disp_ppg_draw_plotPPG(struct hpi_ppg_wr_data_t ppg_sensor_sample)
+void hpi_disp_ppg_draw_plotPPG(const struct hpi_ppg_wr_data_t *ppg_sensor_sample)
 {
     // Update last data received timestamp
     last_ppg_data_time = k_uptime_get_32();
 
     // Store the SCD state for use in periodic timeout checks
-    last_scd_state = ppg_sensor_sample.scd_state;
+    last_scd_state = ppg_sensor_sample->scd_state;
 
     // Update signal status based on SCD state
-    hpi_ppg_update_signal_status(ppg_sensor_sample.scd_state);
+    hpi_ppg_update_signal_status(ppg_sensor_sample->scd_state);
 
-    uint32_t *data_ppg = ppg_sensor_sample.raw_green;
+    const uint32_t *data_ppg = ppg_sensor_sample->raw_green;
 
     // Find min/max in current batch for accurate tracking
     uint32_t batch_min = UINT32_MAX;
     uint32_t batch_max = 0;
     
-    for (int i = 0; i < ppg_sensor_sample.ppg_num_samples; i++)
+    for (int i = 0; i < ppg_sensor_sample->ppg_num_samples; i++)
     {
         if (data_ppg[i] < batch_min) batch_min = data_ppg[i];
         if (data_ppg[i] > batch_max) batch_max = data_ppg[i];
@@ -296,12 +285,9 @@ void hpi_disp_ppg_draw_plotPPG(struct hpi_ppg_wr_data_t ppg_sensor_sample)
         if (batch_max > y_max_ppg) y_max_ppg = batch_max;
     }
 
-    // Plot all samples
-    for (int i = 0; i < ppg_sensor_sample.ppg_num_samples; i++)
-    {
-        lv_chart_set_next_value(chart_ppg, ser_ppg, data_ppg[i]);
-        hpi_ppg_disp_add_samples(1);
-    }
+    // Plot all samples, raw PPG counts fit in int32
+    ui_sweep_plot_add_samples(chart_ppg, (const int32_t *)data_ppg, ppg_sensor_sample->ppg_num_samples);
+    hpi_ppg_disp_add_samples(ppg_sensor_sample->ppg_num_samples);
     
     // Call autoscale once per batch, not per sample, for better performance
     hpi_ppg_disp_do_set_scale(PPG_RAW_WINDOW_SIZE);
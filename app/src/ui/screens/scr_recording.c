@@ -336,6 +336,27 @@ void draw_scr_recording(enum scroll_dir m_scroll_dir)
     hpi_show_screen(scr_recording, m_scroll_dir);
 }
 
+/* Cached screen shown again: the recording may have started or ended meanwhile */
+void hpi_scr_recording_refresh(void)
+{
+    if (scr_recording == NULL) {
+        return;
+    }
+
+    is_recording = hpi_recording_is_active();
+    update_ui_for_state(is_recording);
+
+    if (is_recording) {
+        struct hpi_recording_status_t status;
+        hpi_recording_get_status(&status);
+        if (label_duration != NULL) {
+            uint16_t mins = status.elapsed_s / 60;
+            uint16_t secs = status.elapsed_s % 60;
+            lv_label_set_text_fmt(label_duration, "%02d:%02d", mins, secs);
+        }
+    }
+}
+
 void hpi_scr_recording_update_status(struct hpi_recording_status_t *status)
 {
     if (scr_recording == NULL || status == NULL) {
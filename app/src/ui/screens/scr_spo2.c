@@ -237,4 +237,18 @@ void hpi_disp_update_spo2(uint8_t spo2, int64_t ts_last_update)
 
     // Update progress arc if it exists (for future dynamic updates)
     // This would require storing the arc object globally if needed
-}
\ No newline at end of file
+}
+
+/* Cached screen shown again: pick up the latest reading */
+void hpi_scr_spo2_refresh(void)
+{
+    uint8_t spo2 = 0;
+    int64_t last_update_ts = 0;
+
+    if (hpi_sys_get_last_spo2_update(&spo2, &last_update_ts) != 0)
+    {
+        spo2 = 0;
+        last_update_ts = 0;
+    }
+    hpi_disp_update_spo2(spo2, last_update_ts);
+}
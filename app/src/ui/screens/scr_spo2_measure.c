@@ -48,7 +48,6 @@ static lv_obj_t *scr_spo2_scr_measure;
 
 // GUI components
 static lv_obj_t *chart_ppg;
-static lv_chart_series_t *ser_ppg;
 // static lv_obj_t *label_hr;
 static lv_obj_t *label_spo2_progress;
 static lv_obj_t *bar_spo2_progress;
@@ -146,46 +145,17 @@ void draw_scr_spo2_measure(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t
     lv_label_set_text(label_spo2_progress, "--");
     lv_obj_set_style_text_align(label_spo2_progress, LV_TEXT_ALIGN_CENTER, 0);
 
-    chart_ppg = lv_chart_create(cont_col);
-    lv_obj_set_size(chart_ppg, 390, 140);
-    lv_obj_set_style_bg_color(chart_ppg, lv_color_black(), LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(chart_ppg, 0, LV_PART_MAIN);
-
-    // LVGL 9: Chart point styling changed - commented out
-
-    // lv_obj_set_style_width(...);
-    // LVGL 9: Chart point styling changed - commented out
-
-    // lv_obj_set_style_height(...);
-    lv_obj_set_style_border_width(chart_ppg, 0, LV_PART_MAIN);
-
-    /* Use consistent buffering/point-count choices as raw PPG screen for better visual parity
+    /* Use consistent sweep width choices as raw PPG screen for better visual parity
      * - FI source keeps the wider BPT window
      * - Wrist PPG uses the raw PPG window for snappier updates
      */
-    if (spo2_source == SPO2_SOURCE_PPG_FI)
-    {
-        lv_chart_set_point_count(chart_ppg, BPT_DISP_WINDOW_SIZE * 2);
-    }
-    else if (spo2_source == SPO2_SOURCE_PPG_WR)
-    {
-        /* match raw PPG window size for wrist plotting */
-        lv_chart_set_point_count(chart_ppg, PPG_RAW_WINDOW_SIZE);
-    }
+    uint32_t sweep_samples = (spo2_source == SPO2_SOURCE_PPG_FI) ? (BPT_DISP_WINDOW_SIZE * 2) : PPG_RAW_WINDOW_SIZE;
 
-    lv_chart_set_div_line_count(chart_ppg, 0, 0);
-    lv_chart_set_update_mode(chart_ppg, LV_CHART_UPDATE_MODE_CIRCULAR);
+    chart_ppg = ui_sweep_plot_create(cont_col, 390, 140, sweep_samples, lv_palette_main(LV_PALETTE_ORANGE), 6);
     lv_obj_align(chart_ppg, LV_ALIGN_CENTER, 0, -35);
 
     /* Set a sensible default Y range to keep waveform visible until autoscale runs */
-    lv_chart_set_range(chart_ppg, LV_CHART_AXIS_PRIMARY_Y, 2048 - 128, 2048 + 128);
-
-    ser_ppg = lv_chart_add_series(chart_ppg, lv_palette_main(LV_PALETTE_ORANGE), LV_CHART_AXIS_PRIMARY_Y);
-    lv_obj_set_style_line_width(chart_ppg, 6, LV_PART_ITEMS);
-
-    /* Initialize chart with baseline value to show a flat line instead of junk
-     * during the warmup period. The value 2048 matches the DC offset used in plotting. */
-    lv_chart_set_all_value(chart_ppg, ser_ppg, 2048);
+    ui_sweep_plot_set_range(chart_ppg, 2048 - 128, 2048 + 128);
 
     lv_obj_t *cont_hr = lv_obj_create(cont_col);
     lv_obj_set_size(cont_hr, lv_pct(100), LV_SIZE_CONTENT);
@@ -279,19 +249,21 @@ void hpi_disp_spo2_update_progress(int progress, enum spo2_meas_state state, int
     }
 }
 
-void hpi_disp_spo2_plot_wrist_ppg(struct hpi_ppg_wr_data_t ppg_sensor_sample)
+void hpi_disp_spo2_plot_wrist_ppg(const struct hpi_ppg_wr_data_t *ppg_sensor_sample)
 {
-    uint32_t *data_ppg = ppg_sensor_sample.raw_green;
+    const uint32_t *data_ppg = ppg_sensor_sample->raw_green;
 
     /* Simple DC removal: EMA baseline and plot residual centered to avoid LVGL coord wrap. */
     const float alpha = 0.005f; /* small alpha for slow baseline tracking */
 
     /* Cache locals to reduce repeated global accesses */
-    int num = ppg_sensor_sample.ppg_num_samples;
+    int num = ppg_sensor_sample->ppg_num_samples;
     float local_ymin = y_min_ppg;
     float local_ymax = y_max_ppg;
     float local_base = wr_baseline_ema;
     int local_spo2_source = spo2_source;
+    int32_t plot_buf[PPG_POINTS_PER_SAMPLE];
+    int plot_count = 0;
 
     for (int i = 0; i < num; i++)
     {
@@ -314,11 +286,14 @@ void hpi_disp_spo2_plot_wrist_ppg(struct hpi_ppg_wr_data_t ppg_sensor_sample)
 
         float fplot = (float)plot_val;
 
-        /* Update local extrema then write sample to chart so autoscale sees newest values */
+        /* Update local extrema so autoscale sees newest values */
         if (fplot < local_ymin) local_ymin = fplot;
         if (fplot > local_ymax) local_ymax = fplot;
 
-        lv_chart_set_next_value(chart_ppg, ser_ppg, plot_val);
+        if (plot_count < PPG_POINTS_PER_SAMPLE)
+        {
+            plot_buf[plot_count++] = plot_val;
+        }
 
         /* Commit extrema to globals used by the shared autoscale helper */
         y_min_ppg = local_ymin;
@@ -334,20 +309,25 @@ void hpi_disp_spo2_plot_wrist_ppg(struct hpi_ppg_wr_data_t ppg_sensor_sample)
         }
     }
 
+    /* One sweep update per batch keeps a single dirty rectangle */
+    ui_sweep_plot_add_samples(chart_ppg, plot_buf, plot_count);
+
     /* write back cached locals */
     y_min_ppg = local_ymin;
     y_max_ppg = local_ymax;
     wr_baseline_ema = local_base;
 }
 
-void hpi_disp_spo2_plot_fi_ppg(struct hpi_ppg_fi_data_t ppg_sensor_sample)
+void hpi_disp_spo2_plot_fi_ppg(const struct hpi_ppg_fi_data_t *ppg_sensor_sample)
 {
-    uint32_t *data_ppg = ppg_sensor_sample.raw_ir;
+    const uint32_t *data_ppg = ppg_sensor_sample->raw_ir;
 
     /* Simple DC removal for FI source similar to wrist plotting to reduce baseline wander */
     const float alpha_fi = 0.01f; /* slightly faster baseline tracking for finger */
+    int32_t plot_buf[BPT_PPG_POINTS_PER_SAMPLE];
+    int plot_count = 0;
 
-    for (int i = 0; i < ppg_sensor_sample.ppg_num_samples; i++)
+    for (int i = 0; i < ppg_sensor_sample->ppg_num_samples; i++)
     {
         float data_ppg_i = (float)(data_ppg[i]);
 
@@ -362,7 +342,10 @@ void hpi_disp_spo2_plot_fi_ppg(struct hpi_ppg_fi_data_t ppg_sensor_sample)
                 continue;
             }
             /* Plot last valid value to maintain waveform continuity */
-            lv_chart_set_next_value(chart_ppg, ser_ppg, fi_last_valid_plot_val);
+            if (plot_count < BPT_PPG_POINTS_PER_SAMPLE)
+            {
+                plot_buf[plot_count++] = fi_last_valid_plot_val;
+            }
             hpi_ppg_disp_add_samples(1);
             hpi_ppg_disp_do_set_scale(BPT_DISP_WINDOW_SIZE * 2);
             continue;
@@ -412,11 +395,16 @@ void hpi_disp_spo2_plot_fi_ppg(struct hpi_ppg_fi_data_t ppg_sensor_sample)
             y_max_ppg = (float)plot_val;
         }
 
-        lv_chart_set_next_value(chart_ppg, ser_ppg, plot_val);
+        if (plot_count < BPT_PPG_POINTS_PER_SAMPLE)
+        {
+            plot_buf[plot_count++] = plot_val;
+        }
 
         hpi_ppg_disp_add_samples(1);
         hpi_ppg_disp_do_set_scale(BPT_DISP_WINDOW_SIZE * 2);
     }
+
+    ui_sweep_plot_add_samples(chart_ppg, plot_buf, plot_count);
 }
 
 extern struct k_sem sem_spo2_cancel;
@@ -211,14 +211,14 @@ void draw_scr_spo2_trends(enum scroll_dir m_scroll_dir, uint32_t arg1, uint32_t
 void hpi_disp_spo2_load_trend(void)
 {
     struct hpi_hourly_trend_point_t spo2_hourly_trend_points[SPO2_SCR_TREND_MAX_POINTS];
-    struct hpi_minutely_trend_point_t spo2_minutely_trend_points[SPO2_SCR_TREND_MAX_POINTS];
+    struct hpi_minutely_trend_point_t spo2_minutely_trend_points[HPI_TREND_MINUTE_SLOTS];
     if (chart_spo2_trend == NULL)
         return;
 
     int m_num_points = 0;
 
     //if(0)
-    if(hpi_trend_load_trend(spo2_hourly_trend_points, spo2_minutely_trend_points, &m_num_points, TREND_SPO2) == 0)
+    if(hpi_trend_load_trend(spo2_hourly_trend_points, spo2_minutely_trend_points, ARRAY_SIZE(spo2_minutely_trend_points), &m_num_points, TREND_SPO2) == 0)
     {
         int y_max = -1;
         int y_min = 999;
@@ -28,6 +28,7 @@ static lv_obj_t *label_temp_value;
 static lv_obj_t *label_temp_unit;
 static lv_obj_t *label_temp_last_update;
 static lv_obj_t *btn_temp_unit;
+static lv_obj_t *label_temp_btn;
 
 // Externs - Modern style system
 extern lv_style_t style_body_medium;
@@ -153,15 +154,15 @@ void draw_scr_temp(enum scroll_dir m_scroll_dir)
     lv_obj_set_style_border_width(btn_temp_unit, 0, LV_PART_MAIN);
     lv_obj_set_style_shadow_width(btn_temp_unit, 0, LV_PART_MAIN);
 
-    lv_obj_t *label_btn = lv_label_create(btn_temp_unit);
+    label_temp_btn = lv_label_create(btn_temp_unit);
     // Show the unit to switch TO
     if (temp_unit_pref == 1) {
-        lv_label_set_text(label_btn, "Switch to °C");
+        lv_label_set_text(label_temp_btn, "Switch to °C");
     } else {
-        lv_label_set_text(label_btn, "Switch to °F");
+        lv_label_set_text(label_temp_btn, "Switch to °F");
     }
-    lv_obj_center(label_btn);
-    lv_obj_set_style_text_color(label_btn, lv_color_white(), LV_PART_MAIN);
+    lv_obj_center(label_temp_btn);
+    lv_obj_set_style_text_color(label_temp_btn, lv_color_white(), LV_PART_MAIN);
     lv_obj_add_event_cb(btn_temp_unit, scr_temp_unit_btn_event_handler, LV_EVENT_CLICKED, NULL);
 
     hpi_disp_set_curr_screen(SCR_TEMP);
@@ -195,6 +196,34 @@ void hpi_temp_disp_update_temp_f(double temp_f, int64_t temp_f_last_update)
     lv_label_set_text(label_temp_last_update, last_meas_str);
 }
 
+/* Cached screen shown again, or the unit changed: pick up the latest reading and unit */
+void hpi_scr_temp_refresh(void)
+{
+    uint16_t temp_raw = 0;
+    int64_t temp_last_update = 0;
+
+    if (label_temp_value == NULL || label_temp_unit == NULL || label_temp_last_update == NULL) {
+        return;
+    }
+
+    if (hpi_sys_get_last_temp_update(&temp_raw, &temp_last_update) != 0) {
+        temp_raw = 0;
+        temp_last_update = 0;
+    }
+
+    if (temp_raw == 0) {
+        lv_label_set_text(label_temp_value, "--");
+        lv_label_set_text(label_temp_unit, "");
+        lv_label_set_text(label_temp_last_update, "No measurement yet");
+    } else {
+        hpi_temp_disp_update_temp_f(temp_raw / 100.0, temp_last_update);
+    }
+
+    if (label_temp_btn != NULL) {
+        lv_label_set_text(label_temp_btn, hpi_user_settings_get_temp_unit() == 1 ? "Switch to °C" : "Switch to °F");
+    }
+}
+
 static void scr_temp_unit_btn_event_handler(lv_event_t *e)
 {
     lv_event_code_t code = lv_event_get_code(e);
@@ -21,6 +21,8 @@ LOG_MODULE_REGISTER(display_sh8601, CONFIG_DISPLAY_LOG_LEVEL);
 #define SH8601_PIXEL_FORMAT_RGB565 0U
 #define SH8601_PIXEL_FORMAT_RGB888 1U
 
+#define SH8601_TX_TIMEOUT_MS 500U // A full 390x390 RGB565 frame takes ~75 ms at 33 MHz
+
 /*Display data struct*/
 struct sh8601_data
 {
@@ -29,12 +31,66 @@ struct sh8601_data
 	enum display_orientation orientation;
 
 	bool device_in_sleep;
+
+#ifdef CONFIG_SH8601_ASYNC_FLUSH
+	/* Pixel transfer state, has to outlive sh8601_write() */
+	struct k_sem tx_idle;
+	uint8_t ramwr_hdr[4];
+	struct spi_buf tx_buf[2];
+	struct spi_buf_set tx_bufs;
+	uint32_t tx_start;
+#endif
+
+	struct k_spinlock stats_lock;
+	struct sh8601_flush_stats stats;
 };
 
 static int sh8601_set_mem_area(const struct device *dev, const uint16_t x,
 							   const uint16_t y, const uint16_t w,
 							   const uint16_t h);
 
+static void sh8601_account_transfer(struct sh8601_data *data, uint32_t cycles, int result)
+{
+	uint32_t us = k_cyc_to_us_floor32(cycles);
+	k_spinlock_key_t key = k_spin_lock(&data->stats_lock);
+
+	data->stats.transfer_us += us;
+	if (us > data->stats.transfer_max_us)
+	{
+		data->stats.transfer_max_us = us;
+	}
+	if (result < 0)
+	{
+		data->stats.errors++;
+	}
+
+	k_spin_unlock(&data->stats_lock, key);
+}
+
+/**
+ * @brief Wait for the pixel transfer in flight, if any, to complete.
+ *
+ * Every other bus access goes through here first, so commands never
+ * interleave with pixel data and the caller's buffer is free on return.
+ */
+static int sh8601_wait_idle(const struct device *dev)
+{
+#ifdef CONFIG_SH8601_ASYNC_FLUSH
+	struct sh8601_data *data = dev->data;
+
+	if (k_sem_take(&data->tx_idle, K_MSEC(SH8601_TX_TIMEOUT_MS)) != 0)
+	{
+		LOG_ERR("Pixel transfer timed out");
+		// Don't wedge the display forever on a lost callback
+		k_sem_give(&data->tx_idle);
+		return -ETIMEDOUT;
+	}
+	k_sem_give(&data->tx_idle);
+#endif
+
+	return 0;
+}
+
 int sh8601_transmit_cmd(const struct device *dev, uint8_t cmd, const void *tx_data,
 						size_t tx_len)
 {
@@ -44,6 +100,12 @@ int sh8601_transmit_cmd(const struct device *dev, uint8_t cmd, const void *tx_da
 	struct spi_buf tx_buf[3];
 	struct spi_buf_set tx_bufs = {.buffers = tx_buf, .count = 2U};
 
+	r = sh8601_wait_idle(dev);
+	if (r < 0)
+	{
+		return r;
+	}
+
 	// Send Pre command
 	uint8_t pre_cmd[4] = {0x02, 00};
 	tx_buf[0].buf = &pre_cmd;
@@ -101,7 +163,10 @@ int sh8601_transmit_data(const struct device *dev, const void *tx_data,
 		tx_bufs.count = 3U;
 	}
 
+	uint32_t start = k_cycle_get_32();
+
 	r = spi_write_dt(&config->spi, &tx_bufs);
+	sh8601_account_transfer(dev->data, k_cycle_get_32() - start, r);
 	if (r < 0)
 	{
 		return r;
@@ -110,6 +175,52 @@ int sh8601_transmit_data(const struct device *dev, const void *tx_data,
 	return 0;
 }
 
+#ifdef CONFIG_SH8601_ASYNC_FLUSH
+
+static void sh8601_transmit_done(const struct device *spi_dev, int result, void *user_data)
+{
+	const struct device *dev = user_data;
+	struct sh8601_data *data = dev->data;
+
+	sh8601_account_transfer(data, k_cycle_get_32() - data->tx_start, result);
+	k_sem_give(&data->tx_idle);
+}
+
+/**
+ * @brief Start a RAMWR pixel transfer and return without waiting for it.
+ *
+ * The buffer must stay untouched until the next sh8601_wait_idle(), which
+ * LVGL guarantees by rendering into its other VDB in the meantime.
+ */
+static int sh8601_transmit_data_async(const struct device *dev, const void *tx_data,
+									  size_t tx_len)
+{
+	const struct sh8601_config *config = dev->config;
+	struct sh8601_data *data = dev->data;
+	int r;
+
+	if (k_sem_take(&data->tx_idle, K_MSEC(SH8601_TX_TIMEOUT_MS)) != 0)
+	{
+		return -ETIMEDOUT;
+	}
+
+	data->tx_buf[1].buf = (void *)tx_data;
+	data->tx_buf[1].len = tx_len;
+	data->tx_start = k_cycle_get_32();
+
+	r = spi_transceive_cb(config->spi.bus, &config->spi.config, &data->tx_bufs, NULL,
+						  sh8601_transmit_done, (void *)dev);
+	if (r < 0)
+	{
+		k_sem_give(&data->tx_idle);
+		return r;
+	}
+
+	return 0;
+}
+
+#endif /* CONFIG_SH8601_ASYNC_FLUSH */
+
 static int sh8601_send_cmd(const struct device *dev, uint8_t cmd)
 {
 	int r = 0;
@@ -369,6 +480,20 @@ static int sh8601_init(const struct device *dev)
 		}
 	}
 
+#ifdef CONFIG_SH8601_ASYNC_FLUSH
+	k_sem_init(&data->tx_idle, 1, 1);
+
+	// Pre command and RAMWR, as sent by sh8601_transmit_data()
+	data->ramwr_hdr[0] = 0x02;
+	data->ramwr_hdr[1] = 0x00;
+	data->ramwr_hdr[2] = SH8601_W_RAMWR;
+	data->ramwr_hdr[3] = 0x00;
+	data->tx_buf[0].buf = data->ramwr_hdr;
+	data->tx_buf[0].len = sizeof(data->ramwr_hdr);
+	data->tx_bufs.buffers = data->tx_buf;
+	data->tx_bufs.count = ARRAY_SIZE(data->tx_buf);
+#endif
+
 	sh8601_hw_reset(dev);
 
 	k_msleep(SH8601_RST_DELAY);
@@ -432,6 +557,7 @@ static int sh8601_init(const struct device *dev)
 
 int sh8601_reinit(const struct device *dev)
 {
+	sh8601_wait_idle(dev);
 	sh8601_init(dev);
 }
 
@@ -472,14 +598,38 @@ static int sh8601_write(const struct device *dev, const uint16_t x,
 						const struct display_buffer_descriptor *desc,
 						const void *buf)
 {
+	struct sh8601_data *data = dev->data;
+
 	//LOG_DBG("Writing %dx%d (w,h) @ %dx%d (x,y)", desc->width, desc->height,
 	//		x, y);
-	int r = sh8601_set_mem_area(dev, x, y, desc->width, desc->height);
+
+	// Time LVGL spends stalled on the previous area
+	uint32_t start = k_cycle_get_32();
+	int r = sh8601_wait_idle(dev);
+	uint32_t wait_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	k_spinlock_key_t key = k_spin_lock(&data->stats_lock);
+	data->stats.areas++;
+	data->stats.bytes += desc->buf_size;
+	data->stats.wait_us += wait_us;
+	k_spin_unlock(&data->stats_lock, key);
+
+	if (r < 0)
+	{
+		return r;
+	}
+
+	r = sh8601_set_mem_area(dev, x, y, desc->width, desc->height);
 	if (r < 0)
 	{
 		return r;
 	}
-	sh8601_transmit_data(dev, buf, desc->buf_size);
+
+#ifdef CONFIG_SH8601_ASYNC_FLUSH
+	r = sh8601_transmit_data_async(dev, buf, desc->buf_size);
+#else
+	r = sh8601_transmit_data(dev, buf, desc->buf_size);
+#endif
 	if (r < 0)
 	{
 		return r;
@@ -488,6 +638,16 @@ static int sh8601_write(const struct device *dev, const uint16_t x,
 	return 0;
 }
 
+void sh8601_get_flush_stats(const struct device *dev, struct sh8601_flush_stats *stats)
+{
+	struct sh8601_data *data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->stats_lock);
+
+	*stats = data->stats;
+
+	k_spin_unlock(&data->stats_lock, key);
+}
+
 static int sh8601_read(const struct device *dev, const uint16_t x,
 					   const uint16_t y,
 					   const struct display_buffer_descriptor *desc, void *buf)
@@ -122,9 +122,22 @@ enum
   SH8601_HighContrast
 };
 
+/* Pixel transfer counters since boot, see sh8601_get_flush_stats() */
+struct sh8601_flush_stats
+{
+  uint32_t areas;           ///< display_write() calls
+  uint32_t bytes;           ///< Pixel bytes sent
+  uint32_t errors;          ///< Failed pixel transfers
+  uint32_t transfer_us;     ///< Total time pixel data was on the wire
+  uint32_t transfer_max_us; ///< Longest single area
+  uint32_t wait_us;         ///< Total time display_write() waited for the previous area
+};
+
 int sh8601_transmit_cmd(const struct device *dev, uint8_t cmd,
                         const void *tx_data, size_t tx_len);
 
+void sh8601_get_flush_stats(const struct device *dev, struct sh8601_flush_stats *stats);
+
 int sh8601_reinit(const struct device *dev);
 
 #endif
@@ -15,6 +15,8 @@
 #include <zephyr/pm/device.h>
 #include <zephyr/pm/device_runtime.h>
 
+#include <string.h>
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(bosch_bmi323hpi, CONFIG_BMI323_HPI_LOG_LEVEL);
 
@@ -796,6 +798,150 @@ static int bosch_bmi323_pm_action(const struct device *dev, enum pm_device_actio
 }
 #endif /* CONFIG_PM_DEVICE */
 
+/* Largest FIFO burst per I2C transfer, in frames */
+#define BMI323_FIFO_BURST_FRAMES 16
+
+static int bmi323_set_fifo_odr(const struct device *dev, uint8_t acc_odr, uint8_t gyr_mode)
+{
+	struct bosch_bmi323_data *data = (struct bosch_bmi323_data *)dev->data;
+	uint16_t gyr_conf;
+	int ret;
+
+	data->chip_cfg.reg_acc_conf.bit.acc_odr = acc_odr;
+	ret = bmi323_write_reg_16(dev, BMI3_REG_ACC_CONF, data->chip_cfg.reg_acc_conf.all);
+	if (ret < 0)
+	{
+		return ret;
+	}
+
+	gyr_conf = BMI3_GYR_ODR_100HZ | (BMI3_GYR_RANGE_2000DPS << 4) | (gyr_mode << 12);
+	return bmi323_write_reg_16(dev, BMI3_REG_GYR_CONF, gyr_conf);
+}
+
+int bmi323_hpi_fifo_start(const struct device *dev)
+{
+	struct bosch_bmi323_data *data = (struct bosch_bmi323_data *)dev->data;
+	int ret;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	ret = bmi323_set_fifo_odr(dev, BMI3_ACC_ODR_100HZ, BMI3_GYR_MODE_NORMAL);
+	if (ret == 0)
+	{
+		ret = bmi323_write_reg_16(dev, BMI3_REG_FIFO_CONF, BMI3_FIFO_CONF_ACC_EN | BMI3_FIFO_CONF_GYR_EN);
+	}
+	if (ret == 0)
+	{
+		ret = bmi323_write_reg_16(dev, BMI3_REG_FIFO_CTRL, BMI3_FIFO_CTRL_FLUSH);
+	}
+
+	k_mutex_unlock(&data->lock);
+
+	if (ret < 0)
+	{
+		LOG_ERR("Failed to start FIFO %d", ret);
+	}
+	else
+	{
+		LOG_DBG("FIFO started");
+	}
+
+	return ret;
+}
+
+int bmi323_hpi_fifo_stop(const struct device *dev)
+{
+	struct bosch_bmi323_data *data = (struct bosch_bmi323_data *)dev->data;
+	int ret;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	ret = bmi323_write_reg_16(dev, BMI3_REG_FIFO_CONF, 0);
+	if (ret == 0)
+	{
+		ret = bmi323_write_reg_16(dev, BMI3_REG_FIFO_CTRL, BMI3_FIFO_CTRL_FLUSH);
+	}
+	if (ret == 0)
+	{
+		// Back to the step counter configuration
+		ret = bmi323_set_fifo_odr(dev, BMI3_ACC_ODR_50HZ, BMI3_GYR_MODE_DISABLE);
+	}
+
+	k_mutex_unlock(&data->lock);
+
+	if (ret < 0)
+	{
+		LOG_ERR("Failed to stop FIFO %d", ret);
+	}
+
+	return ret;
+}
+
+int bmi323_hpi_fifo_read(const struct device *dev, int16_t *acc_xyz, int16_t *gyr_xyz,
+						 uint16_t max_frames)
+{
+	struct bosch_bmi323_data *data = (struct bosch_bmi323_data *)dev->data;
+	const struct bmi323_config *config = (const struct bmi323_config *)dev->config;
+	// Two dummy bytes precede I2C read data on this part
+	uint8_t rd_buf[2 + BMI323_FIFO_BURST_FRAMES * BMI323_HPI_FIFO_FRAME_WORDS * 2];
+	uint8_t wr_buf[1] = {BMI3_REG_FIFO_DATA};
+	uint16_t fill_words;
+	uint16_t frames_out = 0;
+	int ret;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	ret = bmi323_read_reg_16(dev, BMI3_REG_FIFO_FILL_LEVEL, &fill_words);
+	if (ret < 0)
+	{
+		k_mutex_unlock(&data->lock);
+		return ret;
+	}
+
+	uint16_t frames_avail = (fill_words & BMI3_FIFO_FILL_LEVEL_MASK) / BMI323_HPI_FIFO_FRAME_WORDS;
+	frames_avail = MIN(frames_avail, max_frames);
+
+	while (frames_avail > 0)
+	{
+		uint16_t burst = MIN(frames_avail, BMI323_FIFO_BURST_FRAMES);
+		size_t len = 2 + burst * BMI323_HPI_FIFO_FRAME_WORDS * 2;
+
+		ret = i2c_write_read_dt(&config->bus, wr_buf, sizeof(wr_buf), rd_buf, len);
+		if (ret < 0)
+		{
+			LOG_ERR("FIFO read failed %d", ret);
+			break;
+		}
+
+		for (int f = 0; f < burst; f++)
+		{
+			const uint8_t *p = &rd_buf[2 + f * BMI323_HPI_FIFO_FRAME_WORDS * 2];
+			int16_t w[BMI323_HPI_FIFO_FRAME_WORDS];
+
+			for (int i = 0; i < BMI323_HPI_FIFO_FRAME_WORDS; i++)
+			{
+				w[i] = (int16_t)(p[2 * i] | (p[2 * i + 1] << 8));
+			}
+
+			// Skip frames the sensor padded before the first real sample
+			if (w[0] == BMI3_FIFO_ACC_DUMMY || w[3] == BMI3_FIFO_GYR_DUMMY)
+			{
+				continue;
+			}
+
+			memcpy(&acc_xyz[frames_out * 3], &w[0], 3 * sizeof(int16_t));
+			memcpy(&gyr_xyz[frames_out * 3], &w[3], 3 * sizeof(int16_t));
+			frames_out++;
+		}
+
+		frames_avail -= burst;
+	}
+
+	k_mutex_unlock(&data->lock);
+
+	return (ret < 0) ? ret : frames_out;
+}
+
 static const struct sensor_driver_api bosch_bmi323_api = {
 	.attr_set = bosch_bmi323_driver_api_attr_set,
 	.attr_get = bosch_bmi323_driver_api_attr_get,
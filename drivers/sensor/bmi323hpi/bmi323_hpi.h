@@ -40,6 +40,7 @@
 
 #include <zephyr/sys/util.h>
 #include <zephyr/types.h>
+#include <zephyr/device.h>
 
 /********************************************************* */
 /*!                 Register Addresses                    */
@@ -822,4 +823,37 @@ enum bmi323_hpi_attribute
     BMI323_HPI_ATTR_EN_ANY_MOTION = 0x03,
     BMI323_HPI_ATTR_EN_NO_MOTION = 0x04,
     BMI323_HPI_ATTR_RESET_STEP_COUNTER = 0x05,
-};
\ No newline at end of file
+};
+
+/* FIFO_CONF (0x36) / FIFO_CTRL (0x37) bits */
+#define BMI3_FIFO_CONF_STOP_ON_FULL BIT(0)
+#define BMI3_FIFO_CONF_TIME_EN BIT(8)
+#define BMI3_FIFO_CONF_ACC_EN BIT(9)
+#define BMI3_FIFO_CONF_GYR_EN BIT(10)
+#define BMI3_FIFO_CONF_TEMP_EN BIT(11)
+#define BMI3_FIFO_CTRL_FLUSH BIT(0)
+#define BMI3_FIFO_FILL_LEVEL_MASK (0x07FF)
+
+/* Words written for an axis with no new data since the previous frame */
+#define BMI3_FIFO_ACC_DUMMY ((int16_t)0x7F01)
+#define BMI3_FIFO_GYR_DUMMY ((int16_t)0x7F02)
+
+/* GYR_CONF (0x21) fields, same layout as ACC_CONF */
+#define BMI3_GYR_ODR_100HZ UINT8_C(0x08)
+#define BMI3_GYR_RANGE_2000DPS UINT8_C(0x04)
+#define BMI3_GYR_MODE_DISABLE UINT8_C(0x00)
+#define BMI3_GYR_MODE_NORMAL UINT8_C(0x04)
+
+/* One FIFO frame with accel and gyro enabled: acc x,y,z then gyr x,y,z */
+#define BMI323_HPI_FIFO_FRAME_WORDS 6
+
+/*
+ * Accel/gyro FIFO streaming at 100 Hz. Start raises the accel ODR from the
+ * 50 Hz step counter setting and enables the gyro; stop restores both.
+ * Read returns the number of complete frames copied (each 3 x int16 per
+ * sensor), or a negative error code.
+ */
+int bmi323_hpi_fifo_start(const struct device *dev);
+int bmi323_hpi_fifo_stop(const struct device *dev);
+int bmi323_hpi_fifo_read(const struct device *dev, int16_t *acc_xyz, int16_t *gyr_xyz,
+                         uint16_t max_frames);
\ No newline at end of file
@@ -194,9 +194,8 @@ static int _max30001_read_bioz_fifo(const struct device *dev, int num_bytes)
      *   Bits 23-4: 20-bit signed ADC data
      *   Bits 3-0:  BTAG (tag bits)
      *
-     * Extract 20-bit ADC and convert to conductance (µS) using datasheet formula:
-     *   Z (Ω) = ADC × VREF / (2^19 × CGMAG × GAIN)
-     *   Conductance (µS) = 1/Z × 10^6
+     * Extract the sign-extended 20-bit ADC code. Conductance is derived
+     * from it in the application (see max30001_bioz.h).
      */
 
     for (int i = 0; i < num_bytes; i += 3)
@@ -555,6 +554,30 @@ static int max30001_attr_set(const struct device *dev,
     return 0;
 }
 
+/*
+ * Size EFIT/BFIT so each FIFO raises its interrupt about every
+ * CONFIG_SENSOR_MAX30001_FIFO_LATENCY_MS at the configured rate (FMSTR = 0).
+ */
+static uint32_t max30001_fifo_thresholds(const struct device *dev)
+{
+    static const uint16_t ecg_sps[] = {512, 256, 128, 128};
+    static const uint16_t bioz_sps[] = {64, 32};
+    struct max30001_data *data = dev->data;
+
+    uint32_t ecg_n = ecg_sps[data->chip_cfg.reg_cnfg_ecg.bit.rate & 0x3] *
+                     CONFIG_SENSOR_MAX30001_FIFO_LATENCY_MS / 1000;
+    uint32_t bioz_n = bioz_sps[data->chip_cfg.reg_cnfg_bioz.bit.rate & 0x1] *
+                      CONFIG_SENSOR_MAX30001_FIFO_LATENCY_MS / 1000;
+
+    data->ecg_fifo_thresh = CLAMP(ecg_n, 1, MAX30001_EFIT_MAX_SAMPLES);
+    data->bioz_fifo_thresh = CLAMP(bioz_n, 1, MAX30001_BFIT_MAX_SAMPLES);
+
+    LOG_DBG("FIFO thresholds: ECG %d, BioZ %d samples", data->ecg_fifo_thresh, data->bioz_fifo_thresh);
+
+    return ((uint32_t)(data->ecg_fifo_thresh - 1) << MAX30001_INT_SHIFT_EFIT) |
+           ((uint32_t)(data->bioz_fifo_thresh - 1) << MAX30001_INT_SHIFT_BFIT);
+}
+
 static int max30001_chip_init(const struct device *dev)
 {
     const struct max30001_config *config = dev->config;
@@ -743,19 +766,19 @@ static int max30001_chip_init(const struct device *dev)
     _max30001RegWrite(dev, CNFG_CAL, 0x702000); // Calibration sources disabled
     k_sleep(K_MSEC(100));
 
-    //_max30001RegWrite(dev, MNGR_INT, 0x190000); // EFIT=4, BFIT=2
-     _max30001RegWrite(dev, MNGR_INT, 0x7B0000); // EFIT=16, BFIT=8
-    //_max30001RegWrite(dev, MNGR_INT, 0xFF0000); // EFIT=31, BFIT=15 (MAX)
-    //_max30001RegWrite(dev, MNGR_INT, 0x3B0000); // EFIT=8, BFIT=4
-    //_max30001RegWrite(dev, MNGR_INT, 0x080000); // EFIT=2, BFIT=2
-    //_max30001RegWrite(dev, MNGR_INT, 0x000000); // EFIT=1, BFIT=1
+    // 125 ms at 128/32 SPS gives 0x7B0000 (16 ECG, 4 BioZ samples per interrupt)
+    _max30001RegWrite(dev, MNGR_INT, max30001_fifo_thresholds(dev));
     k_sleep(K_MSEC(100));
 
     _max30001RegWrite(dev, MNGR_DYN, 0xBFFFFF); // Enable automatic fast recovery
     //_max30001RegWrite(dev, MNGR_DYN, 0x7FFFFF); //  Enable manual fast recovery
     k_sleep(K_MSEC(100));
 
-    //_max30001RegWrite(dev, EN_INT, 0x800003); // Disable all interrupts
+    if (config->intb_gpio.port != NULL)
+    {
+        // Only the FIFO thresholds drive INTB; lead-off and R-R are read with each FIFO event
+        _max30001RegWrite(dev, EN_INT, MAX30001_EN_INT_EINT | MAX30001_EN_INT_BINT | MAX30001_EN_INT_INTB_CMOS);
+    }
 
     if (config->rtor_enabled)
     {
@@ -772,6 +795,14 @@ static int max30001_chip_init(const struct device *dev)
     // For POWER DEBUG ONLY
     //_max30001RegWrite(dev, CNFG_GEN, 0x400000);
 
+#ifdef CONFIG_SENSOR_ASYNC_API
+    err = max30001_async_init(dev);
+    if (err < 0)
+    {
+        return err;
+    }
+#endif
+
     LOG_DBG("\"%s\" OK", dev->name);
     return 0;
 }
@@ -820,6 +851,7 @@ static int max30001_pm_action(const struct device *dev, enum pm_device_action ac
         {                                                                 \
             .spi = SPI_DT_SPEC_INST_GET(                                  \
                 inst, MAX30001_SPI_OPERATION, 0),                         \
+            .intb_gpio = GPIO_DT_SPEC_INST_GET_OR(inst, intb_gpios, {0}), \
             .ecg_gain = DT_INST_PROP(inst, ecg_gain),                     \
             .bioz_gain = DT_INST_PROP(inst, bioz_gain),                   \
             .bioz_cgmag = DT_INST_PROP(inst, bioz_cgmag),                 \
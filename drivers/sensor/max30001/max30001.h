@@ -11,6 +11,8 @@
 #include <zephyr/drivers/spi.h>
 #include <zephyr/drivers/gpio.h>
 
+#include "max30001_bioz.h"
+
 #define MAX30001_STATUS_MASK_EINT 0x800000
 #define MAX30001_STATUS_MASK_EOVF 0x400000
 
@@ -36,6 +38,15 @@
 #define MAX30001_INT_SHIFT_BFIT 16
 #define MAX30001_INT_SHIFT_EFIT 19
 
+// FIFO interrupt thresholds (samples). ECG is capped at what one encoded read hands the app.
+#define MAX30001_EFIT_MAX_SAMPLES 16
+#define MAX30001_BFIT_MAX_SAMPLES 8
+
+// EN_INT: FIFO threshold interrupts on INTB, CMOS driver (no pull-up needed)
+#define MAX30001_EN_INT_EINT 0x800000
+#define MAX30001_EN_INT_BINT 0x080000
+#define MAX30001_EN_INT_INTB_CMOS 0x000001
+
 #define WREG 0x00
 #define RREG 0x01
 
@@ -73,102 +84,6 @@
 #define CLK_PIN 6
 #define RTOR_INTR_MASK 0x04
 
-/* ============================================================================
- * BioZ ADC to Impedance/Conductance Conversion
- *
- * Per MAX30001 datasheet, the BioZ ADC output relates to impedance as:
- *   Z (Ω) = ADC × VREF / (2^19 × CGMAG × GAIN)
- *
- * Where:
- *   - ADC is the 20-bit signed ADC code
- *   - VREF = 1.0V (internal reference)
- *   - CGMAG is the excitation current magnitude (in Amperes)
- *   - GAIN is the BioZ channel voltage gain (V/V)
- *
- * We output conductance in microsiemens (µS) = 1/Z × 10^6
- * ============================================================================ */
-
-#define BIOZ_VREF           1.0f        /* MAX30001 internal reference voltage (V) */
-#define BIOZ_ADC_FULLSCALE  524288.0f   /* 2^19 for 20-bit signed ADC */
-#define BIOZ_MIN_IMPEDANCE  0.1f        /* Minimum valid impedance (Ω) to avoid div-by-zero */
-
-/* BioZ Gain lookup table: register value -> actual gain (V/V) */
-static const float bioz_gain_table[] = {
-    10.0f,   /* 0: 10 V/V */
-    20.0f,   /* 1: 20 V/V */
-    40.0f,   /* 2: 40 V/V */
-    80.0f    /* 3: 80 V/V */
-};
-
-/* BioZ Current Magnitude lookup table: register value -> actual current (A) */
-static const float bioz_cgmag_table[] = {
-    0.0f,       /* 0: Off */
-    8.0e-6f,    /* 1: 8 µA */
-    16.0e-6f,   /* 2: 16 µA */
-    32.0e-6f,   /* 3: 32 µA */
-    48.0e-6f,   /* 4: 48 µA */
-    64.0e-6f,   /* 5: 64 µA */
-    80.0e-6f,   /* 6: 80 µA */
-    96.0e-6f    /* 7: 96 µA */
-};
-
-static const float bioz_cgmag_lc2x_table[] = {
-    0.0f,          /* 0: 0 nA */
-    110.0e-9f,     /* 1: 110 nA */
-    220.0e-9f,     /* 2: 220 nA */
-    440.0e-9f,     /* 3: 440 nA */
-    660.0e-9f,     /* 4: 660 nA */
-    880.0e-9f,     /* 5: 880 nA */
-    1100.0e-9f     /* 6: 1100 nA */
-    /* 0111 is invalid/reserved */
-};
-
-
-/**
- * @brief Convert raw 20-bit BioZ ADC value to conductance in microsiemens (µS)
- *
- * @param raw_adc Raw 20-bit signed ADC value from BioZ FIFO
- * @param gain_reg BioZ gain register value (0-3)
- * @param cgmag_reg BioZ current magnitude register value (0-7)
- * @return Conductance in microsiemens (µS), or 0.0f if invalid
- */
-static inline float max30001_bioz_raw_to_uS(int32_t raw_adc, int gain_reg, int cgmag_reg)
-{
-    /* Validate register values */
-    if (gain_reg < 0 || gain_reg > 3 || cgmag_reg < 0 || cgmag_reg > 7) {
-        return 0.0f;
-    }
-
-    float gain = bioz_gain_table[gain_reg];
-    float cgmag = bioz_cgmag_table[cgmag_reg];
-
-	//float cgmag = bioz_cgmag_lc2x_table[cgmag_reg];
-    /* Avoid division by zero if current is off */
-    if (cgmag == 0.0f) {
-        return 0.0f;
-    }
-
-    /* Calculate electrode voltage from ADC counts:
-     * V_electrode = (raw_adc / 2^19) × (VREF / GAIN) */
-    float v_electrode = ((float)raw_adc / BIOZ_ADC_FULLSCALE) * (BIOZ_VREF / gain);
-
-    /* Calculate impedance using Ohm's law: Z = V / I */
-    float impedance = v_electrode / cgmag;
-
-    /* Take absolute value (impedance is magnitude) */
-    if (impedance < 0.0f) {
-        impedance = -impedance;
-    }
-
-    /* Guard against divide-by-zero for very low impedance */
-    if (impedance < BIOZ_MIN_IMPEDANCE) {
-        return 0.0f;
-    }
-
-    /* Convert to conductance in microsiemens: G (µS) = 1/Z × 10^6 */
-    return (1.0f / impedance) * 1e6f;
-}
-
 enum max30001_channel
 {
 
@@ -487,6 +402,19 @@ struct max30001_data
 	uint8_t bioz_lead_off;
 
 	uint8_t chip_op_mode;
+
+	// Samples per EINT/BINT (EFIT + 1, BFIT + 1), cached so reads skip MNGR_INT
+	uint8_t ecg_fifo_thresh;
+	uint8_t bioz_fifo_thresh;
+
+#ifdef CONFIG_SENSOR_ASYNC_API
+	const struct device *dev;
+	struct gpio_callback intb_cb;
+	struct k_work_delayable fifo_work;
+	atomic_ptr_t pending_sqe; // Stream read parked until the next FIFO event
+	atomic_t intb_fired;
+	uint32_t fifo_timeout_ms;
+#endif
 };
 
 struct max30001_encoded_data
@@ -511,6 +439,7 @@ struct max30001_encoded_data
 };
 
 int max30001_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe);
+int max30001_async_init(const struct device *dev);
 int max30001_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder);
 
 void max30001_synch(const struct device *dev);
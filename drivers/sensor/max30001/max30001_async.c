@@ -1,4 +1,5 @@
 #include <zephyr/drivers/sensor.h>
+#include <zephyr/drivers/gpio.h>
 
 #include <zephyr/logging/log.h>
 
@@ -34,14 +35,14 @@ static int max30001_async_sample_fetch(const struct device *dev,
     struct max30001_data *data = dev->data;
     const struct max30001_config *config = dev->config;
 
-    uint32_t max30001_status, max30001_mngr_int = 0;
+    uint32_t max30001_status;
     uint32_t e_fifo_num_bytes, b_fifo_num_bytes;
 
     uint32_t e_fifo_num_samples = 0;
     uint32_t b_fifo_num_samples = 0;
 
-    uint8_t buf_ecg[512];
-    uint8_t buf_bioz[512];
+    uint8_t buf_ecg[MAX30001_EFIT_MAX_SAMPLES * 3];
+    uint8_t buf_bioz[MAX30001_BFIT_MAX_SAMPLES * 3];
 
     uint8_t cmd_tx_ecg_fifo_burst = ((ECG_FIFO_BURST << 1) | RREG);
     const struct spi_buf tx_buf_ecg[1] = {{.buf = &cmd_tx_ecg_fifo_burst, .len = 1}};
@@ -53,6 +54,7 @@ static int max30001_async_sample_fetch(const struct device *dev,
 
     uint32_t max30001_rtor = 0;
 
+    *rrint = 0;
     max30001_status = max30001_read_status(dev);
 
     if ((max30001_status & MAX30001_STATUS_MASK_DCLOFF) == MAX30001_STATUS_MASK_DCLOFF)
@@ -88,16 +90,11 @@ static int max30001_async_sample_fetch(const struct device *dev,
     if ((max30001_status & MAX30001_STATUS_MASK_EINT) == MAX30001_STATUS_MASK_EINT) // EINT bit is set, FIFO is full
     // while ((max30001_status & MAX30001_STATUS_MASK_EINT) != MAX30001_STATUS_MASK_EINT) // EINT bit is set, FIFO is full
     {
-        max30001_mngr_int = max30001_read_reg(dev, MNGR_INT);
-        e_fifo_num_samples = (((max30001_mngr_int & MAX30001_INT_MASK_EFIT) >> MAX30001_INT_SHIFT_EFIT) + 1); // No of samples = EFIT + 1
-        e_fifo_num_bytes = ((e_fifo_num_samples * 3));                                                        // 24 bit register + 1 dummy byte
+        e_fifo_num_samples = data->ecg_fifo_thresh; // No of samples = EFIT + 1, set at init
+        e_fifo_num_bytes = ((e_fifo_num_samples * 3)); // 24 bit register + 1 dummy byte
 
         // printk("ES: %d ", e_fifo_num_samples);
 
-        if (e_fifo_num_samples > 16)
-        {
-            e_fifo_num_samples = 16;
-        }
         *num_samples_ecg = e_fifo_num_samples;
 
         //_max30001_read_ecg_fifo(dev, e_fifo_num_bytes);
@@ -107,18 +104,19 @@ static int max30001_async_sample_fetch(const struct device *dev,
 
         spi_transceive_dt(&config->spi, &tx_ecg, &rx_ecg);
 
-        // Also read BioZ FIFO when ECG is active
-        if (max30001_mngr_int == 0) {
-            max30001_mngr_int = max30001_read_reg(dev, MNGR_INT);
-        }
-        b_fifo_num_samples = (((max30001_mngr_int & MAX30001_INT_MASK_BFIT) >> MAX30001_INT_SHIFT_BFIT) + 1);
-        b_fifo_num_bytes = (b_fifo_num_samples * 3);
-        *num_samples_bioz = b_fifo_num_samples;
+        // Also read the BioZ FIFO if it reached its threshold at the same time;
+        // otherwise BINT keeps INTB asserted and the next read picks it up
+        if ((max30001_status & MAX30001_STATUS_MASK_BINT) == MAX30001_STATUS_MASK_BINT)
+        {
+            b_fifo_num_samples = data->bioz_fifo_thresh;
+            b_fifo_num_bytes = (b_fifo_num_samples * 3);
 
-        struct spi_buf rx_bioz_buf[2] = {{.buf = NULL, .len = 1}, {.buf = &buf_bioz, .len = b_fifo_num_bytes}}; // 24 bit register
-        const struct spi_buf_set rx_bioz = {.buffers = rx_bioz_buf, .count = 2};
+            struct spi_buf rx_bioz_buf[2] = {{.buf = NULL, .len = 1}, {.buf = &buf_bioz, .len = b_fifo_num_bytes}}; // 24 bit register
+            const struct spi_buf_set rx_bioz = {.buffers = rx_bioz_buf, .count = 2};
 
-        spi_transceive_dt(&config->spi, &tx_bioz, &rx_bioz);
+            spi_transceive_dt(&config->spi, &tx_bioz, &rx_bioz);
+        }
+        *num_samples_bioz = b_fifo_num_samples;
 
         // Read all the samples from the FIFO
         for (int i = 0; i < e_fifo_num_samples; i++)
@@ -156,8 +154,8 @@ static int max30001_async_sample_fetch(const struct device *dev,
          *   Bits 23-4: 20-bit signed ADC data
          *   Bits 3-0:  BTAG (tag bits)
          *
-         * Extract 20-bit ADC and convert to conductance (µS) using datasheet formula.
-         * Store as fixed-point (×100) for integer transmission.
+         * Extract the sign-extended 20-bit ADC code. Conductance is derived
+         * from it in the application (see max30001_bioz.h).
          */
         for (int i = 0; i < b_fifo_num_samples; i++)
         {
@@ -217,20 +215,13 @@ static int max30001_async_sample_fetch(const struct device *dev,
     // Handle BioZ-only FIFO (when BINT is set but EINT is not)
     else if ((max30001_status & MAX30001_STATUS_MASK_BINT) == MAX30001_STATUS_MASK_BINT)
     {
-        max30001_mngr_int = max30001_read_reg(dev, MNGR_INT);
-        
         // No ECG samples in this case
         *num_samples_ecg = 0;
         
         // Read BioZ FIFO
-        b_fifo_num_samples = (((max30001_mngr_int & MAX30001_INT_MASK_BFIT) >> MAX30001_INT_SHIFT_BFIT) + 1);
+        b_fifo_num_samples = data->bioz_fifo_thresh;
         b_fifo_num_bytes = (b_fifo_num_samples * 3);
         *num_samples_bioz = b_fifo_num_samples;
-        
-        if (b_fifo_num_samples > 32) {
-            b_fifo_num_samples = 32;
-            *num_samples_bioz = 32;
-        }
 
         struct spi_buf rx_bioz_buf[2] = {{.buf = NULL, .len = 1}, {.buf = &buf_bioz, .len = b_fifo_num_bytes}};
         const struct spi_buf_set rx_bioz = {.buffers = rx_bioz_buf, .count = 2};
@@ -242,8 +233,8 @@ static int max30001_async_sample_fetch(const struct device *dev,
          *   Bits 23-4: 20-bit signed ADC data
          *   Bits 3-0:  BTAG (tag bits)
          *
-         * Extract 20-bit ADC and convert to conductance (µS) using datasheet formula.
-         * Store as fixed-point (×1000000) for integer transmission.
+         * Extract the sign-extended 20-bit ADC code. Conductance is derived
+         * from it in the application (see max30001_bioz.h).
          */
         for (int i = 0; i < b_fifo_num_samples; i++)
         {
@@ -310,6 +301,7 @@ static int max30001_async_sample_fetch(const struct device *dev,
         {
             data->lastRRI = (uint16_t)(max30001_rtor >> 10) * 8;
             data->lastHR = (uint16_t)(60 * 1000 / data->lastRRI);
+            *rrint = 1;
         }
     }
 
@@ -320,7 +312,7 @@ static int max30001_async_sample_fetch(const struct device *dev,
     return 0;
 }
 
-int max30001_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+static int max30001_complete_read(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
 {
     struct max30001_data *data = dev->data;
 
@@ -381,4 +373,132 @@ int max30001_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
     rtio_iodev_sqe_ok(iodev_sqe, 0);
 
     return 0;
-}
\ No newline at end of file
+}
+
+/*
+ * Stream reads complete on FIFO events rather than at submit time. The read is
+ * parked in pending_sqe and INTB (EINT/BINT) is armed as a level interrupt; the
+ * ISR masks it and kicks fifo_work, which drains the FIFOs on the driver's own
+ * work queue and completes the read. fifo_work is also scheduled as a timeout
+ * so a read never hangs when the channels are off, and on boards without
+ * intb-gpios that timeout paces the reads at the FIFO interval instead.
+ */
+K_THREAD_STACK_DEFINE(max30001_workq_stack, CONFIG_SENSOR_MAX30001_WORKQ_STACK_SIZE);
+static struct k_work_q max30001_workq;
+static bool max30001_workq_started;
+
+static void max30001_intb_callback(const struct device *port, struct gpio_callback *cb, uint32_t pins)
+{
+    struct max30001_data *data = CONTAINER_OF(cb, struct max30001_data, intb_cb);
+    const struct max30001_config *config = data->dev->config;
+
+    ARG_UNUSED(port);
+    ARG_UNUSED(pins);
+
+    // Level triggered: keep it masked until the FIFOs have been read
+    gpio_pin_interrupt_configure_dt(&config->intb_gpio, GPIO_INT_DISABLE);
+    atomic_set(&data->intb_fired, 1);
+    k_work_reschedule_for_queue(&max30001_workq, &data->fifo_work, K_NO_WAIT);
+}
+
+static void max30001_fifo_work_handler(struct k_work *work)
+{
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct max30001_data *data = CONTAINER_OF(dwork, struct max30001_data, fifo_work);
+    const struct max30001_config *config = data->dev->config;
+    struct rtio_iodev_sqe *iodev_sqe = atomic_ptr_clear(&data->pending_sqe);
+
+    if (iodev_sqe == NULL)
+    {
+        return;
+    }
+
+    if (config->intb_gpio.port != NULL)
+    {
+        gpio_pin_interrupt_configure_dt(&config->intb_gpio, GPIO_INT_DISABLE);
+        if (!atomic_clear(&data->intb_fired))
+        {
+            LOG_DBG("FIFO wait timed out");
+        }
+    }
+
+    max30001_complete_read(data->dev, iodev_sqe);
+}
+
+int max30001_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+    struct max30001_data *data = dev->data;
+    const struct max30001_config *config = dev->config;
+
+    if (data->chip_op_mode == MAX30001_OP_MODE_LON_DETECT)
+    {
+        return max30001_complete_read(dev, iodev_sqe);
+    }
+
+    if (!atomic_ptr_cas(&data->pending_sqe, NULL, iodev_sqe))
+    {
+        rtio_iodev_sqe_err(iodev_sqe, -EBUSY);
+        return -EBUSY;
+    }
+
+    // Timeout first; an interrupt that is already pending reschedules it to now
+    k_work_schedule_for_queue(&max30001_workq, &data->fifo_work, K_MSEC(data->fifo_timeout_ms));
+
+    if (config->intb_gpio.port != NULL)
+    {
+        gpio_pin_interrupt_configure_dt(&config->intb_gpio, GPIO_INT_LEVEL_ACTIVE);
+    }
+
+    return 0;
+}
+
+int max30001_async_init(const struct device *dev)
+{
+    struct max30001_data *data = dev->data;
+    const struct max30001_config *config = dev->config;
+    int ret;
+
+    data->dev = dev;
+    atomic_ptr_set(&data->pending_sqe, NULL);
+    k_work_init_delayable(&data->fifo_work, max30001_fifo_work_handler);
+
+    if (!max30001_workq_started)
+    {
+        k_work_queue_start(&max30001_workq, max30001_workq_stack,
+                           K_THREAD_STACK_SIZEOF(max30001_workq_stack),
+                           CONFIG_SENSOR_MAX30001_WORKQ_PRIORITY, NULL);
+        k_thread_name_set(&max30001_workq.thread, "max30001_wq");
+        max30001_workq_started = true;
+    }
+
+    if (config->intb_gpio.port == NULL)
+    {
+        LOG_INF("No INTB, polling FIFOs every %d ms", CONFIG_SENSOR_MAX30001_FIFO_LATENCY_MS);
+        data->fifo_timeout_ms = CONFIG_SENSOR_MAX30001_FIFO_LATENCY_MS;
+        return 0;
+    }
+
+    if (!gpio_is_ready_dt(&config->intb_gpio))
+    {
+        LOG_ERR("INTB GPIO not ready");
+        return -ENODEV;
+    }
+
+    ret = gpio_pin_configure_dt(&config->intb_gpio, GPIO_INPUT);
+    if (ret < 0)
+    {
+        return ret;
+    }
+
+    gpio_init_callback(&data->intb_cb, max30001_intb_callback, BIT(config->intb_gpio.pin));
+    ret = gpio_add_callback_dt(&config->intb_gpio, &data->intb_cb);
+    if (ret < 0)
+    {
+        return ret;
+    }
+
+    // Watchdog only: a few FIFO periods in case an interrupt is lost
+    data->fifo_timeout_ms = 4 * CONFIG_SENSOR_MAX30001_FIFO_LATENCY_MS;
+
+    return 0;
+}
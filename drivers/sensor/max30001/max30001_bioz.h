@@ -0,0 +1,93 @@
+// ProtoCentral Electronics (info@protocentral.com)
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * MAX30001 BioZ units, shared by the driver and the application.
+ *
+ * BioZ samples leave the driver as raw 20-bit signed ADC codes, sign-extended
+ * to int32 with no further scaling; every layer above passes them on
+ * unchanged (BLE, recordings, plots). Conductance is derived from the codes
+ * in one place, per the datasheet:
+ *
+ *   Z (Ω)  = |ADC| × VREF / (2^19 × GAIN × CGMAG)
+ *   G (µS) = 10^6 / Z = K / |ADC|,   K = 10^6 × 2^19 × GAIN × CGMAG / VREF
+ *
+ * K depends only on the gain and current registers, so a conversion is one
+ * division per sample.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define BIOZ_VREF           1.0f        /* MAX30001 internal reference voltage (V) */
+#define BIOZ_ADC_FULLSCALE  524288.0f   /* 2^19 for 20-bit signed ADC */
+#define BIOZ_MIN_IMPEDANCE  0.1f        /* Minimum valid impedance (Ω) to avoid div-by-zero */
+
+/* BioZ Gain lookup table: register value -> actual gain (V/V) */
+static const float bioz_gain_table[] = {
+    10.0f,   /* 0: 10 V/V */
+    20.0f,   /* 1: 20 V/V */
+    40.0f,   /* 2: 40 V/V */
+    80.0f    /* 3: 80 V/V */
+};
+
+/* BioZ Current Magnitude lookup table: register value -> actual current (A) */
+static const float bioz_cgmag_table[] = {
+    0.0f,       /* 0: Off */
+    8.0e-6f,    /* 1: 8 µA */
+    16.0e-6f,   /* 2: 16 µA */
+    32.0e-6f,   /* 3: 32 µA */
+    48.0e-6f,   /* 4: 48 µA */
+    64.0e-6f,   /* 5: 64 µA */
+    80.0e-6f,   /* 6: 80 µA */
+    96.0e-6f    /* 7: 96 µA */
+};
+
+static const float bioz_cgmag_lc2x_table[] = {
+    0.0f,          /* 0: 0 nA */
+    110.0e-9f,     /* 1: 110 nA */
+    220.0e-9f,     /* 2: 220 nA */
+    440.0e-9f,     /* 3: 440 nA */
+    660.0e-9f,     /* 4: 660 nA */
+    880.0e-9f,     /* 5: 880 nA */
+    1100.0e-9f     /* 6: 1100 nA */
+    /* 0111 is invalid/reserved */
+};
+
+/**
+ * @brief Conductance numerator K for a gain/current setting
+ *
+ * @param gain_reg BioZ gain register value (0-3)
+ * @param cgmag_reg BioZ current magnitude register value (0-7)
+ * @return K in µS × ADC codes, or 0.0f if invalid or the current is off
+ */
+static inline float max30001_bioz_uS_numerator(int gain_reg, int cgmag_reg)
+{
+    if (gain_reg < 0 || gain_reg > 3 || cgmag_reg < 0 || cgmag_reg > 7) {
+        return 0.0f;
+    }
+
+    return 1e6f * BIOZ_ADC_FULLSCALE * bioz_gain_table[gain_reg] * bioz_cgmag_table[cgmag_reg] / BIOZ_VREF;
+}
+
+/**
+ * @brief Convert one raw 20-bit BioZ ADC value to conductance in microsiemens (µS)
+ *
+ * @param raw_adc Raw 20-bit signed ADC value from BioZ FIFO
+ * @param gain_reg BioZ gain register value (0-3)
+ * @param cgmag_reg BioZ current magnitude register value (0-7)
+ * @return Conductance in microsiemens (µS), or 0.0f if invalid
+ */
+static inline float max30001_bioz_raw_to_uS(int32_t raw_adc, int gain_reg, int cgmag_reg)
+{
+    float k = max30001_bioz_uS_numerator(gain_reg, cgmag_reg);
+    float mag = (raw_adc < 0) ? -(float)raw_adc : (float)raw_adc;
+
+    /* Impedance below BIOZ_MIN_IMPEDANCE (or no current) reads as no contact */
+    if (mag * 1e6f < BIOZ_MIN_IMPEDANCE * k || k == 0.0f) {
+        return 0.0f;
+    }
+
+    return k / mag;
+}
@@ -0,0 +1,58 @@
+/*
+ * HealthyPi Move - Host stand-in for the CMSIS-DSP calls used by gsr_algos.c
+ *
+ * Plain C with the CMSIS semantics (saturating |x| and subtraction, 2^-31
+ * scaling, truncating mean).
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef int32_t q31_t;
+typedef float float32_t;
+
+static inline void arm_abs_q31(const q31_t *src, q31_t *dst, uint32_t block_size)
+{
+    for (uint32_t i = 0; i < block_size; i++) {
+        q31_t x = src[i];
+        dst[i] = (x > 0) ? x : ((x == INT32_MIN) ? INT32_MAX : -x);
+    }
+}
+
+static inline void arm_q31_to_float(const q31_t *src, float32_t *dst, uint32_t block_size)
+{
+    for (uint32_t i = 0; i < block_size; i++) {
+        dst[i] = (float32_t)src[i] / 2147483648.0f;
+    }
+}
+
+
+static inline void arm_scale_f32(const float32_t *src, float32_t scale, float32_t *dst, uint32_t block_size)
+{
+    for (uint32_t i = 0; i < block_size; i++) {
+        dst[i] = src[i] * scale;
+    }
+}
+
+static inline void arm_sub_q31(const q31_t *a, const q31_t *b, q31_t *dst, uint32_t block_size)
+{
+    for (uint32_t i = 0; i < block_size; i++) {
+        int64_t d = (int64_t)a[i] - b[i];
+        dst[i] = (d > INT32_MAX) ? INT32_MAX : ((d < INT32_MIN) ? INT32_MIN : (q31_t)d);
+    }
+}
+
+static inline void arm_mean_q31(const q31_t *src, uint32_t block_size, q31_t *result)
+{
+    int64_t sum = 0;
+
+    for (uint32_t i = 0; i < block_size; i++) {
+        sum += src[i];
+    }
+    *result = (q31_t)(sum / block_size);
+}
\ No newline at end of file
@@ -0,0 +1,246 @@
+/*
+ * HealthyPi Move - GSR filter bench
+ *
+ * Compares the previous O(n * window) float GSR smoothing / baseline removal
+ * with the Q11.20 running-sum filters in app/src/gsr_algos.c, and the batch
+ * stress index with the incremental one, on recorded GSR traces.
+ *
+ *   cc -O2 -I tools/gsr_filter_bench -I app/src -I drivers/sensor/max30001 \
+ *      tools/gsr_filter_bench/gsr_filter_bench.c \
+ *      app/src/gsr_algos.c -lm -o gsr_filter_bench
+ *   tools/hpir_decode.py gsr.bin > gsr.csv
+ *   ./gsr_filter_bench gsr.csv [more.csv ...]
+ *
+ * Traces are raw BioZ samples, one per line or as the last CSV column
+ * (hpir_decode.py output); non-numeric lines are skipped and each trace is
+ * cut into GSR_RECORD_BUFFER_SAMPLES sessions. Without arguments a synthetic
+ * 30 s trace is used. Timings are in TSC cycles on x86, nanoseconds elsewhere.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include "hpi_common_types.h"
+#include "gsr_algos.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycles"
+static uint64_t bench_now(void) { return __rdtsc(); }
+#else
+#define BENCH_UNIT "ns"
+static uint64_t bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+#endif
+
+#define BENCH_REPEAT    50
+#define TRACE_MAX       (GSR_RECORD_BUFFER_SAMPLES * 64)
+
+/* Previous implementations, kept verbatim apart from the scratch buffer */
+static float ref_temp[GSR_STREAM_MAX_SAMPLES];
+
+static void ref_smooth_gsr(float *data, int length, int window)
+{
+    for (int i = 0; i < length; i++) {
+        float sum = 0;
+        int count = 0;
+        for (int j = i - window/2; j <= i + window/2; j++) {
+            if (j >= 0 && j < length) {
+                sum += data[j];
+                count++;
+            }
+        }
+        ref_temp[i] = sum / count;
+    }
+    for (int i = 0; i < length; i++)
+        data[i] = ref_temp[i];
+}
+
+static void ref_remove_baseline(float *data, int length, int window)
+{
+    for (int i = 0; i < length; i++) {
+        float sum = 0;
+        int count = 0;
+        for (int j = i - window/2; j <= i + window/2; j++) {
+            if (j >= 0 && j < length) {
+                sum += data[j];
+                count++;
+            }
+        }
+        ref_temp[i] = sum / count;
+    }
+    for (int i = 0; i < length; i++)
+        data[i] -= ref_temp[i];
+}
+
+static int32_t trace[TRACE_MAX];
+
+static int load_trace(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[256];
+    int n = 0;
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    while (n < TRACE_MAX && fgets(line, sizeof(line), f)) {
+        char *field = strrchr(line, ',');
+        char *end;
+        long v = strtol(field ? field + 1 : line, &end, 10);
+        if (end != (field ? field + 1 : line)) {
+            trace[n++] = (int32_t)v;
+        }
+    }
+    fclose(f);
+    return n;
+}
+
+/* 30 s at 32 Hz: ~5 uS tonic drift with three SCRs and sensor noise */
+static int synth_trace(void)
+{
+    uint32_t lcg = 1;
+    int n = GSR_RECORD_BUFFER_SAMPLES;
+
+    for (int i = 0; i < n; i++) {
+        float t = i / 32.0f;
+        float g = 5.0f + 0.02f * t;
+        const float onsets[] = {6.0f, 14.5f, 23.0f};
+        for (int k = 0; k < 3; k++) {
+            float d = t - onsets[k];
+            if (d > 0.0f) {
+                g += 0.3f * (1.0f - expf(-d / 0.75f)) * expf(-d / 4.0f);
+            }
+        }
+        lcg = lcg * 1664525u + 1013904223u;
+        g += 0.004f * (((lcg >> 8) / 16777216.0f) - 0.5f);
+        /* Invert convert_raw_to_uS: raw = Z * 2^19 * gain * I / Vref */
+        trace[i] = (int32_t)((1e6f / g) * 524288.0f * 20.0f * 16e-6f);
+    }
+    return n;
+}
+
+/* Largest difference between a float µS signal and a Q11.20 one */
+static float max_abs_diff(const float *a, const int32_t *b, int n)
+{
+    float m = 0.0f;
+    for (int i = 0; i < n; i++) {
+        m = fmaxf(m, fabsf(a[i] - GSR_Q_TO_US(b[i])));
+    }
+    return m;
+}
+
+static void run_session(const char *name, const int32_t *raw, int n)
+{
+    static float base[GSR_STREAM_MAX_SAMPLES], a[GSR_STREAM_MAX_SAMPLES];
+    static int32_t base_q[GSR_STREAM_MAX_SAMPLES], b[GSR_STREAM_MAX_SAMPLES];
+    static struct gsr_stress_stream stream;
+    struct hpi_gsr_stress_index_t batch_res, stream_res;
+    uint64_t t0, c_ref_s = 0, c_new_s = 0, c_ref_b = 0, c_new_b = 0, c_batch = 0, c_add = 0, c_fin = 0;
+    float d_smooth = 0.0f, d_phasic = 0.0f;
+    int duration = MAX(n / 32, 1);
+
+    convert_raw_to_uS(raw, base, n);
+    gsr_raw_to_q(raw, base_q, n);
+
+    for (int r = 0; r < BENCH_REPEAT; r++) {
+        memcpy(a, base, n * sizeof(float));
+        memcpy(b, base_q, n * sizeof(int32_t));
+
+        t0 = bench_now();
+        ref_smooth_gsr(a, n, GSR_SMOOTH_WINDOW);
+        c_ref_s += bench_now() - t0;
+        t0 = bench_now();
+        smooth_gsr(b, n, GSR_SMOOTH_WINDOW);
+        c_new_s += bench_now() - t0;
+        d_smooth = max_abs_diff(a, b, n);
+
+        t0 = bench_now();
+        ref_remove_baseline(a, n, GSR_BASELINE_WINDOW);
+        c_ref_b += bench_now() - t0;
+        t0 = bench_now();
+        remove_baseline(b, n, GSR_BASELINE_WINDOW);
+        c_new_b += bench_now() - t0;
+        d_phasic = max_abs_diff(a, b, n);
+
+        t0 = bench_now();
+        calculate_gsr_stress_index(raw, n, duration, &batch_res);
+        c_batch += bench_now() - t0;
+
+        /* Fed in 8-sample BioZ batches like data_thread */
+        t0 = bench_now();
+        gsr_stress_stream_reset(&stream);
+        for (int i = 0; i < n; i += BIOZ_POINTS_PER_SAMPLE) {
+            gsr_stress_stream_add(&stream, &raw[i], MIN(BIOZ_POINTS_PER_SAMPLE, n - i));
+        }
+        c_add += bench_now() - t0;
+        t0 = bench_now();
+        gsr_stress_stream_finish(&stream, duration, &stream_res);
+        c_fin += bench_now() - t0;
+    }
+
+    float d_stream = 0.0f;
+    for (int i = 0; i < n; i++) {
+        d_stream = fmaxf(d_stream, GSR_Q_TO_US(llabs((int64_t)stream.phasic[i] - b[i])));
+    }
+    bool same = batch_res.stress_level == stream_res.stress_level &&
+                batch_res.tonic_level_x100 == stream_res.tonic_level_x100 &&
+                batch_res.peaks_per_minute == stream_res.peaks_per_minute &&
+                batch_res.mean_peak_amplitude_x100 == stream_res.mean_peak_amplitude_x100;
+
+    printf("%s: %d samples\n", name, n);
+    printf("  smooth_gsr(%d)       old %9llu  new %9llu %s  max|diff| %.2e uS\n", GSR_SMOOTH_WINDOW,
+           (unsigned long long)(c_ref_s / BENCH_REPEAT), (unsigned long long)(c_new_s / BENCH_REPEAT),
+           BENCH_UNIT, (double)d_smooth);
+    printf("  remove_baseline(%d) old %9llu  new %9llu %s  max|diff| %.2e uS\n", GSR_BASELINE_WINDOW,
+           (unsigned long long)(c_ref_b / BENCH_REPEAT), (unsigned long long)(c_new_b / BENCH_REPEAT),
+           BENCH_UNIT, (double)d_phasic);
+    printf("  stress index batch %9llu, stream add %9llu + finish %9llu %s, phasic max|diff| %.2e\n",
+           (unsigned long long)(c_batch / BENCH_REPEAT), (unsigned long long)(c_add / BENCH_REPEAT),
+           (unsigned long long)(c_fin / BENCH_REPEAT), BENCH_UNIT, (double)d_stream);
+    printf("  batch  level %3u tonic %5u SCR %2u amp %4u\n", batch_res.stress_level,
+           batch_res.tonic_level_x100, batch_res.peaks_per_minute, batch_res.mean_peak_amplitude_x100);
+    printf("  stream level %3u tonic %5u SCR %2u amp %4u  %s\n", stream_res.stress_level,
+           stream_res.tonic_level_x100, stream_res.peaks_per_minute,
+           stream_res.mean_peak_amplitude_x100, same ? "match" : "DIFFER");
+}
+
+int main(int argc, char **argv)
+{
+    char name[300];
+
+    if (argc < 2) {
+        int n = synth_trace();
+        run_session("synthetic", trace, n);
+        return 0;
+    }
+
+    for (int f = 1; f < argc; f++) {
+        int n = load_trace(argv[f]);
+        if (n <= 0) {
+            continue;
+        }
+        for (int off = 0, s = 0; off < n; off += GSR_RECORD_BUFFER_SAMPLES, s++) {
+            int len = MIN(GSR_RECORD_BUFFER_SAMPLES, n - off);
+            if (len < 64) {
+                break;
+            }
+            snprintf(name, sizeof(name), "%s #%d", argv[f], s);
+            run_session(name, &trace[off], len);
+        }
+    }
+    return 0;
+}
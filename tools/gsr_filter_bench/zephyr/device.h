@@ -0,0 +1,2 @@
+/* HealthyPi Move - empty host stand-in, nothing from this header is used by gsr_algos.c */
+#pragma once
@@ -0,0 +1,15 @@
+/*
+ * HealthyPi Move - Host stand-in for the devicetree macros used by gsr_algos.c
+ *
+ * No nodes exist on the host, so gsr_algos.c falls back to the board's BioZ
+ * gain and current settings.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#pragma once
+
+#define DT_ALIAS(alias)         0
+#define DT_NODE_EXISTS(node)    0
@@ -0,0 +1,25 @@
+/*
+ * HealthyPi Move - Host stand-in for the Zephyr kernel API used by gsr_algos.c
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+static inline int64_t k_uptime_get(void)
+{
+    return 0;
+}
@@ -0,0 +1,15 @@
+/*
+ * HealthyPi Move - Host stand-in for Zephyr logging (discards everything)
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#pragma once
+
+#define LOG_MODULE_REGISTER(...)
+#define LOG_ERR(...) do { } while (0)
+#define LOG_WRN(...) do { } while (0)
+#define LOG_INF(...) do { } while (0)
+#define LOG_DBG(...) do { } while (0)
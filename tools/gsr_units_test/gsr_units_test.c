@@ -0,0 +1,220 @@
+/*
+ * HealthyPi Move - GSR unit conversion tests
+ *
+ * Checks the float and Q11.20 conductance conversions in app/src/gsr_algos.c
+ * against the float reference they replaced (per-sample voltage, impedance
+ * and reciprocal) and against the driver's scalar max30001_bioz_raw_to_uS(), and
+ * the Q11.20 smoothing and baseline removal against the float pipeline.
+ *
+ *   cc -O2 -I tools/gsr_filter_bench -I app/src -I drivers/sensor/max30001 \
+ *      tools/gsr_units_test/gsr_units_test.c app/src/gsr_algos.c -lm -o gsr_units_test
+ *   ./gsr_units_test
+ *
+ * Tolerance: conductance within GSR_TEST_REL_TOL relative plus GSR_TEST_ABS_TOL
+ * (one Q11.20 LSB) of the float value, Q11.20 saturated to GSR_TEST_MAX_US
+ * above its range, identical no-contact (0 µS) decisions, and phasic signals
+ * after smoothing and baseline removal within GSR_TEST_PHASIC_TOL µS. Exits
+ * non-zero on any failure.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include "hpi_common_types.h"
+#include "gsr_algos.h"
+#include "max30001_bioz.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycles"
+static uint64_t bench_now(void) { return __rdtsc(); }
+#else
+#include <time.h>
+#define BENCH_UNIT "ns"
+static uint64_t bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+#endif
+
+#define GSR_TEST_REL_TOL     1e-6f
+#define GSR_TEST_ABS_TOL     (1.0f / GSR_Q_ONE_US)
+#define GSR_TEST_MAX_US      GSR_Q_TO_US(INT32_MAX)
+#define GSR_TEST_PHASIC_TOL  1e-4f
+#define GSR_TEST_CHUNK       256
+
+/* Previous per-sample conversion (20 V/V, 16 µA), kept as the reference */
+static void ref_raw_to_uS(const int32_t *raw_data, float *gsr_data, int length)
+{
+    for (int i = 0; i < length; i++) {
+        float v_electrode = ((float)raw_data[i] / 524288.0f) * (1.0f / 20.0f);
+        float impedance = fabsf(v_electrode / 16e-6f);
+
+        gsr_data[i] = (impedance < 0.1f) ? 0.0f : (1.0f / impedance) * 1e6f;
+    }
+}
+
+static int failures;
+
+static void check(const char *name, bool ok)
+{
+    printf("%-52s %s\n", name, ok ? "PASS" : "FAIL");
+    if (!ok) {
+        failures++;
+    }
+}
+
+/* Error of got in units of the tolerance (<= 1 passes) */
+static float tol_err(float got, float ref)
+{
+    return fabsf(got - ref) / (GSR_TEST_REL_TOL * ref + GSR_TEST_ABS_TOL);
+}
+
+/* Every 20-bit code, plus the large codes the synthetic traces use */
+static void test_conversion(void)
+{
+    static int32_t raw[GSR_TEST_CHUNK], q[GSR_TEST_CHUNK];
+    static float got[GSR_TEST_CHUNK], ref[GSR_TEST_CHUNK];
+    float worst = 0.0f, worst_drv = 0.0f, worst_q = 0.0f;
+    long zero_mismatch = 0, saturated = 0, count = 0;
+    int64_t lo = -(1 << 19), hi = (1 << 19);
+
+    for (int pass = 0; pass < 2; pass++) {
+        int64_t step = pass ? 4099 : 1;
+        int64_t from = pass ? -(1ll << 30) : lo, to = pass ? (1ll << 30) : hi;
+
+        for (int64_t c = from; c < to; c += step * GSR_TEST_CHUNK) {
+            int n = 0;
+            for (; n < GSR_TEST_CHUNK && c + n * step < to; n++) {
+                raw[n] = (int32_t)(c + n * step);
+            }
+            convert_raw_to_uS(raw, got, n);
+            gsr_raw_to_q(raw, q, n);
+            ref_raw_to_uS(raw, ref, n);
+
+            for (int i = 0; i < n; i++) {
+                float drv = max30001_bioz_raw_to_uS(raw[i], 1, 2);
+                if ((got[i] == 0.0f) != (ref[i] == 0.0f) || (q[i] == 0) != (ref[i] == 0.0f)) {
+                    zero_mismatch++;
+                }
+                worst = fmaxf(worst, tol_err(got[i], ref[i]));
+                worst_drv = fmaxf(worst_drv, tol_err(got[i], drv));
+                worst_q = fmaxf(worst_q, tol_err(GSR_Q_TO_US(q[i]), fminf(ref[i], GSR_TEST_MAX_US)));
+                saturated += (ref[i] >= GSR_TEST_MAX_US);
+                count++;
+            }
+        }
+    }
+
+    printf("conversion: %ld codes (%ld saturate Q11.20), max err %.2f vs reference, %.2f vs driver,"
+           " Q11.20 %.2f (units of tolerance)\n", count, saturated, (double)worst, (double)worst_drv,
+           (double)worst_q);
+    check("float conversion matches float reference", worst <= 1.0f);
+    check("float conversion matches driver scalar", worst_drv <= 1.0f);
+    check("Q11.20 conversion matches float reference", worst_q <= 1.0f);
+    check("no-contact decisions identical", zero_mismatch == 0);
+    check("single-sample helper matches batch",
+          gsr_raw_sample_to_uS(raw[0]) == got[0] && gsr_raw_sample_to_uS(0) == 0.0f);
+}
+
+/* 30 s at 32 Hz: ~5 uS drifting tonic level with six SCRs and sensor noise */
+static void synth_trace(int32_t *trace, int n)
+{
+    srand(1);
+    for (int i = 0; i < n; i++) {
+        float t = i / 32.0f;
+        float g = 5.0f + 0.02f * t;
+
+        for (int k = 0; k < 6; k++) {
+            float t0 = 3.0f + k * 4.5f;
+            if (t > t0) {
+                float d = t - t0;
+                g += 0.25f * (1.0f - expf(-d / 0.7f)) * expf(-d / 3.0f);
+            }
+        }
+        g += 0.003f * ((float)rand() / RAND_MAX - 0.5f);
+        trace[i] = (int32_t)((1e6f / g) * 524288.0f * 20.0f * 16e-6f);
+    }
+}
+
+/* Previous float moving average, kept as the reference for the Q11.20 filters */
+static void ref_moving_average(const float *data, float *mean, int length, int window)
+{
+    for (int i = 0; i < length; i++) {
+        float sum = 0.0f;
+        int count = 0;
+        for (int j = i - window / 2; j <= i + window / 2; j++) {
+            if (j >= 0 && j < length) {
+                sum += data[j];
+                count++;
+            }
+        }
+        mean[i] = sum / count;
+    }
+}
+
+static void test_phasic(void)
+{
+    static int32_t raw[GSR_RECORD_BUFFER_SAMPLES], got[GSR_RECORD_BUFFER_SAMPLES];
+    static float ref[GSR_RECORD_BUFFER_SAMPLES], smooth[GSR_RECORD_BUFFER_SAMPLES];
+    static float mean[GSR_RECORD_BUFFER_SAMPLES];
+    int n = GSR_RECORD_BUFFER_SAMPLES;
+    float worst = 0.0f;
+
+    synth_trace(raw, n);
+    gsr_raw_to_q(raw, got, n);
+    smooth_gsr(got, n, GSR_SMOOTH_WINDOW);
+    remove_baseline(got, n, GSR_BASELINE_WINDOW);
+
+    ref_raw_to_uS(raw, ref, n);
+    ref_moving_average(ref, smooth, n, GSR_SMOOTH_WINDOW);
+    ref_moving_average(smooth, mean, n, GSR_BASELINE_WINDOW);
+
+    for (int i = 0; i < n; i++) {
+        worst = fmaxf(worst, fabsf(GSR_Q_TO_US(got[i]) - (smooth[i] - mean[i])));
+    }
+
+    printf("phasic: max |diff| %.2e uS\n", (double)worst);
+    check("phasic signal matches reference pipeline", worst <= GSR_TEST_PHASIC_TOL);
+}
+
+static void bench(void)
+{
+    static int32_t raw[GSR_RECORD_BUFFER_SAMPLES], q[GSR_RECORD_BUFFER_SAMPLES];
+    static float out[GSR_RECORD_BUFFER_SAMPLES];
+    int n = GSR_RECORD_BUFFER_SAMPLES;
+    uint64_t t_ref = UINT64_MAX, t_new = UINT64_MAX;
+
+    synth_trace(raw, n);
+    for (int rep = 0; rep < 50; rep++) {
+        uint64_t t0 = bench_now();
+        ref_raw_to_uS(raw, out, n);
+        uint64_t t1 = bench_now();
+        gsr_raw_to_q(raw, q, n);
+        uint64_t t2 = bench_now();
+        t_ref = (t1 - t0 < t_ref) ? t1 - t0 : t_ref;
+        t_new = (t2 - t1 < t_new) ? t2 - t1 : t_new;
+    }
+
+    printf("convert %d samples: float reference %llu, Q11.20 %llu %s\n", n,
+           (unsigned long long)t_ref, (unsigned long long)t_new, BENCH_UNIT);
+}
+
+int main(void)
+{
+    test_conversion();
+    test_phasic();
+    bench();
+
+    printf("%s (%d failure%s)\n", failures ? "FAILED" : "OK", failures, failures == 1 ? "" : "s");
+    return failures ? 1 : 0;
+}
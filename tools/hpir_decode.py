@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+#
+# HealthyPi Move - HPIR recording decoder
+#
+# Decodes signal files from a recording session (ppg_wrist.bin, gsr.bin, ...)
+# to CSV. Handles version 1 (raw interleaved samples) and version 2 (blocks of
+# fixed-predictor + Rice coded samples, see app/src/rec_codec.h).
+#
+#   hpir_decode.py ppg_wrist.bin > ppg_wrist.csv
+#   hpir_decode.py --info session_dir/*.bin
+#
+# SPDX-License-Identifier: MIT
+#
+# Copyright (c) 2025 Protocentral Electronics
+
+import argparse
+import struct
+import sys
+import zlib
+
+FILE_MAGIC = 0x48504952
+FILE_HEADER = struct.Struct("<IBBHqIII")       # 28 bytes
+BLOCK_HEADER = struct.Struct("<HBBHHII")       # 16 bytes
+BLOCK_SYNC = 0xB10C
+CODEC_RAW = 0
+CODEC_RICE = 1
+RICE_ESCAPE = 32
+
+# signal_type -> (name, channel names, channel struct format)
+SIGNALS = {
+    0: ("ppg_wrist", ("ir", "red", "green"), "I"),
+    1: ("ppg_finger", ("ir", "red"), "I"),
+    2: ("imu_accel", ("x", "y", "z"), "h"),
+    3: ("imu_gyro", ("x", "y", "z"), "h"),
+    4: ("gsr", ("value",), "i"),
+}
+
+
+class BitReader:
+    def __init__(self, data, pos):
+        self.data = data
+        self.bit = pos * 8
+
+    def read(self, n):
+        v = 0
+        for _ in range(n):
+            byte = self.data[self.bit >> 3]
+            v = (v << 1) | ((byte >> (7 - (self.bit & 7))) & 1)
+            self.bit += 1
+        return v
+
+    def byte_pos(self):
+        return (self.bit + 7) >> 3
+
+
+def unzigzag(u):
+    return (u >> 1) ^ -(u & 1)
+
+
+def to_signed(v, bits):
+    return v - (1 << bits) if v & (1 << (bits - 1)) else v
+
+
+def decode_rice(payload, n, nch):
+    columns = []
+    pos = 0
+    for _ in range(nch):
+        order, k = payload[pos], payload[pos + 1]
+        pos += 2
+        x = [struct.unpack_from("<i", payload, pos + 4 * i)[0] for i in range(order)]
+        pos += 4 * order
+
+        br = BitReader(payload, pos)
+        for i in range(order, n):
+            q = 0
+            while q < RICE_ESCAPE and br.read(1):
+                q += 1
+            if q == RICE_ESCAPE:
+                u = br.read(64)
+            else:
+                u = (q << k) | br.read(k)
+            r = unzigzag(u)
+            if order == 0:
+                v = r
+            elif order == 1:
+                v = r + x[i - 1]
+            else:
+                v = r + 2 * x[i - 1] - x[i - 2]
+            x.append(to_signed(v & 0xFFFFFFFF, 32))
+        pos = br.byte_pos()
+        columns.append(x)
+    return [list(row) for row in zip(*columns)]
+
+
+def cast(rows, fmt):
+    # Values travel as signed 32-bit; PPG channels are unsigned on the device
+    if fmt == "I":
+        return [[v & 0xFFFFFFFF for v in row] for row in rows]
+    return rows
+
+
+def decode_file(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    magic, version, sig, rate, start_ts, num_samples, decimation, _ = FILE_HEADER.unpack_from(data, 0)
+    if magic != FILE_MAGIC:
+        raise ValueError(f"{path}: not an HPIR file")
+    if sig not in SIGNALS:
+        raise ValueError(f"{path}: unknown signal type {sig}")
+
+    name, channels, fmt = SIGNALS[sig]
+    sample = struct.Struct("<" + fmt * len(channels))
+    info = {
+        "path": path, "version": version, "signal": name, "channels": channels,
+        "rate": rate / max(decimation, 1), "start": start_ts,
+        "num_samples": num_samples, "file_bytes": len(data),
+        "blocks": 0, "crc_errors": 0,
+    }
+    rows = []
+    pos = FILE_HEADER.size
+
+    if version == 1:
+        usable = (len(data) - pos) // sample.size * sample.size
+        rows = [list(r) for r in sample.iter_unpack(data[pos:pos + usable])]
+    elif version == 2:
+        while pos + BLOCK_HEADER.size <= len(data):
+            sync, codec, nch, n, plen, first, crc = BLOCK_HEADER.unpack_from(data, pos)
+            if sync != BLOCK_SYNC or nch != len(channels):
+                raise ValueError(f"{path}: bad block header at offset {pos}")
+            payload = data[pos + BLOCK_HEADER.size:pos + BLOCK_HEADER.size + plen]
+            pos += BLOCK_HEADER.size + plen
+            if len(payload) < plen:
+                break   # Truncated tail (power loss before the last sync)
+            info["blocks"] += 1
+            if zlib.crc32(payload) != crc:
+                info["crc_errors"] += 1
+                continue
+            if first != len(rows):
+                sys.stderr.write(f"{path}: gap at sample {len(rows)}, block starts at {first}\n")
+            if codec == CODEC_RAW:
+                rows += [list(r) for r in sample.iter_unpack(payload[:n * sample.size])]
+            elif codec == CODEC_RICE:
+                rows += cast(decode_rice(payload, n, nch), fmt)
+            else:
+                raise ValueError(f"{path}: unknown codec {codec}")
+    else:
+        raise ValueError(f"{path}: unsupported version {version}")
+
+    info["decoded"] = len(rows)
+    info["raw_bytes"] = len(rows) * sample.size
+    return info, rows
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decode HealthyPi Move HPIR recording files")
+    ap.add_argument("files", nargs="+")
+    ap.add_argument("--info", action="store_true", help="print a summary instead of CSV")
+    args = ap.parse_args()
+
+    status = 0
+    for path in args.files:
+        info, rows = decode_file(path)
+        if info["crc_errors"]:
+            status = 1
+
+        if args.info:
+            ratio = info["raw_bytes"] / max(info["file_bytes"] - FILE_HEADER.size, 1)
+            print(f"{path}: v{info['version']} {info['signal']} {info['rate']:g} Hz, "
+                  f"{info['decoded']}/{info['num_samples']} samples, {info['blocks']} blocks, "
+                  f"{info['crc_errors']} CRC errors, ratio {ratio:.2f}x")
+            continue
+
+        period = 1.0 / info["rate"] if info["rate"] else 0.0
+        print("t_s," + ",".join(info["channels"]))
+        for i, row in enumerate(rows):
+            print(f"{info['start'] + i * period:.3f}," + ",".join(str(v) for v in row))
+
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
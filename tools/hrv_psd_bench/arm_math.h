@@ -0,0 +1,99 @@
+/*
+ * HealthyPi Move - Host stand-in for the CMSIS-DSP calls used by hrv_spectrum.c
+ *
+ * Plain C versions so tools/hrv_psd_bench can build the firmware estimators on
+ * a PC. The real FFT is a radix-2 complex FFT of the full length, roughly
+ * twice the work of arm_rfft_fast_f32, so host timings favour Lomb-Scargle
+ * slightly; compare orders of magnitude, not percentages.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+typedef float float32_t;
+typedef int32_t arm_status;
+
+#define ARM_MATH_SUCCESS 0
+#define PI 3.14159265358979f
+
+typedef struct {
+    uint16_t fftLen;
+} arm_rfft_fast_instance_f32;
+
+static inline arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 *s, uint16_t len)
+{
+    s->fftLen = len;
+    return ARM_MATH_SUCCESS;
+}
+
+/* Same packed layout as CMSIS: [DC, Nyquist, re1, im1, ...] */
+static inline void arm_rfft_fast_f32(const arm_rfft_fast_instance_f32 *s, float32_t *in,
+                                     float32_t *out, uint8_t ifft)
+{
+    static float re[256], im[256];
+    uint32_t n = s->fftLen;
+
+    (void)ifft;
+    for (uint32_t i = 0, j = 0; i < n; i++) {
+        re[j] = in[i];
+        im[j] = 0.0f;
+        /* Bit-reversed increment */
+        uint32_t bit = n >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j |= bit;
+    }
+    for (uint32_t len = 2; len <= n; len <<= 1) {
+        float a = -2.0f * PI / len;
+        for (uint32_t i = 0; i < n; i += len) {
+            for (uint32_t k = 0; k < len / 2; k++) {
+                float wr = cosf(a * k), wi = sinf(a * k);
+                float xr = re[i + k + len / 2] * wr - im[i + k + len / 2] * wi;
+                float xi = re[i + k + len / 2] * wi + im[i + k + len / 2] * wr;
+                re[i + k + len / 2] = re[i + k] - xr;
+                im[i + k + len / 2] = im[i + k] - xi;
+                re[i + k] += xr;
+                im[i + k] += xi;
+            }
+        }
+    }
+    out[0] = re[0];
+    out[1] = re[n / 2];
+    for (uint32_t k = 1; k < n / 2; k++) {
+        out[2 * k] = re[k];
+        out[2 * k + 1] = im[k];
+    }
+}
+
+static inline void arm_mean_f32(const float32_t *src, uint32_t n, float32_t *result)
+{
+    float32_t sum = 0.0f;
+    for (uint32_t i = 0; i < n; i++) {
+        sum += src[i];
+    }
+    *result = sum / n;
+}
+
+static inline void arm_scale_f32(const float32_t *src, float32_t scale, float32_t *dst, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        dst[i] = src[i] * scale;
+    }
+}
+
+static inline arm_status arm_sqrt_f32(float32_t in, float32_t *out)
+{
+    *out = (in > 0.0f) ? sqrtf(in) : 0.0f;
+    return ARM_MATH_SUCCESS;
+}
+
+static inline float32_t arm_sin_f32(float32_t x) { return sinf(x); }
+static inline float32_t arm_cos_f32(float32_t x) { return cosf(x); }
@@ -0,0 +1,512 @@
+/*
+ * HealthyPi Move - QRS detector bench
+ *
+ * Runs the R-peak detector in app/src/ecg_qrs.c over annotated ECG records
+ * and reports sensitivity, positive predictivity, R-peak timing error, how
+ * well ectopic intervals are kept out of HRV, the resulting RMSSD and SDNN
+ * against the reference NN intervals, and CPU per second of ECG.
+ *
+ *   cc -O2 -I app/src tools/qrs_bench/qrs_bench.c app/src/ecg_qrs.c -lm -o qrs_bench
+ *   ./qrs_bench                                  # synthetic records
+ *   ./qrs_bench 100.txt 100.ann 360              # MIT-BIH style record
+ *
+ * A record is a signal file (one sample per line, or the last CSV column,
+ * e.g. "rdsamp -r mitdb/100 -c -H -f 0 -s MLII -p" minus the time column)
+ * and an annotation file, either rdann output ("time sample type ...",
+ * beat types only) or one R-peak sample index per line. Records at another
+ * rate are linearly resampled to 128 Hz. Scoring follows EC57: a beat is
+ * detected if a detection lies within 150 ms, the first 3 s are the
+ * detector's learning period and are not scored.
+ *
+ * Without arguments, 5 minute synthetic records are generated: sum-of-
+ * Gaussians PQRST beats with respiratory and LF rate variability, plus
+ * baseline wander, mains, EMG noise, ectopy and motion bursts. Timings are
+ * in TSC cycles on x86, nanoseconds elsewhere.
+ *
+ * HRV is computed the way data_module.c feeds the streaming engine: only
+ * confident intervals within 300-1500 ms are used, and successive
+ * differences restart after any dropped beat. The bench exits non-zero when
+ * RMSSD or SDNN on any record is off the reference by more than
+ * HRV_MAX_ERR_PCT.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Protocentral Electronics
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ecg_qrs.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycles"
+static uint64_t bench_now(void) { return __rdtsc(); }
+#else
+#define BENCH_UNIT "ns"
+static uint64_t bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+#endif
+
+#define FS              QRS_FS_HZ
+#define BATCH           32                      // MAX30001 ECG FIFO batch
+#define MATCH_WINDOW    (FS * 150 / 1000)
+#define SKIP_SAMPLES    (3 * FS)
+#define REC_SECONDS     300
+#define REC_MAX         (FS * 60 * 60)
+#define BEATS_MAX       (REC_MAX / 20)
+#define BENCH_REPEAT    20
+#define UV_TO_CODES     2.62                    // MAX30001 at 20 V/V: ~0.38 uV per code
+#define HRV_MAX_ERR_PCT 10.0
+
+struct record {
+    const char *name;
+    int32_t *ecg;
+    uint32_t len;
+    uint32_t *ref;                              // Reference R peaks
+    uint8_t *ref_ectopic;                       // Beat is not sinus
+    uint32_t num_ref;
+};
+
+struct detection {
+    uint32_t sample;
+    uint16_t rr_ms;
+    bool confident;
+};
+
+static struct detection det[BEATS_MAX];
+
+/* ----------------------------------------------------------------------- */
+/* Synthetic records                                                        */
+/* ----------------------------------------------------------------------- */
+
+struct synth_cfg {
+    const char *name;
+    float hr_bpm;
+    float r_mv;                 // R amplitude
+    float t_mv;                 // T amplitude
+    float pvc_rate;             // Fraction of premature ventricular beats
+    float apc_rate;             // Fraction of premature atrial beats
+    float emg_mv;               // White noise sigma
+    float mains_mv;
+    float wander_mv;
+    bool motion;                // 2 s bursts of motion artefact every 30 s
+    bool amp_step;              // Amplitude drops to 40% halfway through
+};
+
+static const struct synth_cfg synth_records[] = {
+    {"clean",     70, 1.0f, 0.30f, 0.00f, 0.00f, 0.005f, 0.00f, 0.0f, false, false},
+    {"noisy",     70, 1.0f, 0.30f, 0.00f, 0.00f, 0.080f, 0.20f, 0.5f, false, false},
+    {"ectopy",    75, 1.0f, 0.30f, 0.05f, 0.03f, 0.020f, 0.05f, 0.2f, false, false},
+    {"brady",     45, 0.8f, 0.55f, 0.00f, 0.00f, 0.020f, 0.05f, 0.3f, false, false},
+    {"tachy",    150, 0.9f, 0.25f, 0.00f, 0.00f, 0.030f, 0.05f, 0.3f, false, false},
+    {"low-amp",   65, 0.3f, 0.10f, 0.00f, 0.00f, 0.020f, 0.05f, 0.2f, false, true},
+    {"motion",    80, 1.0f, 0.30f, 0.01f, 0.00f, 0.030f, 0.05f, 0.3f, true,  false},
+};
+
+static uint32_t rng_state = 12345;
+
+static float frand(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (rng_state >> 8) / 16777216.0f;
+}
+
+static float grand(void)
+{
+    float u1 = frand() + 1e-7f, u2 = frand();
+    return sqrtf(-2.0f * logf(u1)) * cosf(2.0f * (float)M_PI * u2);
+}
+
+static void add_wave(float *sig, uint32_t len, float t0, float amp, float sigma)
+{
+    int lo = (int)((t0 - 4 * sigma) * FS), hi = (int)((t0 + 4 * sigma) * FS) + 1;
+
+    for (int i = lo < 0 ? 0 : lo; i < hi && i < (int)len; i++) {
+        float dt = i / (float)FS - t0;
+        sig[i] += amp * expf(-dt * dt / (2 * sigma * sigma));
+    }
+}
+
+static void synth_record(const struct synth_cfg *cfg, struct record *rec, float *sig)
+{
+    uint32_t len = REC_SECONDS * FS;
+    float rr0 = 60.0f / cfg->hr_bpm;
+    float t = 0.5f;
+    bool prev_premature = false;
+
+    memset(sig, 0, len * sizeof(float));
+    rec->num_ref = 0;
+
+    while (t < REC_SECONDS - 1.0f && rec->num_ref < BEATS_MAX) {
+        // Respiratory (0.25 Hz) and LF (0.1 Hz) modulation plus jitter
+        float rr = rr0 * (1.0f + 0.05f * sinf(2 * (float)M_PI * 0.25f * t) +
+                          0.03f * sinf(2 * (float)M_PI * 0.1f * t) + 0.01f * grand());
+        float u = frand();
+        bool pvc = !prev_premature && u < cfg->pvc_rate;
+        bool apc = !prev_premature && !pvc && u < cfg->pvc_rate + cfg->apc_rate;
+        float amp = cfg->r_mv * ((cfg->amp_step && t > REC_SECONDS / 2) ? 0.4f : 1.0f);
+
+        if (pvc || apc) {
+            // Premature by 30%; a PVC is followed by a full compensatory pause
+            float early = 0.3f * rr;
+            t -= early;
+            rr += pvc ? early : 0.0f;
+        }
+
+        if (pvc) {
+            add_wave(sig, len, t, -1.3f * amp, 0.030f);
+            add_wave(sig, len, t + 0.06f, 0.4f * amp, 0.025f);
+            add_wave(sig, len, t + 0.32f, 0.45f * amp, 0.07f);
+        } else {
+            float qt = 0.25f * sqrtf(rr / 1.0f) + 0.05f;
+            add_wave(sig, len, t - 0.18f, 0.12f * amp, 0.025f);
+            add_wave(sig, len, t - 0.025f, -0.10f * amp, 0.010f);
+            add_wave(sig, len, t, amp, 0.011f);
+            add_wave(sig, len, t + 0.03f, -0.25f * amp, 0.010f);
+            add_wave(sig, len, t + qt, cfg->t_mv * amp / cfg->r_mv, 0.045f);
+        }
+
+        rec->ref[rec->num_ref] = (uint32_t)lroundf(t * FS);
+        rec->ref_ectopic[rec->num_ref] = pvc || apc;
+        rec->num_ref++;
+        prev_premature = pvc || apc;
+        t += rr;
+    }
+
+    float motion = 0.0f;
+    for (uint32_t i = 0; i < len; i++) {
+        float ts = i / (float)FS;
+        float v = sig[i] + cfg->emg_mv * grand() +
+                  cfg->mains_mv * sinf(2 * (float)M_PI * 50.0f * ts) +
+                  cfg->wander_mv * sinf(2 * (float)M_PI * 0.3f * ts + 0.7f);
+
+        if (cfg->motion && fmodf(ts, 30.0f) > 20.0f && fmodf(ts, 30.0f) < 22.0f) {
+            motion += 0.25f * grand();
+            v += motion + ((frand() < 0.01f) ? 2.0f * grand() : 0.0f);
+        } else {
+            motion *= 0.9f;
+            v += motion;
+        }
+        rec->ecg[i] = (int32_t)lroundf(v * 1000.0f * UV_TO_CODES);
+    }
+    rec->len = len;
+    rec->name = cfg->name;
+}
+
+/* ----------------------------------------------------------------------- */
+/* Record files                                                             */
+/* ----------------------------------------------------------------------- */
+
+static bool is_beat_code(const char *code)
+{
+    return strlen(code) == 1 && strchr("NLRBAaJSVrFejnE/fQ", code[0]) != NULL;
+}
+
+static int load_record(const char *sig_path, const char *ann_path, double fs_in,
+                       struct record *rec, float *scratch)
+{
+    FILE *f = fopen(sig_path, "r");
+    char line[256];
+    uint32_t n = 0;
+
+    if (f == NULL) {
+        perror(sig_path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) && n < REC_MAX) {
+        char *last = strrchr(line, ',');
+        char *end;
+        double v = strtod(last ? last + 1 : line, &end);
+        if (end != (last ? last + 1 : line)) {
+            scratch[n++] = (float)v;
+        }
+    }
+    fclose(f);
+
+    // Values below 100 are taken to be millivolts (rdsamp -p), otherwise ADC codes
+    float peak = 0.0f;
+    for (uint32_t i = 0; i < n; i++) {
+        peak = fmaxf(peak, fabsf(scratch[i]));
+    }
+    float scale = (peak < 100.0f) ? 1000.0f * UV_TO_CODES : 1.0f;
+
+    double step = fs_in / FS;
+    rec->len = 0;
+    for (double pos = 0; pos + 1 < n && rec->len < REC_MAX; pos += step) {
+        uint32_t i = (uint32_t)pos;
+        float frac = (float)(pos - i);
+        float v = scratch[i] + frac * (scratch[i + 1] - scratch[i]);
+        rec->ecg[rec->len++] = (int32_t)lroundf(v * scale);
+    }
+
+    f = fopen(ann_path, "r");
+    if (f == NULL) {
+        perror(ann_path);
+        return -1;
+    }
+    rec->num_ref = 0;
+    while (fgets(line, sizeof(line), f) && rec->num_ref < BEATS_MAX) {
+        char t0[32], t1[32], t2[32];
+        int fields = sscanf(line, "%31s %31s %31s", t0, t1, t2);
+        long sample;
+        bool ectopic = false;
+
+        if (fields >= 3 && strchr(t0, ':') != NULL) {
+            if (!is_beat_code(t2)) {
+                continue;
+            }
+            sample = strtol(t1, NULL, 10);
+            ectopic = (t2[0] != 'N' && t2[0] != 'L' && t2[0] != 'R' && t2[0] != 'B');
+        } else if (fields >= 1 && sscanf(t0, "%ld", &sample) == 1) {
+        } else {
+            continue;
+        }
+        rec->ref[rec->num_ref] = (uint32_t)lround(sample / step);
+        rec->ref_ectopic[rec->num_ref] = ectopic;
+        rec->num_ref++;
+    }
+    fclose(f);
+
+    rec->name = sig_path;
+    return 0;
+}
+
+/* ----------------------------------------------------------------------- */
+/* Scoring                                                                  */
+/* ----------------------------------------------------------------------- */
+
+struct score {
+    uint32_t tp, fn, fp;
+    double timing_err_ms;
+    uint32_t nn_total, nn_rejected;             // Sinus-sinus intervals, wrongly flagged
+    uint32_t ect_total, ect_accepted;           // Intervals touching an ectopic beat, passed as confident
+    double rmssd_ref, rmssd_det;
+    double sdnn_ref, sdnn_det;
+    uint64_t cost;
+};
+
+static double rmssd(const double *rr, const uint8_t *valid, uint32_t n)
+{
+    double sum = 0.0;
+    uint32_t count = 0;
+
+    for (uint32_t i = 1; i < n; i++) {
+        if (valid[i] && valid[i - 1]) {
+            double d = rr[i] - rr[i - 1];
+            sum += d * d;
+            count++;
+        }
+    }
+    return count ? sqrt(sum / count) : 0.0;
+}
+
+static double sdnn(const double *rr, const uint8_t *valid, uint32_t n)
+{
+    double sum = 0.0, sum_sq = 0.0;
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (valid[i]) {
+            sum += rr[i];
+            sum_sq += rr[i] * rr[i];
+            count++;
+        }
+    }
+    if (count < 2) {
+        return 0.0;
+    }
+    double mean = sum / count;
+    return sqrt((sum_sq - count * mean * mean) / (count - 1));
+}
+
+static double err_pct(double det, double ref)
+{
+    return ref > 0.0 ? 100.0 * (det - ref) / ref : 0.0;
+}
+
+static uint32_t run_detector(const struct record *rec, uint64_t *cost)
+{
+    static struct hpi_qrs_detector qrs;
+    struct hpi_qrs_beat beats[QRS_MAX_BEATS_PER_CALL];
+    uint32_t num_det = 0;
+    uint64_t best = UINT64_MAX;
+
+    for (int rep = 0; rep < BENCH_REPEAT; rep++) {
+        num_det = 0;
+        hpi_qrs_init(&qrs);
+
+        uint64_t t0 = bench_now();
+        for (uint32_t i = 0; i < rec->len; i += BATCH) {
+            uint32_t n = (rec->len - i < BATCH) ? rec->len - i : BATCH;
+            int nb = hpi_qrs_process(&qrs, &rec->ecg[i], n, beats, QRS_MAX_BEATS_PER_CALL);
+            for (int b = 0; b < nb && num_det < BEATS_MAX; b++) {
+                det[num_det++] = (struct detection){beats[b].sample, beats[b].rr_ms,
+                                                    beats[b].confident};
+            }
+        }
+        uint64_t dt = bench_now() - t0;
+        best = (dt < best) ? dt : best;
+    }
+
+    *cost = best;
+    return num_det;
+}
+
+static void score_record(const struct record *rec, struct score *s)
+{
+    static int32_t det_match[BEATS_MAX];        // Reference index matched by each detection
+    static int32_t ref_match[BEATS_MAX];
+    static double rr_ref[BEATS_MAX], rr_det[BEATS_MAX];
+    static uint8_t ok_ref[BEATS_MAX], ok_det[BEATS_MAX];
+
+    memset(s, 0, sizeof(*s));
+    uint32_t num_det = run_detector(rec, &s->cost);
+
+    for (uint32_t i = 0; i < rec->num_ref; i++) {
+        ref_match[i] = -1;
+    }
+
+    // Greedy nearest match within the window, both lists are in time order
+    uint32_t j = 0;
+    for (uint32_t d = 0; d < num_det; d++) {
+        det_match[d] = -1;
+        while (j < rec->num_ref && rec->ref[j] + MATCH_WINDOW < det[d].sample) {
+            j++;
+        }
+        for (uint32_t k = j; k < rec->num_ref && rec->ref[k] <= det[d].sample + MATCH_WINDOW; k++) {
+            if (ref_match[k] < 0) {
+                ref_match[k] = (int32_t)d;
+                det_match[d] = (int32_t)k;
+                break;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < rec->num_ref; i++) {
+        if (rec->ref[i] < SKIP_SAMPLES) {
+            continue;
+        }
+        if (ref_match[i] >= 0) {
+            s->tp++;
+            s->timing_err_ms += fabs((double)det[ref_match[i]].sample - rec->ref[i]) * 1000.0 / FS;
+        } else {
+            s->fn++;
+        }
+    }
+    for (uint32_t d = 0; d < num_det; d++) {
+        if (det[d].sample >= SKIP_SAMPLES && det_match[d] < 0) {
+            s->fp++;
+        }
+    }
+    s->timing_err_ms = s->tp ? s->timing_err_ms / s->tp : 0.0;
+
+    // Interval classification against the reference rhythm
+    uint32_t nr = 0, nd = 0;
+    for (uint32_t i = 1; i < rec->num_ref; i++) {
+        bool nn = !rec->ref_ectopic[i] && !rec->ref_ectopic[i - 1];
+        rr_ref[nr] = (rec->ref[i] - rec->ref[i - 1]) * 1000.0 / FS;
+        ok_ref[nr++] = nn;
+    }
+    for (uint32_t d = 1; d < num_det; d++) {
+        int32_t a = det_match[d - 1], b = det_match[d];
+        rr_det[nd] = det[d].rr_ms;
+        ok_det[nd++] = det[d].confident && det[d].rr_ms >= 300 && det[d].rr_ms <= 1500;
+
+        if (a < 0 || b != a + 1 || rec->ref[b] < SKIP_SAMPLES) {
+            continue;
+        }
+        if (!rec->ref_ectopic[a] && !rec->ref_ectopic[b]) {
+            s->nn_total++;
+            s->nn_rejected += !det[d].confident;
+        } else {
+            s->ect_total++;
+            s->ect_accepted += det[d].confident;
+        }
+    }
+    s->rmssd_ref = rmssd(rr_ref, ok_ref, nr);
+    s->rmssd_det = rmssd(rr_det, ok_det, nd);
+    s->sdnn_ref = sdnn(rr_ref, ok_ref, nr);
+    s->sdnn_det = sdnn(rr_det, ok_det, nd);
+}
+
+/* Returns false when the HRV error is over HRV_MAX_ERR_PCT */
+static bool print_score(const struct record *rec, const struct score *s, struct score *total)
+{
+    double seconds = rec->len / (double)FS;
+    double rmssd_err = err_pct(s->rmssd_det, s->rmssd_ref);
+    double sdnn_err = err_pct(s->sdnn_det, s->sdnn_ref);
+    bool ok = fabs(rmssd_err) <= HRV_MAX_ERR_PCT && fabs(sdnn_err) <= HRV_MAX_ERR_PCT;
+
+    printf("%-12s %6u %6u %4u %4u  %6.2f%% %6.2f%%  %5.1f  %5.1f%% %5u/%-5u  %6.1f %6.1f %+6.1f%%  %6.1f %6.1f %+6.1f%%  %8.0f%s\n",
+           rec->name, rec->num_ref, s->tp, s->fn, s->fp,
+           100.0 * s->tp / (s->tp + s->fn ? s->tp + s->fn : 1),
+           100.0 * s->tp / (s->tp + s->fp ? s->tp + s->fp : 1),
+           s->timing_err_ms,
+           100.0 * s->nn_rejected / (s->nn_total ? s->nn_total : 1),
+           s->ect_accepted, s->ect_total,
+           s->rmssd_ref, s->rmssd_det, rmssd_err,
+           s->sdnn_ref, s->sdnn_det, sdnn_err,
+           s->cost / seconds, ok ? "" : "  FAIL");
+
+    total->tp += s->tp;
+    total->fn += s->fn;
+    total->fp += s->fp;
+    total->cost += s->cost;
+
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    static int32_t ecg[REC_MAX];
+    static float scratch[REC_MAX * 4];
+    static uint32_t ref[BEATS_MAX];
+    static uint8_t ref_ectopic[BEATS_MAX];
+    struct record rec = {.ecg = ecg, .ref = ref, .ref_ectopic = ref_ectopic};
+    struct score s, total = {0};
+    double seconds = 0.0;
+    bool hrv_ok = true;
+
+    printf("%-12s %6s %6s %4s %4s  %7s %7s  %5s  %6s %11s  %6s %6s %7s  %6s %6s %7s  %8s\n",
+           "record", "beats", "TP", "FN", "FP", "Se", "+P", "dt ms", "NN rej",
+           "ectopic ok", "RMSSD", "det", "err", "SDNN", "det", "err", BENCH_UNIT "/s");
+
+    if (argc >= 3) {
+        double fs_in = (argc >= 4) ? atof(argv[3]) : FS;
+        if (load_record(argv[1], argv[2], fs_in, &rec, scratch) != 0) {
+            return 1;
+        }
+        score_record(&rec, &s);
+        hrv_ok &= print_score(&rec, &s, &total);
+        seconds += rec.len / (double)FS;
+    } else {
+        for (size_t i = 0; i < sizeof(synth_records) / sizeof(synth_records[0]); i++) {
+            synth_record(&synth_records[i], &rec, scratch);
+            score_record(&rec, &s);
+            hrv_ok &= print_score(&rec, &s, &total);
+            seconds += rec.len / (double)FS;
+        }
+    }
+
+    printf("%-12s %6s %6u %4u %4u  %6.2f%% %6.2f%%  %5s  %6s %11s  %6s %6s %7s  %6s %6s %7s  %8.0f\n",
+           "total", "", total.tp, total.fn, total.fp,
+           100.0 * total.tp / (total.tp + total.fn ? total.tp + total.fn : 1),
+           100.0 * total.tp / (total.tp + total.fp ? total.tp + total.fp : 1),
+           "", "", "", "", "", "", "", "", "", total.cost / seconds);
+    printf("detector state %zu bytes\n", sizeof(struct hpi_qrs_detector));
+
+    if (!hrv_ok) {
+        printf("HRV error over %.0f%% on at least one record\n", HRV_MAX_ERR_PCT);
+        return 1;
+    }
+    return 0;
+}